@@ -1,10 +1,42 @@
 ﻿#include "Async_ReadJson.h"
+#include "JsonBase64.h"
+#include "JsonLazyString.h"
+#include "JsonParseStrategy.h"
+#include "JsonParserContext.h"
+#include "Async/ParallelFor.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 
 // 定义日志类别
 DEFINE_LOG_CATEGORY(LogReadJson);
 
+namespace
+{
+    /**
+     * 已反序列化的对象扁平化后的条目数量（不在数组内的对象成员总数）
+     * 只读取各对象的成员数量，不构造路径，也不再遍历源文本；没有预扫描结果时用于预留 Map
+     */
+    int32 CountFlattenedEntries(const FJsonObject& RootJson)
+    {
+        int32 NumEntries = 0;
+        TArray<const FJsonObject*, TInlineAllocator<32>> Stack;
+        Stack.Add(&RootJson);
+        while (Stack.Num() > 0)
+        {
+            const FJsonObject* JsonObject = Stack.Pop();
+            NumEntries += JsonObject->Values.Num();
+            for (const auto& Elem : JsonObject->Values)
+            {
+                if (Elem.Value.IsValid() && Elem.Value->Type == EJson::Object)
+                {
+                    Stack.Add(Elem.Value->AsObject().Get());
+                }
+            }
+        }
+        return NumEntries;
+    }
+}
+
 // ============================================================================
 // 内部解析实现
 // ============================================================================
@@ -22,25 +54,6 @@ void UAsync_ReadJson::Activate()
     LoadJson(JsonStr);
 }
 
-int32 UAsync_ReadJson::CountJsonNodes(const TSharedPtr<FJsonObject>& JsonObject)
-{
-    if (!JsonObject.IsValid() || JsonObject->Values.IsEmpty())
-    {
-        return 0;
-    }
-
-    int32 Count = 0;
-    for (const auto& Elem : JsonObject->Values)
-    {
-        ++Count;
-        if (Elem.Value->Type == EJson::Object)
-        {
-            Count += CountJsonNodes(Elem.Value->AsObject());
-        }
-    }
-    return Count;
-}
-
 void UAsync_ReadJson::LoadJson(const FString& JsonString)
 {
     if (JsonString.IsEmpty())
@@ -51,62 +64,24 @@ void UAsync_ReadJson::LoadJson(const FString& JsonString)
         return;
     }
 
-    TSharedPtr<FJsonObject> JsonObject;
-    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-
-    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
-    {
-        UE_LOG(LogReadJson, Error, TEXT("[ %s ] - [ %hs ] Deserialize Failed, JsonString is invalid"), *GetCallerName(), __FUNCTION__);
-        OnReadJsonFailed.Broadcast({});
-        DestroyTask();
-        return;
-    }
-
-    // 自动检测是否是大型Json
-    if (ShouldUseIterativeParsing(JsonString))
-    {
-        const int32 Count = CountJsonNodes(JsonObject);
-        ParsedDataMap.Empty(Count);
-        UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Begin Parse Large Json, TMap initial size is %d"), 
-            *GetCallerName(), __FUNCTION__, Count);
-        ParseJsonIterative(JsonObject);
-    }
-    else
+    // 使用池化的解析上下文直接扫描源文本（迭代展开，不受嵌套深度限制），扫描栈与路径缓冲在多条消息之间复用
+    UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Begin Parse Json"), *GetCallerName(), __FUNCTION__);
     {
-        UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Begin Parse Json"), *GetCallerName(), __FUNCTION__);
-        ParseJson(JsonObject, TEXT(""));
+        const FJsonParserContextPool::FScopedContext Context;
+        if (!Context->Parse(JsonString, FReadJsonOptions(), ParsedData))
+        {
+            UE_LOG(LogReadJson, Error, TEXT("[ %s ] - [ %hs ] Deserialize Failed, %s"), *GetCallerName(), __FUNCTION__, *Context->GetError());
+            OnReadJsonFailed.Broadcast({});
+            DestroyTask();
+            return;
+        }
     }
 
-    OnReadJsonCompleted.Broadcast({ ParsedDataMap });
+    OnReadJsonCompleted.Broadcast(ParsedData);
     UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] End Parse Json"), *GetCallerName(), __FUNCTION__);
     DestroyTask();
 }
 
-void UAsync_ReadJson::ParseJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& CurrentPath)
-{
-    if (!JsonObject.IsValid() || JsonObject->Values.IsEmpty())
-    {
-        UE_LOG(LogReadJson, Warning, TEXT("[ %s ] - [ %hs ] JsonObject is invalid or empty"), *GetCallerName(), __FUNCTION__);
-        return;
-    }
-
-    for (const auto& Elem : JsonObject->Values)
-    {
-        const FString NewPath = JsonDataHelper::BuildNodePath(CurrentPath, Elem.Key);
-        const TSharedPtr<FJsonValue>& Value = Elem.Value;
-
-        ParseJsonValue(Value, NewPath, ParsedDataMap);
-
-        // 如果是对象类型，递归解析子对象
-        if (Value->Type == EJson::Object)
-        {
-            UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Parse Json Object: [ %s ]"), 
-                *GetCallerName(), __FUNCTION__, *NewPath);
-            ParseJson(Value->AsObject(), NewPath);
-        }
-    }
-}
-
 void UAsync_ReadJson::ParseJson_Block(const TSharedPtr<FJsonObject>& JsonObject, const FString& CurrentPath, FParsedData& OutParsedData)
 {
     if (!JsonObject.IsValid() || JsonObject->Values.IsEmpty())
@@ -131,18 +106,17 @@ void UAsync_ReadJson::ParseJson_Block(const TSharedPtr<FJsonObject>& JsonObject,
     }
 }
 
-void UAsync_ReadJson::ParseJsonIterative(const TSharedPtr<FJsonObject>& RootJson)
+void UAsync_ReadJson::ParseJsonIterative_Block(const TSharedPtr<FJsonObject>& RootJson, const FString& RootPath, TMap<FString, FJsonDataStruct>& OutMap)
 {
-    if (!RootJson.IsValid() || RootJson->Values.IsEmpty())
+    if (!RootJson.IsValid())
     {
-        UE_LOG(LogReadJson, Warning, TEXT("[ %s ] - [ %hs ] JsonObject is invalid or empty"), *GetCallerName(), __FUNCTION__);
         return;
     }
 
     // 预分配栈空间，避免频繁扩容
     TArray<FJsonParseStackNode> Stack;
     Stack.Reserve(32);
-    Stack.Emplace(RootJson, TEXT(""));
+    Stack.Emplace(RootJson, RootPath);
 
     while (Stack.Num() > 0)
     {
@@ -163,19 +137,64 @@ void UAsync_ReadJson::ParseJsonIterative(const TSharedPtr<FJsonObject>& RootJson
             const FString NewPath = JsonDataHelper::BuildNodePath(CurrentPath, Elem.Key);
             const TSharedPtr<FJsonValue>& Value = Elem.Value;
 
-            ParseJsonValue(Value, NewPath, ParsedDataMap);
+            ParseJsonValue(Value, NewPath, OutMap);
 
             // 如果是对象类型，将子对象压入栈中继续解析
             if (Value->Type == EJson::Object)
             {
-                UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Parse Json Object: [ %s ]"), 
-                    *GetCallerName(), __FUNCTION__, *NewPath);
+                UE_LOG(LogReadJson, Log, TEXT("[ %hs ] Parse Json Object: [ %s ]"), __FUNCTION__, *NewPath);
                 Stack.Emplace(Value->AsObject(), NewPath);
             }
         }
     }
 }
 
+void UAsync_ReadJson::ParseJsonParallel_Block(const TSharedPtr<FJsonObject>& RootJson, TMap<FString, FJsonDataStruct>& OutMap)
+{
+    if (!RootJson.IsValid())
+    {
+        return;
+    }
+
+    TArray<const TPair<FString, TSharedPtr<FJsonValue>>*> Members;
+    Members.Reserve(RootJson->Values.Num());
+    for (const auto& Elem : RootJson->Values)
+    {
+        Members.Add(&Elem);
+    }
+
+    // 每个根节点成员写入各自的 Map，互不加锁
+    TArray<TMap<FString, FJsonDataStruct>> PartialMaps;
+    PartialMaps.SetNum(Members.Num());
+    ParallelFor(Members.Num(), [&Members, &PartialMaps](const int32 MemberIndex)
+    {
+        const TPair<FString, TSharedPtr<FJsonValue>>& Member = *Members[MemberIndex];
+        TMap<FString, FJsonDataStruct>& PartialMap = PartialMaps[MemberIndex];
+
+        const bool bIsObject = Member.Value.IsValid() && Member.Value->Type == EJson::Object;
+        PartialMap.Reserve(bIsObject ? CountFlattenedEntries(*Member.Value->AsObject()) + 1 : 1);
+        ParseJsonValue(Member.Value, Member.Key, PartialMap);
+        if (bIsObject)
+        {
+            ParseJsonIterative_Block(Member.Value->AsObject(), Member.Key, PartialMap);
+        }
+    });
+
+    int32 NumEntries = OutMap.Num();
+    for (const TMap<FString, FJsonDataStruct>& PartialMap : PartialMaps)
+    {
+        NumEntries += PartialMap.Num();
+    }
+    OutMap.Reserve(NumEntries);
+    for (TMap<FString, FJsonDataStruct>& PartialMap : PartialMaps)
+    {
+        for (TPair<FString, FJsonDataStruct>& Pair : PartialMap)
+        {
+            OutMap.Add(MoveTemp(Pair.Key), MoveTemp(Pair.Value));
+        }
+    }
+}
+
 void UAsync_ReadJson::ParseJsonValue(const TSharedPtr<FJsonValue>& Value, const FString& Path, TMap<FString, FJsonDataStruct>& OutMap)
 {
     if (!Value.IsValid())
@@ -192,7 +211,7 @@ void UAsync_ReadJson::ParseJsonValue(const TSharedPtr<FJsonValue>& Value, const
             TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ObjectString);
             if (FJsonSerializer::Serialize(Value->AsObject().ToSharedRef(), Writer))
             {
-                OutMap.Add(Path, FJsonDataStruct::MakeString(ObjectString));
+                OutMap.Add(Path, FJsonDataStruct::MakeObject(ObjectString));
             }
             break;
         }
@@ -203,7 +222,7 @@ void UAsync_ReadJson::ParseJsonValue(const TSharedPtr<FJsonValue>& Value, const
             TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ArrayString);
             if (FJsonSerializer::Serialize(Value->AsArray(), Writer))
             {
-                OutMap.Add(Path, FJsonDataStruct::MakeString(ArrayString));
+                OutMap.Add(Path, FJsonDataStruct::MakeArray(ArrayString));
             }
             break;
         }
@@ -215,22 +234,16 @@ void UAsync_ReadJson::ParseJsonValue(const TSharedPtr<FJsonValue>& Value, const
         break;
     case EJson::Number:
         {
-            if (const double Num = Value->AsNumber(); FMath::IsFinite(Num))
+            // 按字面量分类：整数保持精确（超出int32范围时为Int64），带小数点或指数的为Double
+            if (FJsonDataStruct NumberData; JsonDataHelper::MakeNumberData(*Value, NumberData))
             {
-                if (JsonDataHelper::IsIntegerValue(Num))
-                {
-                    OutMap.Add(Path, FJsonDataStruct::MakeInt(static_cast<int32>(Num)));
-                }
-                else
-                {
-                    OutMap.Add(Path, FJsonDataStruct::MakeFloat(static_cast<float>(Num)));
-                }
+                OutMap.Add(Path, MoveTemp(NumberData));
             }
             break;
         }
     case EJson::Null:
-        // 显式处理Null值，保留字段但值为空
-        OutMap.Add(Path, FJsonDataStruct::MakeString(TEXT("")));
+        // 显式处理Null值，保留字段但值为空（ContainerKind 记为 Null，与空字符串区分）
+        OutMap.Add(Path, FJsonDataStruct::MakeNull());
         break;
     case EJson::None:
         // None类型不添加到Map，仅记录日志
@@ -253,7 +266,7 @@ TArray<TSharedPtr<FJsonValue>> UAsync_ReadJson::GetJsonValueArray(const FString&
     TSharedPtr<FJsonValue> JsonValue;
     const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonArray);
 
-    if (!FJsonSerializer::Deserialize(Reader, JsonValue) || !JsonDataHelper::ValidateJsonValue(JsonValue, TEXT("GetJsonValueArray")))
+    if (!FJsonSerializer::Deserialize(Reader, JsonValue, FJsonSerializer::EFlags::StoreNumbersAsStrings) || !JsonDataHelper::ValidateJsonValue(JsonValue, TEXT("GetJsonValueArray")))
     {
         return {};
     }
@@ -280,7 +293,7 @@ void UAsync_ReadJson::DestroyTask()
 
 void UAsync_ReadJson::EndTask()
 {
-    OnReadJsonEnd.Broadcast({ ParsedDataMap });
+    OnReadJsonEnd.Broadcast(ParsedData);
     DestroyTask();
     UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Async_ReadJson EndTask"), *GetCallerName(), __FUNCTION__);
 }
@@ -290,12 +303,6 @@ FString UAsync_ReadJson::GetCallerName() const
     return WorldContext ? WorldContext->GetName() : TEXT("Unknown");
 }
 
-bool UAsync_ReadJson::ShouldUseIterativeParsing(const FString& JsonStr)
-{
-    // 基于字符串长度判断是否应使用迭代解析
-    return JsonStr.Len() >= LargeJsonThreshold;
-}
-
 // ============================================================================
 // 主要接口实现
 // ============================================================================
@@ -314,13 +321,14 @@ void UAsync_ReadJson::ReadJson_Block(const UObject* WorldContextObject, const FS
     TSharedPtr<FJsonObject> JsonObject;
     const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InJsonStr);
 
-    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject, FJsonSerializer::EFlags::StoreNumbersAsStrings) || !JsonObject.IsValid())
     {
         UE_LOG(LogReadJson, Error, TEXT("[ %s ] - [ %hs ] Deserialize Failed, JsonString is invalid"), *CallerName, __FUNCTION__);
         return;
     }
 
     UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Begin Parse Json"), *CallerName, __FUNCTION__);
+    OutParsedData.ParsedDataMap.Reserve(CountFlattenedEntries(*JsonObject));
     ParseJson_Block(JsonObject, TEXT(""), OutParsedData);
 
     if (OutParsedData.ParsedDataMap.Num() == 0)
@@ -332,6 +340,107 @@ void UAsync_ReadJson::ReadJson_Block(const UObject* WorldContextObject, const FS
     bIsValid = true;
 }
 
+void UAsync_ReadJson::ReadJson_Block_WithOptions(const UObject* WorldContextObject, const FString& InJsonStr, const FReadJsonOptions& Options, FParsedData& OutParsedData, bool& bIsValid)
+{
+    FReadJsonStats Stats;
+    ReadJson_Block_WithStats(WorldContextObject, InJsonStr, Options, OutParsedData, Stats, bIsValid);
+}
+
+void UAsync_ReadJson::ReadJson_Block_WithStats(const UObject* WorldContextObject, const FString& InJsonStr, const FReadJsonOptions& Options, FParsedData& OutParsedData, FReadJsonStats& OutStats, bool& bIsValid)
+{
+    bIsValid = false;
+    OutParsedData = {};
+    OutStats = {};
+    const FString CallerName = WorldContextObject ? WorldContextObject->GetName() : TEXT("Unknown");
+
+    if (InJsonStr.IsEmpty())
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %s ] - [ %hs ] JsonString is Invalid"), *CallerName, __FUNCTION__);
+        return;
+    }
+
+    // 预扫描仅在 Auto 选择策略或选项要求按其结果预留容量时进行，并在所有策略下用于预留
+    FJsonPreScan PreScan;
+    const bool bPreScanned = JsonParseStrategy::NeedsPreScan(Options);
+    if (bPreScanned)
+    {
+        const double PreScanStartTime = FPlatformTime::Seconds();
+        JsonParseStrategy::PreScan(InJsonStr, PreScan, Options.bLazyStrings ? 0 : Options.LazyStringThreshold);
+        OutStats.PreScanMilliseconds = static_cast<float>((FPlatformTime::Seconds() - PreScanStartTime) * 1000.0);
+        OutStats.MaxDepth = PreScan.MaxDepth;
+        OutStats.RootFanOut = PreScan.RootFanOut;
+        OutStats.MaxFanOut = PreScan.MaxFanOut;
+        OutStats.ReservedEntries = PreScan.NumMembers;
+    }
+
+    OutStats.Strategy = JsonParseStrategy::Resolve(Options, PreScan, InJsonStr.Len());
+    OutStats.bAutoSelected = Options.Strategy == EJsonParseStrategy::Auto && !Options.UsesSourceFlattener();
+
+    const double ParseStartTime = FPlatformTime::Seconds();
+    if (OutStats.Strategy == EJsonParseStrategy::Streaming)
+    {
+        const FJsonParserContextPool::FScopedContext Context;
+        if (!Context->Parse(InJsonStr, Options, OutParsedData, bPreScanned ? &PreScan : nullptr))
+        {
+            UE_LOG(LogReadJson, Error, TEXT("[ %s ] - [ %hs ] Deserialize Failed, %s"), *CallerName, __FUNCTION__, *Context->GetError());
+            return;
+        }
+        OutStats.ReservedEntries = Context->GetReservedEntries();
+    }
+    else
+    {
+        TSharedPtr<FJsonObject> JsonObject;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InJsonStr);
+        if (!FJsonSerializer::Deserialize(Reader, JsonObject, FJsonSerializer::EFlags::StoreNumbersAsStrings) || !JsonObject.IsValid())
+        {
+            UE_LOG(LogReadJson, Error, TEXT("[ %s ] - [ %hs ] Deserialize Failed, JsonString is invalid"), *CallerName, __FUNCTION__);
+            return;
+        }
+
+        // 指定了策略且未预扫描时按已反序列化的对象计数
+        if (!bPreScanned)
+        {
+            OutStats.ReservedEntries = CountFlattenedEntries(*JsonObject);
+        }
+        OutParsedData.ParsedDataMap.Reserve(OutStats.ReservedEntries);
+        switch (OutStats.Strategy)
+        {
+        case EJsonParseStrategy::Iterative:
+            ParseJsonIterative_Block(JsonObject, TEXT(""), OutParsedData.ParsedDataMap);
+            break;
+        case EJsonParseStrategy::Parallel:
+            ParseJsonParallel_Block(JsonObject, OutParsedData.ParsedDataMap);
+            break;
+        default:
+            ParseJson_Block(JsonObject, TEXT(""), OutParsedData);
+            break;
+        }
+    }
+    OutStats.ParseMilliseconds = static_cast<float>((FPlatformTime::Seconds() - ParseStartTime) * 1000.0);
+    OutStats.NumEntries = OutParsedData.NumEntries();
+    OutStats.EstimatedRehashes = JsonParseStrategy::EstimateRehashes(OutStats.ReservedEntries, OutStats.NumEntries);
+    OutStats.bStorageGrew = JsonParseStrategy::ExceedsReservation(OutParsedData, OutStats.ReservedEntries);
+
+    UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Parsed with %s strategy (depth %d, root fan-out %d), pre-scan %.3f ms, parse %.3f ms, reserved %d of %d entries, storage grew: %s"),
+        *CallerName, __FUNCTION__, *UEnum::GetDisplayValueAsText(OutStats.Strategy).ToString(),
+        OutStats.MaxDepth, OutStats.RootFanOut, OutStats.PreScanMilliseconds, OutStats.ParseMilliseconds,
+        OutStats.ReservedEntries, OutStats.NumEntries, OutStats.bStorageGrew ? TEXT("true") : TEXT("false"));
+
+    if (OutParsedData.FlatEntries.IsValid())
+    {
+        UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Entries are stored in FlatEntries, ParsedDataMap is empty; read nodes with GetNodeData / GetAllNodes"),
+            *CallerName, __FUNCTION__);
+    }
+
+    if (OutParsedData.NumPaths() == 0)
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %s ] - [ %hs ] Parse Json Value Is Empty"), *CallerName, __FUNCTION__);
+        return;
+    }
+
+    bIsValid = true;
+}
+
 // ============================================================================
 // 获取节点值实现
 // ============================================================================
@@ -343,9 +452,10 @@ void UAsync_ReadJson::GetNodeData(const FString& NodePath, const FParsedData& Pa
         return;
     }
 
-    if (const FJsonDataStruct* FoundData = ParsedData.ParsedDataMap.Find(NodePath))
+    // 包括延迟记录的字符串
+    if (ParsedData.GetValue(NodePath, NodeData.Value))
     {
-        NodeData = { NodePath, *FoundData };
+        NodeData.Key = NodePath;
         bIsValid = true;
         return;
     }
@@ -353,24 +463,94 @@ void UAsync_ReadJson::GetNodeData(const FString& NodePath, const FParsedData& Pa
     UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] not found"), __FUNCTION__, *NodePath);
 }
 
+void UAsync_ReadJson::GetAllNodes(const FParsedData& ParsedData, TArray<FJsonNode>& Nodes, bool& bIsValid)
+{
+    Nodes.Reset(ParsedData.NumPaths());
+    ParsedData.ForEachPath([&ParsedData, &Nodes](const FString& NodePath, const FJsonDataStruct* Entry)
+    {
+        FJsonNode& Node = Nodes.AddDefaulted_GetRef();
+        Node.Key = NodePath;
+        if (Entry)
+        {
+            Node.Value = *Entry;
+        }
+        else
+        {
+            ParsedData.GetValue(NodePath, Node.Value);
+        }
+    });
+    bIsValid = Nodes.Num() > 0;
+}
+
 void UAsync_ReadJson::GetNodeValueToString(const FString& NodePath, const FParsedData& ParsedData, FString& NodeValue, bool& bIsValid)
 {
-    JsonDataHelper::GetNodeValueImpl(NodePath, ParsedData.ParsedDataMap, NodeValue, bIsValid, TEXT("GetNodeValueToString"));
+    // 延迟记录的字符串不在 ParsedDataMap 中
+    if (ParsedData.LazyStrings.IsValid() && ParsedData.LazyStrings->GetString(NodePath, NodeValue))
+    {
+        bIsValid = true;
+        return;
+    }
+    JsonDataHelper::GetNodeValueImpl(NodePath, ParsedData, NodeValue, bIsValid, TEXT("GetNodeValueToString"));
 }
 
 void UAsync_ReadJson::GetNodeValueToInt(const FString& NodePath, const FParsedData& ParsedData, int32& NodeValue, bool& bIsValid)
 {
-    JsonDataHelper::GetNodeValueImpl(NodePath, ParsedData.ParsedDataMap, NodeValue, bIsValid, TEXT("GetNodeValueToInt"));
+    JsonDataHelper::GetNodeValueImpl(NodePath, ParsedData, NodeValue, bIsValid, TEXT("GetNodeValueToInt"));
 }
 
 void UAsync_ReadJson::GetNodeValueToFloat(const FString& NodePath, const FParsedData& ParsedData, float& NodeValue, bool& bIsValid)
 {
-    JsonDataHelper::GetNodeValueImpl(NodePath, ParsedData.ParsedDataMap, NodeValue, bIsValid, TEXT("GetNodeValueToFloat"));
+    JsonDataHelper::GetNodeValueImpl(NodePath, ParsedData, NodeValue, bIsValid, TEXT("GetNodeValueToFloat"));
+}
+
+void UAsync_ReadJson::GetNodeValueToInt64(const FString& NodePath, const FParsedData& ParsedData, int64& NodeValue, bool& bIsValid)
+{
+    JsonDataHelper::GetNodeValueImpl(NodePath, ParsedData, NodeValue, bIsValid, TEXT("GetNodeValueToInt64"));
+}
+
+void UAsync_ReadJson::GetNodeValueToDouble(const FString& NodePath, const FParsedData& ParsedData, double& NodeValue, bool& bIsValid)
+{
+    JsonDataHelper::GetNodeValueImpl(NodePath, ParsedData, NodeValue, bIsValid, TEXT("GetNodeValueToDouble"));
 }
 
 void UAsync_ReadJson::GetNodeValueToBool(const FString& NodePath, const FParsedData& ParsedData, bool& NodeValue, bool& bIsValid)
 {
-    JsonDataHelper::GetNodeValueImpl(NodePath, ParsedData.ParsedDataMap, NodeValue, bIsValid, TEXT("GetNodeValueToBool"));
+    JsonDataHelper::GetNodeValueImpl(NodePath, ParsedData, NodeValue, bIsValid, TEXT("GetNodeValueToBool"));
+}
+
+void UAsync_ReadJson::GetNodeValueToBytes(const FString& NodePath, const FParsedData& ParsedData, TArray<uint8>& NodeValue, bool& bIsValid)
+{
+    NodeValue.Empty();
+    bIsValid = false;
+    if (!JsonDataHelper::ValidateNodePath(NodePath, TEXT("GetNodeValueToBytes")))
+    {
+        return;
+    }
+
+    if (ParsedData.LazyStrings.IsValid() && ParsedData.LazyStrings->Find(NodePath))
+    {
+        bIsValid = ParsedData.LazyStrings->DecodeBase64(NodePath, NodeValue);
+    }
+    else if (const FJsonDataStruct* FoundData = ParsedData.FindEntry(NodePath))
+    {
+        if (FoundData->ValueType != EValueType::String)
+        {
+            UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] is not a string, Node Type: [ %s ]"),
+                __FUNCTION__, *NodePath, *JsonDataHelper::GetValueTypeName(FoundData->ValueType));
+            return;
+        }
+        bIsValid = JsonBase64::Decode(*FoundData->StringValue, FoundData->StringValue.Len(), NodeValue);
+    }
+    else
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] not found"), __FUNCTION__, *NodePath);
+        return;
+    }
+
+    if (!bIsValid)
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] is not valid Base64"), __FUNCTION__, *NodePath);
+    }
 }
 
 // ============================================================================
@@ -385,7 +565,7 @@ void UAsync_ReadJson::GetNodeValueToStringArray(const FString& NodePath, const F
         return;
     }
 
-    if (const FJsonDataStruct* FoundData = ParsedData.ParsedDataMap.Find(NodePath))
+    if (const FJsonDataStruct* FoundData = ParsedData.FindEntry(NodePath))
     {
         if (FoundData->ValueType == EValueType::String)
         {
@@ -414,7 +594,7 @@ void UAsync_ReadJson::GetNodeValueToIntArray(const FString& NodePath, const FPar
         return;
     }
 
-    if (const FJsonDataStruct* FoundData = ParsedData.ParsedDataMap.Find(NodePath))
+    if (const FJsonDataStruct* FoundData = ParsedData.FindEntry(NodePath))
     {
         if (FoundData->ValueType == EValueType::String)
         {
@@ -443,7 +623,7 @@ void UAsync_ReadJson::GetNodeValueToFloatArray(const FString& NodePath, const FP
         return;
     }
 
-    if (const FJsonDataStruct* FoundData = ParsedData.ParsedDataMap.Find(NodePath))
+    if (const FJsonDataStruct* FoundData = ParsedData.FindEntry(NodePath))
     {
         if (FoundData->ValueType == EValueType::String)
         {
@@ -463,6 +643,126 @@ void UAsync_ReadJson::GetNodeValueToFloatArray(const FString& NodePath, const FP
     UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] not found"), __FUNCTION__, *NodePath);
 }
 
+void UAsync_ReadJson::GetNodeValueToInt64Array(const FString& NodePath, const FParsedData& ParsedData, TArray<int64>& NodeArray, bool& bIsValid)
+{
+    NodeArray.Empty();
+    bIsValid = false;
+    if (!JsonDataHelper::ValidateNodePath(NodePath, TEXT("GetNodeValueToInt64Array")))
+    {
+        return;
+    }
+
+    if (const FJsonDataStruct* FoundData = ParsedData.FindEntry(NodePath))
+    {
+        if (FoundData->ValueType == EValueType::String)
+        {
+            if (FoundData->StringValue.IsEmpty())
+            {
+                UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node Value: [ %s ] is empty"), __FUNCTION__, *NodePath);
+                return;
+            }
+            ParseJsonArrayToInt64Array(FoundData->StringValue, NodeArray, bIsValid);
+            return;
+        }
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] is not a string (array), Node Type: [ %s ]"), 
+            __FUNCTION__, *NodePath, *JsonDataHelper::GetValueTypeName(FoundData->ValueType));
+        return;
+    }
+
+    UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] not found"), __FUNCTION__, *NodePath);
+}
+
+void UAsync_ReadJson::GetNodeValueToDoubleArray(const FString& NodePath, const FParsedData& ParsedData, TArray<double>& NodeArray, bool& bIsValid)
+{
+    NodeArray.Empty();
+    bIsValid = false;
+    if (!JsonDataHelper::ValidateNodePath(NodePath, TEXT("GetNodeValueToDoubleArray")))
+    {
+        return;
+    }
+
+    if (const FJsonDataStruct* FoundData = ParsedData.FindEntry(NodePath))
+    {
+        if (FoundData->ValueType == EValueType::String)
+        {
+            if (FoundData->StringValue.IsEmpty())
+            {
+                UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node Value: [ %s ] is empty"), __FUNCTION__, *NodePath);
+                return;
+            }
+            ParseJsonArrayToDoubleArray(FoundData->StringValue, NodeArray, bIsValid);
+            return;
+        }
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] is not a string (array), Node Type: [ %s ]"), 
+            __FUNCTION__, *NodePath, *JsonDataHelper::GetValueTypeName(FoundData->ValueType));
+        return;
+    }
+
+    UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] not found"), __FUNCTION__, *NodePath);
+}
+
+void UAsync_ReadJson::GetNodeValueToFloatMatrix(const FString& NodePath, const FParsedData& ParsedData, TArray<float>& NodeArray, int32& NumRows, int32& NumColumns, bool& bIsValid)
+{
+    NodeArray.Empty();
+    NumRows = 0;
+    NumColumns = 0;
+    bIsValid = false;
+    if (!JsonDataHelper::ValidateNodePath(NodePath, TEXT("GetNodeValueToFloatMatrix")))
+    {
+        return;
+    }
+
+    if (const FJsonDataStruct* FoundData = ParsedData.FindEntry(NodePath))
+    {
+        if (FoundData->ValueType == EValueType::String)
+        {
+            if (FoundData->StringValue.IsEmpty())
+            {
+                UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node Value: [ %s ] is empty"), __FUNCTION__, *NodePath);
+                return;
+            }
+            ParseJsonArrayToFloatMatrix(FoundData->StringValue, NodeArray, NumRows, NumColumns, bIsValid);
+            return;
+        }
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] is not a string (array), Node Type: [ %s ]"), 
+            __FUNCTION__, *NodePath, *JsonDataHelper::GetValueTypeName(FoundData->ValueType));
+        return;
+    }
+
+    UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] not found"), __FUNCTION__, *NodePath);
+}
+
+void UAsync_ReadJson::GetNodeValueToIntMatrix(const FString& NodePath, const FParsedData& ParsedData, TArray<int32>& NodeArray, int32& NumRows, int32& NumColumns, bool& bIsValid)
+{
+    NodeArray.Empty();
+    NumRows = 0;
+    NumColumns = 0;
+    bIsValid = false;
+    if (!JsonDataHelper::ValidateNodePath(NodePath, TEXT("GetNodeValueToIntMatrix")))
+    {
+        return;
+    }
+
+    if (const FJsonDataStruct* FoundData = ParsedData.FindEntry(NodePath))
+    {
+        if (FoundData->ValueType == EValueType::String)
+        {
+            if (FoundData->StringValue.IsEmpty())
+            {
+                UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node Value: [ %s ] is empty"), __FUNCTION__, *NodePath);
+                return;
+            }
+            ParseJsonArrayToIntMatrix(FoundData->StringValue, NodeArray, NumRows, NumColumns, bIsValid);
+            return;
+        }
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] is not a string (array), Node Type: [ %s ]"), 
+            __FUNCTION__, *NodePath, *JsonDataHelper::GetValueTypeName(FoundData->ValueType));
+        return;
+    }
+
+    UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] not found"), __FUNCTION__, *NodePath);
+}
+
 void UAsync_ReadJson::GetNodeValueToBoolArray(const FString& NodePath, const FParsedData& ParsedData, TArray<bool>& NodeArray, bool& bIsValid)
 {
     NodeArray.Empty();
@@ -472,7 +772,7 @@ void UAsync_ReadJson::GetNodeValueToBoolArray(const FString& NodePath, const FPa
         return;
     }
 
-    if (const FJsonDataStruct* FoundData = ParsedData.ParsedDataMap.Find(NodePath))
+    if (const FJsonDataStruct* FoundData = ParsedData.FindEntry(NodePath))
     {
         if (FoundData->ValueType == EValueType::String)
         {
@@ -518,20 +818,30 @@ void UAsync_ReadJson::ParseJsonArray(const FString& JsonArray, FJsonArray& Array
             break;
         case EJson::Number:
             {
-                const double Num = Element->AsNumber();
-                if (FMath::IsFinite(Num))
+                FJsonDataStruct NumberData;
+                if (!JsonDataHelper::MakeNumberData(*Element, NumberData))
                 {
-                    if (JsonDataHelper::IsIntegerValue(Num))
-                    {
-                        ArrayValue.IntArray.Add(static_cast<int32>(Num));
-                    }
-                    else
-                    {
-                        ArrayValue.FloatArray.Add(static_cast<float>(Num));
-                    }
+                    break;
+                }
+                switch (NumberData.ValueType)
+                {
+                case EValueType::Int:
+                    ArrayValue.IntArray.Add(NumberData.IntValue);
+                    break;
+                case EValueType::Int64:
+                    ArrayValue.Int64Array.Add(NumberData.Int64Value);
+                    break;
+                default:
+                    ArrayValue.FloatArray.Add(NumberData.FloatValue);
+                    ArrayValue.DoubleArray.Add(NumberData.DoubleValue);
+                    break;
                 }
                 break;
             }
+        case EJson::Null:
+            // null 为空字符串（与 QueryJson 的 TypedValues 一致）
+            ArrayValue.StringArray.Add(FString());
+            break;
         case EJson::Object:
             {
                 FString ObjectString;
@@ -611,6 +921,13 @@ void UAsync_ReadJson::ParseJsonArrayToIntArray(const FString& JsonArray, TArray<
     ArrayValue.Empty();
     bIsValid = false;
 
+    // 纯数值数组直接解析到输出数组，不构建 FJsonValue；含其他元素时按原有规则逐个处理
+    if (JsonNumberParser::ParseIntArray(*JsonArray, JsonArray.Len(), ArrayValue) && ArrayValue.Num() > 0)
+    {
+        bIsValid = true;
+        return;
+    }
+
     const TArray<TSharedPtr<FJsonValue>> JsonValueArray = GetJsonValueArray(JsonArray);
     if (JsonValueArray.IsEmpty())
     {
@@ -621,15 +938,15 @@ void UAsync_ReadJson::ParseJsonArrayToIntArray(const FString& JsonArray, TArray<
     {
         if (Element->Type == EJson::Number)
         {
-            const double Num = Element->AsNumber();
-            if (FMath::IsFinite(Num) && JsonDataHelper::IsIntegerValue(Num))
+            FJsonDataStruct NumberData;
+            if (JsonDataHelper::MakeNumberData(*Element, NumberData) && JsonDataHelper::TJsonValueTraits<int32>::IsCompatible(NumberData))
             {
-                ArrayValue.Add(static_cast<int32>(Num));
+                ArrayValue.Add(JsonDataHelper::TJsonValueTraits<int32>::GetValue(NumberData));
             }
             else
             {
-                // 警告跳过的非整数元素
-                UE_LOG(LogReadJson, Verbose, TEXT("[ %hs ] Skipped non-integer number: %f"), __FUNCTION__, Num);
+                // 警告跳过的非int32整数元素
+                UE_LOG(LogReadJson, Verbose, TEXT("[ %hs ] Skipped non-int32 number: %f"), __FUNCTION__, Element->AsNumber());
             }
         }
         else
@@ -646,6 +963,13 @@ void UAsync_ReadJson::ParseJsonArrayToFloatArray(const FString& JsonArray, TArra
     ArrayValue.Empty();
     bIsValid = false;
 
+    // 纯数值数组直接解析到输出数组，不构建 FJsonValue；含其他元素时按原有规则逐个处理
+    if (JsonNumberParser::ParseFloatArray(*JsonArray, JsonArray.Len(), ArrayValue) && ArrayValue.Num() > 0)
+    {
+        bIsValid = true;
+        return;
+    }
+
     const TArray<TSharedPtr<FJsonValue>> JsonValueArray = GetJsonValueArray(JsonArray);
     if (JsonValueArray.IsEmpty())
     {
@@ -656,8 +980,8 @@ void UAsync_ReadJson::ParseJsonArrayToFloatArray(const FString& JsonArray, TArra
     {
         if (Element->Type == EJson::Number)
         {
-            const double Num = Element->AsNumber();
-            if (FMath::IsFinite(Num))
+            double Num = 0.0;
+            if (JsonDataHelper::TryGetNumberValue(*Element, Num))
             {
                 ArrayValue.Add(static_cast<float>(Num));
             }
@@ -676,6 +1000,108 @@ void UAsync_ReadJson::ParseJsonArrayToFloatArray(const FString& JsonArray, TArra
     bIsValid = true;
 }
 
+void UAsync_ReadJson::ParseJsonArrayToInt64Array(const FString& JsonArray, TArray<int64>& ArrayValue, bool& bIsValid)
+{
+    ArrayValue.Empty();
+    bIsValid = false;
+
+    // 纯数值数组直接解析到输出数组，不构建 FJsonValue；含其他元素时按原有规则逐个处理
+    if (JsonNumberParser::ParseInt64Array(*JsonArray, JsonArray.Len(), ArrayValue) && ArrayValue.Num() > 0)
+    {
+        bIsValid = true;
+        return;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>> JsonValueArray = GetJsonValueArray(JsonArray);
+    if (JsonValueArray.IsEmpty())
+    {
+        return;
+    }
+
+    for (const TSharedPtr<FJsonValue>& Element : JsonValueArray)
+    {
+        if (Element->Type == EJson::Number)
+        {
+            FJsonDataStruct NumberData;
+            if (JsonDataHelper::MakeNumberData(*Element, NumberData) && JsonDataHelper::TJsonValueTraits<int64>::IsCompatible(NumberData))
+            {
+                ArrayValue.Add(JsonDataHelper::TJsonValueTraits<int64>::GetValue(NumberData));
+            }
+            else
+            {
+                // 警告跳过的非整数元素
+                UE_LOG(LogReadJson, Verbose, TEXT("[ %hs ] Skipped non-integer number: %f"), __FUNCTION__, Element->AsNumber());
+            }
+        }
+        else
+        {
+            // 警告跳过的非数字类型元素
+            UE_LOG(LogReadJson, Verbose, TEXT("[ %hs ] Skipped non-number element of type: %d"), __FUNCTION__, static_cast<int32>(Element->Type));
+        }
+    }
+    bIsValid = true;
+}
+
+void UAsync_ReadJson::ParseJsonArrayToDoubleArray(const FString& JsonArray, TArray<double>& ArrayValue, bool& bIsValid)
+{
+    ArrayValue.Empty();
+    bIsValid = false;
+
+    // 纯数值数组直接解析到输出数组，不构建 FJsonValue；含其他元素时按原有规则逐个处理
+    if (JsonNumberParser::ParseDoubleArray(*JsonArray, JsonArray.Len(), ArrayValue) && ArrayValue.Num() > 0)
+    {
+        bIsValid = true;
+        return;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>> JsonValueArray = GetJsonValueArray(JsonArray);
+    if (JsonValueArray.IsEmpty())
+    {
+        return;
+    }
+
+    for (const TSharedPtr<FJsonValue>& Element : JsonValueArray)
+    {
+        if (Element->Type == EJson::Number)
+        {
+            double Num = 0.0;
+            if (JsonDataHelper::TryGetNumberValue(*Element, Num))
+            {
+                ArrayValue.Add(Num);
+            }
+            else
+            {
+                // 警告跳过的非有限数值
+                UE_LOG(LogReadJson, Verbose, TEXT("[ %hs ] Skipped non-finite number"), __FUNCTION__);
+            }
+        }
+        else
+        {
+            // 警告跳过的非数字类型元素
+            UE_LOG(LogReadJson, Verbose, TEXT("[ %hs ] Skipped non-number element of type: %d"), __FUNCTION__, static_cast<int32>(Element->Type));
+        }
+    }
+    bIsValid = true;
+}
+
+void UAsync_ReadJson::ParseJsonArrayToFloatMatrix(const FString& JsonArray, TArray<float>& ArrayValue, int32& NumRows, int32& NumColumns, bool& bIsValid)
+{
+    bIsValid = JsonNumberParser::ParseFloatMatrix(*JsonArray, JsonArray.Len(), ArrayValue, NumRows, NumColumns);
+    if (!bIsValid)
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Not a numeric matrix with uniform row length"), __FUNCTION__);
+    }
+}
+
+void UAsync_ReadJson::ParseJsonArrayToIntMatrix(const FString& JsonArray, TArray<int32>& ArrayValue, int32& NumRows, int32& NumColumns, bool& bIsValid)
+{
+    bIsValid = JsonNumberParser::ParseIntMatrix(*JsonArray, JsonArray.Len(), ArrayValue, NumRows, NumColumns);
+    if (!bIsValid)
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Not an int32 matrix with uniform row length"), __FUNCTION__);
+    }
+}
+
 void UAsync_ReadJson::ParseJsonArrayToBoolArray(const FString& JsonArray, TArray<bool>& ArrayValue, bool& bIsValid)
 {
     ArrayValue.Empty();
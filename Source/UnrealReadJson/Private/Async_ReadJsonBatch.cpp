@@ -0,0 +1,156 @@
+﻿#include "Async_ReadJsonBatch.h"
+#include "Async_ReadJson.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <atomic>
+
+struct UAsync_ReadJsonBatch::FBatchState
+{
+    /** JSON字符串或文件路径；每个元素只被一个工作线程领取，领取后移出 */
+    TArray<FString> Inputs;
+    bool bInputsAreFiles = false;
+    FReadJsonOptions Options;
+
+    /** 下一个未领取的文档下标 */
+    std::atomic<int32> NextIndex { 0 };
+    std::atomic<bool> bCancelled { false };
+};
+
+// ============================================================================
+// 创建与激活
+// ============================================================================
+UAsync_ReadJsonBatch* UAsync_ReadJsonBatch::Async_ReadJsonBatch(UObject* WorldContextObject, const TArray<FString>& JsonStrings, const FReadJsonOptions& Options, const int32 MaxConcurrency)
+{
+    return CreateBatch(WorldContextObject, TArray<FString>(JsonStrings), false, Options, MaxConcurrency);
+}
+
+UAsync_ReadJsonBatch* UAsync_ReadJsonBatch::Async_ReadJsonFilesBatch(UObject* WorldContextObject, const TArray<FString>& FilePaths, const FReadJsonOptions& Options, const int32 MaxConcurrency)
+{
+    return CreateBatch(WorldContextObject, TArray<FString>(FilePaths), true, Options, MaxConcurrency);
+}
+
+UAsync_ReadJsonBatch* UAsync_ReadJsonBatch::CreateBatch(UObject* WorldContextObject, TArray<FString>&& Inputs, const bool bInputsAreFiles, const FReadJsonOptions& Options, const int32 MaxConcurrency)
+{
+    UAsync_ReadJsonBatch* AsyncTask = NewObject<UAsync_ReadJsonBatch>();
+    AsyncTask->WorldContext = WorldContextObject;
+    AsyncTask->Results.SetNum(Inputs.Num());
+
+    AsyncTask->State = MakeShared<FBatchState, ESPMode::ThreadSafe>();
+    AsyncTask->State->Inputs = MoveTemp(Inputs);
+    AsyncTask->State->bInputsAreFiles = bInputsAreFiles;
+    AsyncTask->State->Options = Options;
+    AsyncTask->MaxWorkers = FMath::Max(1, MaxConcurrency);
+    return AsyncTask;
+}
+
+void UAsync_ReadJsonBatch::Activate()
+{
+    RegisterWithGameInstance(WorldContext);
+
+    const int32 NumDocuments = Results.Num();
+    if (NumDocuments == 0)
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %s ] - [ %hs ] No documents to parse"), *GetCallerName(), __FUNCTION__);
+        OnAllCompleted.Broadcast(0, 0);
+        SetReadyToDestroy();
+        return;
+    }
+
+    // 每个工作任务循环领取文档，任务数量即同时进行的解析数量
+    const int32 NumWorkers = FMath::Min(MaxWorkers, NumDocuments);
+    UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Begin Parse %d Json documents, %d workers"), *GetCallerName(), __FUNCTION__, NumDocuments, NumWorkers);
+
+    const TSharedRef<FBatchState, ESPMode::ThreadSafe> SharedState = State.ToSharedRef();
+    const TWeakObjectPtr<UAsync_ReadJsonBatch> WeakTask(this);
+    for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+    {
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [SharedState, WeakTask]()
+        {
+            RunWorker(SharedState, WeakTask);
+        });
+    }
+}
+
+// ============================================================================
+// 工作线程
+// ============================================================================
+void UAsync_ReadJsonBatch::RunWorker(const TSharedRef<FBatchState, ESPMode::ThreadSafe>& State, TWeakObjectPtr<UAsync_ReadJsonBatch> WeakTask)
+{
+    const int32 NumDocuments = State->Inputs.Num();
+    while (!State->bCancelled)
+    {
+        const int32 DocumentIndex = State->NextIndex.fetch_add(1);
+        if (DocumentIndex >= NumDocuments)
+        {
+            return;
+        }
+
+        // 领取后移出，解析完成即释放输入
+        FString JsonStr = MoveTemp(State->Inputs[DocumentIndex]);
+        FParsedData ParsedData;
+        bool bIsValid = false;
+
+        if (State->bInputsAreFiles)
+        {
+            const FString FilePath = FPaths::IsRelative(JsonStr) ? FPaths::Combine(FPaths::ProjectDir(), JsonStr) : JsonStr;
+            JsonStr.Reset();
+            if (!FFileHelper::LoadFileToString(JsonStr, *FilePath))
+            {
+                UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to load file [ %s ]"), __FUNCTION__, *FilePath);
+            }
+        }
+
+        if (!JsonStr.IsEmpty())
+        {
+            UAsync_ReadJson::ReadJson_Block_WithOptions(nullptr, JsonStr, State->Options, ParsedData, bIsValid);
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [State, WeakTask, DocumentIndex, ParsedData = MoveTemp(ParsedData), bIsValid]() mutable
+        {
+            if (State->bCancelled)
+            {
+                return;
+            }
+            if (UAsync_ReadJsonBatch* Task = WeakTask.Get())
+            {
+                Task->HandleDocumentParsed(DocumentIndex, MoveTemp(ParsedData), bIsValid);
+            }
+        });
+    }
+}
+
+// ============================================================================
+// 结果处理
+// ============================================================================
+void UAsync_ReadJsonBatch::HandleDocumentParsed(const int32 DocumentIndex, FParsedData&& ParsedData, const bool bIsValid)
+{
+    Results[DocumentIndex] = MoveTemp(ParsedData);
+    ++NumFinished;
+    NumSucceeded += bIsValid ? 1 : 0;
+
+    OnDocumentParsed.Broadcast(DocumentIndex, Results[DocumentIndex], bIsValid);
+
+    if (NumFinished == Results.Num())
+    {
+        UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] End Parse Json documents, Succeeded: %d, Failed: %d"),
+            *GetCallerName(), __FUNCTION__, NumSucceeded, NumFinished - NumSucceeded);
+        OnAllCompleted.Broadcast(NumSucceeded, NumFinished - NumSucceeded);
+        SetReadyToDestroy();
+    }
+}
+
+void UAsync_ReadJsonBatch::Cancel()
+{
+    if (State.IsValid())
+    {
+        State->bCancelled = true;
+    }
+    SetReadyToDestroy();
+    UE_LOG(LogReadJson, Log, TEXT("[ %s ] - [ %hs ] Batch cancelled, %d of %d documents finished"), *GetCallerName(), __FUNCTION__, NumFinished, Results.Num());
+}
+
+FString UAsync_ReadJsonBatch::GetCallerName() const
+{
+    return WorldContext ? WorldContext->GetName() : TEXT("Unknown");
+}
@@ -0,0 +1,234 @@
+﻿#include "FlattenedJsonAsset.h"
+#include "Async_ReadJson.h"
+#include "JsonFlatTable.h"
+#include "Engine/AssetManager.h"
+#if WITH_EDITORONLY_DATA
+#include "EditorFramework/AssetImportData.h"
+#endif
+
+// ============================================================================
+// 紧凑二进制布局
+// ============================================================================
+namespace FlattenedJsonAssetDetail
+{
+    /**
+     * 序列化单个节点值
+     * 只写入 ValueType 对应的有效字段，避免属性标签序列化的额外开销
+     */
+    void SerializeValue(FArchive& Ar, FJsonDataStruct& Value)
+    {
+        uint8 TypeByte = static_cast<uint8>(Value.ValueType);
+        Ar << TypeByte;
+        Value.ValueType = static_cast<EValueType>(TypeByte);
+
+        switch (Value.ValueType)
+        {
+        case EValueType::Bool:
+            Ar << Value.BoolValue;
+            break;
+        case EValueType::Int:
+            Ar << Value.IntValue;
+            break;
+        case EValueType::Float:
+            Ar << Value.FloatValue;
+            break;
+        case EValueType::Int64:
+            Ar << Value.Int64Value;
+            break;
+        case EValueType::Double:
+            Ar << Value.DoubleValue;
+            Value.FloatValue = static_cast<float>(Value.DoubleValue);
+            break;
+        case EValueType::String:
+        default:
+            Ar << Value.StringValue;
+            {
+                uint8 KindByte = static_cast<uint8>(Value.ContainerKind);
+                Ar << KindByte;
+                Value.ContainerKind = static_cast<EJsonContainerKind>(KindByte);
+            }
+            break;
+        }
+    }
+}
+
+// ============================================================================
+// UObject 接口
+// ============================================================================
+void UFlattenedJsonAsset::PostInitProperties()
+{
+#if WITH_EDITORONLY_DATA
+    if (!HasAnyFlags(RF_ClassDefaultObject))
+    {
+        AssetImportData = NewObject<UAssetImportData>(this, TEXT("AssetImportData"));
+    }
+#endif
+    Super::PostInitProperties();
+}
+
+void UFlattenedJsonAsset::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    if (!Ar.IsLoading() && !Ar.IsSaving())
+    {
+        return;
+    }
+
+    int32 FormatVersion = CurrentFormatVersion;
+    Ar << FormatVersion;
+    if (Ar.IsLoading() && FormatVersion != CurrentFormatVersion)
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %s ] - [ %hs ] Unsupported format version %d, reimport the asset"), *GetName(), __FUNCTION__, FormatVersion);
+        Ar.SetError();
+        return;
+    }
+
+    bool bEscapedPaths = ParsedData.bEscapedPaths;
+    Ar << bEscapedPaths;
+    int32 NodeCount = ParsedData.NumEntries();
+    Ar << NodeCount;
+
+    if (Ar.IsLoading())
+    {
+        // 重新加载（如撤销、热重载）时丢弃全部旧状态：数据表、路径索引、延迟字符串与修改计数
+        ParsedData = FParsedData();
+        ParsedData.bEscapedPaths = bEscapedPaths;
+        TMap<FString, FJsonDataStruct>& DataMap = ParsedData.ParsedDataMap;
+
+        // 一次性预分配，加载时不会发生扩容
+        DataMap.Reserve(NodeCount);
+        for (int32 Index = 0; Index < NodeCount && !Ar.IsError(); ++Index)
+        {
+            FString Path;
+            FJsonDataStruct Value;
+            Ar << Path;
+            FlattenedJsonAssetDetail::SerializeValue(Ar, Value);
+            DataMap.Add(MoveTemp(Path), MoveTemp(Value));
+        }
+        return;
+    }
+
+    // 以数据表存储的文档按相同格式写出（加载后保存在 ParsedDataMap 中）
+    if (ParsedData.FlatEntries.IsValid())
+    {
+        for (const FJsonFlatTable::FEntry& Entry : ParsedData.FlatEntries->GetEntries())
+        {
+            FString Path = Entry.Key;
+            FJsonDataStruct Value = Entry.Value;
+            Ar << Path;
+            FlattenedJsonAssetDetail::SerializeValue(Ar, Value);
+        }
+        return;
+    }
+
+    for (TPair<FString, FJsonDataStruct>& Pair : ParsedData.ParsedDataMap)
+    {
+        Ar << Pair.Key;
+        FlattenedJsonAssetDetail::SerializeValue(Ar, Pair.Value);
+    }
+}
+
+// ============================================================================
+// C++ 接口
+// ============================================================================
+void UFlattenedJsonAsset::SetParsedData(FParsedData&& InParsedData)
+{
+    ParsedData = MoveTemp(InParsedData);
+}
+
+TSharedPtr<FStreamableHandle> UFlattenedJsonAsset::RequestAsyncLoad(const TSoftObjectPtr<UFlattenedJsonAsset>& SoftAsset, FOnFlattenedJsonAssetLoaded OnLoaded)
+{
+    if (SoftAsset.IsNull())
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] SoftAsset is null"), __FUNCTION__);
+        OnLoaded.ExecuteIfBound(nullptr);
+        return nullptr;
+    }
+
+    // 已加载则直接回调
+    if (UFlattenedJsonAsset* LoadedAsset = SoftAsset.Get())
+    {
+        OnLoaded.ExecuteIfBound(LoadedAsset);
+        return nullptr;
+    }
+
+    const FSoftObjectPath AssetPath = SoftAsset.ToSoftObjectPath();
+    return UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetPath, FStreamableDelegate::CreateLambda([AssetPath, OnLoaded]()
+    {
+        UFlattenedJsonAsset* LoadedAsset = Cast<UFlattenedJsonAsset>(AssetPath.ResolveObject());
+        if (!LoadedAsset)
+        {
+            UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Failed to load [ %s ]"), __FUNCTION__, *AssetPath.ToString());
+        }
+        OnLoaded.ExecuteIfBound(LoadedAsset);
+    }));
+}
+
+// ============================================================================
+// 蓝图接口
+// ============================================================================
+void UFlattenedJsonAsset::GetNodeData(const FString& NodePath, FJsonNode& NodeData, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeData(NodePath, ParsedData, NodeData, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToString(const FString& NodePath, FString& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToString(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToInt(const FString& NodePath, int32& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToInt(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToFloat(const FString& NodePath, float& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToFloat(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToInt64(const FString& NodePath, int64& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToInt64(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToDouble(const FString& NodePath, double& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToDouble(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToBool(const FString& NodePath, bool& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToBool(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToStringArray(const FString& NodePath, TArray<FString>& NodeArray, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToStringArray(NodePath, ParsedData, NodeArray, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToIntArray(const FString& NodePath, TArray<int32>& NodeArray, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToIntArray(NodePath, ParsedData, NodeArray, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToFloatArray(const FString& NodePath, TArray<float>& NodeArray, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToFloatArray(NodePath, ParsedData, NodeArray, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToInt64Array(const FString& NodePath, TArray<int64>& NodeArray, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToInt64Array(NodePath, ParsedData, NodeArray, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToDoubleArray(const FString& NodePath, TArray<double>& NodeArray, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToDoubleArray(NodePath, ParsedData, NodeArray, bIsValid);
+}
+
+void UFlattenedJsonAsset::GetNodeValueToBoolArray(const FString& NodePath, TArray<bool>& NodeArray, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToBoolArray(NodePath, ParsedData, NodeArray, bIsValid);
+}
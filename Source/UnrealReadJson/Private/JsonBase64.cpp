@@ -0,0 +1,138 @@
+﻿#include "JsonBase64.h"
+
+namespace
+{
+    /** 字符到 6 位值的映射，非法字符为 0xFF（只覆盖 ASCII，非 ASCII 字符在查表前已被排除） */
+    constexpr uint8 DecodeTable[128] =
+    {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0x3E, 0xFF, 0x3F,
+        0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+        0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F,
+        0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    };
+
+    /** 查表合并 4 个字符为 24 位，非法字符会在 OutError 中留下高位 */
+    FORCEINLINE uint32 DecodeQuad(const TCHAR* Text, uint32& OutError)
+    {
+        const uint32 A = DecodeTable[Text[0] & 0x7F];
+        const uint32 B = DecodeTable[Text[1] & 0x7F];
+        const uint32 C = DecodeTable[Text[2] & 0x7F];
+        const uint32 D = DecodeTable[Text[3] & 0x7F];
+        OutError |= A | B | C | D;
+        return (A << 18) | (B << 12) | (C << 6) | D;
+    }
+
+    FORCEINLINE void WriteTriple(uint8* Out, const uint32 Value)
+    {
+        Out[0] = static_cast<uint8>(Value >> 16);
+        Out[1] = static_cast<uint8>(Value >> 8);
+        Out[2] = static_cast<uint8>(Value);
+    }
+
+    /** 8 个字符是否都是 ASCII（UTF-16 小端，每个 uint64 含 4 个字符） */
+    FORCEINLINE bool IsAsciiBlock(const TCHAR* Text)
+    {
+        if constexpr (sizeof(TCHAR) == 2)
+        {
+            uint64 Chars[2];
+            FMemory::Memcpy(Chars, Text, sizeof(Chars));
+            return ((Chars[0] | Chars[1]) & 0xFF80FF80FF80FF80ull) == 0;
+        }
+        else
+        {
+            uint32 Mask = 0;
+            for (int32 Index = 0; Index < 8; ++Index)
+            {
+                Mask |= static_cast<uint32>(Text[Index]);
+            }
+            return Mask < 0x80;
+        }
+    }
+}
+
+bool JsonBase64::Decode(const TCHAR* Text, int32 Length, TArray<uint8>& OutBytes)
+{
+    OutBytes.Reset();
+    if (Length < 0 || (Length > 0 && !Text))
+    {
+        return false;
+    }
+
+    // 去掉末尾填充
+    if (Length % 4 == 0)
+    {
+        for (int32 Padding = 0; Padding < 2 && Length > 0 && Text[Length - 1] == TEXT('='); ++Padding)
+        {
+            --Length;
+        }
+    }
+
+    const int32 Remainder = Length % 4;
+    if (Remainder == 1)
+    {
+        return false;
+    }
+
+    const int32 NumQuads = Length / 4;
+    const int32 NumBytes = NumQuads * 3 + (Remainder == 0 ? 0 : Remainder - 1);
+    OutBytes.SetNumUninitialized(NumBytes);
+    uint8* Out = OutBytes.GetData();
+
+    uint32 Error = 0;
+    int32 Quad = 0;
+
+    // 主循环：每次 8 个字符 -> 6 个字节
+    for (; Quad + 2 <= NumQuads; Quad += 2)
+    {
+        const TCHAR* Block = Text + Quad * 4;
+        if (!IsAsciiBlock(Block))
+        {
+            Error |= 0x80;
+            break;
+        }
+        WriteTriple(Out, DecodeQuad(Block, Error));
+        WriteTriple(Out + 3, DecodeQuad(Block + 4, Error));
+        Out += 6;
+    }
+
+    for (; Quad < NumQuads && Error < 0x80; ++Quad)
+    {
+        const TCHAR* Block = Text + Quad * 4;
+        if ((Block[0] | Block[1] | Block[2] | Block[3]) >= 0x80)
+        {
+            Error |= 0x80;
+            break;
+        }
+        WriteTriple(Out, DecodeQuad(Block, Error));
+        Out += 3;
+    }
+
+    // 末尾不足 4 个字符的部分
+    if (Remainder > 0 && Error < 0x80)
+    {
+        const TCHAR* Tail = Text + NumQuads * 4;
+        uint32 Value = 0;
+        for (int32 Index = 0; Index < Remainder; ++Index)
+        {
+            const uint32 Sextet = Tail[Index] < 0x80 ? DecodeTable[Tail[Index]] : 0xFF;
+            Error |= Sextet;
+            Value |= (Sextet & 0x3F) << (18 - Index * 6);
+        }
+        Out[0] = static_cast<uint8>(Value >> 16);
+        if (Remainder == 3)
+        {
+            Out[1] = static_cast<uint8>(Value >> 8);
+        }
+    }
+
+    if (Error >= 0x80)
+    {
+        OutBytes.Reset();
+        return false;
+    }
+    return true;
+}
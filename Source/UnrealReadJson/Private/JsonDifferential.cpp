@@ -0,0 +1,791 @@
+﻿#include "JsonDifferential.h"
+#include "Async_ReadJson.h"
+#include "JsonNumberParser.h"
+#include "JsonPath.h"
+#include "JsonSourceFlattener.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    /** 按 ReadJson_Block 的方式反序列化（数值保存为字面量） */
+    bool DeserializeObject(const FString& JsonStr, TSharedPtr<FJsonObject>& OutObject)
+    {
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonStr);
+        return FJsonSerializer::Deserialize(Reader, OutObject, FJsonSerializer::EFlags::StoreNumbersAsStrings) && OutObject.IsValid();
+    }
+
+    bool IsAsciiDigit(const TCHAR Char)
+    {
+        return Char >= TEXT('0') && Char <= TEXT('9');
+    }
+
+    bool IsNumberChar(const TCHAR Char)
+    {
+        return IsAsciiDigit(Char) || Char == TEXT('-') || Char == TEXT('+') || Char == TEXT('.') || Char == TEXT('e') || Char == TEXT('E');
+    }
+
+    /** 是否为完整的 JSON 数值字面量：-?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)? */
+    bool IsNumberLiteral(const FString& Literal)
+    {
+        const TCHAR* Char = *Literal;
+        const auto SkipDigits = [&Char]()
+        {
+            const TCHAR* Start = Char;
+            while (IsAsciiDigit(*Char))
+            {
+                ++Char;
+            }
+            return Char > Start;
+        };
+
+        Char += *Char == TEXT('-') ? 1 : 0;
+        if (*Char == TEXT('0'))
+        {
+            ++Char;
+        }
+        else if (!SkipDigits())
+        {
+            return false;
+        }
+        if (*Char == TEXT('.'))
+        {
+            ++Char;
+            if (!SkipDigits())
+            {
+                return false;
+            }
+        }
+        if (*Char == TEXT('e') || *Char == TEXT('E'))
+        {
+            ++Char;
+            Char += *Char == TEXT('+') || *Char == TEXT('-') ? 1 : 0;
+            if (!SkipDigits())
+            {
+                return false;
+            }
+        }
+        return *Char == TEXT('\0');
+    }
+
+    /** 合法字面量是否应分类为整数：不含小数点和指数，且在 int64 范围内 */
+    bool IsInt64Literal(const FString& Literal)
+    {
+        int32 Index = 0;
+        if (!Literal.FindChar(TEXT('.'), Index) && !Literal.FindChar(TEXT('e'), Index) && !Literal.FindChar(TEXT('E'), Index))
+        {
+            const bool bNegative = Literal.StartsWith(TEXT("-"), ESearchCase::CaseSensitive);
+            const FString Digits = bNegative ? Literal.RightChop(1) : Literal;
+            // JSON 整数没有前导零，位数相同时按字典序比较即可
+            return Digits.Len() < 19
+                || (Digits.Len() == 19 && FCString::Strcmp(*Digits, bNegative ? TEXT("9223372036854775808") : TEXT("9223372036854775807")) <= 0);
+        }
+        return false;
+    }
+
+    uint64 GetDoubleBits(const double Value)
+    {
+        uint64 Bits;
+        FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+        return Bits;
+    }
+
+    uint32 GetFloatBits(const float Value)
+    {
+        uint32 Bits;
+        FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+        return Bits;
+    }
+
+    FString DescribeDouble(const double Value)
+    {
+        return FString::Printf(TEXT("%.17g (0x%016llx)"), Value, GetDoubleBits(Value));
+    }
+
+    /** 数值节点按字面量独立转换的结果（不经过 JsonNumberParser） */
+    struct FReferenceNumber
+    {
+        bool bIsNumber = false;
+        /** 不含小数点和指数且在 int64 范围内 */
+        bool bIsInteger = false;
+        int64 Integer = 0;
+        double Double = 0.0;
+    };
+
+    /**
+     * 由数值节点的字面量（StoreNumbersAsStrings）独立转换：整数用 FCString::Atoi64，其余用 FCString::Atod
+     * 没有字面量的节点使用 FJsonValue::AsNumber
+     */
+    FReferenceNumber ConvertReferenceNumber(const FJsonValue& Value)
+    {
+        FReferenceNumber Number;
+        Number.bIsNumber = true;
+        FString Literal;
+        if (!Value.TryGetString(Literal))
+        {
+            Number.Double = Value.AsNumber();
+            return Number;
+        }
+        Number.bIsInteger = IsInt64Literal(Literal);
+        Number.Integer = Number.bIsInteger ? FCString::Atoi64(*Literal) : 0;
+        Number.Double = FCString::Atod(*Literal);
+        return Number;
+    }
+
+    /** 参考实现的数值条目：分类规则与 JsonDataHelper::MakeNumberData 相同，转换不经过 JsonNumberParser */
+    bool MakeReferenceNumberData(const FJsonValue& Value, FJsonDataStruct& OutData)
+    {
+        const FReferenceNumber Number = ConvertReferenceNumber(Value);
+        if (Number.bIsInteger)
+        {
+            OutData = Number.Integer >= MIN_int32 && Number.Integer <= MAX_int32
+                ? FJsonDataStruct::MakeInt(static_cast<int32>(Number.Integer))
+                : FJsonDataStruct::MakeInt64(Number.Integer);
+            return true;
+        }
+        if (!FMath::IsFinite(Number.Double))
+        {
+            return false;
+        }
+        OutData = JsonDataHelper::MakeFloatingPointData(Number.Double);
+        return true;
+    }
+
+    /** 参考实现：遍历顺序与路径同 ParseJson_Block，数值节点由 MakeReferenceNumberData 转换，null 直接记为 Null，其余节点交给 ParseJsonValue */
+    void FlattenReference(const TSharedPtr<FJsonObject>& JsonObject, const FString& CurrentPath, TMap<FString, FJsonDataStruct>& OutMap)
+    {
+        for (const auto& Elem : JsonObject->Values)
+        {
+            const FString NewPath = JsonDataHelper::BuildNodePath(CurrentPath, Elem.Key);
+            const TSharedPtr<FJsonValue>& Value = Elem.Value;
+            if (!Value.IsValid())
+            {
+                continue;
+            }
+
+            if (Value->Type == EJson::Number)
+            {
+                if (FJsonDataStruct NumberData; MakeReferenceNumberData(*Value, NumberData))
+                {
+                    OutMap.Add(NewPath, MoveTemp(NumberData));
+                }
+                continue;
+            }
+            if (Value->Type == EJson::Null)
+            {
+                OutMap.Add(NewPath, FJsonDataStruct::MakeNull());
+                continue;
+            }
+
+            UAsync_ReadJson::ParseJsonValue(Value, NewPath, OutMap);
+            if (Value->Type == EJson::Object)
+            {
+                FlattenReference(Value->AsObject(), NewPath, OutMap);
+            }
+        }
+    }
+
+    /** 用基于 FJsonObject 的引擎展开，None 为参考实现 */
+    void FlattenObject(const EJsonDiffEngines Engine, const TSharedPtr<FJsonObject>& JsonObject, FParsedData& OutParsedData)
+    {
+        switch (Engine)
+        {
+        case EJsonDiffEngines::Iterative:
+            UAsync_ReadJson::ParseJsonIterative_Block(JsonObject, TEXT(""), OutParsedData.ParsedDataMap);
+            break;
+        case EJsonDiffEngines::Parallel:
+            UAsync_ReadJson::ParseJsonParallel_Block(JsonObject, OutParsedData.ParsedDataMap);
+            break;
+        default:
+            FlattenReference(JsonObject, TEXT(""), OutParsedData.ParsedDataMap);
+            break;
+        }
+    }
+
+    /** 用直接扫描源文本的引擎展开 */
+    bool FlattenSource(const EJsonDiffEngines Engine, const FString& JsonStr, FParsedData& OutParsedData, FString& OutError)
+    {
+        FReadJsonOptions Options;
+        Options.bLazyStrings = Engine == EJsonDiffEngines::LazyStrings;
+        Options.bEscapePathKeys = Engine == EJsonDiffEngines::EscapePathKeys;
+        if (Engine == EJsonDiffEngines::IgnoreCaseKeys)
+        {
+            Options.KeyPolicy = EJsonKeyPolicy::IgnoreCase;
+        }
+        else if (Engine == EJsonDiffEngines::CaseSensitiveKeys)
+        {
+            Options.KeyPolicy = EJsonKeyPolicy::CaseSensitive;
+        }
+        FJsonSourceFlattener Flattener;
+        if (!Flattener.Flatten(JsonStr, Options, OutParsedData))
+        {
+            OutError = Flattener.GetError();
+            return false;
+        }
+        return true;
+    }
+
+    bool IsSourceEngine(const EJsonDiffEngines Engine)
+    {
+        return EnumHasAnyFlags(EJsonDiffEngines::ParseEngines & ~(EJsonDiffEngines::Iterative | EJsonDiffEngines::Parallel), Engine);
+    }
+
+    /** 对象与数组文本反序列化后比较（源文本片段与重新序列化的文本格式不同） */
+    bool ContainerTextsEqual(const FString& Expected, const FString& Actual)
+    {
+        TSharedPtr<FJsonValue> ExpectedValue;
+        TSharedPtr<FJsonValue> ActualValue;
+        return FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Expected), ExpectedValue) && ExpectedValue.IsValid()
+            && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Actual), ActualValue) && ActualValue.IsValid()
+            && FJsonValue::CompareEqual(*ExpectedValue, *ActualValue);
+    }
+
+    bool ValuesEqual(const FJsonDataStruct& Expected, const FJsonDataStruct& Actual)
+    {
+        if (Expected == Actual)
+        {
+            return true;
+        }
+        // null 只与 null 相等（不等同于空字符串）
+        if (JsonDataHelper::IsNullEntry(&Expected) || JsonDataHelper::IsNullEntry(&Actual))
+        {
+            return false;
+        }
+        return JsonDataHelper::IsContainerEntry(&Expected) && JsonDataHelper::IsContainerEntry(&Actual)
+            && Expected.ContainerKind == Actual.ContainerKind
+            && ContainerTextsEqual(Expected.StringValue, Actual.StringValue);
+    }
+
+    FString DescribeValue(const FJsonDataStruct& Value)
+    {
+        if (JsonDataHelper::IsNullEntry(&Value))
+        {
+            return TEXT("null");
+        }
+        const FString TypeName = UEnum::GetDisplayValueAsText(Value.ValueType).ToString();
+        switch (Value.ValueType)
+        {
+        case EValueType::Bool:
+            return FString::Printf(TEXT("%s %s"), *TypeName, Value.BoolValue ? TEXT("true") : TEXT("false"));
+        case EValueType::Int:
+            return FString::Printf(TEXT("%s %d"), *TypeName, Value.IntValue);
+        case EValueType::Float:
+            return FString::Printf(TEXT("%s %.9g"), *TypeName, Value.FloatValue);
+        case EValueType::Int64:
+            return FString::Printf(TEXT("%s %lld"), *TypeName, Value.Int64Value);
+        case EValueType::Double:
+            return FString::Printf(TEXT("%s %.17g"), *TypeName, Value.DoubleValue);
+        default:
+            return FString::Printf(TEXT("%s \"%s\"%s"), *TypeName, *Value.StringValue.Left(64), Value.StringValue.Len() > 64 ? TEXT("...") : TEXT(""));
+        }
+    }
+
+    /** 差异描述：每个引擎最多记录 MaxReportedMismatches 条，其余只计数 */
+    struct FMismatchReport
+    {
+        FMismatchReport(const TCHAR* InEngineName, TArray<FString>& InMessages)
+            : EngineName(InEngineName)
+            , Messages(InMessages)
+        {
+        }
+
+        void Add(const FString& Message)
+        {
+            if (NumMismatches++ < JsonDifferential::MaxReportedMismatches)
+            {
+                Messages.Add(FString::Printf(TEXT("[%s] %s"), EngineName, *Message));
+            }
+        }
+
+        /** 追加省略的条数，返回是否没有差异 */
+        bool Finish()
+        {
+            if (NumMismatches > JsonDifferential::MaxReportedMismatches)
+            {
+                Messages.Add(FString::Printf(TEXT("[%s] ... %d more"), EngineName, NumMismatches - JsonDifferential::MaxReportedMismatches));
+            }
+            return NumMismatches == 0;
+        }
+
+        const TCHAR* EngineName;
+        TArray<FString>& Messages;
+        int32 NumMismatches = 0;
+    };
+
+    /** 是否有路径使用了转义（有键名含 '.' 或 '\'） */
+    bool HasEscapedPaths(const FParsedData& ParsedData)
+    {
+        bool bEscaped = false;
+        ParsedData.ForEachPath([&bEscaped](const FString& Path, const FJsonDataStruct*)
+        {
+            int32 Index = 0;
+            bEscaped = bEscaped || Path.FindChar(TEXT('\\'), Index);
+        });
+        return bEscaped;
+    }
+
+    /** 还原转义的路径（默认规则下的路径） */
+    FString UnescapePath(const FString& Path)
+    {
+        TArray<FString> Segments;
+        JsonPath::SplitPath(Path, Segments, true);
+        return JsonPath::JoinSegments(Segments, false);
+    }
+
+    /**
+     * 比较转义路径的结果与参考实现：还原后的路径须为参考实现的路径，参考实现的每条路径都须被还原得到，
+     * 还原后唯一的路径值须相同（不唯一的路径在参考实现中被后出现的值覆盖）
+     */
+    bool CompareEscapedPaths(const FParsedData& Expected, const FParsedData& Actual, const TCHAR* EngineName, TArray<FString>& OutMessages)
+    {
+        FMismatchReport Report(EngineName, OutMessages);
+
+        // 还原后的路径 -> 还原得到该路径的条目数
+        TMap<FString, int32> NumUnescaped;
+        Actual.ForEachPath([&NumUnescaped](const FString& Path, const FJsonDataStruct*)
+        {
+            ++NumUnescaped.FindOrAdd(UnescapePath(Path));
+        });
+
+        FJsonDataStruct ExpectedStorage;
+        FJsonDataStruct ActualStorage;
+        Actual.ForEachPath([&](const FString& Path, const FJsonDataStruct* Entry)
+        {
+            const FString Unescaped = UnescapePath(Path);
+            const FJsonDataStruct* ExpectedValue = Expected.FindValue(Unescaped, ExpectedStorage);
+            if (!ExpectedValue)
+            {
+                Report.Add(FString::Printf(TEXT("unexpected [ %s ] (unescaped [ %s ])"), *Path, *Unescaped));
+                return;
+            }
+            const FJsonDataStruct& ActualValue = Entry ? *Entry : *Actual.FindValue(Path, ActualStorage);
+            if (NumUnescaped.FindChecked(Unescaped) == 1 && !ValuesEqual(*ExpectedValue, ActualValue))
+            {
+                Report.Add(FString::Printf(TEXT("[ %s ] expected %s, got %s"), *Path, *DescribeValue(*ExpectedValue), *DescribeValue(ActualValue)));
+            }
+        });
+
+        Expected.ForEachPath([&](const FString& Path, const FJsonDataStruct*)
+        {
+            if (!NumUnescaped.Contains(Path))
+            {
+                Report.Add(FString::Printf(TEXT("missing [ %s ]"), *Path));
+            }
+        });
+        return Report.Finish();
+    }
+
+    /** 数组元素按 FJsonValue 逐个独立转换，非数值元素的 bIsNumber 为 false */
+    FReferenceNumber ConvertReferenceElement(const TSharedPtr<FJsonValue>& Element)
+    {
+        return Element.IsValid() && Element->Type == EJson::Number ? ConvertReferenceNumber(*Element) : FReferenceNumber();
+    }
+
+    /**
+     * 批量解析的结果与逐元素转换的第一个不同之处
+     * @return 元素下标，全部相同时为 INDEX_NONE
+     */
+    template <typename TValue, typename TPredicate>
+    int32 FindFirstDifference(const TArray<TValue>& Decoded, const TArray<FReferenceNumber>& Expected, TPredicate&& IsEqual)
+    {
+        const int32 NumCommon = FMath::Min(Decoded.Num(), Expected.Num());
+        for (int32 Index = 0; Index < NumCommon; ++Index)
+        {
+            if (!Expected[Index].bIsNumber || !IsEqual(Decoded[Index], Expected[Index]))
+            {
+                return Index;
+            }
+        }
+        return Decoded.Num() == Expected.Num() ? INDEX_NONE : NumCommon;
+    }
+
+    bool IsSameDouble(const double Decoded, const FReferenceNumber& Expected)
+    {
+        return FMath::IsFinite(Expected.Double) && GetDoubleBits(Decoded) == GetDoubleBits(Expected.Double);
+    }
+
+    bool IsSameFloat(const float Decoded, const FReferenceNumber& Expected)
+    {
+        return FMath::IsFinite(Expected.Double) && GetFloatBits(Decoded) == GetFloatBits(static_cast<float>(Expected.Double));
+    }
+
+    bool IsSameInt(const int32 Decoded, const FReferenceNumber& Expected)
+    {
+        return Expected.bIsInteger && Expected.Integer == Decoded;
+    }
+
+    bool IsSameInt64(const int64 Decoded, const FReferenceNumber& Expected)
+    {
+        return Expected.bIsInteger && Expected.Integer == Decoded;
+    }
+}
+
+const TCHAR* JsonDifferential::GetEngineName(const EJsonDiffEngines Engine)
+{
+    switch (Engine)
+    {
+    case EJsonDiffEngines::Iterative:         return TEXT("Iterative");
+    case EJsonDiffEngines::Parallel:          return TEXT("Parallel");
+    case EJsonDiffEngines::Streaming:         return TEXT("Streaming");
+    case EJsonDiffEngines::LazyStrings:       return TEXT("LazyStrings");
+    case EJsonDiffEngines::IgnoreCaseKeys:    return TEXT("IgnoreCase");
+    case EJsonDiffEngines::CaseSensitiveKeys: return TEXT("CaseSensitive");
+    case EJsonDiffEngines::EscapePathKeys:    return TEXT("EscapePaths");
+    case EJsonDiffEngines::BulkArrays:        return TEXT("BulkArrays");
+    default:                                  return TEXT("Reference");
+    }
+}
+
+bool JsonDifferential::ParseReference(const FString& JsonStr, FParsedData& OutParsedData)
+{
+    OutParsedData = {};
+    TSharedPtr<FJsonObject> JsonObject;
+    if (!DeserializeObject(JsonStr, JsonObject))
+    {
+        return false;
+    }
+    FlattenObject(EJsonDiffEngines::None, JsonObject, OutParsedData);
+    return true;
+}
+
+bool JsonDifferential::ParseWithEngine(const EJsonDiffEngines Engine, const FString& JsonStr, FParsedData& OutParsedData)
+{
+    OutParsedData = {};
+    if (IsSourceEngine(Engine))
+    {
+        FString Error;
+        return FlattenSource(Engine, JsonStr, OutParsedData, Error);
+    }
+
+    TSharedPtr<FJsonObject> JsonObject;
+    if (!DeserializeObject(JsonStr, JsonObject))
+    {
+        return false;
+    }
+    FlattenObject(Engine, JsonObject, OutParsedData);
+    return true;
+}
+
+bool JsonDifferential::CompareParsedData(const FParsedData& Expected, const FParsedData& Actual, const TCHAR* EngineName, TArray<FString>& OutMessages)
+{
+    FMismatchReport Report(EngineName, OutMessages);
+
+    const int32 NumExpected = Expected.NumPaths();
+    const int32 NumActual = Actual.NumPaths();
+    if (NumExpected != NumActual)
+    {
+        Report.Add(FString::Printf(TEXT("%d entries, expected %d"), NumActual, NumExpected));
+    }
+
+    int32 NumMissing = 0;
+    FJsonDataStruct ExpectedStorage;
+    FJsonDataStruct ActualStorage;
+    Expected.ForEachPath([&](const FString& Path, const FJsonDataStruct* Entry)
+    {
+        const FJsonDataStruct& ExpectedValue = Entry ? *Entry : *Expected.FindValue(Path, ExpectedStorage);
+        const FJsonDataStruct* ActualValue = Actual.FindValue(Path, ActualStorage);
+        if (!ActualValue)
+        {
+            ++NumMissing;
+            Report.Add(FString::Printf(TEXT("missing [ %s ]"), *Path));
+        }
+        else if (!ValuesEqual(ExpectedValue, *ActualValue))
+        {
+            Report.Add(FString::Printf(TEXT("[ %s ] expected %s, got %s"), *Path, *DescribeValue(ExpectedValue), *DescribeValue(*ActualValue)));
+        }
+    });
+
+    // 数量不同或有缺失时才查找多出的路径
+    if (NumMissing > 0 || NumExpected != NumActual)
+    {
+        Actual.ForEachPath([&](const FString& Path, const FJsonDataStruct*)
+        {
+            if (!Expected.ContainsPath(Path))
+            {
+                Report.Add(FString::Printf(TEXT("unexpected [ %s ]"), *Path));
+            }
+        });
+    }
+    return Report.Finish();
+}
+
+bool JsonDifferential::CompareBulkArrays(const FParsedData& Reference, TArray<FString>& OutMessages)
+{
+    FMismatchReport Report(GetEngineName(EJsonDiffEngines::BulkArrays), OutMessages);
+    FJsonDataStruct Storage;
+    Reference.ForEachPath([&](const FString& Path, const FJsonDataStruct* Entry)
+    {
+        const FJsonDataStruct& Value = Entry ? *Entry : *Reference.FindValue(Path, Storage);
+        if (!JsonDataHelper::IsArrayEntry(&Value))
+        {
+            return;
+        }
+
+        const FString& Text = Value.StringValue;
+        TSharedPtr<FJsonValue> ArrayValue;
+        const TArray<TSharedPtr<FJsonValue>>* Elements = nullptr;
+        if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), ArrayValue, FJsonSerializer::EFlags::StoreNumbersAsStrings)
+            || !ArrayValue.IsValid() || !ArrayValue->TryGetArray(Elements))
+        {
+            Report.Add(FString::Printf(TEXT("[ %s ] array text does not deserialize"), *Path));
+            return;
+        }
+
+        // 一维按元素转换；元素均为长度相同的数组时另按行优先展开，用于比较二维解析
+        TArray<FReferenceNumber> Numbers;
+        TArray<FReferenceNumber> MatrixNumbers;
+        int32 NumColumns = 0;
+        bool bIsMatrix = true;
+        for (int32 RowIndex = 0; RowIndex < Elements->Num(); ++RowIndex)
+        {
+            const TSharedPtr<FJsonValue>& Element = (*Elements)[RowIndex];
+            Numbers.Add(ConvertReferenceElement(Element));
+
+            const TArray<TSharedPtr<FJsonValue>>* Row = nullptr;
+            if (!bIsMatrix || !Element.IsValid() || !Element->TryGetArray(Row) || (RowIndex > 0 && Row->Num() != NumColumns))
+            {
+                bIsMatrix = false;
+                continue;
+            }
+            NumColumns = Row->Num();
+            for (const TSharedPtr<FJsonValue>& RowElement : *Row)
+            {
+                MatrixNumbers.Add(ConvertReferenceElement(RowElement));
+            }
+        }
+
+        const auto Check = [&Report, &Path](const TCHAR* DecoderName, const int32 DifferenceIndex)
+        {
+            if (DifferenceIndex != INDEX_NONE)
+            {
+                Report.Add(FString::Printf(TEXT("[ %s ] %s differs from element-wise conversion at element %d"), *Path, DecoderName, DifferenceIndex));
+            }
+        };
+
+        TArray<double> Doubles;
+        if (JsonNumberParser::ParseDoubleArray(*Text, Text.Len(), Doubles))
+        {
+            Check(TEXT("ParseDoubleArray"), FindFirstDifference(Doubles, Numbers, IsSameDouble));
+        }
+        TArray<float> Floats;
+        if (JsonNumberParser::ParseFloatArray(*Text, Text.Len(), Floats))
+        {
+            Check(TEXT("ParseFloatArray"), FindFirstDifference(Floats, Numbers, IsSameFloat));
+        }
+        TArray<int32> Ints;
+        if (JsonNumberParser::ParseIntArray(*Text, Text.Len(), Ints))
+        {
+            Check(TEXT("ParseIntArray"), FindFirstDifference(Ints, Numbers, IsSameInt));
+        }
+        TArray<int64> Int64s;
+        if (JsonNumberParser::ParseInt64Array(*Text, Text.Len(), Int64s))
+        {
+            Check(TEXT("ParseInt64Array"), FindFirstDifference(Int64s, Numbers, IsSameInt64));
+        }
+
+        // 二维解析接受时，逐元素转换须为同样形状的矩阵
+        int32 NumRows = 0;
+        int32 NumDecodedColumns = 0;
+        const auto CheckMatrix = [&](const TCHAR* DecoderName, const auto& Decoded, auto&& IsEqual)
+        {
+            if (!bIsMatrix || NumRows != Elements->Num() || (NumRows > 0 && NumDecodedColumns != NumColumns))
+            {
+                Report.Add(FString::Printf(TEXT("[ %s ] %s accepted a %dx%d matrix, element-wise shape differs"), *Path, DecoderName, NumRows, NumDecodedColumns));
+                return;
+            }
+            Check(DecoderName, FindFirstDifference(Decoded, MatrixNumbers, IsEqual));
+        };
+        TArray<float> FloatMatrix;
+        if (JsonNumberParser::ParseFloatMatrix(*Text, Text.Len(), FloatMatrix, NumRows, NumDecodedColumns))
+        {
+            CheckMatrix(TEXT("ParseFloatMatrix"), FloatMatrix, IsSameFloat);
+        }
+        TArray<int32> IntMatrix;
+        if (JsonNumberParser::ParseIntMatrix(*Text, Text.Len(), IntMatrix, NumRows, NumDecodedColumns))
+        {
+            CheckMatrix(TEXT("ParseIntMatrix"), IntMatrix, IsSameInt);
+        }
+    });
+    return Report.Finish();
+}
+
+bool JsonDifferential::Run(const FString& JsonStr, const EJsonDiffEngines Engines, FJsonDiffResult& OutResult)
+{
+    OutResult = {};
+
+    TSharedPtr<FJsonObject> JsonObject;
+    FParsedData Reference;
+    OutResult.bReferenceAccepted = DeserializeObject(JsonStr, JsonObject);
+    if (OutResult.bReferenceAccepted)
+    {
+        FlattenObject(EJsonDiffEngines::None, JsonObject, Reference);
+        OutResult.NumReferenceEntries = Reference.NumEntries();
+    }
+
+    // 输入中不区分大小写时冲突的路径数（IgnoreCase 扁平化的 KeyCollisions），键比较策略的引擎需要时才扁平化
+    int32 NumKeyCollisions = INDEX_NONE;
+    const auto CountKeyCollisions = [&NumKeyCollisions, &JsonStr]()
+    {
+        if (NumKeyCollisions == INDEX_NONE)
+        {
+            FParsedData IgnoreCase;
+            FString Error;
+            NumKeyCollisions = FlattenSource(EJsonDiffEngines::IgnoreCaseKeys, JsonStr, IgnoreCase, Error) ? IgnoreCase.KeyCollisions.Num() : 0;
+        }
+        return NumKeyCollisions;
+    };
+
+    for (const EJsonDiffEngines Engine : { EJsonDiffEngines::Iterative, EJsonDiffEngines::Parallel, EJsonDiffEngines::Streaming, EJsonDiffEngines::LazyStrings,
+        EJsonDiffEngines::IgnoreCaseKeys, EJsonDiffEngines::CaseSensitiveKeys, EJsonDiffEngines::EscapePathKeys })
+    {
+        if (!EnumHasAnyFlags(Engines, Engine))
+        {
+            continue;
+        }
+
+        // 基于 FJsonObject 的引擎共用参考实现的反序列化结果，是否接受输入与参考实现相同
+        FParsedData Actual;
+        FString Error;
+        const bool bAccepted = IsSourceEngine(Engine)
+            ? FlattenSource(Engine, JsonStr, Actual, Error)
+            : OutResult.bReferenceAccepted;
+        if (!IsSourceEngine(Engine) && bAccepted)
+        {
+            FlattenObject(Engine, JsonObject, Actual);
+        }
+
+        if (bAccepted != OutResult.bReferenceAccepted)
+        {
+            OutResult.AcceptanceMismatches |= Engine;
+            OutResult.Messages.Add(bAccepted
+                ? FString::Printf(TEXT("[%s] accepted input rejected by the reference"), GetEngineName(Engine))
+                : FString::Printf(TEXT("[%s] rejected input accepted by the reference: %s"), GetEngineName(Engine), *Error));
+            continue;
+        }
+        if (!bAccepted)
+        {
+            continue;
+        }
+
+        bool bMatched = true;
+        switch (Engine)
+        {
+        case EJsonDiffEngines::IgnoreCaseKeys:
+            NumKeyCollisions = Actual.KeyCollisions.Num();
+            // 冲突的键已被 FJsonObject 合并，参考实现无法表示其结果，只比较是否接受输入
+            bMatched = NumKeyCollisions > 0 || CompareParsedData(Reference, Actual, GetEngineName(Engine), OutResult.Messages);
+            break;
+        case EJsonDiffEngines::CaseSensitiveKeys:
+            bMatched = CountKeyCollisions() > 0 || CompareParsedData(Reference, Actual, GetEngineName(Engine), OutResult.Messages);
+            break;
+        case EJsonDiffEngines::EscapePathKeys:
+            bMatched = HasEscapedPaths(Actual)
+                ? CompareEscapedPaths(Reference, Actual, GetEngineName(Engine), OutResult.Messages)
+                : CompareParsedData(Reference, Actual, GetEngineName(Engine), OutResult.Messages);
+            break;
+        default:
+            bMatched = CompareParsedData(Reference, Actual, GetEngineName(Engine), OutResult.Messages);
+            break;
+        }
+        if (!bMatched)
+        {
+            OutResult.EntryMismatches |= Engine;
+        }
+    }
+
+    if (OutResult.bReferenceAccepted && EnumHasAnyFlags(Engines, EJsonDiffEngines::BulkArrays) && !CompareBulkArrays(Reference, OutResult.Messages))
+    {
+        OutResult.EntryMismatches |= EJsonDiffEngines::BulkArrays;
+    }
+    return !OutResult.HasMismatch();
+}
+
+void JsonDifferential::CollectNumberLiterals(const FString& JsonStr, TArray<FString>& OutLiterals)
+{
+    const int32 Length = JsonStr.Len();
+    int32 Index = 0;
+    while (Index < Length)
+    {
+        const TCHAR Char = JsonStr[Index];
+        if (Char == TEXT('"'))
+        {
+            // 跳过字符串（包括转义的引号），未闭合时到文本末尾
+            ++Index;
+            while (Index < Length && JsonStr[Index] != TEXT('"'))
+            {
+                Index += JsonStr[Index] == TEXT('\\') ? 2 : 1;
+            }
+            ++Index;
+        }
+        else if (Char == TEXT('-') || IsAsciiDigit(Char))
+        {
+            const int32 Start = Index;
+            while (Index < Length && IsNumberChar(JsonStr[Index]))
+            {
+                ++Index;
+            }
+            OutLiterals.Add(JsonStr.Mid(Start, Index - Start));
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+}
+
+bool JsonDifferential::CheckNumberLiteral(const FString& Literal, TArray<FString>& OutMessages)
+{
+    const int32 NumMessages = OutMessages.Num();
+    const auto Report = [&OutMessages, &Literal](const FString& Message)
+    {
+        OutMessages.Add(FString::Printf(TEXT("[Number] %s: %s"), *Literal, *Message));
+    };
+
+    double Value = 0.0;
+    const bool bIsLiteral = IsNumberLiteral(Literal);
+    const bool bAccepted = JsonNumberParser::ParseDouble(*Literal, Literal.Len(), Value);
+    bool bIsInteger = false;
+    int64 Integer = 0;
+    double Double = 0.0;
+    const bool bNumberAccepted = JsonNumberParser::ParseNumber(*Literal, Literal.Len(), bIsInteger, Integer, Double);
+    if (bAccepted != bIsLiteral || bNumberAccepted != bIsLiteral)
+    {
+        Report(FString::Printf(TEXT("%s by ParseDouble, %s by ParseNumber, expected %s"),
+            bAccepted ? TEXT("accepted") : TEXT("rejected"), bNumberAccepted ? TEXT("accepted") : TEXT("rejected"), bIsLiteral ? TEXT("accepted") : TEXT("rejected")));
+        return false;
+    }
+    if (!bIsLiteral)
+    {
+        return true;
+    }
+
+    const double Expected = FCString::Atod(*Literal);
+    if (GetDoubleBits(Value) != GetDoubleBits(Expected))
+    {
+        Report(FString::Printf(TEXT("ParseDouble %s, Atod %s"), *DescribeDouble(Value), *DescribeDouble(Expected)));
+    }
+
+    if (FMath::IsFinite(Expected))
+    {
+        const FString RoundTrip = FString::Printf(TEXT("%.17g"), Expected);
+        double RoundTripValue = 0.0;
+        if (!JsonNumberParser::ParseDouble(*RoundTrip, RoundTrip.Len(), RoundTripValue) || GetDoubleBits(RoundTripValue) != GetDoubleBits(Expected))
+        {
+            Report(FString::Printf(TEXT("round trip through %s gives %s"), *RoundTrip, *DescribeDouble(RoundTripValue)));
+        }
+    }
+
+    if (bIsInteger != IsInt64Literal(Literal))
+    {
+        Report(FString::Printf(TEXT("ParseNumber classified as %s"), bIsInteger ? TEXT("integer") : TEXT("double")));
+    }
+    else if (bIsInteger && Integer != FCString::Atoi64(*Literal))
+    {
+        Report(FString::Printf(TEXT("ParseNumber %lld, Atoi64 %lld"), Integer, FCString::Atoi64(*Literal)));
+    }
+    else if (!bIsInteger && GetDoubleBits(Double) != GetDoubleBits(Expected))
+    {
+        Report(FString::Printf(TEXT("ParseNumber %s, Atod %s"), *DescribeDouble(Double), *DescribeDouble(Expected)));
+    }
+    return OutMessages.Num() == NumMessages;
+}
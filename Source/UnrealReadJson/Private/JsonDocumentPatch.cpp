@@ -0,0 +1,986 @@
+﻿#include "JsonDocumentPatch.h"
+#include "Async_ReadJson.h"
+#include "JsonFlatTable.h"
+#include "JsonPath.h"
+#include "JsonPathIndex.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+// ============================================================================
+// 内部实现
+// ============================================================================
+namespace
+{
+    /** 解析JSON文本为值 */
+    TSharedPtr<FJsonValue> ParseJsonText(const FString& JsonText)
+    {
+        TSharedPtr<FJsonValue> JsonValue;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+        if (!FJsonSerializer::Deserialize(Reader, JsonValue, FJsonSerializer::EFlags::StoreNumbersAsStrings))
+        {
+            return nullptr;
+        }
+        return JsonValue;
+    }
+
+    /**
+     * 由条目还原JSON值
+     * 对象/数组节点（ContainerKind）的文本会被重新解析，其余字符串按普通字符串处理
+     */
+    TSharedPtr<FJsonValue> MakeJsonValueFromEntry(const FJsonDataStruct& Entry)
+    {
+        switch (Entry.ValueType)
+        {
+        case EValueType::Bool:  return MakeShared<FJsonValueBoolean>(Entry.BoolValue);
+        case EValueType::Int:   return MakeShared<FJsonValueNumber>(Entry.IntValue);
+        case EValueType::Float:
+        case EValueType::Int64:
+        case EValueType::Double: return JsonDataHelper::MakeWideNumberValue(Entry);
+        default:                break;
+        }
+
+        if (JsonDataHelper::IsNullEntry(&Entry))
+        {
+            return MakeShared<FJsonValueNull>();
+        }
+        if (JsonDataHelper::IsContainerEntry(&Entry))
+        {
+            if (TSharedPtr<FJsonValue> Container = ParseJsonText(Entry.StringValue);
+                Container.IsValid() && (Container->Type == EJson::Object || Container->Type == EJson::Array))
+            {
+                return Container;
+            }
+        }
+        return MakeShared<FJsonValueString>(Entry.StringValue);
+    }
+
+    /**
+     * 比较两个条目的值
+     * 对象/数组节点的文本可能是源文本中的原始片段，也可能是重新序列化的结果，文本不同时按解析后的结构比较
+     */
+    bool EntriesEqual(const FJsonDataStruct& A, const FJsonDataStruct& B)
+    {
+        if (A == B)
+        {
+            return true;
+        }
+        if (!JsonDataHelper::IsContainerEntry(&A) || A.ContainerKind != B.ContainerKind)
+        {
+            return false;
+        }
+        const TSharedPtr<FJsonValue> ValueA = ParseJsonText(A.StringValue);
+        const TSharedPtr<FJsonValue> ValueB = ParseJsonText(B.StringValue);
+        return ValueA.IsValid() && ValueB.IsValid() && *ValueA == *ValueB;
+    }
+
+    /**
+     * 按 ReadJson 的规则将值（及其子对象）扁平化到数据表中（数据表按文档的键比较策略）
+     * @param Scratch 复用的单条目 Map，避免每个节点分配一次
+     */
+    void FlattenJsonValue(const TSharedPtr<FJsonValue>& Value, const FString& Path, const bool bEscape, TMap<FString, FJsonDataStruct>& Scratch, FJsonFlatTable& OutEntries)
+    {
+        if (!Value.IsValid())
+        {
+            return;
+        }
+
+        UAsync_ReadJson::ParseJsonValue(Value, Path, Scratch);
+        for (TPair<FString, FJsonDataStruct>& Pair : Scratch)
+        {
+            OutEntries.Add(MoveTemp(Pair.Key), MoveTemp(Pair.Value));
+        }
+        Scratch.Reset();
+
+        if (Value->Type == EJson::Object)
+        {
+            for (const auto& Elem : Value->AsObject()->Values)
+            {
+                FString ChildPath = Path;
+                JsonPath::AppendSegment(ChildPath, Elem.Key, bEscape, false);
+                FlattenJsonValue(Elem.Value, ChildPath, bEscape, Scratch, OutEntries);
+            }
+        }
+    }
+
+    /** 收集值扁平化后会产生的所有路径 */
+    void CollectSubtreePaths(const TSharedPtr<FJsonValue>& Value, const FString& Path, const bool bEscape, TArray<FString>& OutPaths)
+    {
+        OutPaths.Add(Path);
+        if (Value.IsValid() && Value->Type == EJson::Object)
+        {
+            for (const auto& Elem : Value->AsObject()->Values)
+            {
+                FString ChildPath = Path;
+                JsonPath::AppendSegment(ChildPath, Elem.Key, bEscape, false);
+                CollectSubtreePaths(Elem.Value, ChildPath, bEscape, OutPaths);
+            }
+        }
+    }
+
+    /** 去除 Merge Patch 中的 null 成员（RFC 7386：目标不是对象时以空对象为基础合并） */
+    TSharedPtr<FJsonValue> StripMergePatchNulls(const TSharedPtr<FJsonValue>& PatchValue)
+    {
+        if (!PatchValue.IsValid() || PatchValue->Type != EJson::Object)
+        {
+            return PatchValue;
+        }
+
+        const TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        for (const auto& Elem : PatchValue->AsObject()->Values)
+        {
+            if (Elem.Value.IsValid() && Elem.Value->Type != EJson::Null)
+            {
+                Result->Values.Add(Elem.Key, StripMergePatchNulls(Elem.Value));
+            }
+        }
+        return MakeShared<FJsonValueObject>(Result);
+    }
+
+    /** 解析 JSON Pointer（RFC 6901） */
+    bool ParseJsonPointer(const FString& Pointer, TArray<FString>& OutSegments)
+    {
+        OutSegments.Reset();
+        if (Pointer.IsEmpty())
+        {
+            return true;
+        }
+        if (Pointer[0] != TEXT('/'))
+        {
+            return false;
+        }
+
+        Pointer.RightChop(1).ParseIntoArray(OutSegments, TEXT("/"), false);
+        if (OutSegments.IsEmpty())
+        {
+            OutSegments.Add(FString());
+        }
+        for (FString& Segment : OutSegments)
+        {
+            Segment.ReplaceInline(TEXT("~1"), TEXT("/"), ESearchCase::CaseSensitive);
+            Segment.ReplaceInline(TEXT("~0"), TEXT("~"), ESearchCase::CaseSensitive);
+        }
+        return true;
+    }
+
+    /** 解析数组下标（不允许前导0和负数） */
+    bool ParseArrayIndex(const FString& Segment, int32& OutIndex)
+    {
+        if (Segment.IsEmpty() || Segment.Len() > 9 || (Segment.Len() > 1 && Segment[0] == TEXT('0')))
+        {
+            return false;
+        }
+        for (const TCHAR Char : Segment)
+        {
+            if (!FChar::IsDigit(Char))
+            {
+                return false;
+            }
+        }
+        OutIndex = FCString::Atoi(*Segment);
+        return true;
+    }
+
+    /**
+     * 已解析数据的事务式编辑器
+     * - 通过 FParsedData 的查找接口读取，包括区分大小写的数据表与延迟记录的字符串（被修改后改为普通条目）
+     * - 记录每个被修改路径的原始值，用于失败回滚和计算变化路径
+     * - 祖先对象节点的序列化字符串延迟到读取或提交时统一刷新，同一祖先只重新序列化一次
+     * - 路径按文档的路径编码（FParsedData::bEscapedPaths）构建
+     */
+    class FFlatDocumentEditor
+    {
+    public:
+        explicit FFlatDocumentEditor(FParsedData& InParsedData)
+            : ParsedData(InParsedData)
+        {
+        }
+
+        bool Contains(const FString& Path) const
+        {
+            return ParsedData.ContainsPath(Path);
+        }
+
+        /** 由路径段构建路径 */
+        FString JoinPath(const TArray<FString>& Segments) const
+        {
+            return JsonPath::JoinSegments(Segments, ParsedData.bEscapedPaths);
+        }
+
+        /**
+         * 子节点的路径
+         * @param bParentIsRoot Path 是否为根节点（转义编码中根节点下空键名的路径同样为空，不能按路径判断）
+         */
+        FString ChildPath(const FString& Path, const FString& Key, const bool bParentIsRoot) const
+        {
+            FString Child = Path;
+            JsonPath::AppendSegment(Child, Key, ParsedData.bEscapedPaths, bParentIsRoot);
+            return Child;
+        }
+
+        /** 查找路径的值，延迟记录的字符串写入 Storage */
+        const FJsonDataStruct* Find(const FString& Path, FJsonDataStruct& Storage) const
+        {
+            return ParsedData.FindValue(Path, Storage);
+        }
+
+        /** 获取路径当前的JSON值（必要时先刷新该节点） */
+        TSharedPtr<FJsonValue> GetCurrentValue(const FString& Path)
+        {
+            RefreshIfDirty(Path);
+            FJsonDataStruct Storage;
+            const FJsonDataStruct* Entry = Find(Path, Storage);
+            return Entry ? MakeJsonValueFromEntry(*Entry) : nullptr;
+        }
+
+        /** 用新值替换路径对应的整个子树 */
+        void SetSubtree(const TArray<FString>& Segments, const TSharedPtr<FJsonValue>& Value)
+        {
+            const FString Path = JoinPath(Segments);
+
+            TArray<FString> OldPaths;
+            if (Contains(Path))
+            {
+                CollectSubtreePaths(GetCurrentValue(Path), Path, ParsedData.bEscapedPaths, OldPaths);
+            }
+
+            FJsonFlatTable NewEntries = MakeEntryTable();
+            TMap<FString, FJsonDataStruct> Scratch;
+            FlattenJsonValue(Value, Path, ParsedData.bEscapedPaths, Scratch, NewEntries);
+
+            if (WriteEntries(NewEntries, OldPaths))
+            {
+                MarkAncestorsDirty(Segments);
+            }
+        }
+
+        /** 删除路径对应的整个子树 */
+        void RemoveSubtree(const TArray<FString>& Segments)
+        {
+            const FString Path = JoinPath(Segments);
+            if (!Contains(Path))
+            {
+                return;
+            }
+
+            TArray<FString> OldPaths;
+            CollectSubtreePaths(GetCurrentValue(Path), Path, ParsedData.bEscapedPaths, OldPaths);
+
+            bool bChanged = false;
+            for (const FString& OldPath : OldPaths)
+            {
+                bChanged |= Erase(OldPath);
+            }
+
+            if (bChanged)
+            {
+                MarkAncestorsDirty(Segments);
+            }
+        }
+
+        /** 用新的根对象替换整个文档，只写入不同的条目 */
+        void ReplaceDocument(const TSharedPtr<FJsonObject>& RootObject)
+        {
+            // 所有条目都会按新文档重写，未刷新的祖先无需再处理
+            DirtyChildren.Empty();
+
+            FJsonFlatTable NewEntries = MakeEntryTable();
+            NewEntries.Reserve(ParsedData.NumPaths());
+            TMap<FString, FJsonDataStruct> Scratch;
+            for (const auto& Elem : RootObject->Values)
+            {
+                FlattenJsonValue(Elem.Value, ChildPath(FString(), Elem.Key, true), ParsedData.bEscapedPaths, Scratch, NewEntries);
+            }
+
+            TArray<FString> OldPaths;
+            OldPaths.Reserve(ParsedData.NumPaths());
+            ParsedData.ForEachPath([&OldPaths](const FString& OldPath, const FJsonDataStruct*)
+            {
+                OldPaths.Add(OldPath);
+            });
+            WriteEntries(NewEntries, OldPaths);
+        }
+
+        /** 提交修改：刷新所有脏祖先并输出变化路径 */
+        void Commit(TArray<FString>& OutChangedPaths)
+        {
+            TArray<FString> DirtyPaths;
+            DirtyChildren.GetKeys(DirtyPaths);
+            for (const FString& DirtyPath : DirtyPaths)
+            {
+                RefreshIfDirty(DirtyPath);
+            }
+
+            OutChangedPaths.Reset();
+            FJsonDataStruct Storage;
+            for (const FString& Path : TouchOrder)
+            {
+                const TOptional<FJsonDataStruct>& Original = Originals.FindChecked(Path);
+                const FJsonDataStruct* Current = Find(Path, Storage);
+                if (Original.IsSet() != (Current != nullptr) || (Current && !EntriesEqual(Original.GetValue(), *Current)))
+                {
+                    OutChangedPaths.Add(Path);
+                }
+            }
+        }
+
+        /** 回滚所有修改 */
+        void Rollback()
+        {
+            for (const FString& Path : TouchOrder)
+            {
+                if (const TOptional<FJsonDataStruct>& Original = Originals.FindChecked(Path); Original.IsSet())
+                {
+                    // 原为延迟记录的字符串时恢复为值相同的普通条目
+                    ParsedData.SetEntry(Path, Original.GetValue());
+                }
+                else
+                {
+                    ParsedData.RemoveEntry(Path);
+                }
+            }
+            DirtyChildren.Empty();
+        }
+
+    private:
+        /** 新条目的临时数据表，键比较策略与文档一致 */
+        FJsonFlatTable MakeEntryTable() const
+        {
+            return FJsonFlatTable(ParsedData.IsCaseSensitive() ? EJsonKeyPolicy::CaseSensitive : EJsonKeyPolicy::Default);
+        }
+
+        /**
+         * 用新的子树条目替换旧路径，只写入与现有条目不同的部分
+         * 对象节点按子节点比较：原本就是对象且没有后代被写入或删除时保留原有文本，
+         * 不因原始片段与重新序列化的文本格式不同而重写；数组节点按解析后的结构比较
+         * @return 是否有条目发生变化
+         */
+        bool WriteEntries(const FJsonFlatTable& NewEntries, const TArray<FString>& OldPaths)
+        {
+            // 有后代发生变化的对象路径
+            TSet<FString> ChangedObjects;
+            const auto MarkAncestors = [this, &ChangedObjects](const FString& Path)
+            {
+                TArray<int32, TInlineAllocator<16>> Separators;
+                JsonPath::FindSeparators(Path, ParsedData.bEscapedPaths, Separators);
+                for (int32 Index = Separators.Num() - 1; Index >= 0; --Index)
+                {
+                    bool bAlreadyChanged = false;
+                    ChangedObjects.Add(Path.Left(Separators[Index]), &bAlreadyChanged);
+                    if (bAlreadyChanged)
+                    {
+                        break;
+                    }
+                }
+            };
+
+            bool bChanged = false;
+            for (const FString& OldPath : OldPaths)
+            {
+                if (!NewEntries.Find(OldPath) && Erase(OldPath))
+                {
+                    bChanged = true;
+                    MarkAncestors(OldPath);
+                }
+            }
+
+            // 先比较叶子与数组，再按子节点判断对象，最后按原顺序写入
+            const TArray<FJsonFlatTable::FEntry>& Entries = NewEntries.GetEntries();
+            TBitArray<> ShouldWrite(false, Entries.Num());
+            FJsonDataStruct Storage;
+            for (int32 Index = 0; Index < Entries.Num(); ++Index)
+            {
+                if (!JsonDataHelper::IsObjectEntry(&Entries[Index].Value))
+                {
+                    const FJsonDataStruct* Existing = Find(Entries[Index].Key, Storage);
+                    if (!Existing || !EntriesEqual(*Existing, Entries[Index].Value))
+                    {
+                        ShouldWrite[Index] = true;
+                        MarkAncestors(Entries[Index].Key);
+                    }
+                }
+            }
+            for (int32 Index = 0; Index < Entries.Num(); ++Index)
+            {
+                if (JsonDataHelper::IsObjectEntry(&Entries[Index].Value))
+                {
+                    ShouldWrite[Index] = !JsonDataHelper::IsObjectEntry(Find(Entries[Index].Key, Storage)) || ChangedObjects.Contains(Entries[Index].Key);
+                }
+            }
+            for (int32 Index = 0; Index < Entries.Num(); ++Index)
+            {
+                if (ShouldWrite[Index])
+                {
+                    Write(Entries[Index].Key, Entries[Index].Value, false);
+                    bChanged = true;
+                }
+            }
+            return bChanged;
+        }
+
+        /**
+         * 写入条目
+         * @param bCompare 是否先与现有条目比较，相同时不写入
+         */
+        bool Write(const FString& Path, const FJsonDataStruct& Value, const bool bCompare = true)
+        {
+            FJsonDataStruct Storage;
+            const FJsonDataStruct* Existing = Find(Path, Storage);
+            if (bCompare && Existing && EntriesEqual(*Existing, Value))
+            {
+                return false;
+            }
+            RecordOriginal(Path, Existing);
+            ParsedData.SetEntry(Path, Value);
+            return true;
+        }
+
+        bool Erase(const FString& Path)
+        {
+            FJsonDataStruct Storage;
+            const FJsonDataStruct* Existing = Find(Path, Storage);
+            if (!Existing)
+            {
+                return false;
+            }
+            RecordOriginal(Path, Existing);
+            ParsedData.RemoveEntry(Path);
+            return true;
+        }
+
+        void RecordOriginal(const FString& Path, const FJsonDataStruct* Existing)
+        {
+            if (!Originals.Contains(Path))
+            {
+                Originals.Add(Path, Existing ? TOptional<FJsonDataStruct>(*Existing) : TOptional<FJsonDataStruct>());
+                TouchOrder.Add(Path);
+            }
+        }
+
+        void MarkAncestorsDirty(const TArray<FString>& Segments)
+        {
+            FString ParentPath;
+            for (int32 Index = 0; Index + 1 < Segments.Num(); ++Index)
+            {
+                ParentPath = ChildPath(ParentPath, Segments[Index], Index == 0);
+                DirtyChildren.FindOrAdd(ParentPath).Add(Segments[Index + 1]);
+            }
+        }
+
+        /** 用子节点的当前值重新序列化对象节点（先刷新更深层的脏节点） */
+        void RefreshIfDirty(const FString& Path)
+        {
+            TSet<FString> Children;
+            if (!DirtyChildren.RemoveAndCopyValue(Path, Children))
+            {
+                return;
+            }
+
+            for (const FString& ChildKey : Children)
+            {
+                RefreshIfDirty(ChildPath(Path, ChildKey, false));
+            }
+
+            FJsonDataStruct Storage;
+            const FJsonDataStruct* Entry = Find(Path, Storage);
+            const TSharedPtr<FJsonValue> BaseValue = Entry ? MakeJsonValueFromEntry(*Entry) : nullptr;
+            if (!BaseValue.IsValid() || BaseValue->Type != EJson::Object)
+            {
+                return;
+            }
+
+            const TSharedPtr<FJsonObject> NewObject = MakeShared<FJsonObject>();
+            NewObject->Values = BaseValue->AsObject()->Values;
+            for (const FString& ChildKey : Children)
+            {
+                if (const FJsonDataStruct* ChildEntry = Find(ChildPath(Path, ChildKey, false), Storage))
+                {
+                    NewObject->SetField(ChildKey, MakeJsonValueFromEntry(*ChildEntry));
+                }
+                else
+                {
+                    NewObject->RemoveField(ChildKey);
+                }
+            }
+
+            TMap<FString, FJsonDataStruct> Serialized;
+            UAsync_ReadJson::ParseJsonValue(MakeShared<FJsonValueObject>(NewObject), Path, Serialized);
+            if (const FJsonDataStruct* NewEntry = Serialized.Find(Path))
+            {
+                Write(Path, *NewEntry);
+            }
+        }
+
+    private:
+        FParsedData& ParsedData;
+
+        /** 被修改路径的原始值（未设置表示原本不存在） */
+        TMap<FString, TOptional<FJsonDataStruct>> Originals;
+
+        /** 被修改路径的顺序 */
+        TArray<FString> TouchOrder;
+
+        /** 待刷新的祖先对象节点 -> 发生变化的直接子键 */
+        TMap<FString, TSet<FString>> DirtyChildren;
+    };
+
+    // ========================================================================
+    // JSON Pointer 定位
+    // ========================================================================
+
+    /**
+     * 补丁目标
+     * 对象节点在Map中是扁平化的，可以直接定位；数组不会被扁平化，其内部路径需要在数组的DOM上修改
+     */
+    struct FPatchTarget
+    {
+        /** 在扁平化Map中的路径段（目标本身，或包含目标的数组节点） */
+        TArray<FString> FlatSegments;
+
+        /** 数组节点内部的剩余路径段 */
+        TArray<FString> InnerSegments;
+
+        bool bIsValid = false;
+    };
+
+    FPatchTarget ResolveTarget(const FFlatDocumentEditor& Editor, const TArray<FString>& Segments)
+    {
+        FPatchTarget Target;
+
+        int32 ExistingCount = 0;
+        FString Path;
+        while (ExistingCount < Segments.Num())
+        {
+            FString NextPath = Editor.ChildPath(Path, Segments[ExistingCount], ExistingCount == 0);
+            if (!Editor.Contains(NextPath))
+            {
+                break;
+            }
+            Path = MoveTemp(NextPath);
+            ++ExistingCount;
+        }
+
+        FJsonDataStruct Storage;
+        const FJsonDataStruct* Parent = ExistingCount > 0 ? Editor.Find(Path, Storage) : nullptr;
+        if (ExistingCount == Segments.Num() || ((ExistingCount == 0 || JsonDataHelper::IsObjectEntry(Parent)) && ExistingCount == Segments.Num() - 1))
+        {
+            // 目标本身存在，或其父节点为根/对象节点（目标为待新增的键）
+            Target.FlatSegments = Segments;
+            Target.bIsValid = true;
+        }
+        else if (JsonDataHelper::IsArrayEntry(Parent))
+        {
+            Target.FlatSegments.Append(Segments.GetData(), ExistingCount);
+            Target.InnerSegments.Append(Segments.GetData() + ExistingCount, Segments.Num() - ExistingCount);
+            Target.bIsValid = true;
+        }
+        return Target;
+    }
+
+    /** 读取DOM内部指定路径的值 */
+    TSharedPtr<FJsonValue> GetInnerValue(const TSharedPtr<FJsonValue>& Node, const TArray<FString>& Segments, const int32 Index)
+    {
+        if (!Node.IsValid() || Index == Segments.Num())
+        {
+            return Node;
+        }
+
+        if (Node->Type == EJson::Object)
+        {
+            const TSharedPtr<FJsonValue>* Child = Node->AsObject()->Values.Find(Segments[Index]);
+            return Child ? GetInnerValue(*Child, Segments, Index + 1) : nullptr;
+        }
+        if (Node->Type == EJson::Array)
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Array = Node->AsArray();
+            int32 ArrayIndex = INDEX_NONE;
+            if (ParseArrayIndex(Segments[Index], ArrayIndex) && Array.IsValidIndex(ArrayIndex))
+            {
+                return GetInnerValue(Array[ArrayIndex], Segments, Index + 1);
+            }
+        }
+        return nullptr;
+    }
+
+    enum class EInnerOp : uint8
+    {
+        Add,
+        Remove,
+        Replace
+    };
+
+    /** 以写时复制方式修改DOM内部的值，返回新的节点，失败返回nullptr */
+    TSharedPtr<FJsonValue> ModifyInnerValue(const TSharedPtr<FJsonValue>& Node, const TArray<FString>& Segments, const int32 Index,
+        const EInnerOp Op, const TSharedPtr<FJsonValue>& Value)
+    {
+        if (!Node.IsValid() || !Segments.IsValidIndex(Index))
+        {
+            return nullptr;
+        }
+
+        const FString& Segment = Segments[Index];
+        const bool bIsLast = Index == Segments.Num() - 1;
+
+        if (Node->Type == EJson::Object)
+        {
+            const TSharedPtr<FJsonObject> NewObject = MakeShared<FJsonObject>();
+            NewObject->Values = Node->AsObject()->Values;
+            TSharedPtr<FJsonValue>* Child = NewObject->Values.Find(Segment);
+
+            if (bIsLast && Op == EInnerOp::Add)
+            {
+                NewObject->Values.Add(Segment, Value);
+            }
+            else if (!Child)
+            {
+                return nullptr;
+            }
+            else if (!bIsLast)
+            {
+                *Child = ModifyInnerValue(*Child, Segments, Index + 1, Op, Value);
+                if (!Child->IsValid())
+                {
+                    return nullptr;
+                }
+            }
+            else if (Op == EInnerOp::Remove)
+            {
+                NewObject->Values.Remove(Segment);
+            }
+            else
+            {
+                *Child = Value;
+            }
+            return MakeShared<FJsonValueObject>(NewObject);
+        }
+
+        if (Node->Type == EJson::Array)
+        {
+            TArray<TSharedPtr<FJsonValue>> NewArray = Node->AsArray();
+            if (bIsLast && Op == EInnerOp::Add && Segment == TEXT("-"))
+            {
+                NewArray.Add(Value);
+                return MakeShared<FJsonValueArray>(NewArray);
+            }
+
+            int32 ArrayIndex = INDEX_NONE;
+            if (!ParseArrayIndex(Segment, ArrayIndex))
+            {
+                return nullptr;
+            }
+
+            if (bIsLast && Op == EInnerOp::Add)
+            {
+                if (ArrayIndex > NewArray.Num())
+                {
+                    return nullptr;
+                }
+                NewArray.Insert(Value, ArrayIndex);
+            }
+            else if (!NewArray.IsValidIndex(ArrayIndex))
+            {
+                return nullptr;
+            }
+            else if (!bIsLast)
+            {
+                NewArray[ArrayIndex] = ModifyInnerValue(NewArray[ArrayIndex], Segments, Index + 1, Op, Value);
+                if (!NewArray[ArrayIndex].IsValid())
+                {
+                    return nullptr;
+                }
+            }
+            else if (Op == EInnerOp::Remove)
+            {
+                NewArray.RemoveAt(ArrayIndex);
+            }
+            else
+            {
+                NewArray[ArrayIndex] = Value;
+            }
+            return MakeShared<FJsonValueArray>(NewArray);
+        }
+
+        return nullptr;
+    }
+
+    // ========================================================================
+    // 补丁操作
+    // ========================================================================
+
+    bool GetValueAt(FFlatDocumentEditor& Editor, const TArray<FString>& Segments, TSharedPtr<FJsonValue>& OutValue)
+    {
+        const FPatchTarget Target = ResolveTarget(Editor, Segments);
+        if (!Target.bIsValid || Target.FlatSegments.IsEmpty())
+        {
+            return false;
+        }
+
+        const FString FlatPath = Editor.JoinPath(Target.FlatSegments);
+        if (!Editor.Contains(FlatPath))
+        {
+            return false;
+        }
+        OutValue = GetInnerValue(Editor.GetCurrentValue(FlatPath), Target.InnerSegments, 0);
+        return OutValue.IsValid();
+    }
+
+    bool ModifyValueAt(FFlatDocumentEditor& Editor, const TArray<FString>& Segments, const EInnerOp Op, const TSharedPtr<FJsonValue>& Value)
+    {
+        const FPatchTarget Target = ResolveTarget(Editor, Segments);
+        if (!Target.bIsValid || Target.FlatSegments.IsEmpty())
+        {
+            return false;
+        }
+
+        const FString FlatPath = Editor.JoinPath(Target.FlatSegments);
+        if (Target.InnerSegments.IsEmpty())
+        {
+            if (Op != EInnerOp::Add && !Editor.Contains(FlatPath))
+            {
+                return false;
+            }
+            if (Op == EInnerOp::Remove)
+            {
+                Editor.RemoveSubtree(Target.FlatSegments);
+            }
+            else
+            {
+                Editor.SetSubtree(Target.FlatSegments, Value);
+            }
+            return true;
+        }
+
+        const TSharedPtr<FJsonValue> NewContainer = ModifyInnerValue(Editor.GetCurrentValue(FlatPath), Target.InnerSegments, 0, Op, Value);
+        if (!NewContainer.IsValid())
+        {
+            return false;
+        }
+        Editor.SetSubtree(Target.FlatSegments, NewContainer);
+        return true;
+    }
+
+    bool TestValueAt(FFlatDocumentEditor& Editor, const TArray<FString>& Segments, const TSharedPtr<FJsonValue>& Value)
+    {
+        TSharedPtr<FJsonValue> Current;
+        if (!GetValueAt(Editor, Segments, Current))
+        {
+            return false;
+        }
+
+        // 标量按扁平化后的条目比较，与文档本身的存储精度一致
+        if (Current->Type != EJson::Object && Current->Type != EJson::Array)
+        {
+            const FString Path = Editor.JoinPath(Segments);
+            TMap<FString, FJsonDataStruct> Expected;
+            TMap<FString, FJsonDataStruct> Actual;
+            UAsync_ReadJson::ParseJsonValue(Value, Path, Expected);
+            UAsync_ReadJson::ParseJsonValue(Current, Path, Actual);
+            const FJsonDataStruct* ExpectedEntry = Expected.Find(Path);
+            const FJsonDataStruct* ActualEntry = Actual.Find(Path);
+            return ExpectedEntry && ActualEntry && *ExpectedEntry == *ActualEntry;
+        }
+        return *Current == *Value;
+    }
+
+    /** 应用 RFC 6902 操作数组 */
+    bool ApplyJsonPatchOperations(FFlatDocumentEditor& Editor, const TArray<TSharedPtr<FJsonValue>>& Operations)
+    {
+        for (int32 OpIndex = 0; OpIndex < Operations.Num(); ++OpIndex)
+        {
+            const TSharedPtr<FJsonObject>* Operation = nullptr;
+            FString OpName;
+            FString PathPointer;
+            TArray<FString> Segments;
+            if (!Operations[OpIndex].IsValid() || !Operations[OpIndex]->TryGetObject(Operation)
+                || !(*Operation)->TryGetStringField(TEXT("op"), OpName)
+                || !(*Operation)->TryGetStringField(TEXT("path"), PathPointer)
+                || !ParseJsonPointer(PathPointer, Segments))
+            {
+                UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Operation %d is malformed"), __FUNCTION__, OpIndex);
+                return false;
+            }
+
+            const TSharedPtr<FJsonValue> Value = (*Operation)->TryGetField(TEXT("value"));
+            bool bSucceeded = false;
+
+            if (OpName == TEXT("add") || OpName == TEXT("replace"))
+            {
+                if (Value.IsValid() && Segments.IsEmpty())
+                {
+                    // 替换根节点等同于整个文档更新
+                    bSucceeded = Value->Type == EJson::Object;
+                    if (bSucceeded)
+                    {
+                        Editor.ReplaceDocument(Value->AsObject());
+                    }
+                }
+                else if (Value.IsValid())
+                {
+                    bSucceeded = ModifyValueAt(Editor, Segments, OpName == TEXT("add") ? EInnerOp::Add : EInnerOp::Replace, Value);
+                }
+            }
+            else if (OpName == TEXT("remove"))
+            {
+                bSucceeded = ModifyValueAt(Editor, Segments, EInnerOp::Remove, nullptr);
+            }
+            else if (OpName == TEXT("move") || OpName == TEXT("copy"))
+            {
+                FString FromPointer;
+                TArray<FString> FromSegments;
+                TSharedPtr<FJsonValue> FromValue;
+                if ((*Operation)->TryGetStringField(TEXT("from"), FromPointer) && ParseJsonPointer(FromPointer, FromSegments)
+                    && GetValueAt(Editor, FromSegments, FromValue))
+                {
+                    if (OpName == TEXT("copy"))
+                    {
+                        bSucceeded = ModifyValueAt(Editor, Segments, EInnerOp::Add, FromValue);
+                    }
+                    else if (!(PathPointer.StartsWith(FromPointer + TEXT("/"), ESearchCase::CaseSensitive)))
+                    {
+                        // move 的目标不能位于源节点内部
+                        bSucceeded = ModifyValueAt(Editor, FromSegments, EInnerOp::Remove, nullptr)
+                            && ModifyValueAt(Editor, Segments, EInnerOp::Add, FromValue);
+                    }
+                }
+            }
+            else if (OpName == TEXT("test"))
+            {
+                bSucceeded = Value.IsValid() && TestValueAt(Editor, Segments, Value);
+            }
+
+            if (!bSucceeded)
+            {
+                UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Operation %d [ %s %s ] failed"), __FUNCTION__, OpIndex, *OpName, *PathPointer);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** 应用 RFC 7386 合并补丁（父节点为根或对象节点） */
+    void ApplyMergePatchObject(FFlatDocumentEditor& Editor, const TArray<FString>& ParentSegments, const TSharedPtr<FJsonObject>& PatchObject)
+    {
+        FJsonDataStruct Storage;
+        for (const auto& Elem : PatchObject->Values)
+        {
+            const TSharedPtr<FJsonValue>& PatchValue = Elem.Value;
+            if (!PatchValue.IsValid() || PatchValue->Type == EJson::None)
+            {
+                continue;
+            }
+
+            TArray<FString> ChildSegments = ParentSegments;
+            ChildSegments.Add(Elem.Key);
+
+            if (PatchValue->Type == EJson::Null)
+            {
+                Editor.RemoveSubtree(ChildSegments);
+            }
+            else if (PatchValue->Type == EJson::Object && JsonDataHelper::IsObjectEntry(Editor.Find(Editor.JoinPath(ChildSegments), Storage)))
+            {
+                ApplyMergePatchObject(Editor, ChildSegments, PatchValue->AsObject());
+            }
+            else
+            {
+                Editor.SetSubtree(ChildSegments, StripMergePatchNulls(PatchValue));
+            }
+        }
+    }
+}
+
+// ============================================================================
+// C++ 接口实现
+// ============================================================================
+bool JsonPatchHelper::ApplyDocument(TMap<FString, FJsonDataStruct>& InOutMap, const FString& NewJsonStr, TArray<FString>& OutChangedPaths)
+{
+    FParsedData ParsedData;
+    ParsedData.ParsedDataMap = MoveTemp(InOutMap);
+    const bool bSucceeded = ApplyDocument(ParsedData, NewJsonStr, OutChangedPaths);
+    InOutMap = MoveTemp(ParsedData.ParsedDataMap);
+    return bSucceeded;
+}
+
+bool JsonPatchHelper::ApplyDocument(FParsedData& InOutParsedData, const FString& NewJsonStr, TArray<FString>& OutChangedPaths)
+{
+    OutChangedPaths.Reset();
+
+    TSharedPtr<FJsonObject> JsonObject;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(NewJsonStr);
+    if (NewJsonStr.IsEmpty() || !FJsonSerializer::Deserialize(Reader, JsonObject, FJsonSerializer::EFlags::StoreNumbersAsStrings) || !JsonObject.IsValid())
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Deserialize Failed, JsonString is invalid"), __FUNCTION__);
+        return false;
+    }
+
+    FFlatDocumentEditor Editor(InOutParsedData);
+    Editor.ReplaceDocument(JsonObject);
+    Editor.Commit(OutChangedPaths);
+    return true;
+}
+
+bool JsonPatchHelper::ApplyPatch(TMap<FString, FJsonDataStruct>& InOutMap, const FString& PatchStr, const EJsonPatchFormat Format, TArray<FString>& OutChangedPaths)
+{
+    FParsedData ParsedData;
+    ParsedData.ParsedDataMap = MoveTemp(InOutMap);
+    const bool bSucceeded = ApplyPatch(ParsedData, PatchStr, Format, OutChangedPaths);
+    InOutMap = MoveTemp(ParsedData.ParsedDataMap);
+    return bSucceeded;
+}
+
+bool JsonPatchHelper::ApplyPatch(FParsedData& InOutParsedData, const FString& PatchStr, EJsonPatchFormat Format, TArray<FString>& OutChangedPaths)
+{
+    OutChangedPaths.Reset();
+
+    const TSharedPtr<FJsonValue> PatchValue = PatchStr.IsEmpty() ? nullptr : ParseJsonText(PatchStr);
+    if (!PatchValue.IsValid())
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Deserialize Failed, PatchString is invalid"), __FUNCTION__);
+        return false;
+    }
+
+    if (Format == EJsonPatchFormat::Auto)
+    {
+        Format = PatchValue->Type == EJson::Array ? EJsonPatchFormat::JsonPatch : EJsonPatchFormat::MergePatch;
+    }
+
+    FFlatDocumentEditor Editor(InOutParsedData);
+    bool bSucceeded = false;
+
+    if (Format == EJsonPatchFormat::JsonPatch)
+    {
+        bSucceeded = PatchValue->Type == EJson::Array && ApplyJsonPatchOperations(Editor, PatchValue->AsArray());
+    }
+    else if (PatchValue->Type == EJson::Object)
+    {
+        ApplyMergePatchObject(Editor, {}, PatchValue->AsObject());
+        bSucceeded = true;
+    }
+    else
+    {
+        // 非对象的合并补丁会替换整个文档，而文档根节点必须是对象
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Merge patch root must be an object"), __FUNCTION__);
+    }
+
+    if (!bSucceeded)
+    {
+        Editor.Rollback();
+        return false;
+    }
+
+    Editor.Commit(OutChangedPaths);
+    return true;
+}
+
+// ============================================================================
+// 蓝图接口实现
+// ============================================================================
+void UJsonPatchLibrary::ApplyJsonDocument(FParsedData& ParsedData, const FString& NewJsonStr, TArray<FString>& ChangedPaths, bool& bIsValid)
+{
+    bIsValid = JsonPatchHelper::ApplyDocument(ParsedData, NewJsonStr, ChangedPaths);
+    JsonPathIndexHelper::UpdateIndex(ParsedData, ChangedPaths);
+}
+
+void UJsonPatchLibrary::ApplyJsonPatch(FParsedData& ParsedData, const FString& PatchStr, EJsonPatchFormat Format, TArray<FString>& ChangedPaths, bool& bIsValid)
+{
+    bIsValid = JsonPatchHelper::ApplyPatch(ParsedData, PatchStr, Format, ChangedPaths);
+    JsonPathIndexHelper::UpdateIndex(ParsedData, ChangedPaths);
+}
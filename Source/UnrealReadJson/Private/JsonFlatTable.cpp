@@ -0,0 +1,470 @@
+﻿#include "JsonFlatTable.h"
+#include "JsonLazyString.h"
+#include "Hash/CityHash.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define READJSON_FLAT_TABLE_SSE2 1
+#else
+#define READJSON_FLAT_TABLE_SSE2 0
+#endif
+
+namespace
+{
+    /** 空槽位；已占用槽位的控制字节为哈希的 7 位，最高位为0 */
+    constexpr uint8 EmptyControl = 0x80;
+
+    /** 最大负载 7/8 */
+    FORCEINLINE int32 MaxLoad(const int32 Capacity)
+    {
+        return Capacity - Capacity / 8;
+    }
+
+    /** 打散哈希：高位用于槽位，另取 7 位作为控制字节 */
+    FORCEINLINE uint64 MixHash(const uint32 Hash)
+    {
+        return static_cast<uint64>(Hash) * 0x9E3779B97F4A7C15ull;
+    }
+
+    FORCEINLINE uint32 SlotHash(const uint64 Mixed)
+    {
+        return static_cast<uint32>(Mixed >> 32);
+    }
+
+    FORCEINLINE uint8 ControlHash(const uint64 Mixed)
+    {
+        return static_cast<uint8>((Mixed >> 25) & 0x7F);
+    }
+
+    /** 已写入 StringValue 的延迟记录字符串：标记为普通字符串 */
+    FORCEINLINE FJsonDataStruct& MarkLazyString(FJsonDataStruct& Storage)
+    {
+        Storage.ValueType = EValueType::String;
+        Storage.ContainerKind = EJsonContainerKind::None;
+        return Storage;
+    }
+
+    /** 修改前取得独占的数据表（拷贝 FParsedData 时共享） */
+    FJsonFlatTable& GetUniqueTable(TSharedPtr<FJsonFlatTable>& Table)
+    {
+        if (!Table.IsUnique())
+        {
+            Table = MakeShared<FJsonFlatTable>(*Table);
+        }
+        return *Table;
+    }
+
+    /** 删除延迟记录的字符串，记录被共享时先复制 */
+    bool RemoveLazyString(TSharedPtr<FJsonLazyStrings>& LazyStrings, const FString& NodePath)
+    {
+        if (!LazyStrings.IsValid() || !LazyStrings->Find(NodePath))
+        {
+            return false;
+        }
+        if (!LazyStrings.IsUnique())
+        {
+            LazyStrings = LazyStrings->Clone();
+        }
+        return LazyStrings->Remove(NodePath);
+    }
+
+#if READJSON_FLAT_TABLE_SSE2
+    constexpr int32 GroupWidth = 16;
+
+    /** 一组 16 个控制字节，匹配结果的第 i 位对应第 i 个槽位 */
+    struct FControlGroup
+    {
+        __m128i Controls;
+
+        explicit FControlGroup(const uint8* Data)
+            : Controls(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Data)))
+        {
+        }
+
+        FORCEINLINE uint32 Match(const uint8 Hash) const
+        {
+            return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(Controls, _mm_set1_epi8(static_cast<char>(Hash)))));
+        }
+
+        FORCEINLINE uint32 MatchEmpty() const
+        {
+            return static_cast<uint32>(_mm_movemask_epi8(Controls));
+        }
+
+        static FORCEINLINE int32 LowestIndex(const uint32 Mask)
+        {
+            return static_cast<int32>(FMath::CountTrailingZeros(Mask));
+        }
+    };
+
+    using FMatchMask = uint32;
+#else
+    constexpr int32 GroupWidth = 8;
+
+    /** 一组 8 个控制字节（SWAR），匹配结果中第 i 个字节的最高位对应第 i 个槽位 */
+    struct FControlGroup
+    {
+        uint64 Controls;
+
+        explicit FControlGroup(const uint8* Data)
+        {
+            FMemory::Memcpy(&Controls, Data, sizeof(Controls));
+        }
+
+        /** 可能包含误报（之后会比较完整哈希），不会漏报 */
+        FORCEINLINE uint64 Match(const uint8 Hash) const
+        {
+            const uint64 Diff = Controls ^ (0x0101010101010101ull * Hash);
+            return (Diff - 0x0101010101010101ull) & ~Diff & 0x8080808080808080ull;
+        }
+
+        FORCEINLINE uint64 MatchEmpty() const
+        {
+            return Controls & 0x8080808080808080ull;
+        }
+
+        static FORCEINLINE int32 LowestIndex(const uint64 Mask)
+        {
+            return static_cast<int32>(FMath::CountTrailingZeros64(Mask) >> 3);
+        }
+    };
+
+    using FMatchMask = uint64;
+#endif
+}
+
+// ============================================================================
+// 构建与转换
+// ============================================================================
+FJsonFlatTable::FJsonFlatTable(const TMap<FString, FJsonDataStruct>& Map)
+{
+    Reserve(Map.Num());
+    for (const TPair<FString, FJsonDataStruct>& Pair : Map)
+    {
+        Add(Pair.Key, Pair.Value);
+    }
+}
+
+FJsonFlatTable::FJsonFlatTable(TMap<FString, FJsonDataStruct>&& Map)
+{
+    Reserve(Map.Num());
+    for (TPair<FString, FJsonDataStruct>& Pair : Map)
+    {
+        Add(MoveTemp(Pair.Key), MoveTemp(Pair.Value));
+    }
+    Map.Empty();
+}
+
+FJsonFlatTable FJsonFlatTable::FromParsedData(const FParsedData& ParsedData)
+{
+    const int32 NumLazy = ParsedData.LazyStrings.IsValid() ? ParsedData.LazyStrings->Num() : 0;
+    if (ParsedData.FlatEntries.IsValid() && NumLazy == 0)
+    {
+        return *ParsedData.FlatEntries;
+    }
+
+    FJsonFlatTable Table(ParsedData.FlatEntries.IsValid() ? ParsedData.FlatEntries->GetKeyPolicy() : EJsonKeyPolicy::Default);
+    Table.Reserve(ParsedData.NumEntries() + NumLazy);
+    ParsedData.ForEachPath([&Table](const FString& NodePath, const FJsonDataStruct* Entry)
+    {
+        if (Entry)
+        {
+            Table.Add(NodePath, *Entry);
+        }
+    });
+    if (NumLazy > 0)
+    {
+        TMap<FString, FJsonDataStruct> LazyEntries;
+        ParsedData.LazyStrings->MaterializeTo(LazyEntries);
+        for (TPair<FString, FJsonDataStruct>& Pair : LazyEntries)
+        {
+            Table.Add(MoveTemp(Pair.Key), MoveTemp(Pair.Value));
+        }
+    }
+    return Table;
+}
+
+void FJsonFlatTable::ToParsedData(FParsedData& OutParsedData) const
+{
+    OutParsedData = {};
+    if (IsCaseSensitive())
+    {
+        // ParsedDataMap 不区分大小写，会合并仅大小写不同的路径
+        OutParsedData.FlatEntries = MakeShared<FJsonFlatTable>(*this);
+        return;
+    }
+    OutParsedData.ParsedDataMap.Reserve(Entries.Num());
+    for (const FEntry& Entry : Entries)
+    {
+        OutParsedData.ParsedDataMap.Add(Entry.Key, Entry.Value);
+    }
+}
+
+void FJsonFlatTable::Reset(const int32 ExpectedNum)
+{
+    Entries.Reset();
+    Controls.Reset();
+    SlotEntries.Reset();
+    Reserve(ExpectedNum);
+}
+
+void FJsonFlatTable::Reserve(const int32 Number)
+{
+    Entries.Reserve(Number);
+
+    int32 NewCapacity = FMath::Max(SlotEntries.Num(), GroupWidth);
+    while (MaxLoad(NewCapacity) < Number)
+    {
+        NewCapacity *= 2;
+    }
+    if (NewCapacity != SlotEntries.Num())
+    {
+        Rehash(NewCapacity);
+    }
+}
+
+// ============================================================================
+// 添加与查找
+// ============================================================================
+uint32 FJsonFlatTable::HashKey(const FStringView Key, const EJsonKeyPolicy KeyPolicy)
+{
+    if (KeyPolicy == EJsonKeyPolicy::CaseSensitive)
+    {
+        // 区分大小写时直接按字节计算，不逐字符转换大小写
+        return CityHash32(reinterpret_cast<const char*>(Key.GetData()), static_cast<uint32>(Key.Len() * sizeof(TCHAR)));
+    }
+    return FCrc::Strihash_DEPRECATED(Key.Len(), Key.GetData());
+}
+
+FJsonDataStruct& FJsonFlatTable::AddByHash(const uint32 Hash, FString Key, FJsonDataStruct Value)
+{
+    const int32 Existing = FindEntryIndex(Hash, Key);
+    if (Existing != INDEX_NONE)
+    {
+        Entries[Existing].Value = MoveTemp(Value);
+        return Entries[Existing].Value;
+    }
+
+    if (Entries.Num() + 1 > MaxLoad(SlotEntries.Num()))
+    {
+        Rehash(FMath::Max(SlotEntries.Num() * 2, GroupWidth));
+    }
+
+    const int32 EntryIndex = Entries.Num();
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Key = MoveTemp(Key);
+    Entry.Value = MoveTemp(Value);
+    Entry.Hash = Hash;
+    InsertSlot(Hash, EntryIndex);
+    return Entry.Value;
+}
+
+bool FJsonFlatTable::Remove(const FStringView Key)
+{
+    const int32 EntryIndex = FindEntryIndex(HashKey(Key), Key);
+    if (EntryIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // 没有墓碑标记，删除后按保存的哈希重建哈希表，保持其余条目的插入顺序
+    Entries.RemoveAt(EntryIndex);
+    Rehash(SlotEntries.Num());
+    return true;
+}
+
+const FJsonDataStruct* FJsonFlatTable::FindByHash(const uint32 Hash, const FStringView Key) const
+{
+    const int32 EntryIndex = FindEntryIndex(Hash, Key);
+    return EntryIndex != INDEX_NONE ? &Entries[EntryIndex].Value : nullptr;
+}
+
+int32 FJsonFlatTable::FindEntryIndex(const uint32 Hash, const FStringView Key) const
+{
+    const int32 Capacity = SlotEntries.Num();
+    if (Capacity == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    const uint64 Mixed = MixHash(Hash);
+    const uint8 Control = ControlHash(Mixed);
+    const int32 Mask = Capacity - 1;
+    const uint8* ControlData = Controls.GetData();
+
+    // 按组做三角数探测，槽位数量为2的幂时可以遍历所有组
+    int32 GroupStart = static_cast<int32>(SlotHash(Mixed)) & Mask;
+    for (int32 Step = GroupWidth; ; Step += GroupWidth)
+    {
+        const FControlGroup Group(ControlData + GroupStart);
+        for (FMatchMask Matches = Group.Match(Control); Matches; Matches &= Matches - 1)
+        {
+            const int32 Slot = (GroupStart + FControlGroup::LowestIndex(Matches)) & Mask;
+            const FEntry& Entry = Entries[SlotEntries[Slot]];
+            if (Entry.Hash == Hash && KeysEqual(Entry.Key, Key))
+            {
+                return SlotEntries[Slot];
+            }
+        }
+        if (Group.MatchEmpty())
+        {
+            return INDEX_NONE;
+        }
+        GroupStart = (GroupStart + Step) & Mask;
+    }
+}
+
+void FJsonFlatTable::InsertSlot(const uint32 Hash, const int32 EntryIndex)
+{
+    const uint64 Mixed = MixHash(Hash);
+    const int32 Mask = SlotEntries.Num() - 1;
+
+    int32 GroupStart = static_cast<int32>(SlotHash(Mixed)) & Mask;
+    for (int32 Step = GroupWidth; ; Step += GroupWidth)
+    {
+        const FMatchMask Empty = FControlGroup(Controls.GetData() + GroupStart).MatchEmpty();
+        if (Empty)
+        {
+            const int32 Slot = (GroupStart + FControlGroup::LowestIndex(Empty)) & Mask;
+            SetControl(Slot, ControlHash(Mixed));
+            SlotEntries[Slot] = EntryIndex;
+            return;
+        }
+        GroupStart = (GroupStart + Step) & Mask;
+    }
+}
+
+void FJsonFlatTable::Rehash(const int32 NewCapacity)
+{
+    Controls.Init(EmptyControl, NewCapacity + GroupWidth);
+    SlotEntries.Init(INDEX_NONE, NewCapacity);
+
+    // 使用保存的哈希，不重新计算字符串哈希
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+    {
+        InsertSlot(Entries[EntryIndex].Hash, EntryIndex);
+    }
+}
+
+void FJsonFlatTable::SetControl(const int32 Slot, const uint8 Control)
+{
+    Controls[Slot] = Control;
+    if (Slot < GroupWidth)
+    {
+        Controls[SlotEntries.Num() + Slot] = Control;
+    }
+}
+
+// ============================================================================
+// FParsedData
+// ============================================================================
+bool FParsedData::IsCaseSensitive() const
+{
+    return FlatEntries.IsValid() && FlatEntries->IsCaseSensitive();
+}
+
+const FJsonDataStruct* FParsedData::FindEntry(const FString& NodePath) const
+{
+    return FlatEntries.IsValid() ? FlatEntries->Find(NodePath) : ParsedDataMap.Find(NodePath);
+}
+
+int32 FParsedData::NumEntries() const
+{
+    return FlatEntries.IsValid() ? FlatEntries->Num() : ParsedDataMap.Num();
+}
+
+const FJsonDataStruct* FParsedData::FindValue(const FString& NodePath, FJsonDataStruct& Storage) const
+{
+    if (const FJsonDataStruct* Entry = FindEntry(NodePath))
+    {
+        return Entry;
+    }
+    return LazyStrings.IsValid() && LazyStrings->GetString(NodePath, Storage.StringValue)
+        ? &MarkLazyString(Storage)
+        : nullptr;
+}
+
+const FJsonDataStruct* FParsedData::FindValueByHash(const uint32 Hash, const FString& NodePath, FJsonDataStruct& Storage) const
+{
+    // 不区分大小写的数据表与 ParsedDataMap 的哈希相同，区分大小写的数据表使用自己的哈希
+    const FJsonDataStruct* Entry = nullptr;
+    if (FlatEntries.IsValid())
+    {
+        Entry = FlatEntries->IsCaseSensitive() ? FlatEntries->Find(NodePath) : FlatEntries->FindByHash(Hash, NodePath);
+    }
+    else
+    {
+        Entry = ParsedDataMap.FindByHash(Hash, NodePath);
+    }
+    if (Entry)
+    {
+        return Entry;
+    }
+    return LazyStrings.IsValid() && LazyStrings->GetStringByHash(Hash, NodePath, Storage.StringValue)
+        ? &MarkLazyString(Storage)
+        : nullptr;
+}
+
+bool FParsedData::GetValue(const FString& NodePath, FJsonDataStruct& OutValue) const
+{
+    const FJsonDataStruct* Value = FindValue(NodePath, OutValue);
+    if (Value && Value != &OutValue)
+    {
+        OutValue = *Value;
+    }
+    return Value != nullptr;
+}
+
+bool FParsedData::ContainsPath(const FString& NodePath) const
+{
+    return FindEntry(NodePath) || (LazyStrings.IsValid() && LazyStrings->Find(NodePath));
+}
+
+int32 FParsedData::NumPaths() const
+{
+    return NumEntries() + (LazyStrings.IsValid() ? LazyStrings->Num() : 0);
+}
+
+void FParsedData::ForEachPath(const TFunctionRef<void(const FString& NodePath, const FJsonDataStruct* Entry)> Function) const
+{
+    if (FlatEntries.IsValid())
+    {
+        for (const FJsonFlatTable::FEntry& Entry : FlatEntries->GetEntries())
+        {
+            Function(Entry.Key, &Entry.Value);
+        }
+    }
+    else
+    {
+        for (const TPair<FString, FJsonDataStruct>& Pair : ParsedDataMap)
+        {
+            Function(Pair.Key, &Pair.Value);
+        }
+    }
+    if (LazyStrings.IsValid())
+    {
+        LazyStrings->ForEachSpan([&Function](const FString& Path, const FJsonSourceSpan&)
+        {
+            Function(Path, nullptr);
+        });
+    }
+}
+
+FJsonDataStruct& FParsedData::SetEntry(const FString& NodePath, FJsonDataStruct Value)
+{
+    ++Generation;
+    RemoveLazyString(LazyStrings, NodePath);
+    return FlatEntries.IsValid()
+        ? GetUniqueTable(FlatEntries).Add(NodePath, MoveTemp(Value))
+        : ParsedDataMap.Add(NodePath, MoveTemp(Value));
+}
+
+bool FParsedData::RemoveEntry(const FString& NodePath)
+{
+    ++Generation;
+    const bool bRemovedLazy = RemoveLazyString(LazyStrings, NodePath);
+    const bool bRemoved = FlatEntries.IsValid()
+        ? FlatEntries->Find(NodePath) && GetUniqueTable(FlatEntries).Remove(NodePath)
+        : ParsedDataMap.Remove(NodePath) > 0;
+    return bRemoved || bRemovedLazy;
+}
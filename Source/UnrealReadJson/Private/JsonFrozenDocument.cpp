@@ -0,0 +1,295 @@
+﻿#include "JsonFrozenDocument.h"
+#include "JsonFlatTable.h"
+#include "JsonLazyString.h"
+#include "Hash/CityHash.h"
+
+namespace
+{
+    /** 平均每个桶的键数量，越大位移表越小、冻结越慢 */
+    constexpr int32 KeysPerBucket = 4;
+
+    /** 每个桶尝试的种子上限，超过后放弃（实际远小于该值） */
+    constexpr int32 MaxSeed = 1 << 24;
+
+    /** 不区分大小写的 64 位 FNV-1a */
+    uint64 HashPathIgnoreCase(const FStringView Key)
+    {
+        uint64 Hash = 0xCBF29CE484222325ull;
+        for (const TCHAR Char : Key)
+        {
+            Hash = (Hash ^ static_cast<uint64>(TChar<TCHAR>::ToLower(Char))) * 0x100000001B3ull;
+        }
+        return Hash;
+    }
+
+    /** splitmix64 的混合函数 */
+    FORCEINLINE uint64 Mix(uint64 Value)
+    {
+        Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+        return Value ^ (Value >> 31);
+    }
+
+    /** 将 32 位值均匀映射到 [0, Range)，不使用除法 */
+    FORCEINLINE int32 Reduce(const uint32 Value, const int32 Range)
+    {
+        return static_cast<int32>((static_cast<uint64>(Value) * static_cast<uint64>(Range)) >> 32);
+    }
+
+    FORCEINLINE int32 BucketOf(const uint64 Hash, const int32 NumBuckets)
+    {
+        return Reduce(static_cast<uint32>(Hash >> 32), NumBuckets);
+    }
+
+    FORCEINLINE int32 SlotOf(const uint64 Hash, const int32 Seed, const int32 NumSlots)
+    {
+        return Reduce(static_cast<uint32>(Mix(Hash + static_cast<uint64>(Seed) * 0x9E3779B97F4A7C15ull)), NumSlots);
+    }
+}
+
+// ============================================================================
+// 冻结
+// ============================================================================
+bool FJsonFrozenDocument::Freeze(const FParsedData& ParsedData)
+{
+    TMap<FString, FJsonDataStruct> LazyEntries;
+    if (ParsedData.LazyStrings.IsValid())
+    {
+        ParsedData.LazyStrings->MaterializeTo(LazyEntries);
+    }
+
+    TArray<FPendingEntry> Pending;
+    Pending.Reserve(ParsedData.NumEntries() + LazyEntries.Num());
+    ParsedData.ForEachPath([&Pending](const FString& NodePath, const FJsonDataStruct* Entry)
+    {
+        if (Entry)
+        {
+            Pending.Add({ FStringView(NodePath), Entry });
+        }
+    });
+    for (const TPair<FString, FJsonDataStruct>& Pair : LazyEntries)
+    {
+        Pending.Add({ FStringView(Pair.Key), &Pair.Value });
+    }
+    return Build(Pending, ParsedData.IsCaseSensitive());
+}
+
+bool FJsonFrozenDocument::Freeze(const FJsonFlatTable& Table)
+{
+    TArray<FPendingEntry> Pending;
+    Pending.Reserve(Table.Num());
+    for (const FJsonFlatTable::FEntry& Entry : Table.GetEntries())
+    {
+        Pending.Add({ FStringView(Entry.Key), &Entry.Value });
+    }
+    return Build(Pending, Table.IsCaseSensitive());
+}
+
+bool FJsonFrozenDocument::Freeze(const TMap<FString, FJsonDataStruct>& Map)
+{
+    TArray<FPendingEntry> Pending;
+    Pending.Reserve(Map.Num());
+    for (const TPair<FString, FJsonDataStruct>& Pair : Map)
+    {
+        Pending.Add({ FStringView(Pair.Key), &Pair.Value });
+    }
+    return Build(Pending, false);
+}
+
+void FJsonFrozenDocument::ToParsedData(FParsedData& OutParsedData) const
+{
+    OutParsedData = {};
+    if (bCaseSensitive)
+    {
+        const TSharedRef<FJsonFlatTable> Table = MakeShared<FJsonFlatTable>(EJsonKeyPolicy::CaseSensitive);
+        Table->Reserve(Values.Num());
+        for (int32 Index = 0; Index < Values.Num(); ++Index)
+        {
+            Table->Add(FString(GetKey(Index)), Values[Index]);
+        }
+        OutParsedData.FlatEntries = Table;
+        return;
+    }
+
+    OutParsedData.ParsedDataMap.Reserve(Values.Num());
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        OutParsedData.ParsedDataMap.Add(FString(GetKey(Index)), Values[Index]);
+    }
+}
+
+void FJsonFrozenDocument::Reset()
+{
+    KeyChars.Empty();
+    KeyOffsets.Empty();
+    Values.Empty();
+    Displacements.Empty();
+    bCaseSensitive = false;
+}
+
+uint64 FJsonFrozenDocument::HashPath(const FStringView Key) const
+{
+    // 区分大小写时直接按字节计算
+    return bCaseSensitive
+        ? CityHash64(reinterpret_cast<const char*>(Key.GetData()), static_cast<uint32>(Key.Len() * sizeof(TCHAR)))
+        : HashPathIgnoreCase(Key);
+}
+
+bool FJsonFrozenDocument::Build(TArray<FPendingEntry>& Pending, const bool bInCaseSensitive)
+{
+    Reset();
+    bCaseSensitive = bInCaseSensitive;
+
+    const int32 NumKeys = Pending.Num();
+    if (NumKeys == 0)
+    {
+        return true;
+    }
+
+    int32 NumChars = 0;
+    for (FPendingEntry& Entry : Pending)
+    {
+        Entry.Hash = HashPath(Entry.Key);
+        NumChars += Entry.Key.Len();
+    }
+
+    // 按桶分组（计数排序），桶内键的哈希必须互不相同
+    const int32 NumBuckets = FMath::Max(1, (NumKeys + KeysPerBucket - 1) / KeysPerBucket);
+    TArray<int32> BucketStarts;
+    BucketStarts.SetNumZeroed(NumBuckets + 1);
+    for (const FPendingEntry& Entry : Pending)
+    {
+        ++BucketStarts[BucketOf(Entry.Hash, NumBuckets) + 1];
+    }
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        BucketStarts[Bucket + 1] += BucketStarts[Bucket];
+    }
+    TArray<int32> BucketKeys;
+    BucketKeys.SetNumUninitialized(NumKeys);
+    {
+        TArray<int32> Cursors(BucketStarts.GetData(), NumBuckets);
+        for (int32 KeyIndex = 0; KeyIndex < NumKeys; ++KeyIndex)
+        {
+            BucketKeys[Cursors[BucketOf(Pending[KeyIndex].Hash, NumBuckets)]++] = KeyIndex;
+        }
+    }
+
+    // 键多的桶先放置，此时空槽位多，容易找到种子
+    TArray<int32> BucketOrder;
+    BucketOrder.Reserve(NumBuckets);
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        if (BucketStarts[Bucket + 1] > BucketStarts[Bucket])
+        {
+            BucketOrder.Add(Bucket);
+        }
+    }
+    BucketOrder.StableSort([&BucketStarts](const int32 A, const int32 B)
+    {
+        return BucketStarts[A + 1] - BucketStarts[A] > BucketStarts[B + 1] - BucketStarts[B];
+    });
+
+    Displacements.SetNumZeroed(NumBuckets);
+    TArray<int32> KeySlots;
+    KeySlots.SetNumUninitialized(NumKeys);
+    TBitArray<> Occupied(false, NumKeys);
+    TArray<int32, TInlineAllocator<32>> Candidate;
+    int32 NextFreeSlot = 0;
+
+    for (const int32 Bucket : BucketOrder)
+    {
+        const int32 First = BucketStarts[Bucket];
+        const int32 Count = BucketStarts[Bucket + 1] - First;
+
+        // 只有一个键的桶直接放入下一个空槽位，不需要搜索种子
+        if (Count == 1)
+        {
+            while (Occupied[NextFreeSlot])
+            {
+                ++NextFreeSlot;
+            }
+            Occupied[NextFreeSlot] = true;
+            KeySlots[BucketKeys[First]] = NextFreeSlot;
+            Displacements[Bucket] = -(NextFreeSlot + 1);
+            continue;
+        }
+
+        bool bPlaced = false;
+        for (int32 Seed = 1; Seed < MaxSeed && !bPlaced; ++Seed)
+        {
+            Candidate.Reset();
+            bPlaced = true;
+            for (int32 Offset = 0; Offset < Count; ++Offset)
+            {
+                const int32 Slot = SlotOf(Pending[BucketKeys[First + Offset]].Hash, Seed, NumKeys);
+                if (Occupied[Slot] || Candidate.Contains(Slot))
+                {
+                    bPlaced = false;
+                    break;
+                }
+                Candidate.Add(Slot);
+            }
+            if (bPlaced)
+            {
+                for (int32 Offset = 0; Offset < Count; ++Offset)
+                {
+                    Occupied[Candidate[Offset]] = true;
+                    KeySlots[BucketKeys[First + Offset]] = Candidate[Offset];
+                }
+                Displacements[Bucket] = Seed;
+            }
+        }
+
+        if (!bPlaced)
+        {
+            // 同一个桶内存在哈希完全相同的两个路径
+            UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to place %d paths (first: %s)"), __FUNCTION__, Count,
+                *FString(Pending[BucketKeys[First]].Key));
+            Reset();
+            return false;
+        }
+    }
+
+    // 按槽位连续存放键与值
+    TArray<int32> SlotKeys;
+    SlotKeys.SetNumUninitialized(NumKeys);
+    for (int32 KeyIndex = 0; KeyIndex < NumKeys; ++KeyIndex)
+    {
+        SlotKeys[KeySlots[KeyIndex]] = KeyIndex;
+    }
+
+    KeyChars.Reserve(NumChars);
+    KeyOffsets.Reserve(NumKeys + 1);
+    Values.Reserve(NumKeys);
+    for (const int32 KeyIndex : SlotKeys)
+    {
+        const FPendingEntry& Entry = Pending[KeyIndex];
+        KeyOffsets.Add(KeyChars.Num());
+        KeyChars.Append(Entry.Key.GetData(), Entry.Key.Len());
+        Values.Add(*Entry.Value);
+    }
+    KeyOffsets.Add(KeyChars.Num());
+    return true;
+}
+
+// ============================================================================
+// 查找
+// ============================================================================
+const FJsonDataStruct* FJsonFrozenDocument::Find(const FStringView Key) const
+{
+    if (Values.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    const uint64 Hash = HashPath(Key);
+    const int32 Displacement = Displacements[BucketOf(Hash, Displacements.Num())];
+    if (Displacement == 0)
+    {
+        return nullptr;
+    }
+
+    const int32 Slot = Displacement < 0 ? -Displacement - 1 : SlotOf(Hash, Displacement, Values.Num());
+    return GetKey(Slot).Equals(Key, bCaseSensitive ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase) ? &Values[Slot] : nullptr;
+}
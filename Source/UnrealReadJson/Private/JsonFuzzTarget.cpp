@@ -0,0 +1,42 @@
+﻿#include "JsonDifferential.h"
+
+/**
+ * libFuzzer 入口
+ * 默认不编译；在 Linux 上用 clang 构建带 -fsanitize=fuzzer 的程序目标，并定义 WITH_READJSON_LIBFUZZER=1 时启用
+ * 输入按 UTF-8 解码后交给 JsonDifferential::Run，其中的数值片段交给 JsonDifferential::CheckNumberLiteral，
+ * 任一引擎与参考实现不一致或数值解析与 FCString::Atod 不一致时以 Fatal 日志终止，libFuzzer 保存该输入
+ * 种子语料与字典见插件目录 Resources/Fuzz
+ */
+#ifndef WITH_READJSON_LIBFUZZER
+#define WITH_READJSON_LIBFUZZER 0
+#endif
+
+#if WITH_READJSON_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8* Data, const SIZE_T Size)
+{
+    const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data), static_cast<int32>(Size));
+    const FString JsonStr(Converter.Length(), Converter.Get());
+
+    // 模糊测试进程不一定启动任务图，不测试并行展开
+    FJsonDiffResult Result;
+    if (!JsonDifferential::Run(JsonStr, EJsonDiffEngines::All & ~EJsonDiffEngines::Parallel, Result))
+    {
+        UE_LOG(LogReadJson, Fatal, TEXT("[ %hs ] Parse engines disagree:\n%s"), __FUNCTION__, *FString::Join(Result.Messages, TEXT("\n")));
+    }
+
+    TArray<FString> NumberLiterals;
+    TArray<FString> Messages;
+    JsonDifferential::CollectNumberLiterals(JsonStr, NumberLiterals);
+    for (const FString& Literal : NumberLiterals)
+    {
+        JsonDifferential::CheckNumberLiteral(Literal, Messages);
+    }
+    if (Messages.Num() > 0)
+    {
+        UE_LOG(LogReadJson, Fatal, TEXT("[ %hs ] Number parsing disagrees with Atod:\n%s"), __FUNCTION__, *FString::Join(Messages, TEXT("\n")));
+    }
+    return 0;
+}
+
+#endif
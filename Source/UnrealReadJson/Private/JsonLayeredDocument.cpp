@@ -0,0 +1,330 @@
+﻿#include "JsonLayeredDocument.h"
+#include "JsonLazyString.h"
+#include "JsonParsedWriter.h"
+#include "JsonPath.h"
+
+namespace
+{
+    /** 没有任何条目的层不限制键比较方式与路径编码 */
+    FORCEINLINE bool IsEmptyLayer(const FParsedData& Layer)
+    {
+        return Layer.NumEntries() == 0 && !Layer.LazyStrings.IsValid();
+    }
+
+    /** 按层内顺序遍历条目与延迟记录的字符串，Function(Path, Hash)；Hash 按层的键比较方式计算 */
+    template <typename TFunction>
+    void ForEachLayerPath(const FParsedData& Layer, TFunction&& Function)
+    {
+        // 数据表保存的哈希与 FJsonLayeredDocument::HashPath 一致（不区分大小写时与 GetTypeHash 相同）
+        if (Layer.FlatEntries.IsValid())
+        {
+            for (const FJsonFlatTable::FEntry& Entry : Layer.FlatEntries->GetEntries())
+            {
+                Function(Entry.Key, Entry.Hash);
+            }
+        }
+        else
+        {
+            for (const TPair<FString, FJsonDataStruct>& Pair : Layer.ParsedDataMap)
+            {
+                Function(Pair.Key, GetTypeHash(Pair.Key));
+            }
+        }
+        if (Layer.LazyStrings.IsValid())
+        {
+            Layer.LazyStrings->ForEachSpan([&Function](const FString& Path, const FJsonSourceSpan&)
+            {
+                Function(Path, GetTypeHash(Path));
+            });
+        }
+    }
+}
+
+// ============================================================================
+// 层
+// ============================================================================
+bool FJsonLayeredDocument::PushLayer(const TSharedRef<const FParsedData>& Layer)
+{
+    if (!IsEmptyLayer(*Layer))
+    {
+        const bool bLayerCaseSensitive = Layer->IsCaseSensitive();
+        const bool bHasKeyFormat = Layers.ContainsByPredicate([](const TSharedRef<const FParsedData>& Existing)
+        {
+            return !IsEmptyLayer(*Existing);
+        });
+        if (!bHasKeyFormat)
+        {
+            bCaseSensitive = bLayerCaseSensitive;
+            bEscapedPaths = Layer->bEscapedPaths;
+            HiddenSubtrees = FJsonFlatTable(bCaseSensitive ? EJsonKeyPolicy::CaseSensitive : EJsonKeyPolicy::Default);
+        }
+        else if (bLayerCaseSensitive != bCaseSensitive || Layer->bEscapedPaths != bEscapedPaths)
+        {
+            UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Layer key policy or path encoding does not match existing layers"), __FUNCTION__);
+            return false;
+        }
+    }
+
+    Layers.Add(Layer);
+    AddHiddenSubtrees(Layers.Num() - 1);
+    return true;
+}
+
+bool FJsonLayeredDocument::RemoveLayer(const int32 LayerIndex)
+{
+    if (!Layers.IsValidIndex(LayerIndex))
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Invalid layer index [ %d ]"), __FUNCTION__, LayerIndex);
+        return false;
+    }
+
+    // 隐藏的子树与层下标相关，按剩余的层重新建立
+    TArray<TSharedRef<const FParsedData>> Remaining = MoveTemp(Layers);
+    Remaining.RemoveAt(LayerIndex);
+    Reset();
+    for (const TSharedRef<const FParsedData>& Layer : Remaining)
+    {
+        PushLayer(Layer);
+    }
+    return true;
+}
+
+void FJsonLayeredDocument::Reset()
+{
+    Layers.Reset();
+    bCaseSensitive = false;
+    bEscapedPaths = false;
+    HiddenSubtrees.Reset();
+}
+
+void FJsonLayeredDocument::AddHiddenSubtrees(const int32 LayerIndex)
+{
+    if (LayerIndex == 0)
+    {
+        return;
+    }
+
+    const FParsedData& Layer = *Layers[LayerIndex];
+    ForEachLayerPath(Layer, [this, &Layer, LayerIndex](const FString& Path, const uint32 Hash)
+    {
+        if (JsonDataHelper::IsObjectEntry(Layer.FindEntry(Path)))
+        {
+            return;
+        }
+        for (int32 LowerIndex = LayerIndex - 1; LowerIndex >= 0; --LowerIndex)
+        {
+            if (JsonDataHelper::IsObjectEntry(FindInLayer(LowerIndex, Hash, Path).Entry))
+            {
+                HiddenSubtrees.Add(Path, FJsonDataStruct::MakeInt(LayerIndex));
+                return;
+            }
+        }
+    });
+}
+
+// ============================================================================
+// 读取
+// ============================================================================
+const FJsonDataStruct* FJsonLayeredDocument::Find(const FString& NodePath) const
+{
+    // 与 FParsedData::FindEntry 一致：提供路径的层中是延迟字符串时视为不存在
+    FLayerHit Hit;
+    ResolveLayer(HashPath(NodePath), NodePath, Hit);
+    return Hit.Entry;
+}
+
+bool FJsonLayeredDocument::GetNodeData(const FString& NodePath, FJsonDataStruct& OutValue) const
+{
+    const uint32 Hash = HashPath(NodePath);
+    FLayerHit Hit;
+    const int32 LayerIndex = ResolveLayer(Hash, NodePath, Hit);
+    if (Hit.Entry)
+    {
+        OutValue = *Hit.Entry;
+        return true;
+    }
+
+    FString LazyValue;
+    if (Hit.bLazy && Layers[LayerIndex]->LazyStrings->GetStringByHash(Hash, NodePath, LazyValue))
+    {
+        OutValue = FJsonDataStruct::MakeString(LazyValue);
+        return true;
+    }
+    return false;
+}
+
+int32 FJsonLayeredDocument::FindLayerIndex(const FString& NodePath) const
+{
+    FLayerHit Hit;
+    return ResolveLayer(HashPath(NodePath), NodePath, Hit);
+}
+
+uint32 FJsonLayeredDocument::HashPath(const FString& NodePath) const
+{
+    // 区分大小写的层使用 FJsonFlatTable 的哈希，其余与 ParsedDataMap 及不区分大小写的数据表相同
+    return bCaseSensitive ? FJsonFlatTable::HashKey(NodePath, EJsonKeyPolicy::CaseSensitive) : GetTypeHash(NodePath);
+}
+
+FJsonLayeredDocument::FLayerHit FJsonLayeredDocument::FindInLayer(const int32 LayerIndex, const uint32 Hash, const FString& NodePath) const
+{
+    const FParsedData& Layer = *Layers[LayerIndex];
+    FLayerHit Hit;
+    Hit.Entry = Layer.FlatEntries.IsValid()
+        ? Layer.FlatEntries->FindByHash(Hash, NodePath)
+        : Layer.ParsedDataMap.FindByHash(Hash, NodePath);
+    Hit.bLazy = !Hit.Entry && Layer.LazyStrings.IsValid() && Layer.LazyStrings->FindByHash(Hash, NodePath);
+    return Hit;
+}
+
+int32 FJsonLayeredDocument::ResolveLayer(const uint32 Hash, const FString& NodePath, FLayerHit& OutHit) const
+{
+    const int32 Floor = GetVisibleFloor(NodePath);
+    for (int32 LayerIndex = Layers.Num() - 1; LayerIndex >= Floor; --LayerIndex)
+    {
+        OutHit = FindInLayer(LayerIndex, Hash, NodePath);
+        if (OutHit.IsFound())
+        {
+            return LayerIndex;
+        }
+    }
+    OutHit = {};
+    return INDEX_NONE;
+}
+
+int32 FJsonLayeredDocument::GetVisibleFloor(const FStringView NodePath) const
+{
+    if (HiddenSubtrees.Num() == 0)
+    {
+        return 0;
+    }
+
+    TArray<int32, TInlineAllocator<16>> Separators;
+    JsonPath::FindSeparators(NodePath, bEscapedPaths, Separators);
+    int32 Floor = 0;
+    for (const int32 Separator : Separators)
+    {
+        if (const FJsonDataStruct* HiddenBy = HiddenSubtrees.Find(NodePath.Left(Separator)))
+        {
+            Floor = FMath::Max(Floor, HiddenBy->IntValue);
+        }
+    }
+    return Floor;
+}
+
+// ============================================================================
+// 合并
+// ============================================================================
+void FJsonLayeredDocument::ToParsedData(FParsedData& OutParsedData) const
+{
+    if (Layers.Num() == 1)
+    {
+        OutParsedData = *Layers[0];
+        return;
+    }
+
+    OutParsedData = {};
+    OutParsedData.bEscapedPaths = bEscapedPaths;
+    int32 TotalEntries = 0;
+    for (const TSharedRef<const FParsedData>& Layer : Layers)
+    {
+        OutParsedData.KeyCollisions.Append(Layer->KeyCollisions);
+        TotalEntries += Layer->NumEntries() + (Layer->LazyStrings.IsValid() ? Layer->LazyStrings->Num() : 0);
+    }
+    if (bCaseSensitive)
+    {
+        OutParsedData.FlatEntries = MakeShared<FJsonFlatTable>(EJsonKeyPolicy::CaseSensitive);
+        OutParsedData.FlatEntries->Reserve(TotalEntries);
+    }
+    else
+    {
+        OutParsedData.ParsedDataMap.Reserve(TotalEntries);
+    }
+
+    // 按层从下到上遍历，路径第一次出现时写入提供该路径的层的值，保留下层的条目顺序
+    TArray<FString> ChangedPaths;
+    for (int32 LayerIndex = 0; LayerIndex < Layers.Num(); ++LayerIndex)
+    {
+        ForEachLayerPath(*Layers[LayerIndex], [this, &OutParsedData, &ChangedPaths](const FString& Path, const uint32 Hash)
+        {
+            const bool bAdded = OutParsedData.FlatEntries.IsValid()
+                ? OutParsedData.FlatEntries->FindByHash(Hash, Path) != nullptr
+                : OutParsedData.ParsedDataMap.FindByHash(Hash, Path) != nullptr;
+            if (bAdded)
+            {
+                return;
+            }
+
+            FLayerHit Hit;
+            const int32 SourceLayer = ResolveLayer(Hash, Path, Hit);
+            if (SourceLayer == INDEX_NONE)
+            {
+                return;
+            }
+
+            FJsonDataStruct Value;
+            if (Hit.Entry)
+            {
+                Value = *Hit.Entry;
+            }
+            else
+            {
+                FString LazyValue;
+                Layers[SourceLayer]->LazyStrings->GetStringByHash(Hash, Path, LazyValue);
+                Value = FJsonDataStruct::MakeString(LazyValue);
+            }
+
+            if (OutParsedData.FlatEntries.IsValid())
+            {
+                OutParsedData.FlatEntries->AddByHash(Hash, Path, MoveTemp(Value));
+            }
+            else
+            {
+                OutParsedData.ParsedDataMap.AddByHash(Hash, Path, MoveTemp(Value));
+            }
+            if (SourceLayer > 0)
+            {
+                ChangedPaths.Add(Path);
+            }
+        });
+    }
+
+    // 上层提供的路径所在的对象、以及上层的对象本身（保存的文本只含该层的子条目）按合并后的子条目重新生成
+    if (ChangedPaths.Num() > 0)
+    {
+        FJsonParsedWriter Writer;
+        Writer.RefreshObjectText(OutParsedData, ChangedPaths, true);
+    }
+}
+
+// ============================================================================
+// UJsonLayeredDocument
+// ============================================================================
+UJsonLayeredDocument* UJsonLayeredDocument::CreateLayeredDocument()
+{
+    return NewObject<UJsonLayeredDocument>();
+}
+
+void UJsonLayeredDocument::PushLayer(const FParsedData& Layer, bool& bIsValid)
+{
+    bIsValid = Document.PushLayer(MakeShared<FParsedData>(Layer));
+}
+
+void UJsonLayeredDocument::RemoveLayer(const int32 LayerIndex, bool& bIsValid)
+{
+    bIsValid = Document.RemoveLayer(LayerIndex);
+}
+
+void UJsonLayeredDocument::GetNodeData(const FString& NodePath, FJsonNode& NodeData, bool& bIsValid) const
+{
+    FJsonDataStruct Value;
+    bIsValid = Document.GetNodeData(NodePath, Value);
+    if (bIsValid)
+    {
+        NodeData = { NodePath, MoveTemp(Value) };
+    }
+}
+
+void UJsonLayeredDocument::ToParsedData(FParsedData& ParsedData) const
+{
+    Document.ToParsedData(ParsedData);
+}
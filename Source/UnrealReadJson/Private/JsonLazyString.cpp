@@ -0,0 +1,128 @@
+﻿#include "JsonLazyString.h"
+#include "JsonBase64.h"
+#include "JsonSourceFlattener.h"
+#include "Misc/ScopeRWLock.h"
+
+FJsonLazyStrings::FJsonLazyStrings(const TSharedRef<const FString>& InSource)
+    : Source(InSource)
+{
+}
+
+void FJsonLazyStrings::Add(FString&& Path, const FJsonSourceSpan& Span)
+{
+    SpanIndices.Add(MoveTemp(Path), Spans.Add(Span));
+    Unescaped.AddDefaulted();
+}
+
+void FJsonLazyStrings::Reserve(const int32 Number)
+{
+    SpanIndices.Reserve(Number);
+    Spans.Reserve(Number);
+    Unescaped.Reserve(Number);
+}
+
+bool FJsonLazyStrings::Remove(const FString& Path)
+{
+    // 区间与缓存保留在原下标，其余节点的下标不变
+    return SpanIndices.Remove(Path) > 0;
+}
+
+TSharedRef<FJsonLazyStrings> FJsonLazyStrings::Clone() const
+{
+    const TSharedRef<FJsonLazyStrings> Copy = MakeShared<FJsonLazyStrings>(Source);
+    Copy->SpanIndices = SpanIndices;
+    Copy->Spans = Spans;
+    Copy->Unescaped.SetNum(Spans.Num());
+    return Copy;
+}
+
+const FJsonSourceSpan* FJsonLazyStrings::Find(const FString& Path) const
+{
+    return FindByHash(GetTypeHash(Path), Path);
+}
+
+const FJsonSourceSpan* FJsonLazyStrings::FindByHash(const uint32 Hash, const FString& Path) const
+{
+    const int32* SpanIndex = SpanIndices.FindByHash(Hash, Path);
+    return SpanIndex ? &Spans[*SpanIndex] : nullptr;
+}
+
+FStringView FJsonLazyStrings::GetViewByIndex(const int32 SpanIndex) const
+{
+    const FJsonSourceSpan& Span = Spans[SpanIndex];
+    if (!Span.bHasEscapes)
+    {
+        return FStringView(**Source + Span.Offset, Span.Length);
+    }
+
+    {
+        FReadScopeLock Lock(UnescapedLock);
+        if (const FString* Cached = Unescaped[SpanIndex].Get())
+        {
+            return FStringView(**Cached, Cached->Len());
+        }
+    }
+
+    // 在锁外反转义，写入时若其他线程已先写入则使用已有结果
+    FString Value;
+    // 转义已在扫描时校验
+    FJsonSourceFlattener::Unescape(**Source + Span.Offset, Span.Length, Value);
+
+    FWriteScopeLock Lock(UnescapedLock);
+    TUniquePtr<FString>& Cached = Unescaped[SpanIndex];
+    if (!Cached.IsValid())
+    {
+        Cached = MakeUnique<FString>(MoveTemp(Value));
+    }
+    return FStringView(**Cached, Cached->Len());
+}
+
+bool FJsonLazyStrings::GetString(const FString& Path, FString& OutValue) const
+{
+    return GetStringByHash(GetTypeHash(Path), Path, OutValue);
+}
+
+bool FJsonLazyStrings::GetStringByHash(const uint32 Hash, const FString& Path, FString& OutValue) const
+{
+    const int32* SpanIndex = SpanIndices.FindByHash(Hash, Path);
+    if (!SpanIndex)
+    {
+        return false;
+    }
+    OutValue = FString(GetViewByIndex(*SpanIndex));
+    return true;
+}
+
+bool FJsonLazyStrings::GetStringView(const FString& Path, FStringView& OutView) const
+{
+    const int32* SpanIndex = SpanIndices.Find(Path);
+    if (!SpanIndex)
+    {
+        return false;
+    }
+    OutView = GetViewByIndex(*SpanIndex);
+    return true;
+}
+
+bool FJsonLazyStrings::DecodeBase64(const FString& Path, TArray<uint8>& OutBytes) const
+{
+    const int32* SpanIndex = SpanIndices.Find(Path);
+    if (!SpanIndex)
+    {
+        OutBytes.Reset();
+        return false;
+    }
+
+    // 部分编码器会把 '/' 转义为 "\/"，此时使用反转义后的内容
+    const FStringView View = GetViewByIndex(*SpanIndex);
+    return JsonBase64::Decode(View.GetData(), View.Len(), OutBytes);
+}
+
+void FJsonLazyStrings::MaterializeTo(TMap<FString, FJsonDataStruct>& OutMap) const
+{
+    OutMap.Reserve(OutMap.Num() + SpanIndices.Num());
+    for (const TPair<FString, int32>& Pair : SpanIndices)
+    {
+        OutMap.Add(Pair.Key).StringValue = FString(GetViewByIndex(Pair.Value));
+    }
+}
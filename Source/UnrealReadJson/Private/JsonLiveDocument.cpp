@@ -0,0 +1,270 @@
+﻿#include "JsonLiveDocument.h"
+#include "Async_ReadJson.h"
+#include "JsonPathIndex.h"
+
+UJsonLiveDocument::UJsonLiveDocument()
+{
+    // 根节点
+    TrieNodes.AddDefaulted();
+}
+
+void UJsonLiveDocument::BeginDestroy()
+{
+    if (DispatchTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(DispatchTickerHandle);
+        DispatchTickerHandle.Reset();
+    }
+    Super::BeginDestroy();
+}
+
+// ============================================================================
+// 创建与更新
+// ============================================================================
+UJsonLiveDocument* UJsonLiveDocument::CreateLiveDocument(const FParsedData& InitialData)
+{
+    UJsonLiveDocument* Document = NewObject<UJsonLiveDocument>();
+    Document->ParsedData = InitialData;
+    return Document;
+}
+
+void UJsonLiveDocument::ApplyJsonDocument(const FString& NewJsonStr, TArray<FString>& ChangedPaths, bool& bIsValid)
+{
+    bIsValid = JsonPatchHelper::ApplyDocument(ParsedData, NewJsonStr, ChangedPaths);
+    JsonPathIndexHelper::UpdateIndex(ParsedData, ChangedPaths);
+    QueueChangedPaths(ChangedPaths);
+}
+
+void UJsonLiveDocument::ApplyJsonPatch(const FString& PatchStr, EJsonPatchFormat Format, TArray<FString>& ChangedPaths, bool& bIsValid)
+{
+    bIsValid = JsonPatchHelper::ApplyPatch(ParsedData, PatchStr, Format, ChangedPaths);
+    JsonPathIndexHelper::UpdateIndex(ParsedData, ChangedPaths);
+    QueueChangedPaths(ChangedPaths);
+}
+
+void UJsonLiveDocument::NotifyPathsChanged(const TArray<FString>& ChangedPaths)
+{
+    JsonPathIndexHelper::UpdateIndex(ParsedData, ChangedPaths);
+    QueueChangedPaths(ChangedPaths);
+}
+
+void UJsonLiveDocument::FlushNotifications()
+{
+    if (DispatchTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(DispatchTickerHandle);
+        DispatchTickerHandle.Reset();
+    }
+
+    if (PendingChangedPaths.IsEmpty())
+    {
+        return;
+    }
+
+    const TSet<FString> ChangedPaths = MoveTemp(PendingChangedPaths);
+    PendingChangedPaths.Reset();
+
+    // 沿前缀树匹配：路径经过的节点上的前缀订阅、终点节点上的精确订阅
+    TMap<int32, TArray<FString>> Matches;
+    TArray<FString> Segments;
+    const bool bCaseSensitive = ParsedData.IsCaseSensitive();
+    for (const FString& ChangedPath : ChangedPaths)
+    {
+        for (const int32 Handle : TrieNodes[0].PrefixSubscribers)
+        {
+            Matches.FindOrAdd(Handle).Add(ChangedPath);
+        }
+
+        JsonPath::SplitPath(ChangedPath, Segments, ParsedData.bEscapedPaths);
+        int32 NodeIndex = 0;
+        for (const FString& Segment : Segments)
+        {
+            const int32* ChildIndex = JsonPath::FindSegment(TrieNodes[NodeIndex].Children, Segment, bCaseSensitive);
+            if (!ChildIndex)
+            {
+                NodeIndex = INDEX_NONE;
+                break;
+            }
+            NodeIndex = *ChildIndex;
+            for (const int32 Handle : TrieNodes[NodeIndex].PrefixSubscribers)
+            {
+                Matches.FindOrAdd(Handle).Add(ChangedPath);
+            }
+        }
+
+        if (NodeIndex > 0)
+        {
+            for (const int32 Handle : TrieNodes[NodeIndex].ExactSubscribers)
+            {
+                Matches.FindOrAdd(Handle).Add(ChangedPath);
+            }
+        }
+    }
+
+    for (const TPair<int32, TArray<FString>>& Match : Matches)
+    {
+        // 回调中可能增删订阅，先拷贝委托再执行
+        const FSubscription* Subscription = Subscriptions.Find(Match.Key);
+        if (!Subscription)
+        {
+            continue;
+        }
+        const FString SubscribedPath = Subscription->Path;
+        const FOnJsonPathChanged Delegate = Subscription->Delegate;
+        const FOnJsonPathChangedNative NativeDelegate = Subscription->NativeDelegate;
+
+        Delegate.ExecuteIfBound(SubscribedPath, Match.Value);
+        NativeDelegate.ExecuteIfBound(SubscribedPath, Match.Value);
+    }
+}
+
+// ============================================================================
+// 订阅
+// ============================================================================
+int32 UJsonLiveDocument::Subscribe(const FString& NodePath, bool bIncludeDescendants, FOnJsonPathChanged OnChanged)
+{
+    FSubscription Subscription;
+    Subscription.Path = NodePath;
+    Subscription.bIncludeDescendants = bIncludeDescendants;
+    Subscription.Delegate = OnChanged;
+    return AddSubscription(MoveTemp(Subscription));
+}
+
+int32 UJsonLiveDocument::SubscribeNative(const FString& NodePath, bool bIncludeDescendants, FOnJsonPathChangedNative OnChanged)
+{
+    FSubscription Subscription;
+    Subscription.Path = NodePath;
+    Subscription.bIncludeDescendants = bIncludeDescendants;
+    Subscription.NativeDelegate = MoveTemp(OnChanged);
+    return AddSubscription(MoveTemp(Subscription));
+}
+
+void UJsonLiveDocument::Unsubscribe(int32 SubscriptionHandle)
+{
+    FSubscription Subscription;
+    if (!Subscriptions.RemoveAndCopyValue(SubscriptionHandle, Subscription))
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %s ] - [ %hs ] Subscription %d not found"), *GetName(), __FUNCTION__, SubscriptionHandle);
+        return;
+    }
+
+    FSubscriptionTrieNode& Node = TrieNodes[Subscription.TrieNodeIndex];
+    (Subscription.bIncludeDescendants ? Node.PrefixSubscribers : Node.ExactSubscribers).RemoveSingleSwap(SubscriptionHandle);
+    PruneTrieNodes(Subscription.TrieNodeIndex);
+}
+
+int32 UJsonLiveDocument::AddSubscription(FSubscription&& Subscription)
+{
+    // 根路径只能以前缀方式订阅（即订阅所有变化）
+    if (Subscription.Path.IsEmpty() && !Subscription.bIncludeDescendants)
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %s ] - [ %hs ] NodePath is empty"), *GetName(), __FUNCTION__);
+        return INDEX_NONE;
+    }
+
+    const int32 Handle = NextSubscriptionHandle++;
+    Subscription.TrieNodeIndex = FindOrAddTrieNode(Subscription.Path);
+
+    FSubscriptionTrieNode& Node = TrieNodes[Subscription.TrieNodeIndex];
+    (Subscription.bIncludeDescendants ? Node.PrefixSubscribers : Node.ExactSubscribers).Add(Handle);
+
+    Subscriptions.Add(Handle, MoveTemp(Subscription));
+    return Handle;
+}
+
+int32 UJsonLiveDocument::FindOrAddTrieNode(const FString& NodePath)
+{
+    TArray<FString> Segments;
+    JsonPath::SplitPath(NodePath, Segments, ParsedData.bEscapedPaths);
+
+    int32 NodeIndex = 0;
+    const bool bCaseSensitive = ParsedData.IsCaseSensitive();
+    for (const FString& Segment : Segments)
+    {
+        if (const int32* ChildIndex = JsonPath::FindSegment(TrieNodes[NodeIndex].Children, Segment, bCaseSensitive))
+        {
+            NodeIndex = *ChildIndex;
+            continue;
+        }
+
+        // 先取下标再添加，避免 TrieNodes 扩容后引用失效
+        const int32 NewIndex = FreeTrieNodes.Num() > 0 ? FreeTrieNodes.Pop() : TrieNodes.AddDefaulted();
+        TrieNodes[NewIndex].Segment = Segment;
+        TrieNodes[NewIndex].Parent = NodeIndex;
+        TrieNodes[NodeIndex].Children.Add(Segment, NewIndex);
+        NodeIndex = NewIndex;
+    }
+    return NodeIndex;
+}
+
+void UJsonLiveDocument::PruneTrieNodes(int32 NodeIndex)
+{
+    // 根节点始终保留
+    while (NodeIndex > 0 && TrieNodes[NodeIndex].IsEmpty())
+    {
+        const int32 ParentIndex = TrieNodes[NodeIndex].Parent;
+        TrieNodes[ParentIndex].Children.Remove(TrieNodes[NodeIndex].Segment);
+        TrieNodes[NodeIndex] = FSubscriptionTrieNode();
+        FreeTrieNodes.Add(NodeIndex);
+        NodeIndex = ParentIndex;
+    }
+}
+
+void UJsonLiveDocument::QueueChangedPaths(const TArray<FString>& ChangedPaths)
+{
+    if (ChangedPaths.IsEmpty())
+    {
+        return;
+    }
+
+    PendingChangedPaths.Append(ChangedPaths);
+    if (!DispatchTickerHandle.IsValid())
+    {
+        DispatchTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UJsonLiveDocument::HandleDispatchTick));
+    }
+}
+
+bool UJsonLiveDocument::HandleDispatchTick(float DeltaTime)
+{
+    DispatchTickerHandle.Reset();
+    FlushNotifications();
+    return false;
+}
+
+// ============================================================================
+// 读取
+// ============================================================================
+void UJsonLiveDocument::GetNodeData(const FString& NodePath, FJsonNode& NodeData, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeData(NodePath, ParsedData, NodeData, bIsValid);
+}
+
+void UJsonLiveDocument::GetNodeValueToString(const FString& NodePath, FString& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToString(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UJsonLiveDocument::GetNodeValueToInt(const FString& NodePath, int32& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToInt(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UJsonLiveDocument::GetNodeValueToInt64(const FString& NodePath, int64& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToInt64(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UJsonLiveDocument::GetNodeValueToFloat(const FString& NodePath, float& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToFloat(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UJsonLiveDocument::GetNodeValueToDouble(const FString& NodePath, double& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToDouble(NodePath, ParsedData, NodeValue, bIsValid);
+}
+
+void UJsonLiveDocument::GetNodeValueToBool(const FString& NodePath, bool& NodeValue, bool& bIsValid) const
+{
+    UAsync_ReadJson::GetNodeValueToBool(NodePath, ParsedData, NodeValue, bIsValid);
+}
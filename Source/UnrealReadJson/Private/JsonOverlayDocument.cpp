@@ -0,0 +1,375 @@
+﻿#include "JsonOverlayDocument.h"
+#include "JsonLazyString.h"
+#include "JsonParsedWriter.h"
+#include "JsonPath.h"
+
+// ============================================================================
+// FJsonOverlayDocument
+// ============================================================================
+FJsonOverlayDocument::FJsonOverlayDocument()
+    : FJsonOverlayDocument(MakeShared<FParsedData>())
+{
+}
+
+FJsonOverlayDocument::FJsonOverlayDocument(const TSharedRef<const FParsedData>& InBase)
+    : Base(InBase)
+    , Overrides(InBase->IsCaseSensitive() ? EJsonKeyPolicy::CaseSensitive : EJsonKeyPolicy::Default)
+{
+}
+
+// ============================================================================
+// 修改
+// ============================================================================
+bool FJsonOverlayDocument::SetValue(const FString& NodePath, const FJsonDataStruct& Value)
+{
+    if (NodePath.IsEmpty())
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] NodePath is empty"), __FUNCTION__);
+        return false;
+    }
+
+    bool bShadowed = false;
+    const FJsonDataStruct* Existing = Resolve(NodePath, bShadowed);
+    if (!Existing && (bShadowed || !BaseContains(NodePath)))
+    {
+        // 新增的路径：父节点须为根或对象
+        TArray<int32, TInlineAllocator<16>> Separators;
+        JsonPath::FindSeparators(NodePath, Base->bEscapedPaths, Separators);
+        if (Separators.Num() > 0 && !JsonDataHelper::IsObjectEntry(Find(NodePath.Left(Separators.Last()))))
+        {
+            UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Parent of [ %s ] is not an object"), __FUNCTION__, *NodePath);
+            return false;
+        }
+    }
+
+    // 替换对象时隐藏其子路径（新值即使是对象文本也不展开）
+    const bool bReplacesObject = JsonDataHelper::IsObjectEntry(Existing);
+    if (bReplacesObject)
+    {
+        RemoveDescendantOverrides(NodePath);
+    }
+    FOverrideState& State = AddOverride(NodePath, Value);
+    State.bRemoved = false;
+    if (bReplacesObject && !State.bHidesDescendants)
+    {
+        State.bHidesDescendants = true;
+        ++NumHidingOverrides;
+    }
+    return true;
+}
+
+bool FJsonOverlayDocument::Remove(const FString& NodePath)
+{
+    if (!Contains(NodePath))
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] not found"), __FUNCTION__, *NodePath);
+        return false;
+    }
+
+    RemoveDescendantOverrides(NodePath);
+    FOverrideState& State = AddOverride(NodePath, FJsonDataStruct());
+    State.bRemoved = true;
+    if (!State.bHidesDescendants)
+    {
+        State.bHidesDescendants = true;
+        ++NumHidingOverrides;
+    }
+    return true;
+}
+
+void FJsonOverlayDocument::ResetOverrides()
+{
+    Overrides.Reset();
+    OverrideStates.Reset();
+    NumHidingOverrides = 0;
+}
+
+FJsonOverlayDocument::FOverrideState& FJsonOverlayDocument::AddOverride(const FString& NodePath, const FJsonDataStruct& Value)
+{
+    Overrides.Add(NodePath, Value);
+    const int32 Index = Overrides.IndexOf(NodePath);
+    if (Index >= OverrideStates.Num())
+    {
+        OverrideStates.SetNum(Index + 1);
+    }
+    return OverrideStates[Index];
+}
+
+void FJsonOverlayDocument::RemoveDescendantOverrides(const FStringView NodePath)
+{
+    const TArray<FJsonFlatTable::FEntry>& Entries = Overrides.GetEntries();
+    for (int32 Index = 0; Index < Entries.Num(); ++Index)
+    {
+        if (IsDescendantPath(Entries[Index].Key, NodePath))
+        {
+            OverrideStates[Index].bRemoved = true;
+        }
+    }
+}
+
+// ============================================================================
+// 读取
+// ============================================================================
+const FJsonDataStruct* FJsonOverlayDocument::Find(const FString& NodePath) const
+{
+    bool bShadowed = false;
+    return Resolve(NodePath, bShadowed);
+}
+
+bool FJsonOverlayDocument::GetNodeData(const FString& NodePath, FJsonDataStruct& OutValue) const
+{
+    bool bShadowed = false;
+    if (const FJsonDataStruct* Found = Resolve(NodePath, bShadowed))
+    {
+        OutValue = *Found;
+        return true;
+    }
+
+    FString LazyValue;
+    if (!bShadowed && Base->LazyStrings.IsValid() && Base->LazyStrings->GetString(NodePath, LazyValue))
+    {
+        OutValue = FJsonDataStruct::MakeString(LazyValue);
+        return true;
+    }
+    return false;
+}
+
+bool FJsonOverlayDocument::Contains(const FString& NodePath) const
+{
+    bool bShadowed = false;
+    return Resolve(NodePath, bShadowed) || (!bShadowed && BaseContains(NodePath));
+}
+
+void FJsonOverlayDocument::GetModifiedPaths(TArray<FString>& OutPaths) const
+{
+    OutPaths.Reset(Overrides.Num());
+    for (const FJsonFlatTable::FEntry& Entry : Overrides.GetEntries())
+    {
+        OutPaths.Add(Entry.Key);
+    }
+}
+
+const FJsonDataStruct* FJsonOverlayDocument::Resolve(const FString& NodePath, bool& bOutShadowed) const
+{
+    bOutShadowed = false;
+    if (Overrides.Num() > 0)
+    {
+        const int32 Index = Overrides.IndexOf(NodePath);
+        if (Index != INDEX_NONE)
+        {
+            bOutShadowed = true;
+            return OverrideStates[Index].bRemoved ? nullptr : &Overrides.GetEntries()[Index].Value;
+        }
+        if (NumHidingOverrides > 0 && IsHiddenByAncestor(NodePath))
+        {
+            bOutShadowed = true;
+            return nullptr;
+        }
+    }
+    return Base->FindEntry(NodePath);
+}
+
+bool FJsonOverlayDocument::IsHiddenByAncestor(const FStringView NodePath) const
+{
+    TArray<int32, TInlineAllocator<16>> Separators;
+    JsonPath::FindSeparators(NodePath, Base->bEscapedPaths, Separators);
+    for (const int32 Separator : Separators)
+    {
+        const int32 Index = Overrides.IndexOf(NodePath.Left(Separator));
+        if (Index != INDEX_NONE && OverrideStates[Index].bHidesDescendants)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FJsonOverlayDocument::IsDescendantPath(const FStringView Descendant, const FStringView Ancestor) const
+{
+    return Descendant.Len() > Ancestor.Len()
+        && Descendant[Ancestor.Len()] == TEXT('.')
+        && Descendant.Left(Ancestor.Len()).Equals(Ancestor, Overrides.IsCaseSensitive() ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase);
+}
+
+bool FJsonOverlayDocument::BaseContains(const FString& NodePath) const
+{
+    return Base->FindEntry(NodePath) || (Base->LazyStrings.IsValid() && Base->LazyStrings->Find(NodePath));
+}
+
+// ============================================================================
+// 合并
+// ============================================================================
+void FJsonOverlayDocument::ToParsedData(FParsedData& OutParsedData) const
+{
+    OutParsedData = {};
+    OutParsedData.KeyCollisions = Base->KeyCollisions;
+    OutParsedData.bEscapedPaths = Base->bEscapedPaths;
+
+    // 基础条目：被删除、被隐藏的跳过，被覆盖的使用覆盖值
+    const auto MergeEntries = [this](const auto& Entries, auto&& AddEntry)
+    {
+        for (const auto& Entry : Entries)
+        {
+            const int32 Index = Overrides.Num() > 0 ? Overrides.IndexOf(Entry.Key) : INDEX_NONE;
+            if (Index != INDEX_NONE)
+            {
+                if (!OverrideStates[Index].bRemoved)
+                {
+                    AddEntry(Entry, Overrides.GetEntries()[Index].Value);
+                }
+            }
+            else if (NumHidingOverrides == 0 || !IsHiddenByAncestor(Entry.Key))
+            {
+                AddEntry(Entry, Entry.Value);
+            }
+        }
+    };
+
+    // 沿用基础文档的存储方式（数据表的哈希与 Overrides 相同）
+    if (Base->FlatEntries.IsValid())
+    {
+        const TSharedRef<FJsonFlatTable> Table = MakeShared<FJsonFlatTable>(Base->FlatEntries->GetKeyPolicy());
+        Table->Reserve(Base->FlatEntries->Num() + Overrides.Num());
+        MergeEntries(Base->FlatEntries->GetEntries(), [&Table](const FJsonFlatTable::FEntry& Entry, const FJsonDataStruct& Value)
+        {
+            Table->AddByHash(Entry.Hash, Entry.Key, Value);
+        });
+        OutParsedData.FlatEntries = Table;
+    }
+    else
+    {
+        OutParsedData.ParsedDataMap.Reserve(Base->ParsedDataMap.Num() + Overrides.Num());
+        const auto AddToMap = [&OutParsedData](const TPair<FString, FJsonDataStruct>& Entry, const FJsonDataStruct& Value)
+        {
+            OutParsedData.ParsedDataMap.Add(Entry.Key, Value);
+        };
+        MergeEntries(Base->ParsedDataMap, AddToMap);
+    }
+
+    // 延迟记录的字符串：涉及修改时反转义后写入条目，否则继续共享
+    if (Base->LazyStrings.IsValid())
+    {
+        bool bLazyModified = false;
+        if (Overrides.Num() > 0)
+        {
+            Base->LazyStrings->ForEachSpan([this, &bLazyModified](const FString& Path, const FJsonSourceSpan&)
+            {
+                bLazyModified = bLazyModified || Overrides.IndexOf(Path) != INDEX_NONE || (NumHidingOverrides > 0 && IsHiddenByAncestor(Path));
+            });
+        }
+        if (bLazyModified)
+        {
+            TMap<FString, FJsonDataStruct> LazyEntries;
+            Base->LazyStrings->MaterializeTo(LazyEntries);
+            MergeEntries(LazyEntries, [&OutParsedData](const TPair<FString, FJsonDataStruct>& Entry, const FJsonDataStruct& Value)
+            {
+                OutParsedData.SetEntry(Entry.Key, Value);
+            });
+        }
+        else
+        {
+            OutParsedData.LazyStrings = Base->LazyStrings;
+        }
+    }
+
+    if (Overrides.Num() == 0)
+    {
+        return;
+    }
+
+    // 新增的路径
+    const TArray<FJsonFlatTable::FEntry>& Entries = Overrides.GetEntries();
+    for (int32 Index = 0; Index < Entries.Num(); ++Index)
+    {
+        if (OverrideStates[Index].bRemoved || BaseContains(Entries[Index].Key))
+        {
+            continue;
+        }
+        if (OutParsedData.FlatEntries.IsValid())
+        {
+            OutParsedData.FlatEntries->AddByHash(Entries[Index].Hash, Entries[Index].Key, Entries[Index].Value);
+        }
+        else
+        {
+            OutParsedData.ParsedDataMap.Add(Entries[Index].Key, Entries[Index].Value);
+        }
+    }
+
+    // 被修改路径的祖先对象重新生成文本
+    TArray<FString> ModifiedPaths;
+    GetModifiedPaths(ModifiedPaths);
+    FJsonParsedWriter Writer;
+    Writer.RefreshObjectText(OutParsedData, ModifiedPaths);
+}
+
+// ============================================================================
+// UJsonOverlayDocument
+// ============================================================================
+UJsonOverlayDocument* UJsonOverlayDocument::CreateOverlayBase(const FParsedData& BaseData)
+{
+    UJsonOverlayDocument* Overlay = NewObject<UJsonOverlayDocument>();
+    Overlay->Document = FJsonOverlayDocument(MakeShared<FParsedData>(BaseData));
+    return Overlay;
+}
+
+UJsonOverlayDocument* UJsonOverlayDocument::CreateOverlay() const
+{
+    UJsonOverlayDocument* Overlay = NewObject<UJsonOverlayDocument>();
+    Overlay->Document = FJsonOverlayDocument(Document.GetSharedBase());
+    return Overlay;
+}
+
+void UJsonOverlayDocument::SetNodeData(const FString& NodePath, const FJsonDataStruct& Value, bool& bIsValid)
+{
+    bIsValid = Document.SetValue(NodePath, Value);
+}
+
+void UJsonOverlayDocument::SetNodeValueString(const FString& NodePath, const FString& Value, bool& bIsValid)
+{
+    bIsValid = Document.SetValue(NodePath, FJsonDataStruct::MakeString(Value));
+}
+
+void UJsonOverlayDocument::SetNodeValueInt(const FString& NodePath, const int32 Value, bool& bIsValid)
+{
+    bIsValid = Document.SetValue(NodePath, FJsonDataStruct::MakeInt(Value));
+}
+
+void UJsonOverlayDocument::SetNodeValueFloat(const FString& NodePath, const float Value, bool& bIsValid)
+{
+    bIsValid = Document.SetValue(NodePath, FJsonDataStruct::MakeDouble(Value));
+}
+
+void UJsonOverlayDocument::SetNodeValueBool(const FString& NodePath, const bool Value, bool& bIsValid)
+{
+    bIsValid = Document.SetValue(NodePath, FJsonDataStruct::MakeBool(Value));
+}
+
+void UJsonOverlayDocument::RemoveNode(const FString& NodePath, bool& bIsValid)
+{
+    bIsValid = Document.Remove(NodePath);
+}
+
+void UJsonOverlayDocument::ResetOverrides()
+{
+    Document.ResetOverrides();
+}
+
+void UJsonOverlayDocument::GetNodeData(const FString& NodePath, FJsonNode& NodeData, bool& bIsValid) const
+{
+    FJsonDataStruct Value;
+    bIsValid = Document.GetNodeData(NodePath, Value);
+    if (bIsValid)
+    {
+        NodeData = { NodePath, MoveTemp(Value) };
+    }
+}
+
+void UJsonOverlayDocument::GetModifiedPaths(TArray<FString>& ModifiedPaths) const
+{
+    Document.GetModifiedPaths(ModifiedPaths);
+}
+
+void UJsonOverlayDocument::ToParsedData(FParsedData& ParsedData) const
+{
+    Document.ToParsedData(ParsedData);
+}
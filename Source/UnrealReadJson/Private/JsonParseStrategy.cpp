@@ -0,0 +1,188 @@
+﻿#include "JsonParseStrategy.h"
+#include "JsonFlatTable.h"
+
+void JsonParseStrategy::PreScan(const FString& JsonStr, FJsonPreScan& OutPreScan, const int32 LazyStringThreshold)
+{
+    OutPreScan = {};
+
+    struct FLevel
+    {
+        int32 NumCommas = 0;
+        bool bIsArray = false;
+        /** 对象自身的路径长度与当前成员的路径长度 */
+        int32 BasePathLength = 0;
+        int32 MemberPathLength = 0;
+    };
+    TArray<FLevel, TInlineAllocator<64>> Levels;
+    int32 ArrayDepth = 0;
+
+    // 上一个有效字符，用于判断空对象和空数组
+    TCHAR LastSignificant = TEXT('\0');
+    // 上一个字符串的源文本长度，遇到 ':' 时即为键的长度
+    int32 LastStringLength = 0;
+
+    const TCHAR* Cursor = *JsonStr;
+    const TCHAR* End = Cursor + JsonStr.Len();
+    while (Cursor < End)
+    {
+        const TCHAR Char = *Cursor++;
+        switch (Char)
+        {
+        case TEXT('"'):
+            {
+                // 跳过字符串内容（含转义的引号）
+                const TCHAR* StringStart = Cursor;
+                while (Cursor < End && *Cursor != TEXT('"'))
+                {
+                    Cursor += *Cursor == TEXT('\\') ? 2 : 1;
+                }
+                LastStringLength = static_cast<int32>(FMath::Min(Cursor, End) - StringStart);
+                ++Cursor;
+                // 紧跟在 ':' 之后的字符串是成员的值
+                if (LastSignificant == TEXT(':') && ArrayDepth == 0 && LastStringLength >= LazyStringThreshold)
+                {
+                    ++OutPreScan.NumLazyStrings;
+                }
+                break;
+            }
+        case TEXT(':'):
+            if (Levels.Num() > 0 && ArrayDepth == 0)
+            {
+                FLevel& Level = Levels.Last();
+                // 按嵌套层数计入分隔符（空键名也占一个分隔符），结果为上界
+                Level.MemberPathLength = Level.BasePathLength + (Levels.Num() > 1 ? 1 : 0) + LastStringLength;
+                OutPreScan.MaxPathLength = FMath::Max(OutPreScan.MaxPathLength, Level.MemberPathLength);
+            }
+            break;
+        case TEXT('{'):
+        case TEXT('['):
+            {
+                const int32 BasePathLength = Levels.Num() > 0 ? Levels.Last().MemberPathLength : 0;
+                FLevel& Level = Levels.AddDefaulted_GetRef();
+                Level.BasePathLength = BasePathLength;
+                Level.bIsArray = Char == TEXT('[');
+                ArrayDepth += Level.bIsArray ? 1 : 0;
+                OutPreScan.MaxDepth = FMath::Max(OutPreScan.MaxDepth, Levels.Num());
+                break;
+            }
+        case TEXT('}'):
+        case TEXT(']'):
+            {
+                if (Levels.Num() == 0)
+                {
+                    break;
+                }
+                const FLevel Level = Levels.Pop();
+                const bool bEmpty = LastSignificant == TEXT('{') || LastSignificant == TEXT('[');
+                const int32 FanOut = bEmpty ? 0 : Level.NumCommas + 1;
+
+                OutPreScan.MaxFanOut = FMath::Max(OutPreScan.MaxFanOut, FanOut);
+                if (Level.bIsArray)
+                {
+                    --ArrayDepth;
+                }
+                else if (ArrayDepth == 0)
+                {
+                    OutPreScan.NumMembers += FanOut;
+                }
+                if (Levels.Num() == 0)
+                {
+                    OutPreScan.RootFanOut = FanOut;
+                }
+                break;
+            }
+        case TEXT(','):
+            if (Levels.Num() > 0)
+            {
+                ++Levels.Last().NumCommas;
+            }
+            break;
+        case TEXT(' '):
+        case TEXT('\n'):
+        case TEXT('\r'):
+        case TEXT('\t'):
+            continue;
+        default:
+            break;
+        }
+        LastSignificant = Char;
+    }
+}
+
+EJsonParseStrategy JsonParseStrategy::Resolve(const FReadJsonOptions& Options, const FJsonPreScan& PreScan, const int32 JsonLength)
+{
+    if (Options.UsesSourceFlattener())
+    {
+        return EJsonParseStrategy::Streaming;
+    }
+    if (Options.Strategy != EJsonParseStrategy::Auto)
+    {
+        return Options.Strategy;
+    }
+
+    if (JsonLength >= LargeJsonLength)
+    {
+        const bool bWideRoot = PreScan.RootFanOut >= MinParallelRootFanOut && PreScan.NumMembers >= MinParallelMembers;
+        return bWideRoot ? EJsonParseStrategy::Parallel : EJsonParseStrategy::Iterative;
+    }
+    if (PreScan.MaxDepth > MaxRecursiveDepth)
+    {
+        return EJsonParseStrategy::Iterative;
+    }
+    return EJsonParseStrategy::Recursive;
+}
+
+bool JsonParseStrategy::NeedsPreScan(const FReadJsonOptions& Options)
+{
+    return Options.bPreScanCapacity || (Options.Strategy == EJsonParseStrategy::Auto && !Options.UsesSourceFlattener());
+}
+
+int32 JsonParseStrategy::EstimateRehashes(const int32 ReservedCapacity, const int32 NumEntries)
+{
+    if (NumEntries <= 0)
+    {
+        return 0;
+    }
+
+    // 未预留时第一次添加即分配哈希
+    int32 NumRehashes = ReservedCapacity > 0 ? 0 : 1;
+    int32 Num = FMath::Max(ReservedCapacity, 1);
+    uint32 NumBuckets = FDefaultSetAllocator::GetNumberOfHashBuckets(Num);
+    const uint32 FinalNumBuckets = FDefaultSetAllocator::GetNumberOfHashBuckets(NumEntries);
+    while (NumBuckets < FinalNumBuckets)
+    {
+        // 二分查找哈希桶数量下一次变化时的元素数量
+        int32 Low = Num + 1;
+        int32 High = NumEntries;
+        while (Low < High)
+        {
+            const int32 Mid = Low + (High - Low) / 2;
+            if (FDefaultSetAllocator::GetNumberOfHashBuckets(Mid) > NumBuckets)
+            {
+                High = Mid;
+            }
+            else
+            {
+                Low = Mid + 1;
+            }
+        }
+        Num = Low;
+        NumBuckets = FDefaultSetAllocator::GetNumberOfHashBuckets(Num);
+        ++NumRehashes;
+    }
+    return NumRehashes;
+}
+
+bool JsonParseStrategy::ExceedsReservation(const FParsedData& ParsedData, const int32 ReservedEntries)
+{
+    if (ParsedData.FlatEntries.IsValid())
+    {
+        FJsonFlatTable Reserved(ParsedData.FlatEntries->GetKeyPolicy());
+        Reserved.Reserve(ReservedEntries);
+        return ParsedData.FlatEntries->GetAllocatedSize() > Reserved.GetAllocatedSize();
+    }
+
+    TMap<FString, FJsonDataStruct> Reserved;
+    Reserved.Reserve(ReservedEntries);
+    return ParsedData.ParsedDataMap.GetAllocatedSize() > Reserved.GetAllocatedSize();
+}
@@ -0,0 +1,941 @@
+﻿#include "JsonParsedWriter.h"
+#include "JsonFlatTable.h"
+#include "JsonLazyString.h"
+#include "JsonPath.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+    /** 写入 FArchive 时每累计多少字节写入一次 */
+    constexpr int32 ArchiveFlushBytes = 64 * 1024;
+
+    FORCEINLINE bool IsWhitespace(const TCHAR Char)
+    {
+        return Char == TEXT(' ') || Char == TEXT('\t') || Char == TEXT('\n') || Char == TEXT('\r');
+    }
+
+    FORCEINLINE bool IsDigit(const TCHAR Char)
+    {
+        return Char >= TEXT('0') && Char <= TEXT('9');
+    }
+
+    FORCEINLINE bool IsHexDigit(const TCHAR Char)
+    {
+        return IsDigit(Char) || (Char >= TEXT('a') && Char <= TEXT('f')) || (Char >= TEXT('A') && Char <= TEXT('F'));
+    }
+
+    /** 不需要转义、可以按单字节写出的字符 */
+    FORCEINLINE bool IsPlainAscii(const TCHAR Char)
+    {
+        return Char >= 0x20 && Char < 0x80 && Char != TEXT('"') && Char != TEXT('\\');
+    }
+
+    /** 校验数值字面量，返回长度（0 表示不合法） */
+    int32 ScanNumber(const TCHAR* Cursor, const TCHAR* End)
+    {
+        const TCHAR* Start = Cursor;
+        if (Cursor < End && *Cursor == TEXT('-'))
+        {
+            ++Cursor;
+        }
+        if (Cursor >= End || !IsDigit(*Cursor))
+        {
+            return 0;
+        }
+        if (*Cursor == TEXT('0'))
+        {
+            ++Cursor;
+        }
+        else
+        {
+            while (Cursor < End && IsDigit(*Cursor))
+            {
+                ++Cursor;
+            }
+        }
+        if (Cursor < End && *Cursor == TEXT('.'))
+        {
+            if (++Cursor >= End || !IsDigit(*Cursor))
+            {
+                return 0;
+            }
+            while (Cursor < End && IsDigit(*Cursor))
+            {
+                ++Cursor;
+            }
+        }
+        if (Cursor < End && (*Cursor == TEXT('e') || *Cursor == TEXT('E')))
+        {
+            ++Cursor;
+            if (Cursor < End && (*Cursor == TEXT('+') || *Cursor == TEXT('-')))
+            {
+                ++Cursor;
+            }
+            if (Cursor >= End || !IsDigit(*Cursor))
+            {
+                return 0;
+            }
+            while (Cursor < End && IsDigit(*Cursor))
+            {
+                ++Cursor;
+            }
+        }
+        return static_cast<int32>(Cursor - Start);
+    }
+
+    /** 比较字面量（true / false / null） */
+    bool MatchLiteral(const TCHAR* Cursor, const TCHAR* End, const TCHAR* Literal, const int32 Length)
+    {
+        return End - Cursor >= Length && FCString::Strncmp(Cursor, Literal, Length) == 0;
+    }
+}
+
+// ============================================================================
+// 写出入口
+// ============================================================================
+void FJsonParsedWriter::Write(const FParsedData& ParsedData, TArray<uint8>& OutBytes)
+{
+    OutBytes.Reset();
+    Bytes = &OutBytes;
+    Archive = nullptr;
+    WriteDocument(ParsedData);
+    Bytes = nullptr;
+}
+
+bool FJsonParsedWriter::Write(const FParsedData& ParsedData, FArchive& Ar)
+{
+    ArchiveBuffer.Reset();
+    Bytes = &ArchiveBuffer;
+    Archive = &Ar;
+    WriteDocument(ParsedData);
+    if (ArchiveBuffer.Num() > 0)
+    {
+        Ar.Serialize(ArchiveBuffer.GetData(), ArchiveBuffer.Num());
+        ArchiveBuffer.Reset();
+    }
+    Bytes = nullptr;
+    Archive = nullptr;
+    return !Ar.IsError();
+}
+
+void FJsonParsedWriter::MarkModified(const FStringView NodePath)
+{
+    ModifiedPaths.Add(FString(NodePath));
+}
+
+void FJsonParsedWriter::ResetModified()
+{
+    ModifiedPaths.Reset();
+}
+
+void FJsonParsedWriter::RefreshObjectText(FParsedData& ParsedData, const TConstArrayView<FString> ChangedPaths, const bool bIncludeSelf)
+{
+    TArray<uint8> ObjectBytes;
+    Bytes = &ObjectBytes;
+    Archive = nullptr;
+    Document = &ParsedData;
+    BuildNodes(ParsedData);
+    for (const FString& ChangedPath : ChangedPaths)
+    {
+        MarkDirtyPath(ChangedPath, bIncludeSelf);
+    }
+
+    // 先生成全部文本再写回：重建的对象不读取子对象保存的文本，写回顺序不影响结果
+    TArray<TPair<int32, FString>> ObjectTexts;
+    for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+    {
+        if (Nodes[NodeIndex].bDirty)
+        {
+            ObjectBytes.Reset();
+            WriteObject(Nodes[NodeIndex].FirstChild);
+            const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(ObjectBytes.GetData()), ObjectBytes.Num());
+            ObjectTexts.Emplace(NodeIndex, FString(Converter.Length(), Converter.Get()));
+        }
+    }
+    for (TPair<int32, FString>& ObjectText : ObjectTexts)
+    {
+        // 经 SetEntry 写回：递增修改计数，共享的数据表先复制
+        const FString Path(Nodes[ObjectText.Key].Path);
+        if (ParsedData.FindEntry(Path))
+        {
+            ParsedData.SetEntry(Path, FJsonDataStruct::MakeObject(ObjectText.Value));
+        }
+    }
+
+    Bytes = nullptr;
+    Document = nullptr;
+}
+
+void FJsonParsedWriter::WriteDocument(const FParsedData& ParsedData)
+{
+    Document = &ParsedData;
+    BuildNodes(ParsedData);
+    for (const FString& ModifiedPath : ModifiedPaths)
+    {
+        MarkDirtyPath(ModifiedPath, true);
+    }
+
+    // 根对象始终按子条目写出
+    WriteObject(RootFirstChild);
+    Document = nullptr;
+}
+
+void FJsonParsedWriter::WriteObject(const int32 FirstChild)
+{
+    // 只有需要重建的对象压栈（显式栈，深层嵌套不会导致栈溢出）
+    WriteByte('{');
+    Stack.Reset();
+    Stack.Add({ FirstChild, true });
+    while (Stack.Num() > 0)
+    {
+        FFrame& Frame = Stack.Last();
+        if (Frame.NextChild == INDEX_NONE)
+        {
+            WriteByte('}');
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6
+            Stack.Pop(EAllowShrinking::No);
+#else
+            Stack.Pop(false);
+#endif
+            continue;
+        }
+
+        const FNode& Node = Nodes[Frame.NextChild];
+        if (!Frame.bFirst)
+        {
+            WriteByte(',');
+        }
+        Frame.bFirst = false;
+        Frame.NextChild = Node.NextSibling;
+        WriteKey(Node);
+        if (WriteValue(Node))
+        {
+            WriteByte('{');
+            Stack.Add({ Node.FirstChild, true });
+        }
+        FlushIfNeeded();
+    }
+}
+
+// ============================================================================
+// 还原层级
+// ============================================================================
+void FJsonParsedWriter::BuildNodes(const FParsedData& ParsedData)
+{
+    const int32 NumLazy = ParsedData.LazyStrings.IsValid() ? ParsedData.LazyStrings->Num() : 0;
+    Nodes.Reset();
+    Nodes.Reserve(ParsedData.NumEntries() + NumLazy);
+    RootFirstChild = INDEX_NONE;
+    ObjectNodes.Reset();
+
+    const auto AddNode = [this](const FString& Path, const FJsonDataStruct* Data, const FJsonSourceSpan* LazySpan)
+    {
+        const int32 NodeIndex = Nodes.AddDefaulted();
+        FNode& Node = Nodes[NodeIndex];
+        Node.Path = FStringView(*Path, Path.Len());
+        Node.Data = Data;
+        Node.LazySpan = LazySpan;
+        if (JsonDataHelper::IsObjectEntry(Data))
+        {
+            ObjectNodes.Add(Data, NodeIndex);
+        }
+    };
+    if (ParsedData.FlatEntries.IsValid())
+    {
+        for (const FJsonFlatTable::FEntry& Entry : ParsedData.FlatEntries->GetEntries())
+        {
+            AddNode(Entry.Key, &Entry.Value, nullptr);
+        }
+    }
+    else
+    {
+        for (const TPair<FString, FJsonDataStruct>& Pair : ParsedData.ParsedDataMap)
+        {
+            AddNode(Pair.Key, &Pair.Value, nullptr);
+        }
+    }
+    if (NumLazy > 0)
+    {
+        ParsedData.LazyStrings->ForEachSpan([&AddNode](const FString& Path, const FJsonSourceSpan& Span)
+        {
+            AddNode(Path, nullptr, &Span);
+        });
+    }
+
+    // 连接父子关系，子节点保持条目顺序
+    int32 RootLastChild = INDEX_NONE;
+    for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+    {
+        int32 KeyStart = 0;
+        const int32 Parent = FindParentObject(Nodes[NodeIndex].Path, KeyStart);
+        FNode& Node = Nodes[NodeIndex];
+        Node.Parent = Parent;
+        Node.KeyStart = KeyStart;
+        int32& FirstChild = Parent != INDEX_NONE ? Nodes[Parent].FirstChild : RootFirstChild;
+        int32& LastChild = Parent != INDEX_NONE ? Nodes[Parent].LastChild : RootLastChild;
+        if (LastChild == INDEX_NONE)
+        {
+            FirstChild = NodeIndex;
+        }
+        else
+        {
+            Nodes[LastChild].NextSibling = NodeIndex;
+        }
+        LastChild = NodeIndex;
+    }
+}
+
+int32 FJsonParsedWriter::FindParentObject(const FStringView Path, int32& OutKeyStart)
+{
+    JsonPath::FindSeparators(Path, Document->bEscapedPaths, Separators);
+
+    // 从最长的前缀开始，通常直接父路径就是对象节点
+    for (int32 Index = Separators.Num() - 1; Index >= 0; --Index)
+    {
+        const int32 Parent = FindObjectNode(Path.Left(Separators[Index]));
+        if (Parent != INDEX_NONE)
+        {
+            OutKeyStart = Separators[Index] + 1;
+            return Parent;
+        }
+    }
+    OutKeyStart = 0;
+    return INDEX_NONE;
+}
+
+int32 FJsonParsedWriter::FindObjectNode(const FStringView Path)
+{
+    const FJsonDataStruct* Entry = nullptr;
+    if (Document->FlatEntries.IsValid())
+    {
+        Entry = Document->FlatEntries->Find(Path);
+    }
+    else
+    {
+        PathScratch.Reset();
+        PathScratch.Append(Path.GetData(), Path.Len());
+        Entry = Document->ParsedDataMap.Find(PathScratch);
+    }
+    if (!JsonDataHelper::IsObjectEntry(Entry))
+    {
+        return INDEX_NONE;
+    }
+    const int32* NodeIndex = ObjectNodes.Find(Entry);
+    return NodeIndex ? *NodeIndex : INDEX_NONE;
+}
+
+void FJsonParsedWriter::MarkDirtyPath(const FStringView Path, const bool bIncludeSelf)
+{
+    // 路径本身是对象时（按 bIncludeSelf）重建自身，否则（包括已删除的路径）重建所在的对象
+    int32 KeyStart = 0;
+    int32 NodeIndex = bIncludeSelf ? FindObjectNode(Path) : INDEX_NONE;
+    if (NodeIndex == INDEX_NONE)
+    {
+        NodeIndex = FindParentObject(Path, KeyStart);
+    }
+    for (; NodeIndex != INDEX_NONE && !Nodes[NodeIndex].bDirty; NodeIndex = Nodes[NodeIndex].Parent)
+    {
+        Nodes[NodeIndex].bDirty = true;
+    }
+}
+
+// ============================================================================
+// 写出值
+// ============================================================================
+bool FJsonParsedWriter::WriteValue(const FNode& Node)
+{
+    if (Node.LazySpan)
+    {
+        WriteLazyString(Node);
+        return false;
+    }
+
+    const FJsonDataStruct& Data = *Node.Data;
+    switch (Data.ValueType)
+    {
+    case EValueType::Bool:
+        if (Data.BoolValue)
+        {
+            WriteAscii("true", 4);
+        }
+        else
+        {
+            WriteAscii("false", 5);
+        }
+        return false;
+    case EValueType::Int:
+        WriteInt64(Data.IntValue);
+        return false;
+    case EValueType::Int64:
+        WriteInt64(Data.Int64Value);
+        return false;
+    case EValueType::Float:
+        WriteDouble(Data.FloatValue, true);
+        return false;
+    case EValueType::Double:
+        WriteDouble(Data.DoubleValue, false);
+        return false;
+    default:
+        break;
+    }
+
+    const FStringView Text(*Data.StringValue, Data.StringValue.Len());
+    if (Node.FirstChild != INDEX_NONE)
+    {
+        // 有子条目的对象：未修改时复用保存的文本，否则（或文本不合法时）按子条目重建
+        if (Node.bDirty || !bReuseSpans || !CopyContainer(Text))
+        {
+            return true;
+        }
+        return false;
+    }
+    if (JsonDataHelper::IsNullEntry(&Data))
+    {
+        WriteAscii("null", 4);
+        return false;
+    }
+    // 只有扁平化时记录为对象或数组的条目按 JSON 文本写出，内容以 '{' / '[' 开头的普通字符串仍写为字符串
+    if (JsonDataHelper::IsContainerEntry(&Data) && CopyContainer(Text))
+    {
+        return false;
+    }
+    WriteString(Text);
+    return false;
+}
+
+void FJsonParsedWriter::WriteKey(const FNode& Node)
+{
+    const FStringView Key = Node.Path.RightChop(Node.KeyStart);
+    WriteByte('"');
+    if (!Document->bEscapedPaths)
+    {
+        WriteStringBody(Key);
+    }
+    else
+    {
+        // 还原转义的键名（"\." -> '.'，"\\" -> '\'，末尾单独的 '\' 保留）
+        const TCHAR* Cursor = Key.GetData();
+        const TCHAR* const End = Cursor + Key.Len();
+        while (Cursor < End)
+        {
+            const TCHAR* RunEnd = Cursor;
+            while (RunEnd < End && *RunEnd != TEXT('\\'))
+            {
+                ++RunEnd;
+            }
+            WriteStringBody(FStringView(Cursor, static_cast<int32>(RunEnd - Cursor)));
+            if (RunEnd == End)
+            {
+                break;
+            }
+            const TCHAR* Escaped = RunEnd + 1 < End ? RunEnd + 1 : RunEnd;
+            WriteStringBody(FStringView(Escaped, 1));
+            Cursor = Escaped + 1;
+        }
+    }
+    WriteByte('"');
+    WriteByte(':');
+}
+
+void FJsonParsedWriter::WriteString(const FStringView Text)
+{
+    WriteByte('"');
+    WriteStringBody(Text);
+    WriteByte('"');
+}
+
+void FJsonParsedWriter::WriteStringBody(const FStringView Text)
+{
+    const TCHAR* Cursor = Text.GetData();
+    const TCHAR* const End = Cursor + Text.Len();
+    while (Cursor < End)
+    {
+        // 连续的普通 ASCII 字符批量写出
+        const TCHAR* RunEnd = Cursor;
+        while (RunEnd < End && IsPlainAscii(*RunEnd))
+        {
+            ++RunEnd;
+        }
+        if (RunEnd > Cursor)
+        {
+            WriteNarrow(Cursor, static_cast<int32>(RunEnd - Cursor));
+            Cursor = RunEnd;
+            continue;
+        }
+
+        switch (*Cursor)
+        {
+        case TEXT('"'):
+            WriteAscii("\\\"", 2);
+            break;
+        case TEXT('\\'):
+            WriteAscii("\\\\", 2);
+            break;
+        case TEXT('\b'):
+            WriteAscii("\\b", 2);
+            break;
+        case TEXT('\f'):
+            WriteAscii("\\f", 2);
+            break;
+        case TEXT('\n'):
+            WriteAscii("\\n", 2);
+            break;
+        case TEXT('\r'):
+            WriteAscii("\\r", 2);
+            break;
+        case TEXT('\t'):
+            WriteAscii("\\t", 2);
+            break;
+        default:
+            if (*Cursor < 0x20)
+            {
+                WriteUnicodeEscape(static_cast<uint32>(*Cursor));
+                break;
+            }
+            Cursor += WriteChar(Cursor, End);
+            continue;
+        }
+        ++Cursor;
+    }
+}
+
+void FJsonParsedWriter::WriteLazyString(const FNode& Node)
+{
+    const FString& Source = Document->LazyStrings->GetSource();
+    const FJsonSourceSpan& Span = *Node.LazySpan;
+    const TCHAR* Cursor = *Source + Span.Offset;
+    const TCHAR* const End = Cursor + Span.Length;
+
+    // 源文本中的转义内容已经是合法的 JSON，只需转换编码
+    const int32 RollbackNum = Bytes->Num();
+    WriteByte('"');
+    if (CopyStringBody(Cursor, End) && Cursor == End)
+    {
+        WriteByte('"');
+        return;
+    }
+
+    Rollback(RollbackNum);
+    FString Value;
+    Document->LazyStrings->GetString(FString(Node.Path), Value);
+    WriteString(Value);
+}
+
+void FJsonParsedWriter::WriteInt64(const int64 Value)
+{
+    ANSICHAR Buffer[24];
+    int32 Position = UE_ARRAY_COUNT(Buffer);
+    uint64 Magnitude = Value < 0 ? 0 - static_cast<uint64>(Value) : static_cast<uint64>(Value);
+    do
+    {
+        Buffer[--Position] = static_cast<ANSICHAR>('0' + Magnitude % 10);
+        Magnitude /= 10;
+    }
+    while (Magnitude > 0);
+    if (Value < 0)
+    {
+        Buffer[--Position] = '-';
+    }
+    WriteAscii(Buffer + Position, UE_ARRAY_COUNT(Buffer) - Position);
+}
+
+void FJsonParsedWriter::WriteDouble(const double Value, const bool bSinglePrecision)
+{
+    if (!FMath::IsFinite(Value))
+    {
+        WriteAscii("null", 4);
+        return;
+    }
+
+    // 先用较短的精度，不能还原原值时使用完整精度
+    ANSICHAR Buffer[40];
+    int32 Length = 0;
+    if (bSinglePrecision)
+    {
+        Length = FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%.7g", Value);
+        if (static_cast<float>(FCStringAnsi::Atod(Buffer)) != static_cast<float>(Value))
+        {
+            Length = FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%.9g", Value);
+        }
+    }
+    else
+    {
+        Length = FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%.15g", Value);
+        if (FCStringAnsi::Atod(Buffer) != Value)
+        {
+            Length = FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%.17g", Value);
+        }
+    }
+    Length = FMath::Clamp(Length, 0, static_cast<int32>(UE_ARRAY_COUNT(Buffer)) - 1);
+    WriteAscii(Buffer, Length);
+
+    // 整数值保留小数部分，重新解析时仍为浮点数
+    for (int32 Index = 0; Index < Length; ++Index)
+    {
+        if (Buffer[Index] == '.' || Buffer[Index] == 'e' || Buffer[Index] == 'E')
+        {
+            return;
+        }
+    }
+    WriteAscii(".0", 2);
+}
+
+// ============================================================================
+// 复用保存的文本
+// ============================================================================
+bool FJsonParsedWriter::CopyContainer(const FStringView Text)
+{
+    enum class EExpect : uint8
+    {
+        Value,
+        Key,
+        AfterValue
+    };
+
+    const int32 RollbackNum = Bytes->Num();
+    const auto Fail = [this, RollbackNum]()
+    {
+        Rollback(RollbackNum);
+        return false;
+    };
+
+    const TCHAR* Cursor = Text.GetData();
+    const TCHAR* const End = Cursor + Text.Len();
+    ContainerStack.Reset();
+    EExpect Expect = EExpect::Value;
+    while (true)
+    {
+        while (Cursor < End && IsWhitespace(*Cursor))
+        {
+            ++Cursor;
+        }
+        if (Expect == EExpect::AfterValue && ContainerStack.Num() == 0)
+        {
+            // 最外层容器结束后只允许空白
+            return Cursor == End ? true : Fail();
+        }
+        if (Cursor >= End)
+        {
+            return Fail();
+        }
+
+        const TCHAR Char = *Cursor;
+        if (Expect == EExpect::Key)
+        {
+            if (Char != TEXT('"'))
+            {
+                return Fail();
+            }
+            WriteByte('"');
+            if (!CopyStringBody(++Cursor, End) || Cursor >= End)
+            {
+                return Fail();
+            }
+            WriteByte('"');
+            ++Cursor;
+            while (Cursor < End && IsWhitespace(*Cursor))
+            {
+                ++Cursor;
+            }
+            if (Cursor >= End || *Cursor != TEXT(':'))
+            {
+                return Fail();
+            }
+            WriteByte(':');
+            ++Cursor;
+            Expect = EExpect::Value;
+            continue;
+        }
+
+        if (Expect == EExpect::AfterValue)
+        {
+            const TCHAR Open = ContainerStack.Last();
+            if (Char == TEXT(','))
+            {
+                WriteByte(',');
+                ++Cursor;
+                Expect = Open == TEXT('{') ? EExpect::Key : EExpect::Value;
+                continue;
+            }
+            if (Char != (Open == TEXT('{') ? TEXT('}') : TEXT(']')))
+            {
+                return Fail();
+            }
+            WriteByte(static_cast<uint8>(Char));
+            ++Cursor;
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6
+            ContainerStack.Pop(EAllowShrinking::No);
+#else
+            ContainerStack.Pop(false);
+#endif
+            continue;
+        }
+
+        // 期待一个值；最外层只能是对象或数组
+        if (ContainerStack.Num() == 0 && Char != TEXT('{') && Char != TEXT('['))
+        {
+            return Fail();
+        }
+        switch (Char)
+        {
+        case TEXT('{'):
+        case TEXT('['):
+            {
+                const TCHAR Close = Char == TEXT('{') ? TEXT('}') : TEXT(']');
+                WriteByte(static_cast<uint8>(Char));
+                ContainerStack.Add(Char);
+                ++Cursor;
+                while (Cursor < End && IsWhitespace(*Cursor))
+                {
+                    ++Cursor;
+                }
+                if (Cursor < End && *Cursor == Close)
+                {
+                    // 空容器
+                    WriteByte(static_cast<uint8>(Close));
+                    ++Cursor;
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6
+                    ContainerStack.Pop(EAllowShrinking::No);
+#else
+                    ContainerStack.Pop(false);
+#endif
+                    Expect = EExpect::AfterValue;
+                }
+                else
+                {
+                    Expect = Char == TEXT('{') ? EExpect::Key : EExpect::Value;
+                }
+            }
+            continue;
+        case TEXT('"'):
+            WriteByte('"');
+            if (!CopyStringBody(++Cursor, End) || Cursor >= End)
+            {
+                return Fail();
+            }
+            WriteByte('"');
+            ++Cursor;
+            break;
+        case TEXT('t'):
+            if (!MatchLiteral(Cursor, End, TEXT("true"), 4))
+            {
+                return Fail();
+            }
+            WriteAscii("true", 4);
+            Cursor += 4;
+            break;
+        case TEXT('f'):
+            if (!MatchLiteral(Cursor, End, TEXT("false"), 5))
+            {
+                return Fail();
+            }
+            WriteAscii("false", 5);
+            Cursor += 5;
+            break;
+        case TEXT('n'):
+            if (!MatchLiteral(Cursor, End, TEXT("null"), 4))
+            {
+                return Fail();
+            }
+            WriteAscii("null", 4);
+            Cursor += 4;
+            break;
+        default:
+            {
+                const int32 Length = ScanNumber(Cursor, End);
+                if (Length == 0)
+                {
+                    return Fail();
+                }
+                WriteNarrow(Cursor, Length);
+                Cursor += Length;
+            }
+            break;
+        }
+        Expect = EExpect::AfterValue;
+    }
+}
+
+bool FJsonParsedWriter::CopyStringBody(const TCHAR*& Cursor, const TCHAR* End)
+{
+    while (Cursor < End)
+    {
+        const TCHAR* RunEnd = Cursor;
+        while (RunEnd < End && IsPlainAscii(*RunEnd))
+        {
+            ++RunEnd;
+        }
+        if (RunEnd > Cursor)
+        {
+            WriteNarrow(Cursor, static_cast<int32>(RunEnd - Cursor));
+            Cursor = RunEnd;
+            continue;
+        }
+
+        const TCHAR Char = *Cursor;
+        if (Char == TEXT('"'))
+        {
+            return true;
+        }
+        if (Char == TEXT('\\'))
+        {
+            // 转义序列按原样复制
+            if (Cursor + 1 >= End)
+            {
+                return false;
+            }
+            const TCHAR Escaped = Cursor[1];
+            if (Escaped == TEXT('u'))
+            {
+                if (End - Cursor < 6 || !IsHexDigit(Cursor[2]) || !IsHexDigit(Cursor[3]) || !IsHexDigit(Cursor[4]) || !IsHexDigit(Cursor[5]))
+                {
+                    return false;
+                }
+                WriteNarrow(Cursor, 6);
+                Cursor += 6;
+                continue;
+            }
+            if (Escaped == 0 || !FCString::Strchr(TEXT("\"\\/bfnrt"), Escaped))
+            {
+                return false;
+            }
+            WriteNarrow(Cursor, 2);
+            Cursor += 2;
+            continue;
+        }
+        if (Char < 0x20)
+        {
+            return false;
+        }
+        Cursor += WriteChar(Cursor, End);
+    }
+    return true;
+}
+
+// ============================================================================
+// 编码
+// ============================================================================
+int32 FJsonParsedWriter::WriteChar(const TCHAR* Cursor, const TCHAR* End)
+{
+    uint32 CodePoint = static_cast<uint32>(*Cursor);
+    int32 Consumed = 1;
+    if (CodePoint >= 0xD800 && CodePoint <= 0xDFFF)
+    {
+        const uint32 Low = Cursor + 1 < End ? static_cast<uint32>(Cursor[1]) : 0;
+        if (CodePoint > 0xDBFF || Low < 0xDC00 || Low > 0xDFFF)
+        {
+            // 孤立的代理项无法编码为 UTF-8
+            WriteUnicodeEscape(CodePoint);
+            return 1;
+        }
+        CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+        Consumed = 2;
+    }
+    else if (CodePoint > 0x10FFFF)
+    {
+        CodePoint = 0xFFFD;
+    }
+
+    if (CodePoint < 0x80)
+    {
+        WriteByte(static_cast<uint8>(CodePoint));
+    }
+    else if (CodePoint < 0x800)
+    {
+        WriteByte(static_cast<uint8>(0xC0 | (CodePoint >> 6)));
+        WriteByte(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+    }
+    else if (CodePoint < 0x10000)
+    {
+        WriteByte(static_cast<uint8>(0xE0 | (CodePoint >> 12)));
+        WriteByte(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+        WriteByte(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+    }
+    else
+    {
+        WriteByte(static_cast<uint8>(0xF0 | (CodePoint >> 18)));
+        WriteByte(static_cast<uint8>(0x80 | ((CodePoint >> 12) & 0x3F)));
+        WriteByte(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+        WriteByte(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+    }
+    return Consumed;
+}
+
+void FJsonParsedWriter::WriteUnicodeEscape(const uint32 CodeUnit)
+{
+    static const ANSICHAR HexDigits[] = "0123456789ABCDEF";
+    const ANSICHAR Escape[6] = { '\\', 'u', HexDigits[(CodeUnit >> 12) & 0xF], HexDigits[(CodeUnit >> 8) & 0xF], HexDigits[(CodeUnit >> 4) & 0xF], HexDigits[CodeUnit & 0xF] };
+    WriteAscii(Escape, 6);
+}
+
+void FJsonParsedWriter::WriteAscii(const ANSICHAR* Text, const int32 Length)
+{
+    Bytes->Append(reinterpret_cast<const uint8*>(Text), Length);
+}
+
+void FJsonParsedWriter::WriteNarrow(const TCHAR* Text, const int32 Length)
+{
+    const int32 Start = Bytes->AddUninitialized(Length);
+    uint8* Dest = Bytes->GetData() + Start;
+    for (int32 Index = 0; Index < Length; ++Index)
+    {
+        Dest[Index] = static_cast<uint8>(Text[Index]);
+    }
+}
+
+void FJsonParsedWriter::Rollback(const int32 NumBytes)
+{
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6
+    Bytes->SetNum(NumBytes, EAllowShrinking::No);
+#else
+    Bytes->SetNum(NumBytes, false);
+#endif
+}
+
+void FJsonParsedWriter::FlushIfNeeded()
+{
+    if (Archive && Bytes->Num() >= ArchiveFlushBytes)
+    {
+        Archive->Serialize(Bytes->GetData(), Bytes->Num());
+        Bytes->Reset();
+    }
+}
+
+// ============================================================================
+// 蓝图接口
+// ============================================================================
+void UJsonWriterLibrary::WriteJsonString(const FParsedData& ParsedData, const TArray<FString>& ModifiedPaths, FString& JsonStr)
+{
+    FJsonParsedWriter Writer;
+    for (const FString& Path : ModifiedPaths)
+    {
+        Writer.MarkModified(Path);
+    }
+
+    TArray<uint8> Bytes;
+    Writer.Write(ParsedData, Bytes);
+    const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+    JsonStr = FString(Converter.Length(), Converter.Get());
+}
+
+void UJsonWriterLibrary::WriteJsonFile(const FParsedData& ParsedData, const TArray<FString>& ModifiedPaths, const FString& FilePath, bool& bIsValid)
+{
+    bIsValid = false;
+    const TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!FileWriter.IsValid())
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to open [ %s ]"), __FUNCTION__, *FilePath);
+        return;
+    }
+
+    FJsonParsedWriter Writer;
+    for (const FString& Path : ModifiedPaths)
+    {
+        Writer.MarkModified(Path);
+    }
+    bIsValid = Writer.Write(ParsedData, *FileWriter) && FileWriter->Close();
+    if (!bIsValid)
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to write [ %s ]"), __FUNCTION__, *FilePath);
+    }
+}
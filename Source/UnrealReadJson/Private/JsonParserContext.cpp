@@ -0,0 +1,135 @@
+﻿#include "JsonParserContext.h"
+#include "JsonLazyString.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    FCriticalSection PoolLock;
+    TArray<TUniquePtr<FJsonParserContext>> PooledContexts;
+}
+
+// ============================================================================
+// 解析上下文
+// ============================================================================
+bool FJsonParserContext::Parse(const FString& JsonStr, const FReadJsonOptions& Options, FParsedData& OutParsedData, const FJsonPreScan* PreScan)
+{
+    FJsonPreScan LocalPreScan;
+    if (!PreScan && Options.bPreScanCapacity)
+    {
+        JsonParseStrategy::PreScan(JsonStr, LocalPreScan, Options.bLazyStrings ? 0 : Options.LazyStringThreshold);
+        PreScan = &LocalPreScan;
+    }
+
+    // 没有预扫描结果时按上一次的数量预留，扫描栈与路径缓冲保留上一次的大小（不足时在扫描中增长）
+    ReservedEntries = PreScan ? PreScan->NumMembers : LastNumEntries;
+    int32 ReservedLazyStrings = 0;
+    if (Options.UsesLazyStrings())
+    {
+        ReservedLazyStrings = PreScan ? PreScan->NumLazyStrings : LastNumLazyStrings;
+        // 延迟记录的字符串不进入条目存储（上一次的条目数量已不含这些字符串）
+        if (PreScan)
+        {
+            ReservedEntries = FMath::Max(ReservedEntries - ReservedLazyStrings, 0);
+        }
+    }
+
+    // 使用数据表存储时由扁平化器预留数据表
+    if (!Options.UsesFlatTableStorage())
+    {
+        OutParsedData.ParsedDataMap.Reserve(ReservedEntries);
+    }
+    Flattener.Reserve(PreScan ? PreScan->MaxDepth : 0, PreScan ? PreScan->MaxPathLength : 0, ReservedEntries, ReservedLazyStrings);
+    if (!Flattener.Flatten(JsonStr, Options, OutParsedData))
+    {
+        return false;
+    }
+    LastNumEntries = OutParsedData.NumEntries();
+    LastNumLazyStrings = OutParsedData.LazyStrings.IsValid() ? OutParsedData.LazyStrings->Num() : 0;
+    return true;
+}
+
+// ============================================================================
+// 上下文池
+// ============================================================================
+FJsonParserContextPool::FScopedContext::FScopedContext()
+    : Context(Acquire())
+{
+}
+
+FJsonParserContextPool::FScopedContext::~FScopedContext()
+{
+    Release(MoveTemp(Context));
+}
+
+TUniquePtr<FJsonParserContext> FJsonParserContextPool::Acquire()
+{
+    {
+        FScopeLock Lock(&PoolLock);
+        if (PooledContexts.Num() > 0)
+        {
+            return PooledContexts.Pop();
+        }
+    }
+    return MakeUnique<FJsonParserContext>();
+}
+
+void FJsonParserContextPool::Release(TUniquePtr<FJsonParserContext>&& Context)
+{
+    if (!Context.IsValid())
+    {
+        return;
+    }
+
+    FScopeLock Lock(&PoolLock);
+    if (PooledContexts.Num() < MaxPooledContexts)
+    {
+        PooledContexts.Add(MoveTemp(Context));
+    }
+}
+
+void FJsonParserContextPool::Trim()
+{
+    TArray<TUniquePtr<FJsonParserContext>> Released;
+    {
+        FScopeLock Lock(&PoolLock);
+        Released = MoveTemp(PooledContexts);
+    }
+}
+
+// ============================================================================
+// 蓝图接口实现
+// ============================================================================
+void UJsonParserContextLibrary::ReadJson_Pooled(const FString& InJsonStr, const FReadJsonOptions& Options, FOnJsonParsed OnParsed)
+{
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [JsonStr = InJsonStr, Options, OnParsed]()
+    {
+        FParsedData ParsedData;
+        bool bIsValid = false;
+        ReadJson_PooledBlock(JsonStr, Options, ParsedData, bIsValid);
+
+        AsyncTask(ENamedThreads::GameThread, [OnParsed, ParsedData = MoveTemp(ParsedData), bIsValid]()
+        {
+            OnParsed.ExecuteIfBound(ParsedData, bIsValid);
+        });
+    });
+}
+
+void UJsonParserContextLibrary::ReadJson_PooledBlock(const FString& InJsonStr, const FReadJsonOptions& Options, FParsedData& OutParsedData, bool& bIsValid)
+{
+    bIsValid = false;
+    if (InJsonStr.IsEmpty())
+    {
+        OutParsedData = {};
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] JsonString is Invalid"), __FUNCTION__);
+        return;
+    }
+
+    const FJsonParserContextPool::FScopedContext Context;
+    if (!Context->Parse(InJsonStr, Options, OutParsedData))
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Deserialize Failed, %s"), __FUNCTION__, *Context->GetError());
+        return;
+    }
+    bIsValid = true;
+}
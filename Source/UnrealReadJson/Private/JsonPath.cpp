@@ -0,0 +1,176 @@
+﻿#include "JsonPath.h"
+
+namespace
+{
+    FORCEINLINE bool IsEscapedChar(const TCHAR Char)
+    {
+        return Char == TEXT('.') || Char == TEXT('\\');
+    }
+
+    template <typename TSegment>
+    const FJsonDataStruct* FindEntryBySegments(const FParsedData& ParsedData, const TConstArrayView<TSegment> Segments)
+    {
+        // 每个线程复用一个路径缓冲
+        static thread_local FString PathScratch;
+        PathScratch.Reset();
+        for (int32 Index = 0; Index < Segments.Num(); ++Index)
+        {
+            JsonPath::AppendSegment(PathScratch, Segments[Index], ParsedData.bEscapedPaths, Index == 0);
+        }
+        return ParsedData.FindEntry(PathScratch);
+    }
+}
+
+// ============================================================================
+// 路径段编码
+// ============================================================================
+bool JsonPath::NeedsEscape(const FStringView Segment)
+{
+    for (const TCHAR Char : Segment)
+    {
+        if (IsEscapedChar(Char))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void JsonPath::AppendSegment(FString& InOutPath, const FStringView Segment, const bool bEscape, const bool bFirstSegment)
+{
+    // 转义编码中空键名也是一个路径段，不能按路径是否为空判断
+    if (bEscape ? !bFirstSegment : !InOutPath.IsEmpty())
+    {
+        InOutPath.AppendChar(TEXT('.'));
+    }
+    if (!bEscape || !NeedsEscape(Segment))
+    {
+        InOutPath.Append(Segment.GetData(), Segment.Len());
+        return;
+    }
+
+    InOutPath.Reserve(InOutPath.Len() + Segment.Len() * 2);
+    for (const TCHAR Char : Segment)
+    {
+        if (IsEscapedChar(Char))
+        {
+            InOutPath.AppendChar(TEXT('\\'));
+        }
+        InOutPath.AppendChar(Char);
+    }
+}
+
+FString JsonPath::JoinSegments(const TConstArrayView<FString> Segments, const bool bEscape)
+{
+    int32 Length = 0;
+    for (const FString& Segment : Segments)
+    {
+        Length += Segment.Len() + 1;
+    }
+
+    FString Path;
+    Path.Reserve(Length);
+    for (int32 Index = 0; Index < Segments.Num(); ++Index)
+    {
+        AppendSegment(Path, Segments[Index], bEscape, Index == 0);
+    }
+    return Path;
+}
+
+void JsonPath::SplitPath(const FStringView NodePath, TArray<FString>& OutSegments, const bool bEscaped)
+{
+    OutSegments.Reset();
+    if (NodePath.IsEmpty())
+    {
+        return;
+    }
+
+    FString* Segment = &OutSegments.AddDefaulted_GetRef();
+    const TCHAR* Cursor = NodePath.GetData();
+    const TCHAR* const End = Cursor + NodePath.Len();
+    const TCHAR* SegmentStart = Cursor;
+    while (Cursor < End)
+    {
+        // '\' 后的字符按原样属于当前路径段（路径末尾单独的 '\' 保留）
+        if (bEscaped && *Cursor == TEXT('\\') && Cursor + 1 < End)
+        {
+            Segment->Append(SegmentStart, static_cast<int32>(Cursor - SegmentStart));
+            SegmentStart = Cursor + 1;
+            Cursor += 2;
+            continue;
+        }
+        if (*Cursor == TEXT('.'))
+        {
+            Segment->Append(SegmentStart, static_cast<int32>(Cursor - SegmentStart));
+            Segment = &OutSegments.AddDefaulted_GetRef();
+            SegmentStart = Cursor + 1;
+        }
+        ++Cursor;
+    }
+    Segment->Append(SegmentStart, static_cast<int32>(End - SegmentStart));
+}
+
+void JsonPath::FindSeparators(const FStringView NodePath, const bool bEscaped, TArray<int32, TInlineAllocator<16>>& OutSeparators)
+{
+    OutSeparators.Reset();
+    for (int32 Index = 0; Index < NodePath.Len(); ++Index)
+    {
+        if (bEscaped && NodePath[Index] == TEXT('\\'))
+        {
+            ++Index;
+        }
+        else if (NodePath[Index] == TEXT('.'))
+        {
+            OutSeparators.Add(Index);
+        }
+    }
+}
+
+const FJsonDataStruct* JsonPath::FindEntry(const FParsedData& ParsedData, const TConstArrayView<FString> Segments)
+{
+    return FindEntryBySegments(ParsedData, Segments);
+}
+
+const FJsonDataStruct* JsonPath::FindEntry(const FParsedData& ParsedData, const TConstArrayView<FStringView> Segments)
+{
+    return FindEntryBySegments(ParsedData, Segments);
+}
+
+// ============================================================================
+// 增量路径构建器
+// ============================================================================
+FJsonPathBuilder::FJsonPathBuilder(const bool bInEscape)
+    : bEscape(bInEscape)
+{
+}
+
+FJsonPathBuilder::FJsonPathBuilder(const FParsedData& ParsedData)
+    : bEscape(ParsedData.bEscapedPaths)
+{
+}
+
+void FJsonPathBuilder::Push(const FStringView Segment)
+{
+    SegmentStarts.Add(Path.Len());
+    JsonPath::AppendSegment(Path, Segment, bEscape, SegmentStarts.Num() == 1);
+}
+
+void FJsonPathBuilder::Pop()
+{
+    if (SegmentStarts.Num() == 0)
+    {
+        return;
+    }
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6
+    Path.LeftInline(SegmentStarts.Pop(EAllowShrinking::No), EAllowShrinking::No);
+#else
+    Path.LeftInline(SegmentStarts.Pop(false), false);
+#endif
+}
+
+void FJsonPathBuilder::Reset()
+{
+    Path.Reset();
+    SegmentStarts.Reset();
+}
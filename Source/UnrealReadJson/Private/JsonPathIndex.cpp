@@ -0,0 +1,438 @@
+﻿#include "JsonPathIndex.h"
+#include "JsonPath.h"
+#include "Async_ReadJson.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FJsonPathIndex::FJsonPathIndex()
+{
+    // 根节点
+    Nodes.AddDefaulted();
+}
+
+// ============================================================================
+// 构建与更新
+// ============================================================================
+void FJsonPathIndex::Build(const FParsedData& ParsedData)
+{
+    bEscapedPaths = ParsedData.bEscapedPaths;
+    bCaseSensitive = ParsedData.IsCaseSensitive();
+    Generation = ParsedData.Generation;
+    Nodes.Reset();
+    FreeNodes.Reset();
+    ArrayValueCache.Reset();
+    NumEntries = 0;
+
+    // 每个条目约对应一个节点，预分配避免扩容
+    Nodes.Reserve(ParsedData.NumPaths() + 1);
+    Nodes.AddDefaulted();
+
+    ParsedData.ForEachPath([this](const FString& NodePath, const FJsonDataStruct*)
+    {
+        AddPath(NodePath);
+    });
+}
+
+void FJsonPathIndex::AddPath(const FString& NodePath)
+{
+    TArray<FString> Segments;
+    JsonPath::SplitPath(NodePath, Segments, bEscapedPaths);
+
+    int32 NodeIndex = 0;
+    for (const FString& Segment : Segments)
+    {
+        if (const int32* ChildIndex = FindChild(Nodes[NodeIndex], Segment))
+        {
+            NodeIndex = *ChildIndex;
+            continue;
+        }
+
+        // 先分配再写入父节点，避免 Nodes 扩容后引用失效
+        const int32 NewIndex = AllocateNode(NodeIndex, Segment);
+        Nodes[NodeIndex].Children.Add(Segment, NewIndex);
+        NodeIndex = NewIndex;
+    }
+
+    // 路径的值可能已改变，丢弃缓存的数组
+    ArrayValueCache.Remove(NodeIndex);
+
+    FNode& Node = Nodes[NodeIndex];
+    if (!Node.bHasEntry)
+    {
+        Node.bHasEntry = true;
+        Node.Path = NodePath;
+        ++NumEntries;
+    }
+}
+
+void FJsonPathIndex::RemovePath(const FString& NodePath)
+{
+    int32 NodeIndex = FindNode(NodePath);
+    if (NodeIndex == INDEX_NONE || !Nodes[NodeIndex].bHasEntry)
+    {
+        return;
+    }
+
+    Nodes[NodeIndex].bHasEntry = false;
+    Nodes[NodeIndex].Path.Empty();
+    ArrayValueCache.Remove(NodeIndex);
+    --NumEntries;
+
+    // 回收不再有条目和子节点的节点；紧凑父节点的子节点表，之后添加的子节点仍排在末尾
+    while (NodeIndex != 0 && !Nodes[NodeIndex].bHasEntry && Nodes[NodeIndex].Children.IsEmpty())
+    {
+        const int32 ParentIndex = Nodes[NodeIndex].Parent;
+        Nodes[ParentIndex].Children.Remove(Nodes[NodeIndex].Segment);
+        Nodes[ParentIndex].Children.CompactStable();
+        Nodes[NodeIndex] = FNode();
+        FreeNodes.Add(NodeIndex);
+        NodeIndex = ParentIndex;
+    }
+}
+
+int32 FJsonPathIndex::AllocateNode(const int32 Parent, const FString& Segment)
+{
+    int32 NodeIndex;
+    if (FreeNodes.Num() > 0)
+    {
+        NodeIndex = FreeNodes.Pop();
+    }
+    else
+    {
+        NodeIndex = Nodes.AddDefaulted();
+    }
+
+    FNode& Node = Nodes[NodeIndex];
+    Node.Parent = Parent;
+    Node.Segment = Segment;
+    return NodeIndex;
+}
+
+// ============================================================================
+// 查询
+// ============================================================================
+int32 FJsonPathIndex::FindNode(const FString& NodePath) const
+{
+    TArray<FString> Segments;
+    JsonPath::SplitPath(NodePath, Segments, bEscapedPaths);
+    return FindNodeBySegments(Segments);
+}
+
+int32 FJsonPathIndex::FindNodeBySegments(const TConstArrayView<FString> Segments) const
+{
+    int32 NodeIndex = 0;
+    for (const FString& Segment : Segments)
+    {
+        const int32* ChildIndex = FindChild(Nodes[NodeIndex], Segment);
+        if (!ChildIndex)
+        {
+            return INDEX_NONE;
+        }
+        NodeIndex = *ChildIndex;
+    }
+    return NodeIndex;
+}
+
+bool FJsonPathIndex::Contains(const FString& NodePath) const
+{
+    const int32 NodeIndex = FindNode(NodePath);
+    return NodeIndex != INDEX_NONE && Nodes[NodeIndex].bHasEntry;
+}
+
+bool FJsonPathIndex::GetSubtreePaths(const FString& NodePath, const bool bIncludeSelf, TArray<FString>& OutPaths) const
+{
+    OutPaths.Reset();
+    const int32 NodeIndex = FindNode(NodePath);
+    if (NodeIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    if (bIncludeSelf && Nodes[NodeIndex].bHasEntry)
+    {
+        OutPaths.Add(Nodes[NodeIndex].Path);
+    }
+    for (const TPair<FString, int32>& Child : Nodes[NodeIndex].Children)
+    {
+        CollectSubtree(Child.Value, OutPaths);
+    }
+    return true;
+}
+
+bool FJsonPathIndex::GetChildren(const FString& NodePath, TArray<FString>& OutChildKeys, TArray<FString>& OutChildPaths) const
+{
+    OutChildKeys.Reset();
+    OutChildPaths.Reset();
+    const int32 NodeIndex = FindNode(NodePath);
+    if (NodeIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const FNode& Node = Nodes[NodeIndex];
+    OutChildKeys.Reserve(Node.Children.Num());
+    OutChildPaths.Reserve(Node.Children.Num());
+    for (const TPair<FString, int32>& Child : Node.Children)
+    {
+        if (Nodes[Child.Value].bHasEntry)
+        {
+            OutChildKeys.Add(Child.Key);
+            OutChildPaths.Add(Nodes[Child.Value].Path);
+        }
+    }
+    return true;
+}
+
+void FJsonPathIndex::MatchPattern(const FString& Pattern, TArray<FString>& OutPaths) const
+{
+    OutPaths.Reset();
+
+    TArray<FString> PatternSegments;
+    JsonPath::SplitPath(Pattern, PatternSegments, bEscapedPaths);
+
+    TSet<int32> Emitted;
+    MatchRecursive(0, PatternSegments, 0, Emitted, OutPaths);
+}
+
+int32 FJsonPathIndex::FindChildNode(const int32 NodeIndex, const FString& Segment) const
+{
+    const int32* ChildIndex = Nodes.IsValidIndex(NodeIndex) ? FindChild(Nodes[NodeIndex], Segment) : nullptr;
+    return ChildIndex ? *ChildIndex : INDEX_NONE;
+}
+
+void FJsonPathIndex::GetChildNodes(const int32 NodeIndex, TArray<int32>& OutChildIndices) const
+{
+    OutChildIndices.Reset();
+    if (!Nodes.IsValidIndex(NodeIndex))
+    {
+        return;
+    }
+    for (const TPair<FString, int32>& Child : Nodes[NodeIndex].Children)
+    {
+        OutChildIndices.Add(Child.Value);
+    }
+}
+
+const FString* FJsonPathIndex::GetNodePath(const int32 NodeIndex) const
+{
+    return Nodes.IsValidIndex(NodeIndex) && Nodes[NodeIndex].bHasEntry ? &Nodes[NodeIndex].Path : nullptr;
+}
+
+TSharedPtr<FJsonValue> FJsonPathIndex::GetArrayValue(const int32 NodeIndex, const FJsonDataStruct& Entry) const
+{
+    if (!JsonDataHelper::IsArrayEntry(&Entry))
+    {
+        return nullptr;
+    }
+
+    // 条目可能被就地改写（修改计数与路径数量不变），只有文本相同时才使用缓存
+    if (const FCachedArray* Cached = ArrayValueCache.Find(NodeIndex))
+    {
+        if (Cached->Text.Equals(Entry.StringValue, ESearchCase::CaseSensitive))
+        {
+            return Cached->Value;
+        }
+    }
+
+    TSharedPtr<FJsonValue> ArrayValue;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Entry.StringValue);
+    if (!FJsonSerializer::Deserialize(Reader, ArrayValue, FJsonSerializer::EFlags::StoreNumbersAsStrings) || !ArrayValue.IsValid() || ArrayValue->Type != EJson::Array)
+    {
+        ArrayValue.Reset();
+    }
+    ArrayValueCache.Add(NodeIndex, { Entry.StringValue, ArrayValue });
+    return ArrayValue;
+}
+
+void FJsonPathIndex::CollectSubtree(const int32 NodeIndex, TArray<FString>& OutPaths) const
+{
+    // 显式栈，避免深层文档导致栈溢出
+    TArray<int32, TInlineAllocator<32>> Stack;
+    Stack.Add(NodeIndex);
+
+    TArray<int32, TInlineAllocator<16>> ChildIndices;
+    while (Stack.Num() > 0)
+    {
+        const FNode& Node = Nodes[Stack.Pop()];
+        if (Node.bHasEntry)
+        {
+            OutPaths.Add(Node.Path);
+        }
+
+        // 逆序压栈，保证按插入顺序输出
+        ChildIndices.Reset();
+        for (const TPair<FString, int32>& Child : Node.Children)
+        {
+            ChildIndices.Add(Child.Value);
+        }
+        for (int32 Index = ChildIndices.Num() - 1; Index >= 0; --Index)
+        {
+            Stack.Add(ChildIndices[Index]);
+        }
+    }
+}
+
+void FJsonPathIndex::MatchRecursive(const int32 NodeIndex, const TArray<FString>& PatternSegments, const int32 PatternIndex,
+    TSet<int32>& Emitted, TArray<FString>& OutPaths) const
+{
+    const FNode& Node = Nodes[NodeIndex];
+    if (PatternIndex == PatternSegments.Num())
+    {
+        bool bAlreadyEmitted = false;
+        Emitted.Add(NodeIndex, &bAlreadyEmitted);
+        if (Node.bHasEntry && !bAlreadyEmitted)
+        {
+            OutPaths.Add(Node.Path);
+        }
+        return;
+    }
+
+    const FString& Segment = PatternSegments[PatternIndex];
+    if (Segment == TEXT("**"))
+    {
+        // 匹配0个路径段
+        MatchRecursive(NodeIndex, PatternSegments, PatternIndex + 1, Emitted, OutPaths);
+        // 匹配1个及以上路径段
+        for (const TPair<FString, int32>& Child : Node.Children)
+        {
+            MatchRecursive(Child.Value, PatternSegments, PatternIndex, Emitted, OutPaths);
+        }
+    }
+    else if (Segment == TEXT("*"))
+    {
+        for (const TPair<FString, int32>& Child : Node.Children)
+        {
+            MatchRecursive(Child.Value, PatternSegments, PatternIndex + 1, Emitted, OutPaths);
+        }
+    }
+    else if (Segment.Contains(TEXT("*")) || Segment.Contains(TEXT("?")))
+    {
+        for (const TPair<FString, int32>& Child : Node.Children)
+        {
+            if (Child.Key.MatchesWildcard(Segment, bCaseSensitive ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase))
+            {
+                MatchRecursive(Child.Value, PatternSegments, PatternIndex + 1, Emitted, OutPaths);
+            }
+        }
+    }
+    else if (const int32* ChildIndex = FindChild(Node, Segment))
+    {
+        MatchRecursive(*ChildIndex, PatternSegments, PatternIndex + 1, Emitted, OutPaths);
+    }
+}
+
+// ============================================================================
+// C++ 辅助函数实现
+// ============================================================================
+const FJsonPathIndex& JsonPathIndexHelper::GetOrBuildIndex(const FParsedData& ParsedData)
+{
+    // 修改计数不一致说明经写入接口修改过；路径数量不一致说明条目被直接修改过
+    if (!ParsedData.PathIndex.IsValid() || ParsedData.PathIndex->GetGeneration() != ParsedData.Generation
+        || ParsedData.PathIndex->Num() != ParsedData.NumPaths())
+    {
+        const TSharedPtr<FJsonPathIndex> NewIndex = MakeShared<FJsonPathIndex>();
+        NewIndex->Build(ParsedData);
+        ParsedData.PathIndex = NewIndex;
+    }
+    return *ParsedData.PathIndex;
+}
+
+void JsonPathIndexHelper::InvalidateIndex(FParsedData& ParsedData)
+{
+    ParsedData.PathIndex.Reset();
+}
+
+void JsonPathIndexHelper::UpdateIndex(FParsedData& ParsedData, const TArray<FString>& ChangedPaths)
+{
+    if (!ParsedData.PathIndex.IsValid() || ChangedPaths.IsEmpty())
+    {
+        return;
+    }
+
+    if (!ParsedData.PathIndex.IsUnique())
+    {
+        ParsedData.PathIndex.Reset();
+        return;
+    }
+
+    // 删除路径后数据的遍历顺序可能改变（Map 复用空位），此时重建索引，使子节点顺序与 ForEachPath 一致
+    for (const FString& ChangedPath : ChangedPaths)
+    {
+        if (!ParsedData.ContainsPath(ChangedPath) && ParsedData.PathIndex->Contains(ChangedPath))
+        {
+            ParsedData.PathIndex.Reset();
+            return;
+        }
+    }
+
+    for (const FString& ChangedPath : ChangedPaths)
+    {
+        if (ParsedData.ContainsPath(ChangedPath))
+        {
+            ParsedData.PathIndex->AddPath(ChangedPath);
+        }
+    }
+    ParsedData.PathIndex->SetGeneration(ParsedData.Generation);
+}
+
+// ============================================================================
+// 蓝图接口实现
+// ============================================================================
+void UJsonPathIndexLibrary::GetSubtreePaths(const FString& NodePath, const FParsedData& ParsedData, bool bIncludeSelf, TArray<FString>& Paths, bool& bIsValid)
+{
+    bIsValid = JsonPathIndexHelper::GetOrBuildIndex(ParsedData).GetSubtreePaths(NodePath, bIncludeSelf, Paths);
+    if (!bIsValid)
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] not found"), __FUNCTION__, *NodePath);
+    }
+}
+
+void UJsonPathIndexLibrary::GetChildPaths(const FString& NodePath, const FParsedData& ParsedData, TArray<FString>& ChildKeys, TArray<FString>& ChildPaths, bool& bIsValid)
+{
+    bIsValid = JsonPathIndexHelper::GetOrBuildIndex(ParsedData).GetChildren(NodePath, ChildKeys, ChildPaths);
+    if (!bIsValid)
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Node [ %s ] not found"), __FUNCTION__, *NodePath);
+    }
+}
+
+void UJsonPathIndexLibrary::GetChildNodes(const FString& NodePath, const FParsedData& ParsedData, TArray<FJsonNode>& ChildNodes, bool& bIsValid)
+{
+    ChildNodes.Reset();
+
+    TArray<FString> ChildKeys;
+    TArray<FString> ChildPaths;
+    GetChildPaths(NodePath, ParsedData, ChildKeys, ChildPaths, bIsValid);
+
+    ChildNodes.Reserve(ChildPaths.Num());
+    for (const FString& ChildPath : ChildPaths)
+    {
+        FJsonNode& ChildNode = ChildNodes.AddDefaulted_GetRef();
+        ChildNode.Key = ChildPath;
+        if (!ParsedData.GetValue(ChildPath, ChildNode.Value))
+        {
+            ChildNodes.Pop();
+        }
+    }
+}
+
+void UJsonPathIndexLibrary::FindPathsByPattern(const FString& Pattern, const FParsedData& ParsedData, TArray<FString>& Paths, bool& bIsValid)
+{
+    JsonPathIndexHelper::GetOrBuildIndex(ParsedData).MatchPattern(Pattern, Paths);
+    bIsValid = Paths.Num() > 0;
+}
+
+FString UJsonPathIndexLibrary::MakeNodePath(const TArray<FString>& Segments, const FParsedData& ParsedData)
+{
+    return JsonPath::JoinSegments(Segments, ParsedData.bEscapedPaths);
+}
+
+void UJsonPathIndexLibrary::SplitNodePath(const FString& NodePath, const FParsedData& ParsedData, TArray<FString>& Segments)
+{
+    JsonPath::SplitPath(NodePath, Segments, ParsedData.bEscapedPaths);
+}
+
+void UJsonPathIndexLibrary::GetNodeDataBySegments(const TArray<FString>& Segments, const FParsedData& ParsedData, FJsonNode& NodeData, bool& bIsValid)
+{
+    UAsync_ReadJson::GetNodeData(JsonPath::JoinSegments(Segments, ParsedData.bEscapedPaths), ParsedData, NodeData, bIsValid);
+}
@@ -0,0 +1,1046 @@
+﻿#include "JsonQuery.h"
+#include "Async_ReadJson.h"
+#include "JsonPathIndex.h"
+#include "Misc/ScopeLock.h"
+
+// ============================================================================
+// 查询编译
+// ============================================================================
+
+/**
+ * JSONPath 语法解析器
+ */
+class FJsonQueryParser
+{
+public:
+    FJsonQueryParser(const FString& InText, FJsonQuery& InQuery)
+        : Text(InText)
+        , Query(InQuery)
+    {
+    }
+
+    bool Parse(FString& OutError)
+    {
+        SkipWhitespace();
+        if (Peek() == TEXT('$'))
+        {
+            ++Pos;
+        }
+        else if (IsNameChar(Peek()))
+        {
+            // 允许省略 $，如 items[*].id
+            FJsonQuery::FStep Step;
+            FString Name;
+            ParseName(Name);
+            Step.Names.Add(MoveTemp(Name));
+            Query.Steps.Add(MoveTemp(Step));
+        }
+
+        while (Error.IsEmpty())
+        {
+            SkipWhitespace();
+            if (Pos >= Text.Len())
+            {
+                break;
+            }
+
+            FJsonQuery::FStep Step;
+            if (ConsumeString(TEXT("..")))
+            {
+                Step.bRecursive = true;
+                if (Peek() == TEXT('['))
+                {
+                    ParseBracket(Step);
+                }
+                else
+                {
+                    ParseDotSelector(Step);
+                }
+            }
+            else if (Consume(TEXT('.')))
+            {
+                ParseDotSelector(Step);
+            }
+            else if (Peek() == TEXT('['))
+            {
+                ParseBracket(Step);
+            }
+            else
+            {
+                Fail(TEXT("Unexpected character"));
+            }
+            Query.Steps.Add(MoveTemp(Step));
+        }
+
+        OutError = Error;
+        return Error.IsEmpty();
+    }
+
+private:
+    TCHAR Peek(const int32 Offset = 0) const
+    {
+        return Pos + Offset < Text.Len() ? Text[Pos + Offset] : TEXT('\0');
+    }
+
+    void SkipWhitespace()
+    {
+        while (Pos < Text.Len() && FChar::IsWhitespace(Text[Pos]))
+        {
+            ++Pos;
+        }
+    }
+
+    bool Consume(const TCHAR Char)
+    {
+        if (Peek() == Char)
+        {
+            ++Pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConsumeString(const TCHAR* String)
+    {
+        const int32 Length = FCString::Strlen(String);
+        if (FCString::Strncmp(*Text + FMath::Min(Pos, Text.Len()), String, Length) == 0 && Pos + Length <= Text.Len())
+        {
+            Pos += Length;
+            return true;
+        }
+        return false;
+    }
+
+    bool Expect(const TCHAR Char)
+    {
+        SkipWhitespace();
+        if (Consume(Char))
+        {
+            return true;
+        }
+        return Fail(FString::Printf(TEXT("Expected '%c'"), Char));
+    }
+
+    bool Fail(const FString& Message)
+    {
+        if (Error.IsEmpty())
+        {
+            Error = FString::Printf(TEXT("%s at position %d"), *Message, Pos);
+        }
+        return false;
+    }
+
+    static bool IsNameChar(const TCHAR Char)
+    {
+        if (Char == TEXT('\0') || FChar::IsWhitespace(Char))
+        {
+            return false;
+        }
+        return FCString::Strchr(TEXT(".[]()=!<>&|,'\"@"), Char) == nullptr;
+    }
+
+    bool ParseName(FString& OutName)
+    {
+        const int32 Start = Pos;
+        while (IsNameChar(Peek()))
+        {
+            ++Pos;
+        }
+        if (Pos == Start)
+        {
+            return Fail(TEXT("Expected name"));
+        }
+        OutName = Text.Mid(Start, Pos - Start);
+        return true;
+    }
+
+    bool ParseQuoted(FString& OutString)
+    {
+        const TCHAR Quote = Peek();
+        if (Quote != TEXT('\'') && Quote != TEXT('"'))
+        {
+            return Fail(TEXT("Expected quoted string"));
+        }
+        ++Pos;
+
+        OutString.Reset();
+        while (Pos < Text.Len() && Text[Pos] != Quote)
+        {
+            if (Text[Pos] == TEXT('\\') && Pos + 1 < Text.Len())
+            {
+                ++Pos;
+            }
+            OutString.AppendChar(Text[Pos++]);
+        }
+        return Consume(Quote) || Fail(TEXT("Unterminated string"));
+    }
+
+    bool TryParseInt(int32& OutValue)
+    {
+        const int32 Start = Pos;
+        if (Peek() == TEXT('-'))
+        {
+            ++Pos;
+        }
+        if (!FChar::IsDigit(Peek()))
+        {
+            Pos = Start;
+            return false;
+        }
+        while (FChar::IsDigit(Peek()))
+        {
+            ++Pos;
+        }
+        OutValue = FCString::Atoi(*Text.Mid(Start, Pos - Start));
+        return true;
+    }
+
+    void ParseDotSelector(FJsonQuery::FStep& Step)
+    {
+        if (Consume(TEXT('*')))
+        {
+            Step.Type = FJsonQuery::EStepType::Wildcard;
+            return;
+        }
+        FString Name;
+        if (ParseName(Name))
+        {
+            Step.Names.Add(MoveTemp(Name));
+        }
+    }
+
+    void ParseBracket(FJsonQuery::FStep& Step)
+    {
+        Expect(TEXT('['));
+        SkipWhitespace();
+
+        if (Consume(TEXT('*')))
+        {
+            Step.Type = FJsonQuery::EStepType::Wildcard;
+        }
+        else if (Consume(TEXT('?')))
+        {
+            Step.Type = FJsonQuery::EStepType::Filter;
+            Expect(TEXT('('));
+            Step.FilterRoot = ParseOr();
+            Expect(TEXT(')'));
+        }
+        else
+        {
+            do
+            {
+                SkipWhitespace();
+                int32 Number = 0;
+                if (Peek() == TEXT('\'') || Peek() == TEXT('"'))
+                {
+                    FString Name;
+                    ParseQuoted(Name);
+                    Step.Names.Add(MoveTemp(Name));
+                }
+                else if (const bool bHasStart = TryParseInt(Number); (SkipWhitespace(), Peek() == TEXT(':')))
+                {
+                    // 切片 [start:end:step]
+                    Step.Type = FJsonQuery::EStepType::Slice;
+                    Step.bHasSliceStart = bHasStart;
+                    Step.SliceStart = Number;
+                    ++Pos;
+                    SkipWhitespace();
+                    Step.bHasSliceEnd = TryParseInt(Step.SliceEnd);
+                    SkipWhitespace();
+                    if (Consume(TEXT(':')))
+                    {
+                        SkipWhitespace();
+                        if (!TryParseInt(Step.SliceStep) || Step.SliceStep == 0)
+                        {
+                            Step.SliceStep = 1;
+                        }
+                    }
+                    break;
+                }
+                else if (bHasStart)
+                {
+                    Step.Indices.Add(Number);
+                }
+                else
+                {
+                    Fail(TEXT("Expected name, index or slice"));
+                    return;
+                }
+                SkipWhitespace();
+            }
+            while (Consume(TEXT(',')));
+        }
+
+        Expect(TEXT(']'));
+    }
+
+    int32 AddFilterNode(FJsonQuery::FFilterNode&& Node)
+    {
+        return Query.FilterNodes.Add(MoveTemp(Node));
+    }
+
+    int32 ParseOr()
+    {
+        int32 Left = ParseAnd();
+        SkipWhitespace();
+        while (Error.IsEmpty() && ConsumeString(TEXT("||")))
+        {
+            FJsonQuery::FFilterNode Node;
+            Node.Op = FJsonQuery::EFilterOp::Or;
+            Node.Children = { Left, ParseAnd() };
+            Left = AddFilterNode(MoveTemp(Node));
+            SkipWhitespace();
+        }
+        return Left;
+    }
+
+    int32 ParseAnd()
+    {
+        int32 Left = ParseUnary();
+        SkipWhitespace();
+        while (Error.IsEmpty() && ConsumeString(TEXT("&&")))
+        {
+            FJsonQuery::FFilterNode Node;
+            Node.Op = FJsonQuery::EFilterOp::And;
+            Node.Children = { Left, ParseUnary() };
+            Left = AddFilterNode(MoveTemp(Node));
+            SkipWhitespace();
+        }
+        return Left;
+    }
+
+    int32 ParseUnary()
+    {
+        SkipWhitespace();
+        if (Peek() == TEXT('!') && Peek(1) != TEXT('='))
+        {
+            ++Pos;
+            FJsonQuery::FFilterNode Node;
+            Node.Op = FJsonQuery::EFilterOp::Not;
+            Node.Children = { ParseUnary() };
+            return AddFilterNode(MoveTemp(Node));
+        }
+        if (Consume(TEXT('(')))
+        {
+            const int32 Inner = ParseOr();
+            Expect(TEXT(')'));
+            return Inner;
+        }
+
+        FJsonQuery::FFilterNode Node;
+        if (!ParseOperand(Node.Left))
+        {
+            return INDEX_NONE;
+        }
+
+        SkipWhitespace();
+        static const TPair<const TCHAR*, FJsonQuery::EFilterOp> Operators[] =
+        {
+            { TEXT("=="), FJsonQuery::EFilterOp::Equal },
+            { TEXT("!="), FJsonQuery::EFilterOp::NotEqual },
+            { TEXT("<="), FJsonQuery::EFilterOp::LessEqual },
+            { TEXT(">="), FJsonQuery::EFilterOp::GreaterEqual },
+            { TEXT("<"),  FJsonQuery::EFilterOp::Less },
+            { TEXT(">"),  FJsonQuery::EFilterOp::Greater },
+        };
+        for (const TPair<const TCHAR*, FJsonQuery::EFilterOp>& Operator : Operators)
+        {
+            if (ConsumeString(Operator.Key))
+            {
+                Node.Op = Operator.Value;
+                if (!ParseOperand(Node.Right))
+                {
+                    return INDEX_NONE;
+                }
+                return AddFilterNode(MoveTemp(Node));
+            }
+        }
+
+        if (!Node.Left.bIsRelativePath)
+        {
+            Fail(TEXT("Expected comparison operator"));
+            return INDEX_NONE;
+        }
+        Node.Op = FJsonQuery::EFilterOp::Exists;
+        return AddFilterNode(MoveTemp(Node));
+    }
+
+    bool ParseOperand(FJsonQuery::FOperand& OutOperand)
+    {
+        SkipWhitespace();
+        FJsonQuery::FScalar& Literal = OutOperand.Literal;
+
+        if (Consume(TEXT('@')))
+        {
+            OutOperand.bIsRelativePath = true;
+            return ParseRelativePath(OutOperand.RelativePath);
+        }
+        if (Peek() == TEXT('\'') || Peek() == TEXT('"'))
+        {
+            Literal.Type = FJsonQuery::EScalarType::String;
+            return ParseQuoted(Literal.StringValue);
+        }
+        if (FChar::IsDigit(Peek()) || Peek() == TEXT('-'))
+        {
+            const int32 Start = Pos;
+            while (FChar::IsDigit(Peek()) || FCString::Strchr(TEXT("+-.eE"), Peek()) != nullptr)
+            {
+                ++Pos;
+            }
+            const FString Number = Text.Mid(Start, Pos - Start);
+            Literal.Type = FJsonQuery::EScalarType::Number;
+            if (!JsonNumberParser::ParseDouble(*Number, Number.Len(), Literal.NumberValue))
+            {
+                return false;
+            }
+            Literal.bIsInteger = JsonDataHelper::ClassifyNumberLiteral(*Number, Number.Len(), Literal.IntegerValue) != JsonDataHelper::ENumberLiteralKind::Double;
+            return true;
+        }
+        if (ConsumeString(TEXT("true")))
+        {
+            Literal.Type = FJsonQuery::EScalarType::Bool;
+            Literal.BoolValue = true;
+            return true;
+        }
+        if (ConsumeString(TEXT("false")))
+        {
+            Literal.Type = FJsonQuery::EScalarType::Bool;
+            Literal.BoolValue = false;
+            return true;
+        }
+        if (ConsumeString(TEXT("null")))
+        {
+            Literal.Type = FJsonQuery::EScalarType::Null;
+            return true;
+        }
+        return Fail(TEXT("Expected operand"));
+    }
+
+    bool ParseRelativePath(TArray<FJsonQuery::FPathSegment>& OutPath)
+    {
+        while (Error.IsEmpty())
+        {
+            FJsonQuery::FPathSegment Segment;
+            if (Peek() == TEXT('.') && Peek(1) != TEXT('.'))
+            {
+                ++Pos;
+                if (!ParseName(Segment.Name))
+                {
+                    return false;
+                }
+            }
+            else if (Consume(TEXT('[')))
+            {
+                SkipWhitespace();
+                if (Peek() == TEXT('\'') || Peek() == TEXT('"'))
+                {
+                    ParseQuoted(Segment.Name);
+                }
+                else if (TryParseInt(Segment.Index))
+                {
+                    Segment.bIsIndex = true;
+                }
+                else
+                {
+                    return Fail(TEXT("Expected name or index"));
+                }
+                if (!Expect(TEXT(']')))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                break;
+            }
+            OutPath.Add(MoveTemp(Segment));
+        }
+        return Error.IsEmpty();
+    }
+
+    const FString& Text;
+    FJsonQuery& Query;
+    int32 Pos = 0;
+    FString Error;
+};
+
+// ============================================================================
+// 查询求值
+// ============================================================================
+
+/**
+ * JSONPath 求值器
+ * 游标要么指向路径索引中的扁平化节点，要么指向数组内部的DOM值
+ */
+class FJsonQueryEvaluator
+{
+public:
+    FJsonQueryEvaluator(const FJsonQuery& InQuery, const FParsedData& InParsedData)
+        : Query(InQuery)
+        , ParsedData(InParsedData)
+        , Index(JsonPathIndexHelper::GetOrBuildIndex(InParsedData))
+    {
+    }
+
+    void Evaluate(TArray<FJsonNode>& OutResults)
+    {
+        TArray<FCursor> Cursors;
+        Cursors.Add(FCursor::MakeFlat(FJsonPathIndex::RootNode, FString()));
+
+        for (const FJsonQuery::FStep& Step : Query.Steps)
+        {
+            TArray<FCursor> Candidates;
+            if (Step.bRecursive)
+            {
+                for (const FCursor& Cursor : Cursors)
+                {
+                    CollectDescendantsOrSelf(Cursor, Candidates);
+                }
+            }
+            else
+            {
+                Candidates = MoveTemp(Cursors);
+            }
+
+            Cursors.Reset();
+            for (const FCursor& Candidate : Candidates)
+            {
+                ApplySelector(Step, Candidate, Cursors);
+            }
+            if (Cursors.IsEmpty())
+            {
+                break;
+            }
+        }
+
+        OutResults.Reserve(Cursors.Num());
+        for (const FCursor& Cursor : Cursors)
+        {
+            FJsonDataStruct Data;
+            if (ToData(Cursor, Data))
+            {
+                OutResults.Add({ Cursor.Path, MoveTemp(Data) });
+            }
+        }
+    }
+
+private:
+    struct FCursor
+    {
+        int32 NodeIndex = INDEX_NONE;
+        TSharedPtr<FJsonValue> Dom;
+        FString Path;
+
+        static FCursor MakeFlat(const int32 InNodeIndex, const FString& InPath)
+        {
+            FCursor Cursor;
+            Cursor.NodeIndex = InNodeIndex;
+            Cursor.Path = InPath;
+            return Cursor;
+        }
+
+        static FCursor MakeDom(const TSharedPtr<FJsonValue>& InDom, FString&& InPath)
+        {
+            FCursor Cursor;
+            Cursor.Dom = InDom;
+            Cursor.Path = MoveTemp(InPath);
+            return Cursor;
+        }
+    };
+
+    /** 获取扁平化游标的值（延迟记录的字符串反转义后写入 Storage） */
+    const FJsonDataStruct* GetEntry(const FCursor& Cursor, FJsonDataStruct& Storage) const
+    {
+        if (Cursor.Dom.IsValid())
+        {
+            return nullptr;
+        }
+        const FString* Path = Index.GetNodePath(Cursor.NodeIndex);
+        return Path ? ParsedData.FindValue(*Path, Storage) : nullptr;
+    }
+
+    /** 获取游标对应的数组（扁平化节点通过索引缓存解析） */
+    TSharedPtr<FJsonValue> GetArray(const FCursor& Cursor) const
+    {
+        if (Cursor.Dom.IsValid())
+        {
+            return Cursor.Dom->Type == EJson::Array ? Cursor.Dom : nullptr;
+        }
+        FJsonDataStruct Storage;
+        const FJsonDataStruct* Entry = GetEntry(Cursor, Storage);
+        return Entry ? Index.GetArrayValue(Cursor.NodeIndex, *Entry) : nullptr;
+    }
+
+    static FString MakeElementPath(const FString& ArrayPath, const int32 ElementIndex)
+    {
+        return FString::Printf(TEXT("%s[%d]"), *ArrayPath, ElementIndex);
+    }
+
+    void GetChildren(const FCursor& Cursor, TArray<FCursor>& OutChildren) const
+    {
+        if (!Cursor.Dom.IsValid())
+        {
+            TArray<int32> ChildIndices;
+            Index.GetChildNodes(Cursor.NodeIndex, ChildIndices);
+            for (const int32 ChildIndex : ChildIndices)
+            {
+                if (const FString* ChildPath = Index.GetNodePath(ChildIndex))
+                {
+                    OutChildren.Add(FCursor::MakeFlat(ChildIndex, *ChildPath));
+                }
+            }
+        }
+        else if (Cursor.Dom->Type == EJson::Object)
+        {
+            for (const auto& Elem : Cursor.Dom->AsObject()->Values)
+            {
+                OutChildren.Add(FCursor::MakeDom(Elem.Value, JsonDataHelper::BuildNodePath(Cursor.Path, Elem.Key)));
+            }
+            return;
+        }
+
+        if (const TSharedPtr<FJsonValue> Array = GetArray(Cursor))
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Elements = Array->AsArray();
+            for (int32 ElementIndex = 0; ElementIndex < Elements.Num(); ++ElementIndex)
+            {
+                OutChildren.Add(FCursor::MakeDom(Elements[ElementIndex], MakeElementPath(Cursor.Path, ElementIndex)));
+            }
+        }
+    }
+
+    bool GetChildByName(const FCursor& Cursor, const FString& Name, FCursor& OutChild) const
+    {
+        if (!Cursor.Dom.IsValid())
+        {
+            const int32 ChildIndex = Index.FindChildNode(Cursor.NodeIndex, Name);
+            const FString* ChildPath = Index.GetNodePath(ChildIndex);
+            if (ChildPath)
+            {
+                OutChild = FCursor::MakeFlat(ChildIndex, *ChildPath);
+            }
+            return ChildPath != nullptr;
+        }
+
+        if (Cursor.Dom->Type == EJson::Object)
+        {
+            if (const TSharedPtr<FJsonValue>* Child = Cursor.Dom->AsObject()->Values.Find(Name))
+            {
+                OutChild = FCursor::MakeDom(*Child, JsonDataHelper::BuildNodePath(Cursor.Path, Name));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool GetChildByIndex(const FCursor& Cursor, int32 ElementIndex, FCursor& OutChild) const
+    {
+        const TSharedPtr<FJsonValue> Array = GetArray(Cursor);
+        if (!Array.IsValid())
+        {
+            return false;
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>& Elements = Array->AsArray();
+        if (ElementIndex < 0)
+        {
+            ElementIndex += Elements.Num();
+        }
+        if (!Elements.IsValidIndex(ElementIndex))
+        {
+            return false;
+        }
+        OutChild = FCursor::MakeDom(Elements[ElementIndex], MakeElementPath(Cursor.Path, ElementIndex));
+        return true;
+    }
+
+    void CollectDescendantsOrSelf(const FCursor& Cursor, TArray<FCursor>& OutCursors) const
+    {
+        // 显式栈，先序遍历
+        TArray<FCursor> Stack;
+        Stack.Add(Cursor);
+        TArray<FCursor> Children;
+        while (Stack.Num() > 0)
+        {
+            FCursor Current = Stack.Pop();
+            Children.Reset();
+            GetChildren(Current, Children);
+            for (int32 ChildIndex = Children.Num() - 1; ChildIndex >= 0; --ChildIndex)
+            {
+                Stack.Add(MoveTemp(Children[ChildIndex]));
+            }
+            OutCursors.Add(MoveTemp(Current));
+        }
+    }
+
+    void ApplySelector(const FJsonQuery::FStep& Step, const FCursor& Cursor, TArray<FCursor>& OutCursors) const
+    {
+        switch (Step.Type)
+        {
+        case FJsonQuery::EStepType::Child:
+            {
+                FCursor Child;
+                for (const FString& Name : Step.Names)
+                {
+                    if (GetChildByName(Cursor, Name, Child))
+                    {
+                        OutCursors.Add(MoveTemp(Child));
+                    }
+                }
+                for (const int32 ElementIndex : Step.Indices)
+                {
+                    if (GetChildByIndex(Cursor, ElementIndex, Child))
+                    {
+                        OutCursors.Add(MoveTemp(Child));
+                    }
+                }
+                break;
+            }
+        case FJsonQuery::EStepType::Wildcard:
+            GetChildren(Cursor, OutCursors);
+            break;
+        case FJsonQuery::EStepType::Slice:
+            {
+                const TSharedPtr<FJsonValue> Array = GetArray(Cursor);
+                if (!Array.IsValid())
+                {
+                    break;
+                }
+                const TArray<TSharedPtr<FJsonValue>>& Elements = Array->AsArray();
+                const int32 Num = Elements.Num();
+                auto Normalize = [Num](const int32 Value) { return Value < 0 ? FMath::Max(Value + Num, 0) : FMath::Min(Value, Num); };
+                if (Step.SliceStep > 0)
+                {
+                    const int32 Start = Step.bHasSliceStart ? Normalize(Step.SliceStart) : 0;
+                    const int32 End = Step.bHasSliceEnd ? Normalize(Step.SliceEnd) : Num;
+                    for (int32 ElementIndex = Start; ElementIndex < End; ElementIndex += Step.SliceStep)
+                    {
+                        OutCursors.Add(FCursor::MakeDom(Elements[ElementIndex], MakeElementPath(Cursor.Path, ElementIndex)));
+                    }
+                }
+                else
+                {
+                    const int32 Start = Step.bHasSliceStart ? FMath::Min(Normalize(Step.SliceStart), Num - 1) : Num - 1;
+                    const int32 End = Step.bHasSliceEnd ? Normalize(Step.SliceEnd) : -1;
+                    for (int32 ElementIndex = Start; ElementIndex > End; ElementIndex += Step.SliceStep)
+                    {
+                        OutCursors.Add(FCursor::MakeDom(Elements[ElementIndex], MakeElementPath(Cursor.Path, ElementIndex)));
+                    }
+                }
+                break;
+            }
+        case FJsonQuery::EStepType::Filter:
+            {
+                TArray<FCursor> Children;
+                GetChildren(Cursor, Children);
+                for (FCursor& Child : Children)
+                {
+                    if (EvaluateFilter(Step.FilterRoot, Child))
+                    {
+                        OutCursors.Add(MoveTemp(Child));
+                    }
+                }
+                break;
+            }
+        default:
+            break;
+        }
+    }
+
+    FJsonQuery::FScalar ToScalar(const FCursor& Cursor) const
+    {
+        FJsonQuery::FScalar Scalar;
+        FJsonDataStruct Storage;
+        if (const FJsonDataStruct* Entry = GetEntry(Cursor, Storage))
+        {
+            if (JsonDataHelper::IsNullEntry(Entry))
+            {
+                // 与数组内部的 null 元素一致
+                Scalar.Type = FJsonQuery::EScalarType::Null;
+                return Scalar;
+            }
+            switch (Entry->ValueType)
+            {
+            case EValueType::Bool:
+                Scalar.Type = FJsonQuery::EScalarType::Bool;
+                Scalar.BoolValue = Entry->BoolValue;
+                break;
+            case EValueType::Int:
+            case EValueType::Int64:
+                Scalar.Type = FJsonQuery::EScalarType::Number;
+                Scalar.bIsInteger = true;
+                Scalar.IntegerValue = JsonDataHelper::TJsonValueTraits<int64>::GetValue(*Entry);
+                Scalar.NumberValue = static_cast<double>(Scalar.IntegerValue);
+                break;
+            case EValueType::Float:
+                Scalar.Type = FJsonQuery::EScalarType::Number;
+                Scalar.NumberValue = Entry->FloatValue;
+                Scalar.bSinglePrecision = true;
+                break;
+            case EValueType::Double:
+                Scalar.Type = FJsonQuery::EScalarType::Number;
+                Scalar.NumberValue = Entry->DoubleValue;
+                break;
+            default:
+                Scalar.Type = JsonDataHelper::IsContainerEntry(Entry) ? FJsonQuery::EScalarType::Container : FJsonQuery::EScalarType::String;
+                Scalar.StringValue = Entry->StringValue;
+                break;
+            }
+            return Scalar;
+        }
+
+        if (!Cursor.Dom.IsValid())
+        {
+            return Scalar;
+        }
+        switch (Cursor.Dom->Type)
+        {
+        case EJson::Null:
+            Scalar.Type = FJsonQuery::EScalarType::Null;
+            break;
+        case EJson::Boolean:
+            Scalar.Type = FJsonQuery::EScalarType::Bool;
+            Scalar.BoolValue = Cursor.Dom->AsBool();
+            break;
+        case EJson::Number:
+            {
+                FJsonDataStruct NumberData;
+                if (JsonDataHelper::MakeNumberData(*Cursor.Dom, NumberData))
+                {
+                    Scalar.Type = FJsonQuery::EScalarType::Number;
+                    Scalar.bIsInteger = NumberData.ValueType == EValueType::Int || NumberData.ValueType == EValueType::Int64;
+                    Scalar.IntegerValue = Scalar.bIsInteger ? JsonDataHelper::TJsonValueTraits<int64>::GetValue(NumberData) : 0;
+                    Scalar.NumberValue = Scalar.bIsInteger ? static_cast<double>(Scalar.IntegerValue) : NumberData.DoubleValue;
+                }
+                break;
+            }
+        case EJson::String:
+            Scalar.Type = FJsonQuery::EScalarType::String;
+            Scalar.StringValue = Cursor.Dom->AsString();
+            break;
+        case EJson::Object:
+        case EJson::Array:
+            Scalar.Type = FJsonQuery::EScalarType::Container;
+            break;
+        default:
+            break;
+        }
+        return Scalar;
+    }
+
+    FJsonQuery::FScalar ResolveOperand(const FJsonQuery::FOperand& Operand, const FCursor& Current) const
+    {
+        if (!Operand.bIsRelativePath)
+        {
+            return Operand.Literal;
+        }
+
+        FCursor Cursor = Current;
+        for (const FJsonQuery::FPathSegment& Segment : Operand.RelativePath)
+        {
+            FCursor Next;
+            if (!(Segment.bIsIndex ? GetChildByIndex(Cursor, Segment.Index, Next) : GetChildByName(Cursor, Segment.Name, Next)))
+            {
+                return FJsonQuery::FScalar();
+            }
+            Cursor = MoveTemp(Next);
+        }
+        return ToScalar(Cursor);
+    }
+
+    static bool CompareScalars(const FJsonQuery::FScalar& Left, const FJsonQuery::FScalar& Right, const FJsonQuery::EFilterOp Op)
+    {
+        using EScalarType = FJsonQuery::EScalarType;
+        using EFilterOp = FJsonQuery::EFilterOp;
+
+        if (Left.Type == EScalarType::Missing || Right.Type == EScalarType::Missing)
+        {
+            return false;
+        }
+
+        int32 Order = 0;
+        if (Left.Type == EScalarType::Number && Right.Type == EScalarType::Number)
+        {
+            if (Left.bIsInteger && Right.bIsInteger)
+            {
+                Order = Left.IntegerValue < Right.IntegerValue ? -1 : (Left.IntegerValue > Right.IntegerValue ? 1 : 0);
+            }
+            else if (Left.bSinglePrecision || Right.bSinglePrecision)
+            {
+                const float LeftValue = static_cast<float>(Left.NumberValue);
+                const float RightValue = static_cast<float>(Right.NumberValue);
+                Order = LeftValue < RightValue ? -1 : (LeftValue > RightValue ? 1 : 0);
+            }
+            else
+            {
+                Order = Left.NumberValue < Right.NumberValue ? -1 : (Left.NumberValue > Right.NumberValue ? 1 : 0);
+            }
+        }
+        else if (Left.Type == EScalarType::String && Right.Type == EScalarType::String)
+        {
+            Order = Left.StringValue.Compare(Right.StringValue, ESearchCase::CaseSensitive);
+        }
+        else
+        {
+            // 不同类型、布尔、null 和容器只支持相等比较
+            const bool bEqual = Left.Type == Right.Type
+                && (Left.Type == EScalarType::Null || (Left.Type == EScalarType::Bool && Left.BoolValue == Right.BoolValue));
+            return Op == EFilterOp::Equal ? bEqual : (Op == EFilterOp::NotEqual ? !bEqual : false);
+        }
+
+        switch (Op)
+        {
+        case EFilterOp::Equal:        return Order == 0;
+        case EFilterOp::NotEqual:     return Order != 0;
+        case EFilterOp::Less:         return Order < 0;
+        case EFilterOp::LessEqual:    return Order <= 0;
+        case EFilterOp::Greater:      return Order > 0;
+        case EFilterOp::GreaterEqual: return Order >= 0;
+        default:                      return false;
+        }
+    }
+
+    bool EvaluateFilter(const int32 NodeIndex, const FCursor& Current) const
+    {
+        if (!Query.FilterNodes.IsValidIndex(NodeIndex))
+        {
+            return false;
+        }
+
+        const FJsonQuery::FFilterNode& Node = Query.FilterNodes[NodeIndex];
+        switch (Node.Op)
+        {
+        case FJsonQuery::EFilterOp::Or:
+            return EvaluateFilter(Node.Children[0], Current) || EvaluateFilter(Node.Children[1], Current);
+        case FJsonQuery::EFilterOp::And:
+            return EvaluateFilter(Node.Children[0], Current) && EvaluateFilter(Node.Children[1], Current);
+        case FJsonQuery::EFilterOp::Not:
+            return !EvaluateFilter(Node.Children[0], Current);
+        case FJsonQuery::EFilterOp::Exists:
+            return ResolveOperand(Node.Left, Current).Type != FJsonQuery::EScalarType::Missing;
+        default:
+            return CompareScalars(ResolveOperand(Node.Left, Current), ResolveOperand(Node.Right, Current), Node.Op);
+        }
+    }
+
+    bool ToData(const FCursor& Cursor, FJsonDataStruct& OutData) const
+    {
+        if (!Cursor.Dom.IsValid())
+        {
+            const FString* Path = Index.GetNodePath(Cursor.NodeIndex);
+            return Path && ParsedData.GetValue(*Path, OutData);
+        }
+
+        TMap<FString, FJsonDataStruct> Converted;
+        UAsync_ReadJson::ParseJsonValue(Cursor.Dom, Cursor.Path, Converted);
+        if (FJsonDataStruct* Data = Converted.Find(Cursor.Path))
+        {
+            OutData = MoveTemp(*Data);
+            return true;
+        }
+        return false;
+    }
+
+    const FJsonQuery& Query;
+    const FParsedData& ParsedData;
+    const FJsonPathIndex& Index;
+};
+
+// ============================================================================
+// FJsonQuery
+// ============================================================================
+TSharedPtr<const FJsonQuery> FJsonQuery::Compile(const FString& QueryString, FString& OutError)
+{
+    const TSharedRef<FJsonQuery> Query = MakeShared<FJsonQuery>();
+    Query->QueryString = QueryString;
+
+    FJsonQueryParser Parser(QueryString, *Query);
+    if (!Parser.Parse(OutError))
+    {
+        return nullptr;
+    }
+    return Query;
+}
+
+void FJsonQuery::Evaluate(const FParsedData& ParsedData, TArray<FJsonNode>& OutResults) const
+{
+    OutResults.Reset();
+    FJsonQueryEvaluator Evaluator(*this, ParsedData);
+    Evaluator.Evaluate(OutResults);
+}
+
+// ============================================================================
+// C++ 辅助函数实现
+// ============================================================================
+namespace
+{
+    /** 编译结果缓存上限，超出后清空重建 */
+    constexpr int32 MaxCompiledQueryCacheSize = 256;
+
+    FCriticalSection CompiledQueryCacheLock;
+    TMap<FString, TSharedPtr<const FJsonQuery>> CompiledQueryCache;
+}
+
+TSharedPtr<const FJsonQuery> JsonQueryHelper::GetOrCompile(const FString& QueryString, FString& OutError)
+{
+    {
+        FScopeLock Lock(&CompiledQueryCacheLock);
+        if (const TSharedPtr<const FJsonQuery>* Cached = CompiledQueryCache.Find(QueryString))
+        {
+            // TMap 的 FString 键不区分大小写，查询中的字符串字面量区分大小写，需再次确认
+            if ((*Cached)->GetQueryString().Equals(QueryString, ESearchCase::CaseSensitive))
+            {
+                return *Cached;
+            }
+        }
+    }
+
+    TSharedPtr<const FJsonQuery> Query = FJsonQuery::Compile(QueryString, OutError);
+    if (Query.IsValid())
+    {
+        FScopeLock Lock(&CompiledQueryCacheLock);
+        if (CompiledQueryCache.Num() >= MaxCompiledQueryCacheSize)
+        {
+            CompiledQueryCache.Reset();
+        }
+        CompiledQueryCache.Add(QueryString, Query);
+    }
+    return Query;
+}
+
+// ============================================================================
+// 蓝图接口实现
+// ============================================================================
+void UJsonQueryLibrary::QueryJson(const FString& Query, const FParsedData& ParsedData, TArray<FJsonNode>& Results, FJsonArray& TypedValues, bool& bIsValid)
+{
+    Results.Reset();
+    TypedValues = {};
+    bIsValid = false;
+
+    FString Error;
+    const TSharedPtr<const FJsonQuery> CompiledQuery = JsonQueryHelper::GetOrCompile(Query, Error);
+    if (!CompiledQuery.IsValid())
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to compile query [ %s ]: %s"), __FUNCTION__, *Query, *Error);
+        return;
+    }
+
+    CompiledQuery->Evaluate(ParsedData, Results);
+    for (const FJsonNode& Result : Results)
+    {
+        switch (Result.Value.ValueType)
+        {
+        case EValueType::Bool:  TypedValues.BoolArray.Add(Result.Value.BoolValue); break;
+        case EValueType::Int:   TypedValues.IntArray.Add(Result.Value.IntValue); break;
+        case EValueType::Int64: TypedValues.Int64Array.Add(Result.Value.Int64Value); break;
+        case EValueType::Float:
+        case EValueType::Double:
+            // FloatArray 与 DoubleArray 一一对应
+            TypedValues.FloatArray.Add(Result.Value.FloatValue);
+            TypedValues.DoubleArray.Add(JsonDataHelper::TJsonValueTraits<double>::GetValue(Result.Value));
+            break;
+        default:                TypedValues.StringArray.Add(Result.Value.StringValue); break;
+        }
+    }
+    bIsValid = Results.Num() > 0;
+}
@@ -0,0 +1,213 @@
+﻿#include "JsonSchemaAccessor.h"
+#include "JsonParserContext.h"
+#include "JsonPath.h"
+#include "JsonSourceFlattener.h"
+
+/**
+ * 按路径段树扫描源文本：节点编号即路径段树的下标，键在扫描时逐个与当前节点的子节点比较，
+ * 不在树中的成员整体跳过，命中槽位的值直接写入槽位
+ */
+struct FJsonSchemaLayout::FSlotVisitor final : IJsonSourceVisitor
+{
+    FSlotVisitor(const FJsonSchemaLayout& InLayout, FJsonSchemaSlots& InSlots)
+        : Layout(InLayout)
+        , Slots(InSlots)
+    {
+    }
+
+    virtual int32 FindChild(const int32 ParentNode, const FStringView Key) const override
+    {
+        // 与 FJsonObject 的键查找一致，不区分大小写
+        for (const int32 ChildIndex : Layout.Tree[ParentNode].Children)
+        {
+            if (FStringView(Layout.Tree[ChildIndex].Key).Equals(Key, ESearchCase::IgnoreCase))
+            {
+                return ChildIndex;
+            }
+        }
+        return INDEX_NONE;
+    }
+
+    virtual bool HasChildren(const int32 Node) const override
+    {
+        return Layout.Tree[Node].Children.Num() > 0;
+    }
+
+    virtual bool WantsValue(const int32 Node) const override
+    {
+        return Layout.Tree[Node].SlotIndex != INDEX_NONE;
+    }
+
+    virtual void Visit(const int32 Node, const FJsonDataStruct& Value) override
+    {
+        Layout.AssignEntry(Layout.Tree[Node].SlotIndex, Value, Slots);
+    }
+
+    const FJsonSchemaLayout& Layout;
+    FJsonSchemaSlots& Slots;
+};
+
+FJsonSchemaLayout::FJsonSchemaLayout(const FJsonSchemaField* Fields, const int32 NumFields, const bool bInEscapedPaths)
+    : bEscapedPaths(bInEscapedPaths)
+{
+    Tree.AddDefaulted();
+    Slots.Reserve(NumFields);
+
+    TArray<FString> Segments;
+    for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+    {
+        const FJsonSchemaField& Field = Fields[FieldIndex];
+
+        FSlot& Slot = Slots.AddDefaulted_GetRef();
+        Slot.Path = Field.Path;
+        Slot.PathHash = GetTypeHash(Slot.Path);
+        Slot.Type = Field.Type;
+        switch (Field.Type)
+        {
+        case EValueType::Bool:  Slot.TypedIndex = NumBools++; break;
+        case EValueType::Int:   Slot.TypedIndex = NumInts++; break;
+        case EValueType::Float: Slot.TypedIndex = NumFloats++; break;
+        case EValueType::Int64: Slot.TypedIndex = NumInt64s++; break;
+        case EValueType::Double: Slot.TypedIndex = NumDoubles++; break;
+        default:                Slot.TypedIndex = NumStrings++; break;
+        }
+
+        // 插入路径段树
+        Segments.Reset();
+        JsonPath::SplitPath(Slot.Path, Segments, bEscapedPaths);
+        int32 NodeIndex = 0;
+        for (FString& Segment : Segments)
+        {
+            // 与扫描时的查找一致，不区分大小写
+            const int32* Existing = Tree[NodeIndex].Children.FindByPredicate([this, &Segment](const int32 ChildIndex)
+            {
+                return Tree[ChildIndex].Key.Equals(Segment, ESearchCase::IgnoreCase);
+            });
+            if (Existing)
+            {
+                NodeIndex = *Existing;
+                continue;
+            }
+
+            const int32 ChildIndex = Tree.AddDefaulted();
+            Tree[ChildIndex].Key = MoveTemp(Segment);
+            Tree[NodeIndex].Children.Add(ChildIndex);
+            NodeIndex = ChildIndex;
+        }
+        Tree[NodeIndex].SlotIndex = FieldIndex;
+    }
+}
+
+void FJsonSchemaLayout::InitSlots(FJsonSchemaSlots& OutSlots) const
+{
+    OutSlots.Bools.Init(false, NumBools);
+    OutSlots.Ints.Init(0, NumInts);
+    OutSlots.Floats.Init(0.0f, NumFloats);
+    OutSlots.Strings.Reset(NumStrings);
+    OutSlots.Strings.SetNum(NumStrings);
+    OutSlots.Int64s.Init(0, NumInt64s);
+    OutSlots.Doubles.Init(0.0, NumDoubles);
+    OutSlots.Present.Init(false, Slots.Num());
+}
+
+bool FJsonSchemaLayout::ReadFromJson(const FString& JsonStr, FJsonSchemaSlots& OutSlots) const
+{
+    InitSlots(OutSlots);
+
+    // 扫描源文本时沿路径段树解析槽位，不构建 FJsonObject，也不生成扁平化路径
+    FSlotVisitor Visitor(*this, OutSlots);
+    const FJsonParserContextPool::FScopedContext Context;
+    if (!Context->Scan(JsonStr, Visitor))
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to parse JSON: %s"), __FUNCTION__, *Context->GetError());
+        InitSlots(OutSlots);
+        return false;
+    }
+    return true;
+}
+
+int32 FJsonSchemaLayout::ReadFromParsedData(const FParsedData& ParsedData, FJsonSchemaSlots& OutSlots) const
+{
+    InitSlots(OutSlots);
+    if (ParsedData.bEscapedPaths != bEscapedPaths)
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Path encoding of the data does not match the layout (bEscapedPaths)"), __FUNCTION__);
+        return 0;
+    }
+
+    int32 NumAssigned = 0;
+    FJsonDataStruct LazyValue;
+    for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+    {
+        const FSlot& Slot = Slots[SlotIndex];
+        // 预先计算的哈希与 ParsedDataMap / 延迟记录的字符串一致，区分大小写的文档按路径查找
+        if (const FJsonDataStruct* Entry = ParsedData.FindValueByHash(Slot.PathHash, Slot.Path, LazyValue))
+        {
+            NumAssigned += AssignEntry(SlotIndex, *Entry, OutSlots) ? 1 : 0;
+        }
+    }
+    return NumAssigned;
+}
+
+bool FJsonSchemaLayout::AssignEntry(const int32 SlotIndex, const FJsonDataStruct& Entry, FJsonSchemaSlots& OutSlots) const
+{
+    const FSlot& Slot = Slots[SlotIndex];
+    switch (Slot.Type)
+    {
+    case EValueType::Bool:
+        if (Entry.ValueType != EValueType::Bool)
+        {
+            return false;
+        }
+        OutSlots.Bools[Slot.TypedIndex] = Entry.BoolValue;
+        break;
+    case EValueType::Int:
+        if (!JsonDataHelper::TJsonValueTraits<int32>::IsCompatible(Entry))
+        {
+            return false;
+        }
+        OutSlots.Ints[Slot.TypedIndex] = JsonDataHelper::TJsonValueTraits<int32>::GetValue(Entry);
+        break;
+    case EValueType::Int64:
+        if (!JsonDataHelper::TJsonValueTraits<int64>::IsCompatible(Entry))
+        {
+            return false;
+        }
+        OutSlots.Int64s[Slot.TypedIndex] = JsonDataHelper::TJsonValueTraits<int64>::GetValue(Entry);
+        break;
+    case EValueType::Float:
+    case EValueType::Double:
+        {
+            // 浮点槽位接受任意数值条目
+            double Number = 0.0;
+            switch (Entry.ValueType)
+            {
+            case EValueType::Int:    Number = Entry.IntValue; break;
+            case EValueType::Int64:  Number = static_cast<double>(Entry.Int64Value); break;
+            case EValueType::Float:  Number = Entry.FloatValue; break;
+            case EValueType::Double: Number = Entry.DoubleValue; break;
+            default:                 return false;
+            }
+            if (Slot.Type == EValueType::Float)
+            {
+                OutSlots.Floats[Slot.TypedIndex] = static_cast<float>(Number);
+            }
+            else
+            {
+                OutSlots.Doubles[Slot.TypedIndex] = Number;
+            }
+            break;
+        }
+    default:
+        // null 不填充字符串槽位
+        if (Entry.ValueType != EValueType::String || JsonDataHelper::IsNullEntry(&Entry))
+        {
+            return false;
+        }
+        OutSlots.Strings[Slot.TypedIndex] = Entry.StringValue;
+        break;
+    }
+
+    OutSlots.Present[SlotIndex] = true;
+    return true;
+}
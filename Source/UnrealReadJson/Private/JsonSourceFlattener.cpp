@@ -0,0 +1,993 @@
+﻿#include "JsonSourceFlattener.h"
+#include "JsonFlatTable.h"
+#include "JsonLazyString.h"
+#include "JsonNumberParser.h"
+
+namespace
+{
+    FORCEINLINE bool IsNumberChar(const TCHAR Char)
+    {
+        return (Char >= TEXT('0') && Char <= TEXT('9')) || Char == TEXT('-') || Char == TEXT('+') || Char == TEXT('.') || Char == TEXT('e') || Char == TEXT('E');
+    }
+
+    FORCEINLINE int32 HexValue(const TCHAR Char)
+    {
+        if (Char >= TEXT('0') && Char <= TEXT('9'))
+        {
+            return Char - TEXT('0');
+        }
+        if (Char >= TEXT('a') && Char <= TEXT('f'))
+        {
+            return Char - TEXT('a') + 10;
+        }
+        if (Char >= TEXT('A') && Char <= TEXT('F'))
+        {
+            return Char - TEXT('A') + 10;
+        }
+        return INDEX_NONE;
+    }
+
+    // 条目存储：ParsedDataMap 或 FJsonFlatTable（FParsedData::FlatEntries），路径哈希只计算一次
+    FORCEINLINE uint32 HashPath(const TMap<FString, FJsonDataStruct>& Map, const FString& Path)
+    {
+        return GetTypeHash(Path);
+    }
+
+    FORCEINLINE uint32 HashPath(const FJsonFlatTable& Table, const FString& Path)
+    {
+        return Table.HashKey(Path);
+    }
+
+    FORCEINLINE FJsonDataStruct* FindPath(TMap<FString, FJsonDataStruct>& Map, const uint32 Hash, const FString& Path)
+    {
+        return Map.FindByHash(Hash, Path);
+    }
+
+    FORCEINLINE FJsonDataStruct* FindPath(FJsonFlatTable& Table, const uint32 Hash, const FString& Path)
+    {
+        return const_cast<FJsonDataStruct*>(Table.FindByHash(Hash, Path));
+    }
+
+    FORCEINLINE FJsonDataStruct& AddPath(TMap<FString, FJsonDataStruct>& Map, const uint32 Hash, FString&& Path)
+    {
+        return Map.AddByHash(Hash, MoveTemp(Path), FJsonDataStruct());
+    }
+
+    FORCEINLINE FJsonDataStruct& AddPath(FJsonFlatTable& Table, const uint32 Hash, FString&& Path)
+    {
+        return Table.AddByHash(Hash, MoveTemp(Path), FJsonDataStruct());
+    }
+
+    FORCEINLINE void RemovePath(TMap<FString, FJsonDataStruct>& Map, const FString& Path)
+    {
+        Map.Remove(Path);
+    }
+
+    FORCEINLINE void RemovePath(FJsonFlatTable& Table, const FString& Path)
+    {
+        Table.Remove(Path);
+    }
+
+    void RemovePaths(TMap<FString, FJsonDataStruct>& Map, const TArray<FString>& Paths)
+    {
+        for (const FString& Path : Paths)
+        {
+            Map.Remove(Path);
+        }
+    }
+
+    void RemovePaths(FJsonFlatTable& Table, const TArray<FString>& Paths)
+    {
+        // 数据表每次删除都要重建哈希表，一次删除全部路径（只在 Default 下使用，与 TSet<FString> 一样不区分大小写）
+        const TSet<FString> PathSet(Paths);
+        Table.RemoveAll([&PathSet](const FString& Key) { return PathSet.Contains(Key); });
+    }
+
+    /**
+     * 列出对象节点先前的子路径（Default 下重复的对象键）
+     * 按对象的原始片段重新扁平化，开销与子树大小成正比，不遍历整个文档
+     */
+    void CollectChildPaths(const FString& ObjectPath, const FString& ObjectText, const bool bEscapeKeys, TArray<FString>& OutPaths)
+    {
+        FReadJsonOptions ChildOptions;
+        ChildOptions.bEscapePathKeys = bEscapeKeys;
+        FParsedData Children;
+        FJsonSourceFlattener ChildFlattener;
+        if (!ChildFlattener.Flatten(ObjectText, ChildOptions, Children))
+        {
+            return;
+        }
+
+        OutPaths.Reserve(OutPaths.Num() + Children.ParsedDataMap.Num());
+        for (const TPair<FString, FJsonDataStruct>& Child : Children.ParsedDataMap)
+        {
+            FString& ChildPath = OutPaths.Emplace_GetRef(ObjectPath);
+            ChildPath.AppendChar(TEXT('.'));
+            ChildPath.Append(Child.Key);
+        }
+    }
+}
+
+// ============================================================================
+// 扁平化
+// ============================================================================
+bool FJsonSourceFlattener::Flatten(const TSharedRef<const FString>& Source, const FReadJsonOptions& Options, FParsedData& OutParsedData)
+{
+    return FlattenText(*Source, Source, Options, OutParsedData);
+}
+
+bool FJsonSourceFlattener::Flatten(const FString& Source, const FReadJsonOptions& Options, FParsedData& OutParsedData)
+{
+    return FlattenText(Source, nullptr, Options, OutParsedData);
+}
+
+bool FJsonSourceFlattener::FlattenText(const FString& Source, const TSharedPtr<const FString>& SharedSource, const FReadJsonOptions& Options, FParsedData& OutParsedData)
+{
+    // 保留 Map 已分配的内存，重复使用同一个 FParsedData 时不再分配
+    OutParsedData.ParsedDataMap.Reset();
+    OutParsedData.PathIndex.Reset();
+    ++OutParsedData.Generation;
+    OutParsedData.LazyStrings.Reset();
+    OutParsedData.KeyCollisions.Reset();
+    OutParsedData.FlatEntries.Reset();
+    OutParsedData.bEscapedPaths = Options.bEscapePathKeys;
+    bEscapeKeys = Options.bEscapePathKeys;
+
+    bool bSucceeded = false;
+    if (Options.UsesFlatTableStorage())
+    {
+        const TSharedRef<FJsonFlatTable> Table = MakeShared<FJsonFlatTable>(Options.KeyPolicy);
+        Table->Reserve(ExpectedEntries);
+        bSucceeded = FlattenEntries(*Table, Source, SharedSource, Options, OutParsedData);
+        OutParsedData.FlatEntries = Table;
+    }
+    else
+    {
+        bSucceeded = FlattenEntries(OutParsedData.ParsedDataMap, Source, SharedSource, Options, OutParsedData);
+    }
+
+    if (OutParsedData.KeyCollisions.Num() > 0)
+    {
+        UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] %d paths collide with existing paths and were skipped (first: %s)"),
+            __FUNCTION__, OutParsedData.KeyCollisions.Num(), *OutParsedData.KeyCollisions[0]);
+    }
+    return bSucceeded;
+}
+
+template <typename TStore>
+bool FJsonSourceFlattener::FlattenEntries(TStore& Store, const FString& Source, const TSharedPtr<const FString>& SharedSource, const FReadJsonOptions& Options, FParsedData& OutParsedData)
+{
+    Error.Reset();
+    Stack.Reset();
+    PathLength = 0;
+    bHasDottedKeys = false;
+
+    Begin = *Source;
+    Cursor = Begin;
+    End = Begin + Source.Len();
+
+    TSharedPtr<FJsonLazyStrings> LazyStrings;
+
+    // Default 以外的策略不覆盖已有路径（含延迟记录的字符串），冲突的路径移入 KeyCollisions；
+    // Default 与 FJsonObject 一致以最后一次出现的值为准，先删除先前的值、其子节点以及延迟记录的字符串
+    const bool bReportCollisions = Options.KeyPolicy != EJsonKeyPolicy::Default;
+    const auto ClaimPath = [this, &Store, &LazyStrings, &OutParsedData, bReportCollisions](const uint32 Hash, FString& Path)
+    {
+        const FJsonDataStruct* Existing = FindPath(Store, Hash, Path);
+        const bool bExistingLazy = LazyStrings.IsValid() && LazyStrings->Find(Path);
+        if (!Existing && !bExistingLazy)
+        {
+            return true;
+        }
+        if (bReportCollisions)
+        {
+            OutParsedData.KeyCollisions.Add(MoveTemp(Path));
+            return false;
+        }
+
+        // 路径无歧义（转义键名，或尚未出现含 '.' 的键名）时先前的对象一定是同一对象中的重复键，删除其子节点；
+        // 否则可能只是不同键拼接出的相同路径（如 "a.b" 与 a 中的 b），与 FJsonObject 展开的结果一样保留
+        if (JsonDataHelper::IsObjectEntry(Existing) && (bEscapeKeys || !bHasDottedKeys))
+        {
+            TArray<FString> ChildPaths;
+            CollectChildPaths(Path, Existing->StringValue, bEscapeKeys, ChildPaths);
+            RemovePaths(Store, ChildPaths);
+            if (LazyStrings.IsValid())
+            {
+                for (const FString& ChildPath : ChildPaths)
+                {
+                    LazyStrings->Remove(ChildPath);
+                }
+            }
+        }
+        // 同一路径只保留在条目存储或延迟记录的字符串之一中
+        if (bExistingLazy)
+        {
+            LazyStrings->Remove(Path);
+        }
+        return true;
+    };
+
+    // 添加默认值条目，路径冲突时返回 nullptr
+    const auto AddEntry = [&Store, &ClaimPath](FString& Path) -> FJsonDataStruct*
+    {
+        const uint32 Hash = HashPath(Store, Path);
+        return ClaimPath(Hash, Path) ? &AddPath(Store, Hash, MoveTemp(Path)) : nullptr;
+    };
+
+    SkipWhitespace();
+    if (Cursor >= End || *Cursor != TEXT('{'))
+    {
+        return Fail(TEXT("Expected '{' at root"));
+    }
+    Stack.AddDefaulted_GetRef().StartOffset = 0;
+    ++Cursor;
+
+    // 刚进入对象时期望键或 '}'，读完一个成员后期望 ',' 或 '}'
+    bool bAfterMember = false;
+    while (Stack.Num() > 0)
+    {
+        SkipWhitespace();
+        if (Cursor >= End)
+        {
+            return Fail(TEXT("Unexpected end of input"));
+        }
+
+        if (*Cursor == TEXT('}'))
+        {
+            ++Cursor;
+            FFrame Frame = MoveTemp(Stack.Last());
+            Stack.Pop();
+            PathLength = Frame.ParentPathLength;
+            if (Stack.Num() > 0 && Frame.bHasEntry)
+            {
+                // 对象节点在进入时已占位（保持与子节点的先后顺序），结束时写入原始片段
+                if (FJsonDataStruct* Entry = FindPath(Store, Frame.EntryHash, Frame.EntryPath))
+                {
+                    const TCHAR* ObjectStart = Begin + Frame.StartOffset;
+                    Entry->StringValue = FString(FStringView(ObjectStart, static_cast<int32>(Cursor - ObjectStart)));
+                    Entry->ContainerKind = EJsonContainerKind::Object;
+                }
+            }
+            bAfterMember = true;
+            continue;
+        }
+
+        if (bAfterMember)
+        {
+            if (*Cursor != TEXT(','))
+            {
+                return Fail(TEXT("Expected ',' or '}'"));
+            }
+            ++Cursor;
+            SkipWhitespace();
+        }
+
+        // 键
+        if (Cursor >= End || *Cursor != TEXT('"'))
+        {
+            return Fail(TEXT("Expected object key"));
+        }
+        FJsonSourceSpan KeySpan;
+        if (!ScanString(KeySpan))
+        {
+            return false;
+        }
+        const int32 ParentPathLength = PathLength;
+        if (!AppendKey(KeySpan))
+        {
+            return false;
+        }
+
+        SkipWhitespace();
+        if (Cursor >= End || *Cursor != TEXT(':'))
+        {
+            return Fail(TEXT("Expected ':'"));
+        }
+        ++Cursor;
+        SkipWhitespace();
+        if (Cursor >= End)
+        {
+            return Fail(TEXT("Unexpected end of input"));
+        }
+
+        // 值
+        FString EntryPath(GetPathView());
+        switch (*Cursor)
+        {
+        case TEXT('{'):
+            {
+                FFrame& Frame = Stack.AddDefaulted_GetRef();
+                Frame.StartOffset = static_cast<int32>(Cursor - Begin);
+                Frame.ParentPathLength = ParentPathLength;
+                const uint32 EntryHash = HashPath(Store, EntryPath);
+                if (ClaimPath(EntryHash, EntryPath))
+                {
+                    AddPath(Store, EntryHash, FString(EntryPath));
+                    Frame.EntryHash = EntryHash;
+                    Frame.EntryPath = MoveTemp(EntryPath);
+                    Frame.bHasEntry = true;
+                }
+                ++Cursor;
+                bAfterMember = false;
+                // 路径保持为对象路径，直到对象结束
+                continue;
+            }
+        case TEXT('['):
+            {
+                const TCHAR* ArrayStart = Cursor;
+                if (!SkipValue())
+                {
+                    return false;
+                }
+                if (FJsonDataStruct* Entry = AddEntry(EntryPath))
+                {
+                    Entry->StringValue = FString(FStringView(ArrayStart, static_cast<int32>(Cursor - ArrayStart)));
+                    Entry->ContainerKind = EJsonContainerKind::Array;
+                }
+                break;
+            }
+        case TEXT('"'):
+            {
+                FJsonSourceSpan Span;
+                if (!ScanString(Span))
+                {
+                    return false;
+                }
+                if (Options.IsLazyString(Span.Length))
+                {
+                    const uint32 EntryHash = HashPath(Store, EntryPath);
+                    if (!ClaimPath(EntryHash, EntryPath))
+                    {
+                        break;
+                    }
+                    // 先前的值不是延迟记录的字符串时仍在条目存储中（Default）
+                    if (FindPath(Store, EntryHash, EntryPath))
+                    {
+                        RemovePath(Store, EntryPath);
+                    }
+                    if (!LazyStrings.IsValid())
+                    {
+                        // 源文本未被共享持有时复制一次
+                        TSharedPtr<const FString> LazySource = SharedSource;
+                        if (!LazySource.IsValid())
+                        {
+                            LazySource = MakeShared<FString>(Source);
+                        }
+                        LazyStrings = MakeShared<FJsonLazyStrings>(LazySource.ToSharedRef());
+                        LazyStrings->Reserve(ExpectedLazyStrings);
+                    }
+                    LazyStrings->Add(MoveTemp(EntryPath), Span);
+                    break;
+                }
+
+                FJsonDataStruct* Entry = AddEntry(EntryPath);
+                if (!Span.bHasEscapes)
+                {
+                    if (Entry)
+                    {
+                        Entry->StringValue = FString(FStringView(Begin + Span.Offset, Span.Length));
+                    }
+                }
+                else
+                {
+                    // 冲突的条目同样校验转义序列
+                    FString DiscardedValue;
+                    if (!Unescape(Begin + Span.Offset, Span.Length, Entry ? Entry->StringValue : DiscardedValue))
+                    {
+                        return Fail(TEXT("Invalid escape sequence"));
+                    }
+                }
+                break;
+            }
+        case TEXT('t'):
+        case TEXT('f'):
+            {
+                const bool bValue = *Cursor == TEXT('t');
+                if (!(bValue ? ConsumeLiteral(TEXT("true"), 4) : ConsumeLiteral(TEXT("false"), 5)))
+                {
+                    return Fail(TEXT("Invalid literal"));
+                }
+                if (FJsonDataStruct* Entry = AddEntry(EntryPath))
+                {
+                    *Entry = FJsonDataStruct::MakeBool(bValue);
+                }
+                break;
+            }
+        case TEXT('n'):
+            {
+                if (!ConsumeLiteral(TEXT("null"), 4))
+                {
+                    return Fail(TEXT("Invalid literal"));
+                }
+                // 与 ReadJson 一致：保留字段但值为空，记为 null
+                if (FJsonDataStruct* Entry = AddEntry(EntryPath))
+                {
+                    *Entry = FJsonDataStruct::MakeNull();
+                }
+                break;
+            }
+        default:
+            {
+                FJsonDataStruct NumberData;
+                bool bFinite = true;
+                if (!ScanNumber(NumberData, bFinite))
+                {
+                    return false;
+                }
+                if (bFinite)
+                {
+                    if (FJsonDataStruct* Entry = AddEntry(EntryPath))
+                    {
+                        *Entry = MoveTemp(NumberData);
+                    }
+                }
+                break;
+            }
+        }
+
+        PathLength = ParentPathLength;
+        bAfterMember = true;
+    }
+
+    SkipWhitespace();
+    if (Cursor != End)
+    {
+        return Fail(TEXT("Unexpected characters after root object"));
+    }
+
+    OutParsedData.LazyStrings = MoveTemp(LazyStrings);
+    return true;
+}
+
+bool FJsonSourceFlattener::Scan(const FString& Source, IJsonSourceVisitor& Visitor)
+{
+    Error.Reset();
+    ScanStack.Reset();
+
+    Begin = *Source;
+    Cursor = Begin;
+    End = Begin + Source.Len();
+
+    // 对象与数组节点的值为源文本中的原始片段
+    const auto VisitContainer = [this, &Visitor](const int32 Node, const TCHAR* ContainerStart, const EJsonContainerKind Kind)
+    {
+        FJsonDataStruct Value;
+        Value.StringValue = FString(FStringView(ContainerStart, static_cast<int32>(Cursor - ContainerStart)));
+        Value.ContainerKind = Kind;
+        Visitor.Visit(Node, Value);
+    };
+
+    SkipWhitespace();
+    if (Cursor >= End || *Cursor != TEXT('{'))
+    {
+        return Fail(TEXT("Expected '{' at root"));
+    }
+    ScanStack.AddDefaulted();
+    ++Cursor;
+
+    bool bAfterMember = false;
+    while (ScanStack.Num() > 0)
+    {
+        SkipWhitespace();
+        if (Cursor >= End)
+        {
+            return Fail(TEXT("Unexpected end of input"));
+        }
+
+        if (*Cursor == TEXT('}'))
+        {
+            ++Cursor;
+            const FScanFrame Frame = ScanStack.Pop();
+            if (ScanStack.Num() > 0 && Visitor.WantsValue(Frame.Node))
+            {
+                VisitContainer(Frame.Node, Begin + Frame.StartOffset, EJsonContainerKind::Object);
+            }
+            bAfterMember = true;
+            continue;
+        }
+
+        if (bAfterMember)
+        {
+            if (*Cursor != TEXT(','))
+            {
+                return Fail(TEXT("Expected ',' or '}'"));
+            }
+            ++Cursor;
+            SkipWhitespace();
+        }
+
+        // 键：不含转义的键直接引用源文本
+        if (Cursor >= End || *Cursor != TEXT('"'))
+        {
+            return Fail(TEXT("Expected object key"));
+        }
+        FJsonSourceSpan KeySpan;
+        if (!ScanString(KeySpan))
+        {
+            return false;
+        }
+        FStringView Key(Begin + KeySpan.Offset, KeySpan.Length);
+        if (KeySpan.bHasEscapes)
+        {
+            if (!Unescape(Key.GetData(), Key.Len(), KeyScratch))
+            {
+                return Fail(TEXT("Invalid escape sequence"));
+            }
+            Key = KeyScratch;
+        }
+        const int32 Node = Visitor.FindChild(ScanStack.Last().Node, Key);
+
+        SkipWhitespace();
+        if (Cursor >= End || *Cursor != TEXT(':'))
+        {
+            return Fail(TEXT("Expected ':'"));
+        }
+        ++Cursor;
+        SkipWhitespace();
+        if (Cursor >= End)
+        {
+            return Fail(TEXT("Unexpected end of input"));
+        }
+        bAfterMember = true;
+
+        // 不需要的成员只校验
+        if (Node == INDEX_NONE)
+        {
+            if (!SkipValue())
+            {
+                return false;
+            }
+            continue;
+        }
+
+        // 值
+        switch (*Cursor)
+        {
+        case TEXT('{'):
+        case TEXT('['):
+            {
+                if (*Cursor == TEXT('{') && Visitor.HasChildren(Node))
+                {
+                    ScanStack.Add({ static_cast<int32>(Cursor - Begin), Node });
+                    ++Cursor;
+                    bAfterMember = false;
+                    break;
+                }
+                const TCHAR* ContainerStart = Cursor;
+                if (!SkipValue())
+                {
+                    return false;
+                }
+                if (Visitor.WantsValue(Node))
+                {
+                    VisitContainer(Node, ContainerStart, *ContainerStart == TEXT('{') ? EJsonContainerKind::Object : EJsonContainerKind::Array);
+                }
+                break;
+            }
+        case TEXT('"'):
+            {
+                FJsonSourceSpan Span;
+                if (!ScanString(Span))
+                {
+                    return false;
+                }
+                FJsonDataStruct Value;
+                if (!Span.bHasEscapes)
+                {
+                    Value.StringValue = FString(FStringView(Begin + Span.Offset, Span.Length));
+                }
+                else if (!Unescape(Begin + Span.Offset, Span.Length, Value.StringValue))
+                {
+                    return Fail(TEXT("Invalid escape sequence"));
+                }
+                if (Visitor.WantsValue(Node))
+                {
+                    Visitor.Visit(Node, Value);
+                }
+                break;
+            }
+        case TEXT('t'):
+        case TEXT('f'):
+            {
+                const bool bValue = *Cursor == TEXT('t');
+                if (!(bValue ? ConsumeLiteral(TEXT("true"), 4) : ConsumeLiteral(TEXT("false"), 5)))
+                {
+                    return Fail(TEXT("Invalid literal"));
+                }
+                if (Visitor.WantsValue(Node))
+                {
+                    Visitor.Visit(Node, FJsonDataStruct::MakeBool(bValue));
+                }
+                break;
+            }
+        case TEXT('n'):
+            if (!ConsumeLiteral(TEXT("null"), 4))
+            {
+                return Fail(TEXT("Invalid literal"));
+            }
+            if (Visitor.WantsValue(Node))
+            {
+                Visitor.Visit(Node, FJsonDataStruct::MakeNull());
+            }
+            break;
+        default:
+            {
+                FJsonDataStruct NumberData;
+                bool bFinite = true;
+                if (!ScanNumber(NumberData, bFinite))
+                {
+                    return false;
+                }
+                if (bFinite && Visitor.WantsValue(Node))
+                {
+                    Visitor.Visit(Node, NumberData);
+                }
+                break;
+            }
+        }
+    }
+
+    SkipWhitespace();
+    if (Cursor != End)
+    {
+        return Fail(TEXT("Unexpected characters after root object"));
+    }
+    return true;
+}
+
+void FJsonSourceFlattener::Reserve(const int32 MaxDepth, const int32 MaxPathLength, const int32 NumEntries, const int32 NumLazyStrings)
+{
+    ExpectedEntries = NumEntries;
+    ExpectedLazyStrings = NumLazyStrings;
+    Stack.Reserve(MaxDepth);
+    if (PathBuffer.Num() < MaxPathLength)
+    {
+        PathBuffer.SetNumUninitialized(MaxPathLength);
+    }
+}
+
+// ============================================================================
+// 词法
+// ============================================================================
+bool FJsonSourceFlattener::Fail(const TCHAR* Message)
+{
+    Error = FString::Printf(TEXT("%s at offset %d"), Message, static_cast<int32>(Cursor - Begin));
+    return false;
+}
+
+void FJsonSourceFlattener::SkipWhitespace()
+{
+    while (Cursor < End && (*Cursor == TEXT(' ') || *Cursor == TEXT('\n') || *Cursor == TEXT('\r') || *Cursor == TEXT('\t')))
+    {
+        ++Cursor;
+    }
+}
+
+bool FJsonSourceFlattener::ScanString(FJsonSourceSpan& OutSpan)
+{
+    ++Cursor;
+    const TCHAR* ContentStart = Cursor;
+    OutSpan.bHasEscapes = false;
+
+    while (Cursor < End)
+    {
+        const TCHAR Char = *Cursor;
+        if (Char == TEXT('"'))
+        {
+            OutSpan.Offset = static_cast<int32>(ContentStart - Begin);
+            OutSpan.Length = static_cast<int32>(Cursor - ContentStart);
+            ++Cursor;
+            return true;
+        }
+        if (Char == TEXT('\\'))
+        {
+            // 只校验转义序列，反转义在需要时进行
+            OutSpan.bHasEscapes = true;
+            if (++Cursor >= End)
+            {
+                break;
+            }
+            if (*Cursor == TEXT('u'))
+            {
+                if (End - Cursor < 5 || HexValue(Cursor[1]) < 0 || HexValue(Cursor[2]) < 0 || HexValue(Cursor[3]) < 0 || HexValue(Cursor[4]) < 0)
+                {
+                    return Fail(TEXT("Invalid unicode escape"));
+                }
+                Cursor += 5;
+                continue;
+            }
+            if (!FCString::Strchr(TEXT("\"\\/bfnrt"), *Cursor))
+            {
+                return Fail(TEXT("Invalid escape sequence"));
+            }
+        }
+        else if (Char < 0x20)
+        {
+            return Fail(TEXT("Control character in string"));
+        }
+        ++Cursor;
+    }
+    return Fail(TEXT("Unterminated string"));
+}
+
+bool FJsonSourceFlattener::ScanNumber(FJsonDataStruct& OutData, bool& bOutFinite)
+{
+    const TCHAR* LiteralStart = Cursor;
+    while (Cursor < End && IsNumberChar(*Cursor))
+    {
+        ++Cursor;
+    }
+
+    bool bIsInteger = false;
+    int64 Integer = 0;
+    double Number = 0.0;
+    if (!JsonNumberParser::ParseNumber(LiteralStart, static_cast<int32>(Cursor - LiteralStart), bIsInteger, Integer, Number))
+    {
+        Cursor = LiteralStart;
+        return Fail(TEXT("Invalid number"));
+    }
+
+    bOutFinite = true;
+    if (bIsInteger)
+    {
+        OutData = Integer >= MIN_int32 && Integer <= MAX_int32
+            ? FJsonDataStruct::MakeInt(static_cast<int32>(Integer))
+            : FJsonDataStruct::MakeInt64(Integer);
+    }
+    else if (FMath::IsFinite(Number))
+    {
+        OutData = JsonDataHelper::MakeFloatingPointData(Number);
+    }
+    else
+    {
+        bOutFinite = false;
+    }
+    return true;
+}
+
+bool FJsonSourceFlattener::ConsumeLiteral(const TCHAR* Literal, const int32 Length)
+{
+    if (End - Cursor < Length || FCString::Strncmp(Cursor, Literal, Length) != 0)
+    {
+        return false;
+    }
+    Cursor += Length;
+    return true;
+}
+
+bool FJsonSourceFlattener::SkipValue()
+{
+    SkipStack.Reset();
+    while (true)
+    {
+        // 读取一个值
+        SkipWhitespace();
+        if (Cursor >= End)
+        {
+            return Fail(TEXT("Unexpected end of input"));
+        }
+
+        bool bOpenedContainer = false;
+        switch (*Cursor)
+        {
+        case TEXT('['):
+        case TEXT('{'):
+            {
+                const bool bIsObject = *Cursor == TEXT('{');
+                ++Cursor;
+                SkipWhitespace();
+                if (Cursor < End && *Cursor == (bIsObject ? TEXT('}') : TEXT(']')))
+                {
+                    ++Cursor;
+                    break;
+                }
+                SkipStack.Add(bIsObject ? TEXT('}') : TEXT(']'));
+                bOpenedContainer = true;
+                break;
+            }
+        case TEXT('"'):
+            {
+                FJsonSourceSpan Span;
+                if (!ScanString(Span))
+                {
+                    return false;
+                }
+                break;
+            }
+        case TEXT('t'):
+        case TEXT('f'):
+        case TEXT('n'):
+            if (!ConsumeLiteral(TEXT("true"), 4) && !ConsumeLiteral(TEXT("false"), 5) && !ConsumeLiteral(TEXT("null"), 4))
+            {
+                return Fail(TEXT("Invalid literal"));
+            }
+            break;
+        default:
+            {
+                FJsonDataStruct NumberData;
+                bool bFinite = true;
+                if (!ScanNumber(NumberData, bFinite))
+                {
+                    return false;
+                }
+                break;
+            }
+        }
+
+        // 值读取完毕，处理分隔符与容器结束
+        bool bNeedKey = bOpenedContainer && SkipStack.Last() == TEXT('}');
+        while (!bOpenedContainer && !bNeedKey)
+        {
+            if (SkipStack.IsEmpty())
+            {
+                return true;
+            }
+            SkipWhitespace();
+            if (Cursor >= End)
+            {
+                return Fail(TEXT("Unexpected end of input"));
+            }
+            if (*Cursor == SkipStack.Last())
+            {
+                ++Cursor;
+                SkipStack.Pop();
+                continue;
+            }
+            if (*Cursor != TEXT(','))
+            {
+                return Fail(TEXT("Expected ',' in container"));
+            }
+            ++Cursor;
+            if (SkipStack.Last() == TEXT('}'))
+            {
+                bNeedKey = true;
+            }
+            break;
+        }
+
+        if (bNeedKey)
+        {
+            SkipWhitespace();
+            FJsonSourceSpan KeySpan;
+            if (Cursor >= End || *Cursor != TEXT('"') || !ScanString(KeySpan))
+            {
+                return Error.IsEmpty() ? Fail(TEXT("Expected object key")) : false;
+            }
+            SkipWhitespace();
+            if (Cursor >= End || *Cursor != TEXT(':'))
+            {
+                return Fail(TEXT("Expected ':'"));
+            }
+            ++Cursor;
+        }
+    }
+}
+
+bool FJsonSourceFlattener::AppendKey(const FJsonSourceSpan& KeySpan)
+{
+    const TCHAR* KeyData = Begin + KeySpan.Offset;
+    int32 KeyLength = KeySpan.Length;
+    if (KeySpan.bHasEscapes)
+    {
+        if (!Unescape(KeyData, KeyLength, KeyScratch))
+        {
+            return Fail(TEXT("Invalid escape sequence"));
+        }
+        KeyData = *KeyScratch;
+        KeyLength = KeyScratch.Len();
+    }
+
+    // 转义时键名中的 '\' 与 '.' 各多占一个字符；不转义时记录是否出现过含 '.' 的键名（路径可能有歧义）
+    int32 NumEscapes = 0;
+    if (bEscapeKeys)
+    {
+        for (int32 Index = 0; Index < KeyLength; ++Index)
+        {
+            NumEscapes += (KeyData[Index] == TEXT('.') || KeyData[Index] == TEXT('\\')) ? 1 : 0;
+        }
+    }
+    else if (!bHasDottedKeys)
+    {
+        for (int32 Index = 0; Index < KeyLength && !bHasDottedKeys; ++Index)
+        {
+            bHasDottedKeys = KeyData[Index] == TEXT('.');
+        }
+    }
+
+    // 转义时按路径段数量添加分隔符（空键名也是一个路径段，见 JsonPath.h），根对象的成员不添加；不转义时与默认规则一致，按路径是否为空判断
+    const int32 Separator = (bEscapeKeys ? Stack.Num() > 1 : PathLength > 0) ? 1 : 0;
+    const int32 NewLength = PathLength + Separator + KeyLength + NumEscapes;
+    if (PathBuffer.Num() < NewLength)
+    {
+        PathBuffer.SetNumUninitialized(FMath::Max(NewLength, PathBuffer.Num() * 2));
+    }
+    if (Separator)
+    {
+        PathBuffer[PathLength] = TEXT('.');
+    }
+
+    TCHAR* Dest = PathBuffer.GetData() + PathLength + Separator;
+    if (NumEscapes == 0)
+    {
+        FMemory::Memcpy(Dest, KeyData, KeyLength * sizeof(TCHAR));
+    }
+    else
+    {
+        for (int32 Index = 0; Index < KeyLength; ++Index)
+        {
+            if (KeyData[Index] == TEXT('.') || KeyData[Index] == TEXT('\\'))
+            {
+                *Dest++ = TEXT('\\');
+            }
+            *Dest++ = KeyData[Index];
+        }
+    }
+    PathLength = NewLength;
+    return true;
+}
+
+bool FJsonSourceFlattener::Unescape(const TCHAR* Text, const int32 Length, FString& OutValue)
+{
+    OutValue.Reset(Length);
+    const TCHAR* Cursor = Text;
+    const TCHAR* const End = Text + Length;
+    while (Cursor < End)
+    {
+        // 整段追加不含转义的部分
+        const TCHAR* RunStart = Cursor;
+        while (Cursor < End && *Cursor != TEXT('\\'))
+        {
+            ++Cursor;
+        }
+        if (Cursor > RunStart)
+        {
+            OutValue.AppendChars(RunStart, static_cast<int32>(Cursor - RunStart));
+        }
+        if (Cursor >= End)
+        {
+            break;
+        }
+
+        if (++Cursor >= End)
+        {
+            return false;
+        }
+        switch (*Cursor)
+        {
+        case TEXT('"'):  OutValue.AppendChar(TEXT('"')); break;
+        case TEXT('\\'): OutValue.AppendChar(TEXT('\\')); break;
+        case TEXT('/'):  OutValue.AppendChar(TEXT('/')); break;
+        case TEXT('b'):  OutValue.AppendChar(TEXT('\b')); break;
+        case TEXT('f'):  OutValue.AppendChar(TEXT('\f')); break;
+        case TEXT('n'):  OutValue.AppendChar(TEXT('\n')); break;
+        case TEXT('r'):  OutValue.AppendChar(TEXT('\r')); break;
+        case TEXT('t'):  OutValue.AppendChar(TEXT('\t')); break;
+        case TEXT('u'):
+            {
+                if (End - Cursor < 5)
+                {
+                    return false;
+                }
+                int32 CodeUnit = 0;
+                for (int32 Index = 1; Index <= 4; ++Index)
+                {
+                    const int32 Digit = HexValue(Cursor[Index]);
+                    if (Digit < 0)
+                    {
+                        return false;
+                    }
+                    CodeUnit = (CodeUnit << 4) | Digit;
+                }
+                // UTF-16 代理对按代码单元原样追加
+                OutValue.AppendChar(static_cast<TCHAR>(CodeUnit));
+                Cursor += 4;
+                break;
+            }
+        default:
+            return false;
+        }
+        ++Cursor;
+    }
+    return true;
+}
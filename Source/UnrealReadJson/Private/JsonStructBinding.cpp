@@ -0,0 +1,459 @@
+﻿#include "JsonStructBinding.h"
+#include "JsonObjectConverter.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+// ============================================================================
+// 全局缓存
+// ============================================================================
+namespace
+{
+    /** 单个计划缓存的前缀数量上限，超出后清空重建 */
+    constexpr int32 MaxCachedPrefixes = 64;
+
+    /** 元数据中覆盖相对路径的键 */
+    const FName JsonPathMetaKey(TEXT("JsonPath"));
+
+    FRWLock PlanCacheLock;
+    TMap<const UScriptStruct*, TSharedPtr<const FJsonStructBindingPlan>> PlanCache;
+
+    FRWLock PathOverridesLock;
+    TMap<const UScriptStruct*, TMap<FName, FString>> PathOverrides;
+
+    /** 将条目还原为 FJsonValue，供 FJsonObjectConverter 使用 */
+    TSharedPtr<FJsonValue> MakeConverterValue(const FJsonDataStruct& Entry)
+    {
+        switch (Entry.ValueType)
+        {
+        case EValueType::Bool:  return MakeShared<FJsonValueBoolean>(Entry.BoolValue);
+        case EValueType::Int:   return MakeShared<FJsonValueNumber>(Entry.IntValue);
+        case EValueType::Float:
+        case EValueType::Int64:
+        case EValueType::Double: return JsonDataHelper::MakeWideNumberValue(Entry);
+        default:                break;
+        }
+
+        if (JsonDataHelper::IsContainerEntry(&Entry))
+        {
+            TSharedPtr<FJsonValue> Container;
+            const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Entry.StringValue);
+            if (FJsonSerializer::Deserialize(Reader, Container, FJsonSerializer::EFlags::StoreNumbersAsStrings) && Container.IsValid())
+            {
+                return Container;
+            }
+        }
+        return MakeShared<FJsonValueString>(Entry.StringValue);
+    }
+
+    FString EntryToString(const FJsonDataStruct& Entry)
+    {
+        switch (Entry.ValueType)
+        {
+        case EValueType::Bool:  return Entry.BoolValue ? TEXT("true") : TEXT("false");
+        case EValueType::Int:   return LexToString(Entry.IntValue);
+        case EValueType::Float: return LexToString(Entry.FloatValue);
+        case EValueType::Int64: return LexToString(Entry.Int64Value);
+        case EValueType::Double: return LexToString(Entry.DoubleValue);
+        default:                return Entry.StringValue;
+        }
+    }
+}
+
+// ============================================================================
+// 计划编译
+// ============================================================================
+
+/**
+ * 绑定计划编译器
+ * 深度优先遍历结构体属性，嵌套结构体展开为子路径并累加偏移
+ */
+class FJsonStructBindingCompiler
+{
+public:
+    static TSharedPtr<FJsonStructBindingPlan> Compile(const UScriptStruct* Struct)
+    {
+        TSharedPtr<FJsonStructBindingPlan> Plan = MakeShared<FJsonStructBindingPlan>();
+        Plan->Struct = Struct;
+        Plan->StructureSize = Struct->GetStructureSize();
+
+        FJsonStructBindingCompiler Compiler(*Plan);
+        Compiler.AddStruct(Struct, FString(), 0, 0);
+
+        TSharedRef<FJsonStructBindingPlan::FPathHandleArray> RootPaths = MakeShared<FJsonStructBindingPlan::FPathHandleArray>();
+        RootPaths->Reserve(Plan->RelativePaths.Num());
+        for (const FString& RelativePath : Plan->RelativePaths)
+        {
+            RootPaths->Emplace(CopyTemp(RelativePath));
+        }
+        Plan->RootPaths = RootPaths;
+        return Plan;
+    }
+
+private:
+    /** 嵌套结构体展开深度上限 */
+    static constexpr int32 MaxNestingDepth = 16;
+
+    explicit FJsonStructBindingCompiler(FJsonStructBindingPlan& InPlan)
+        : Plan(InPlan)
+    {
+    }
+
+    static FString GetRelativePath(const FProperty* Property, const TMap<FName, FString>* Overrides)
+    {
+        if (Overrides)
+        {
+            if (const FString* Override = Overrides->Find(Property->GetFName()))
+            {
+                return *Override;
+            }
+        }
+#if WITH_EDITORONLY_DATA
+        if (const FString* MetaPath = Property->FindMetaData(JsonPathMetaKey); MetaPath && !MetaPath->IsEmpty())
+        {
+            return *MetaPath;
+        }
+#endif
+        // 蓝图结构体的属性名带有后缀，使用编辑器中显示的名称
+        return Property->GetAuthoredName();
+    }
+
+    void AddStruct(const UScriptStruct* Struct, const FString& BasePath, const int32 BaseOffset, const int32 Depth)
+    {
+        TMap<FName, FString> Overrides;
+        {
+            FReadScopeLock Lock(PathOverridesLock);
+            if (const TMap<FName, FString>* Found = PathOverrides.Find(Struct))
+            {
+                Overrides = *Found;
+            }
+        }
+
+        for (TFieldIterator<FProperty> It(Struct); It; ++It)
+        {
+            const FProperty* Property = *It;
+            const FString Path = JsonDataHelper::BuildNodePath(BasePath, GetRelativePath(Property, Overrides.Num() > 0 ? &Overrides : nullptr));
+            const int32 Offset = BaseOffset + Property->GetOffset_ForInternal();
+
+            FJsonStructBindingPlan::FBinding Binding;
+            Binding.Property = Property;
+            Binding.Offset = Offset;
+            Binding.Kind = ClassifyProperty(Property, Binding.Enum);
+
+            const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+            if (StructProperty && Property->ArrayDim == 1 && Depth < MaxNestingDepth)
+            {
+                // 节点为字符串等非对象值时（如 FDateTime、FGuid）仍交给 FJsonObjectConverter
+                Binding.bSkipObjectEntry = true;
+                AddBinding(MoveTemp(Binding), Path);
+                AddStruct(StructProperty->Struct, Path, Offset, Depth + 1);
+                continue;
+            }
+            AddBinding(MoveTemp(Binding), Path);
+        }
+    }
+
+    void AddBinding(FJsonStructBindingPlan::FBinding&& Binding, const FString& Path)
+    {
+        Plan.Bindings.Add(MoveTemp(Binding));
+        Plan.RelativePaths.Add(Path);
+    }
+
+    static FJsonStructBindingPlan::EBindingKind ClassifyProperty(const FProperty* Property, const UEnum*& OutEnum)
+    {
+        using EBindingKind = FJsonStructBindingPlan::EBindingKind;
+
+        if (Property->ArrayDim != 1)
+        {
+            return EBindingKind::Converter;
+        }
+        if (Property->IsA<FBoolProperty>())
+        {
+            return EBindingKind::Bool;
+        }
+        if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+        {
+            OutEnum = EnumProperty->GetEnum();
+            return EBindingKind::Enum;
+        }
+        if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+        {
+            if (const UEnum* Enum = NumericProperty->GetIntPropertyEnum())
+            {
+                OutEnum = Enum;
+                return EBindingKind::Enum;
+            }
+            return NumericProperty->IsFloatingPoint() ? EBindingKind::Float : EBindingKind::Integer;
+        }
+        if (Property->IsA<FStrProperty>())
+        {
+            return EBindingKind::String;
+        }
+        if (Property->IsA<FNameProperty>())
+        {
+            return EBindingKind::Name;
+        }
+        if (Property->IsA<FTextProperty>())
+        {
+            return EBindingKind::Text;
+        }
+        return EBindingKind::Converter;
+    }
+
+    FJsonStructBindingPlan& Plan;
+};
+
+// ============================================================================
+// FJsonStructBindingPlan
+// ============================================================================
+FJsonStructBindingPlan::FPathHandle::FPathHandle(FString&& InPath)
+    : Path(MoveTemp(InPath))
+    , Hash(GetTypeHash(Path))
+{
+}
+
+TSharedPtr<const FJsonStructBindingPlan> FJsonStructBindingPlan::GetOrCompile(const UScriptStruct* Struct)
+{
+    if (!Struct)
+    {
+        return nullptr;
+    }
+
+    {
+        FReadScopeLock Lock(PlanCacheLock);
+        if (const TSharedPtr<const FJsonStructBindingPlan>* Cached = PlanCache.Find(Struct))
+        {
+            // 结构体被回收后需要重新编译计划；重新实例化与蓝图结构体的修改由模块注册的回调清空缓存（ClearPlanCache）
+            if ((*Cached)->Struct.Get() == Struct && (*Cached)->StructureSize == Struct->GetStructureSize())
+            {
+                return *Cached;
+            }
+        }
+    }
+
+    TSharedPtr<const FJsonStructBindingPlan> Plan = FJsonStructBindingCompiler::Compile(Struct);
+    {
+        FWriteScopeLock Lock(PlanCacheLock);
+        PlanCache.Add(Struct, Plan);
+    }
+    return Plan;
+}
+
+TSharedRef<const FJsonStructBindingPlan::FPathHandleArray> FJsonStructBindingPlan::ResolvePaths(const FString& PathPrefix) const
+{
+    if (PathPrefix.IsEmpty())
+    {
+        return RootPaths;
+    }
+
+    {
+        FReadScopeLock Lock(PrefixPathsLock);
+        if (const TSharedRef<const FPathHandleArray>* Cached = PrefixPaths.Find(PathPrefix))
+        {
+            return *Cached;
+        }
+    }
+
+    TSharedRef<FPathHandleArray> Paths = MakeShared<FPathHandleArray>();
+    Paths->Reserve(RelativePaths.Num());
+    for (const FString& RelativePath : RelativePaths)
+    {
+        Paths->Emplace(JsonDataHelper::BuildNodePath(PathPrefix, RelativePath));
+    }
+
+    FWriteScopeLock Lock(PrefixPathsLock);
+    if (PrefixPaths.Num() >= MaxCachedPrefixes)
+    {
+        PrefixPaths.Reset();
+    }
+    PrefixPaths.Add(PathPrefix, Paths);
+    return Paths;
+}
+
+int32 FJsonStructBindingPlan::Bind(const FParsedData& ParsedData, const FString& PathPrefix, void* StructMemory) const
+{
+    if (!StructMemory || ParsedData.NumPaths() == 0)
+    {
+        return 0;
+    }
+
+    const TSharedRef<const FPathHandleArray> Paths = ResolvePaths(PathPrefix);
+    int32 NumBound = 0;
+    FJsonDataStruct LazyValue;
+    for (int32 BindingIndex = 0; BindingIndex < Bindings.Num(); ++BindingIndex)
+    {
+        const FPathHandle& Handle = (*Paths)[BindingIndex];
+        // 预先计算的哈希与 ParsedDataMap / 延迟记录的字符串一致，区分大小写的文档按路径查找
+        if (const FJsonDataStruct* Entry = ParsedData.FindValueByHash(Handle.Hash, Handle.Path, LazyValue))
+        {
+            NumBound += ApplyBinding(Bindings[BindingIndex], *Entry, StructMemory) ? 1 : 0;
+        }
+    }
+    return NumBound;
+}
+
+bool FJsonStructBindingPlan::ApplyBinding(const FBinding& Binding, const FJsonDataStruct& Entry, void* StructMemory) const
+{
+    void* ValuePtr = static_cast<uint8*>(StructMemory) + Binding.Offset;
+
+    switch (Binding.Kind)
+    {
+    case EBindingKind::Bool:
+        {
+            const FBoolProperty* BoolProperty = CastFieldChecked<FBoolProperty>(Binding.Property);
+            if (Entry.ValueType == EValueType::Bool)
+            {
+                BoolProperty->SetPropertyValue(ValuePtr, Entry.BoolValue);
+                return true;
+            }
+            if (JsonDataHelper::TJsonValueTraits<int64>::IsCompatible(Entry))
+            {
+                BoolProperty->SetPropertyValue(ValuePtr, JsonDataHelper::TJsonValueTraits<int64>::GetValue(Entry) != 0);
+                return true;
+            }
+            return false;
+        }
+    case EBindingKind::Integer:
+        {
+            const FNumericProperty* NumericProperty = CastFieldChecked<FNumericProperty>(Binding.Property);
+            switch (Entry.ValueType)
+            {
+            case EValueType::Int:   NumericProperty->SetIntPropertyValue(ValuePtr, static_cast<int64>(Entry.IntValue)); return true;
+            case EValueType::Int64: NumericProperty->SetIntPropertyValue(ValuePtr, Entry.Int64Value); return true;
+            case EValueType::Float: NumericProperty->SetIntPropertyValue(ValuePtr, static_cast<int64>(Entry.FloatValue)); return true;
+            case EValueType::Double: NumericProperty->SetIntPropertyValue(ValuePtr, static_cast<int64>(Entry.DoubleValue)); return true;
+            case EValueType::Bool:  NumericProperty->SetIntPropertyValue(ValuePtr, static_cast<int64>(Entry.BoolValue)); return true;
+            default:                return false;
+            }
+        }
+    case EBindingKind::Float:
+        {
+            const FNumericProperty* NumericProperty = CastFieldChecked<FNumericProperty>(Binding.Property);
+            switch (Entry.ValueType)
+            {
+            case EValueType::Int:   NumericProperty->SetFloatingPointPropertyValue(ValuePtr, static_cast<double>(Entry.IntValue)); return true;
+            case EValueType::Int64: NumericProperty->SetFloatingPointPropertyValue(ValuePtr, static_cast<double>(Entry.Int64Value)); return true;
+            case EValueType::Float: NumericProperty->SetFloatingPointPropertyValue(ValuePtr, static_cast<double>(Entry.FloatValue)); return true;
+            case EValueType::Double: NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Entry.DoubleValue); return true;
+            default:                return false;
+            }
+        }
+    case EBindingKind::Enum:
+        {
+            int64 EnumValue = 0;
+            if (JsonDataHelper::TJsonValueTraits<int64>::IsCompatible(Entry))
+            {
+                EnumValue = JsonDataHelper::TJsonValueTraits<int64>::GetValue(Entry);
+            }
+            else if (Entry.ValueType == EValueType::String)
+            {
+                // 支持 "Value" 与 "EType::Value" 两种写法
+                EnumValue = Binding.Enum->GetValueByNameString(Entry.StringValue);
+                if (EnumValue == INDEX_NONE)
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                return false;
+            }
+
+            const FNumericProperty* UnderlyingProperty = nullptr;
+            if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Binding.Property))
+            {
+                UnderlyingProperty = EnumProperty->GetUnderlyingProperty();
+            }
+            else
+            {
+                UnderlyingProperty = CastFieldChecked<FNumericProperty>(Binding.Property);
+            }
+            UnderlyingProperty->SetIntPropertyValue(ValuePtr, EnumValue);
+            return true;
+        }
+    case EBindingKind::String:
+        *static_cast<FString*>(ValuePtr) = EntryToString(Entry);
+        return true;
+    case EBindingKind::Name:
+        *static_cast<FName*>(ValuePtr) = FName(*EntryToString(Entry));
+        return true;
+    case EBindingKind::Text:
+        *static_cast<FText*>(ValuePtr) = FText::FromString(EntryToString(Entry));
+        return true;
+    default:
+        break;
+    }
+
+    if (Binding.bSkipObjectEntry && JsonDataHelper::IsObjectEntry(&Entry))
+    {
+        return false;
+    }
+    return FJsonObjectConverter::JsonValueToUProperty(MakeConverterValue(Entry), const_cast<FProperty*>(Binding.Property), ValuePtr, 0, 0);
+}
+
+// ============================================================================
+// C++ 辅助函数实现
+// ============================================================================
+bool JsonStructBindingHelper::ReadStruct(const FParsedData& ParsedData, const FString& PathPrefix, const UScriptStruct* Struct, void* StructMemory)
+{
+    const TSharedPtr<const FJsonStructBindingPlan> Plan = FJsonStructBindingPlan::GetOrCompile(Struct);
+    return Plan.IsValid() && Plan->Bind(ParsedData, PathPrefix, StructMemory) > 0;
+}
+
+void JsonStructBindingHelper::RegisterPathOverride(const UScriptStruct* Struct, const FName PropertyName, const FString& RelativePath)
+{
+    if (!Struct)
+    {
+        return;
+    }
+
+    {
+        FWriteScopeLock Lock(PathOverridesLock);
+        PathOverrides.FindOrAdd(Struct).Add(PropertyName, RelativePath);
+    }
+
+    // 外层结构体的计划中展开了此结构体，无法只移除单个计划
+    ClearPlanCache();
+}
+
+void JsonStructBindingHelper::ClearPlanCache()
+{
+    FWriteScopeLock Lock(PlanCacheLock);
+    PlanCache.Reset();
+}
+
+// ============================================================================
+// 蓝图接口实现
+// ============================================================================
+void UJsonStructBindingLibrary::ReadJsonToStruct(const FParsedData& ParsedData, const FString& PathPrefix, int32& OutStruct, bool& bIsValid)
+{
+    // CustomThunk，实际逻辑位于 execReadJsonToStruct
+    checkNoEntry();
+}
+
+DEFINE_FUNCTION(UJsonStructBindingLibrary::execReadJsonToStruct)
+{
+    P_GET_STRUCT_REF(FParsedData, ParsedData);
+    P_GET_PROPERTY(FStrProperty, PathPrefix);
+
+    Stack.MostRecentPropertyAddress = nullptr;
+    Stack.MostRecentProperty = nullptr;
+    Stack.StepCompiledIn<FStructProperty>(nullptr);
+    void* StructMemory = Stack.MostRecentPropertyAddress;
+    const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+
+    P_GET_UBOOL_REF(bIsValid);
+    P_FINISH;
+
+    P_NATIVE_BEGIN;
+    if (!StructProperty || !StructMemory)
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] OutStruct must be connected to a struct"), __FUNCTION__);
+        bIsValid = false;
+    }
+    else
+    {
+        bIsValid = JsonStructBindingHelper::ReadStruct(ParsedData, PathPrefix, StructProperty->Struct, StructMemory);
+    }
+    P_NATIVE_END;
+}
@@ -1,18 +1,38 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UnrealReadJson.h"
+#include "JsonStructBinding.h"
+#include "UObject/UObjectGlobals.h"
 
 #define LOCTEXT_NAMESPACE "FUnrealReadJsonModule"
 
 void FUnrealReadJsonModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+#if WITH_EDITOR
+	// 结构体被重新实例化后，缓存的计划中的 FProperty 与偏移不再有效（外层结构体的计划中展开了内层结构体，因此全部清空）
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>& ReplacedObjects)
+	{
+		for (const TPair<UObject*, UObject*>& Pair : ReplacedObjects)
+		{
+			if (Cast<UScriptStruct>(Pair.Key))
+			{
+				JsonStructBindingHelper::ClearPlanCache();
+				return;
+			}
+		}
+	});
+#endif
 }
 
 void FUnrealReadJsonModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+#endif
+	JsonStructBindingHelper::ClearPlanCache();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -36,13 +36,6 @@ public:
     FReadJsonSignature OnReadJsonEnd;
     
 private:
-    // ========================================================================
-    // 常量定义
-    // ========================================================================
-
-    /** JSON大小自动检测阈值（字符数，默认100KB） */
-    static constexpr int32 LargeJsonThreshold = 100000;
-
     // ========================================================================
     // 成员变量
     // ========================================================================
@@ -54,8 +47,8 @@ private:
     /** 待解析的JSON字符串 */
     FString JsonStr;
     
-    /** 解析结果 */
-    TMap<FString, FJsonDataStruct> ParsedDataMap;
+    /** 解析结果（EndTask 时再次广播） */
+    FParsedData ParsedData;
 
     
     /* Function */
@@ -65,7 +58,7 @@ public:
     // ========================================================================
     
     /**
-     * 异步读取JSON（推荐用于初次解析或大型JSON）, 依据 LargeJsonThreshold 自动判断是否是大型Json（使用迭代解析避免栈溢出）
+     * 异步读取JSON（推荐用于初次解析或大型JSON），使用池化的解析上下文迭代展开，深层嵌套不会导致栈溢出
      * @param WorldContextObject 上下文对象（用于日志显示调用来源）
      * @param InJsonStr 待解析的JSON字符串
      * @return 异步任务对象
@@ -79,20 +72,17 @@ protected:
     virtual void Activate() override;
     
 public:
-    /** 统计JSON节点数量（用于预分配内存） */
-    static int32 CountJsonNodes(const TSharedPtr<FJsonObject>& JsonObject);
-
-    /** 加载并解析JSON */
+    /** 加载并解析JSON（使用 FJsonParserContextPool 中的解析上下文） */
     void LoadJson(const FString& JsonString);
 
-    /** 递归解析JSON（异步版本） */
-    void ParseJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& CurrentPath);
-
     /** 递归解析JSON（同步版本） */
     static void ParseJson_Block(const TSharedPtr<FJsonObject>& JsonObject, const FString& CurrentPath, FParsedData& OutParsedData);
 
-    /** 迭代解析JSON（适用于大型JSON） */
-    void ParseJsonIterative(const TSharedPtr<FJsonObject>& RootJson);
+    /** 迭代解析JSON（同步版本），RootPath 为 RootJson 自身的路径 */
+    static void ParseJsonIterative_Block(const TSharedPtr<FJsonObject>& RootJson, const FString& RootPath, TMap<FString, FJsonDataStruct>& OutMap);
+
+    /** 按根节点成员并行解析JSON（同步版本），各成员在独立的任务中迭代展开后合并 */
+    static void ParseJsonParallel_Block(const TSharedPtr<FJsonObject>& RootJson, TMap<FString, FJsonDataStruct>& OutMap);
 
     /** 解析单个JSON值并存储到Map中 */
     static void ParseJsonValue(const TSharedPtr<FJsonValue>& Value, const FString& Path, TMap<FString, FJsonDataStruct>& OutMap);
@@ -109,13 +99,6 @@ public:
     
     /** 获取调用者名称（用于日志） */
     FString GetCallerName() const;
-
-    /**
-     * 判断是否应使用迭代解析（基于JSON字符串长度自动检测）
-     * @param JsonStr JSON字符串
-     * @return 如果长度超过LargeJsonThreshold返回true
-     */
-    static bool ShouldUseIterativeParsing(const FString& JsonStr);
     
     
 public:
@@ -133,6 +116,32 @@ public:
     UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Read", DisplayName = "ReadJson", meta = (DefaultToSelf = "WorldContextObject"))
     static void ReadJson_Block(const UObject* WorldContextObject, const FString& InJsonStr, FParsedData& OutParsedData, bool& bIsValid);
 
+    /**
+     * 按选项同步读取JSON
+     * 按 Options.Strategy 选择解析策略（Auto 时预扫描深度与扇出后选择，见 JsonParseStrategy.h）
+     * 启用 LazyStringThreshold 或 bLazyStrings 时直接扫描源文本（FJsonSourceFlattener），不构建 FJsonObject，
+     * 延迟记录的字符串只保存源文本区间，读取时才构造；对象与数组节点保存源文本中的原始片段
+     * @param WorldContextObject 上下文对象
+     * @param InJsonStr 待解析的JSON字符串
+     * @param Options 解析选项
+     * @param OutParsedData 解析结果
+     * @param bIsValid 是否解析成功
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Read", DisplayName = "ReadJson_WithOptions", meta = (DefaultToSelf = "WorldContextObject"))
+    static void ReadJson_Block_WithOptions(const UObject* WorldContextObject, const FString& InJsonStr, const FReadJsonOptions& Options, FParsedData& OutParsedData, bool& bIsValid);
+
+    /**
+     * 按选项同步读取JSON并输出统计（实际使用的策略、预扫描结果与各阶段耗时）
+     * @param WorldContextObject 上下文对象
+     * @param InJsonStr 待解析的JSON字符串
+     * @param Options 解析选项
+     * @param OutParsedData 解析结果
+     * @param OutStats 解析统计
+     * @param bIsValid 是否解析成功
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Read", DisplayName = "ReadJson_WithStats", meta = (DefaultToSelf = "WorldContextObject"))
+    static void ReadJson_Block_WithStats(const UObject* WorldContextObject, const FString& InJsonStr, const FReadJsonOptions& Options, FParsedData& OutParsedData, FReadJsonStats& OutStats, bool& bIsValid);
+
     // ========================================================================
     // 获取节点值 - 单值
     // ========================================================================
@@ -141,6 +150,13 @@ public:
     UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToValue")
     static void GetNodeData(const FString& NodePath, const FParsedData& ParsedData, FJsonNode& NodeData, bool& bIsValid);
 
+    /**
+     * 获取全部节点（按存储顺序，延迟记录的字符串在最后）
+     * 与存储方式无关：以数据表存储的文档 ParsedDataMap 为空，蓝图中需要遍历全部节点时使用此函数
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToValue")
+    static void GetAllNodes(const FParsedData& ParsedData, TArray<FJsonNode>& Nodes, bool& bIsValid);
+
     /** 获取字符串值 */
     UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToValue", DisplayName = "GetNodeValue_ToString")
     static void GetNodeValueToString(const FString& NodePath, const FParsedData& ParsedData, FString& NodeValue, bool& bIsValid);
@@ -153,10 +169,25 @@ public:
     UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToValue", DisplayName = "GetNodeValue_ToFloat")
     static void GetNodeValueToFloat(const FString& NodePath, const FParsedData& ParsedData, float& NodeValue, bool& bIsValid);
 
+    /** 获取64位整数值（同时接受 Int 节点） */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToValue", DisplayName = "GetNodeValue_ToInt64")
+    static void GetNodeValueToInt64(const FString& NodePath, const FParsedData& ParsedData, int64& NodeValue, bool& bIsValid);
+
+    /** 获取双精度值（同时接受 Float 节点） */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToValue", DisplayName = "GetNodeValue_ToDouble")
+    static void GetNodeValueToDouble(const FString& NodePath, const FParsedData& ParsedData, double& NodeValue, bool& bIsValid);
+
     /** 获取布尔值 */
     UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToValue", DisplayName = "GetNodeValue_ToBool")
     static void GetNodeValueToBool(const FString& NodePath, const FParsedData& ParsedData, bool& NodeValue, bool& bIsValid);
 
+    /**
+     * 将字符串节点按 Base64 解码为二进制
+     * 延迟记录的字符串直接从源文本解码，不构造中间字符串
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToValue", DisplayName = "GetNodeValue_ToBytes")
+    static void GetNodeValueToBytes(const FString& NodePath, const FParsedData& ParsedData, TArray<uint8>& NodeValue, bool& bIsValid);
+
     // ========================================================================
     // 获取节点值 - 数组
     // ========================================================================
@@ -173,6 +204,22 @@ public:
     UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToArray", DisplayName = "GetNodeValue_ToFloatArray")
     static void GetNodeValueToFloatArray(const FString& NodePath, const FParsedData& ParsedData, TArray<float>& NodeArray, bool& bIsValid);
 
+    /** 获取64位整数数组 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToArray", DisplayName = "GetNodeValue_ToInt64Array")
+    static void GetNodeValueToInt64Array(const FString& NodePath, const FParsedData& ParsedData, TArray<int64>& NodeArray, bool& bIsValid);
+
+    /** 获取双精度数组 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToArray", DisplayName = "GetNodeValue_ToDoubleArray")
+    static void GetNodeValueToDoubleArray(const FString& NodePath, const FParsedData& ParsedData, TArray<double>& NodeArray, bool& bIsValid);
+
+    /** 获取二维浮点数组（行优先，元素 [Row][Column] 位于 Row * NumColumns + Column） */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToArray", DisplayName = "GetNodeValue_ToFloatMatrix")
+    static void GetNodeValueToFloatMatrix(const FString& NodePath, const FParsedData& ParsedData, TArray<float>& NodeArray, int32& NumRows, int32& NumColumns, bool& bIsValid);
+
+    /** 获取二维整数数组（行优先） */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToArray", DisplayName = "GetNodeValue_ToIntMatrix")
+    static void GetNodeValueToIntMatrix(const FString& NodePath, const FParsedData& ParsedData, TArray<int32>& NodeArray, int32& NumRows, int32& NumColumns, bool& bIsValid);
+
     /** 获取布尔数组 */
     UFUNCTION(BlueprintPure, Category = "FH|ReadJson|GetNodeToArray", DisplayName = "GetNodeValue_ToBoolArray")
     static void GetNodeValueToBoolArray(const FString& NodePath, const FParsedData& ParsedData, TArray<bool>& NodeArray, bool& bIsValid);
@@ -197,6 +244,25 @@ public:
     UFUNCTION(BlueprintPure, Category = "FH|ReadJson|ParseToArray", DisplayName = "ParseJsonArray_ToFloatArray")
     static void ParseJsonArrayToFloatArray(const FString& JsonArray, TArray<float>& ArrayValue, bool& bIsValid);
 
+    /** 解析JSON数组字符串为64位整数数组 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|ParseToArray", DisplayName = "ParseJsonArray_ToInt64Array")
+    static void ParseJsonArrayToInt64Array(const FString& JsonArray, TArray<int64>& ArrayValue, bool& bIsValid);
+
+    /** 解析JSON数组字符串为双精度数组 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|ParseToArray", DisplayName = "ParseJsonArray_ToDoubleArray")
+    static void ParseJsonArrayToDoubleArray(const FString& JsonArray, TArray<double>& ArrayValue, bool& bIsValid);
+
+    /**
+     * 解析二维数值数组字符串为行优先的浮点数组
+     * 一次遍历完成，不构建 FJsonValue；各行长度必须一致，所有元素必须为数值
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|ParseToArray", DisplayName = "ParseJsonArray_ToFloatMatrix")
+    static void ParseJsonArrayToFloatMatrix(const FString& JsonArray, TArray<float>& ArrayValue, int32& NumRows, int32& NumColumns, bool& bIsValid);
+
+    /** 解析二维整数数组字符串为行优先的整数数组，元素须为 int32 范围内的整数 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|ParseToArray", DisplayName = "ParseJsonArray_ToIntMatrix")
+    static void ParseJsonArrayToIntMatrix(const FString& JsonArray, TArray<int32>& ArrayValue, int32& NumRows, int32& NumColumns, bool& bIsValid);
+
     /** 解析JSON数组字符串为布尔数组 */
     UFUNCTION(BlueprintPure, Category = "FH|ReadJson|ParseToArray", DisplayName = "ParseJsonArray_ToBoolArray")
     static void ParseJsonArrayToBoolArray(const FString& JsonArray, TArray<bool>& ArrayValue, bool& bIsValid);
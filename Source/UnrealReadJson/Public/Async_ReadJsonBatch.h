@@ -0,0 +1,116 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "Async_ReadJsonBatch.generated.h"
+
+/** 批量解析中单个文档完成时的委托 */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FReadJsonBatchDocumentSignature, int32, DocumentIndex, FParsedData, ParsedData, bool, bIsValid);
+
+/** 批量解析全部完成时的委托 */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FReadJsonBatchCompletedSignature, int32, NumSucceeded, int32, NumFailed);
+
+/**
+ * 批量异步JSON读取类
+ * 一个任务对象解析一组JSON字符串或文件，在工作线程上并发解析，同时进行的解析数量不超过 MaxConcurrency
+ * - 每个文档完成时在游戏线程触发 DocumentParsed（按完成顺序，DocumentIndex 为输入数组中的下标）
+ * - 全部完成后在游戏线程触发 Completed，之后可通过 GetResults 按输入顺序读取全部结果
+ */
+UCLASS(BlueprintType, meta = (ExposedAsyncProxy = "AsyncTask"))
+class UNREALREADJSON_API UAsync_ReadJsonBatch : public UBlueprintAsyncActionBase
+{
+    GENERATED_BODY()
+
+    /* Property */
+public:
+    // ========================================================================
+    // 委托
+    // ========================================================================
+
+    /** 单个文档解析完成委托（成功或失败） */
+    UPROPERTY(BlueprintAssignable, Category = "FH|ReadJson|Batch", DisplayName = "DocumentParsed")
+    FReadJsonBatchDocumentSignature OnDocumentParsed;
+
+    /** 全部文档解析完成委托 */
+    UPROPERTY(BlueprintAssignable, Category = "FH|ReadJson|Batch", DisplayName = "Completed")
+    FReadJsonBatchCompletedSignature OnAllCompleted;
+
+private:
+    /** 工作线程共享的批量状态 */
+    struct FBatchState;
+
+    /** 上下文对象（用于日志） */
+    UPROPERTY()
+    TObjectPtr<UObject> WorldContext;
+
+    TSharedPtr<FBatchState, ESPMode::ThreadSafe> State;
+
+    /** 按输入顺序保存的解析结果 */
+    TArray<FParsedData> Results;
+
+    /** 同时进行的解析数量上限 */
+    int32 MaxWorkers = 1;
+
+    /** 已完成的文档数量 */
+    int32 NumFinished = 0;
+    int32 NumSucceeded = 0;
+
+
+    /* Function */
+public:
+    /**
+     * 批量异步解析JSON字符串
+     * @param WorldContextObject 上下文对象
+     * @param JsonStrings 待解析的JSON字符串
+     * @param Options 解析选项（与 ReadJson_WithOptions 相同）
+     * @param MaxConcurrency 同时进行的解析数量上限
+     * @return 异步任务对象
+     */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Read|AsyncTask", DisplayName = "ReadJsonBatch_Async",
+        meta = (BlueprintInternalUseOnly = "true", DefaultToSelf = "WorldContextObject", AdvancedDisplay = "Options,MaxConcurrency"))
+    static UAsync_ReadJsonBatch* Async_ReadJsonBatch(UObject* WorldContextObject, const TArray<FString>& JsonStrings, const FReadJsonOptions& Options, int32 MaxConcurrency = 4);
+
+    /**
+     * 批量异步读取并解析JSON文件
+     * 文件在工作线程上读取，相对路径相对于项目目录
+     * @param WorldContextObject 上下文对象
+     * @param FilePaths 文件路径
+     * @param Options 解析选项（与 ReadJson_WithOptions 相同）
+     * @param MaxConcurrency 同时进行的读取与解析数量上限
+     * @return 异步任务对象
+     */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Read|AsyncTask", DisplayName = "ReadJsonFilesBatch_Async",
+        meta = (BlueprintInternalUseOnly = "true", DefaultToSelf = "WorldContextObject", AdvancedDisplay = "Options,MaxConcurrency"))
+    static UAsync_ReadJsonBatch* Async_ReadJsonFilesBatch(UObject* WorldContextObject, const TArray<FString>& FilePaths, const FReadJsonOptions& Options, int32 MaxConcurrency = 4);
+
+    /** 获取解析结果（只读引用，无拷贝），按输入顺序排列，失败的文档为空数据 */
+    const TArray<FParsedData>& GetResultsRef() const { return Results; }
+
+    /**
+     * 获取解析结果，按输入顺序排列，失败的文档为空数据
+     * @note 蓝图中会拷贝全部结果，逐个处理请使用 DocumentParsed
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Batch")
+    TArray<FParsedData> GetResults() const { return Results; }
+
+    /** 取消尚未开始的文档并结束任务（正在解析的文档完成后不再回调） */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Batch")
+    void Cancel();
+
+protected:
+    /** 激活异步任务 */
+    virtual void Activate() override;
+
+private:
+    static UAsync_ReadJsonBatch* CreateBatch(UObject* WorldContextObject, TArray<FString>&& Inputs, bool bInputsAreFiles, const FReadJsonOptions& Options, int32 MaxConcurrency);
+
+    /** 工作线程循环：依次领取未开始的文档，直到全部领取或被取消 */
+    static void RunWorker(const TSharedRef<FBatchState, ESPMode::ThreadSafe>& State, TWeakObjectPtr<UAsync_ReadJsonBatch> WeakTask);
+
+    /** 游戏线程上处理单个文档的结果 */
+    void HandleDocumentParsed(int32 DocumentIndex, FParsedData&& ParsedData, bool bIsValid);
+
+    /** 获取调用者名称（用于日志） */
+    FString GetCallerName() const;
+};
@@ -0,0 +1,142 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "Engine/DataAsset.h"
+#include "Engine/StreamableManager.h"
+#include "FlattenedJsonAsset.generated.h"
+
+class UAssetImportData;
+
+/** 异步加载扁平化JSON资产完成时的委托 */
+DECLARE_DELEGATE_OneParam(FOnFlattenedJsonAssetLoaded, class UFlattenedJsonAsset* /*LoadedAsset*/);
+
+/**
+ * 预扁平化JSON资产
+ * 在编辑器导入/重新导入时执行扁平化，并以紧凑的二进制布局保存
+ * 运行时直接使用 GetNodeValueTo* 读取，无需再次解析JSON
+ */
+UCLASS(BlueprintType)
+class UNREALREADJSON_API UFlattenedJsonAsset : public UDataAsset
+{
+    GENERATED_BODY()
+
+    /* Property */
+public:
+#if WITH_EDITORONLY_DATA
+    /** 导入源文件信息（用于重新导入） */
+    UPROPERTY(VisibleAnywhere, Instanced, Category = "ImportSettings")
+    TObjectPtr<UAssetImportData> AssetImportData;
+#endif
+
+private:
+    // ========================================================================
+    // 常量定义
+    // ========================================================================
+
+    /** 二进制布局版本号，布局变更时递增；只加载当前版本，其他版本的资产需要重新导入 */
+    static constexpr int32 CurrentFormatVersion = 1;
+
+    // ========================================================================
+    // 成员变量
+    // ========================================================================
+
+    /** 扁平化结果（不走属性标签序列化，由 Serialize 以紧凑布局读写） */
+    UPROPERTY(Transient, VisibleAnywhere, Category = "ReadJson")
+    FParsedData ParsedData;
+
+
+    /* Function */
+public:
+    // ========================================================================
+    // UObject 接口
+    // ========================================================================
+
+    virtual void PostInitProperties() override;
+    virtual void Serialize(FArchive& Ar) override;
+
+    // ========================================================================
+    // C++ 接口
+    // ========================================================================
+
+    /** 获取扁平化结果（只读引用，无拷贝） */
+    const FParsedData& GetParsedDataRef() const { return ParsedData; }
+
+    /** 替换扁平化结果（导入/重新导入时使用） */
+    void SetParsedData(FParsedData&& InParsedData);
+
+    /**
+     * 通过 StreamableManager 异步加载资产
+     * @param SoftAsset 资产软引用
+     * @param OnLoaded 加载完成回调（加载失败时参数为nullptr）
+     * @return 加载句柄
+     */
+    static TSharedPtr<FStreamableHandle> RequestAsyncLoad(const TSoftObjectPtr<UFlattenedJsonAsset>& SoftAsset, FOnFlattenedJsonAssetLoaded OnLoaded);
+
+    // ========================================================================
+    // 蓝图接口 - 与 UAsync_ReadJson 的 GetNodeValueTo* 一致，但直接读取资产数据
+    // ========================================================================
+
+    /**
+     * 获取完整解析结果
+     * @note 蓝图中会拷贝整个Map，读取单个字段请直接使用下方的 GetNodeValue 节点
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset")
+    FParsedData GetParsedData() const { return ParsedData; }
+
+    /** 获取节点数量 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset")
+    int32 GetNodeCount() const { return ParsedData.NumEntries(); }
+
+    /** 获取节点完整数据 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset")
+    void GetNodeData(const FString& NodePath, FJsonNode& NodeData, bool& bIsValid) const;
+
+    /** 获取字符串值 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToString")
+    void GetNodeValueToString(const FString& NodePath, FString& NodeValue, bool& bIsValid) const;
+
+    /** 获取整数值 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToInt")
+    void GetNodeValueToInt(const FString& NodePath, int32& NodeValue, bool& bIsValid) const;
+
+    /** 获取浮点值 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToFloat")
+    void GetNodeValueToFloat(const FString& NodePath, float& NodeValue, bool& bIsValid) const;
+
+    /** 获取64位整数值 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToInt64")
+    void GetNodeValueToInt64(const FString& NodePath, int64& NodeValue, bool& bIsValid) const;
+
+    /** 获取双精度值 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToDouble")
+    void GetNodeValueToDouble(const FString& NodePath, double& NodeValue, bool& bIsValid) const;
+
+    /** 获取布尔值 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToBool")
+    void GetNodeValueToBool(const FString& NodePath, bool& NodeValue, bool& bIsValid) const;
+
+    /** 获取字符串数组 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToStringArray")
+    void GetNodeValueToStringArray(const FString& NodePath, TArray<FString>& NodeArray, bool& bIsValid) const;
+
+    /** 获取整数数组 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToIntArray")
+    void GetNodeValueToIntArray(const FString& NodePath, TArray<int32>& NodeArray, bool& bIsValid) const;
+
+    /** 获取浮点数组 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToFloatArray")
+    void GetNodeValueToFloatArray(const FString& NodePath, TArray<float>& NodeArray, bool& bIsValid) const;
+
+    /** 获取64位整数数组 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToInt64Array")
+    void GetNodeValueToInt64Array(const FString& NodePath, TArray<int64>& NodeArray, bool& bIsValid) const;
+
+    /** 获取双精度数组 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToDoubleArray")
+    void GetNodeValueToDoubleArray(const FString& NodePath, TArray<double>& NodeArray, bool& bIsValid) const;
+
+    /** 获取布尔数组 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Asset", DisplayName = "GetNodeValue_ToBoolArray")
+    void GetNodeValueToBoolArray(const FString& NodePath, TArray<bool>& NodeArray, bool& bIsValid) const;
+};
@@ -0,0 +1,25 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Base64 解码
+ * 直接从 TCHAR 区间（如源文本中的字符串值）解码到字节数组，不需要先构造 FString：
+ * - 输出长度由输入长度一次算出，只分配一次
+ * - 每次读取 8 个字符（两个 uint64），整组检查是否为 ASCII 后查表合并为 6 个字节，
+ *   非法字符的标记在循环结束后统一检查，主循环中没有逐字符的分支
+ *
+ * 支持标准字母表（+/）和 URL 安全字母表（-_），末尾的 '=' 填充可省略
+ */
+namespace JsonBase64
+{
+    /**
+     * 解码 Base64 文本
+     * 
+     * @param Text Base64 文本
+     * @param Length 文本长度
+     * @param OutBytes 解码结果
+     * @return 是否为合法的 Base64 文本
+     */
+    UNREALREADJSON_API bool Decode(const TCHAR* Text, int32 Length, TArray<uint8>& OutBytes);
+}
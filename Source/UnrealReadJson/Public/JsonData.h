@@ -2,8 +2,13 @@
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "JsonNumberParser.h"
 #include "JsonData.generated.h"
 
+class FJsonPathIndex;
+class FJsonLazyStrings;
+class FJsonFlatTable;
+
 // ============================================================================
 // 日志类别声明
 // ============================================================================
@@ -22,7 +27,59 @@ enum class EValueType : uint8
     String  UMETA(DisplayName = "String"),
     Bool    UMETA(DisplayName = "Boolean"),
     Int     UMETA(DisplayName = "Integer"),
-    Float   UMETA(DisplayName = "Float")
+    Float   UMETA(DisplayName = "Float"),
+    Int64   UMETA(DisplayName = "Integer64"),
+    Double  UMETA(DisplayName = "Double")
+};
+
+/**
+ * 字符串条目保存的容器类型
+ * 对象与数组节点扁平化为序列化文本（ValueType 为 String），由该字段区分于内容恰好以 '{' / '[' 开头的普通字符串；
+ * null 同样保存为 ValueType 为 String 的空字符串，由 Null 区分于空字符串
+ */
+UENUM(BlueprintType)
+enum class EJsonContainerKind : uint8
+{
+    /** 不是容器（普通字符串或其他类型） */
+    None    UMETA(DisplayName = "None"),
+    /** 序列化的对象 */
+    Object  UMETA(DisplayName = "Object"),
+    /** 序列化的数组 */
+    Array   UMETA(DisplayName = "Array"),
+    /** null（StringValue 为空） */
+    Null    UMETA(DisplayName = "Null")
+};
+
+/**
+ * 解析策略枚举
+ */
+UENUM(BlueprintType)
+enum class EJsonParseStrategy : uint8
+{
+    /** 预扫描深度与扇出后自动选择 */
+    Auto        UMETA(DisplayName = "Auto"),
+    /** 构建 FJsonObject 后递归展开（小型、浅层文档） */
+    Recursive   UMETA(DisplayName = "Recursive"),
+    /** 构建 FJsonObject 后用显式栈展开（深层或大型文档） */
+    Iterative   UMETA(DisplayName = "Iterative"),
+    /** 直接扫描源文本，不构建 FJsonObject（对象与数组节点保存源文本片段） */
+    Streaming   UMETA(DisplayName = "Streaming"),
+    /** 构建 FJsonObject 后按根节点成员并行展开（根节点扇出大的大型文档） */
+    Parallel    UMETA(DisplayName = "Parallel")
+};
+
+/**
+ * 键比较策略
+ */
+UENUM(BlueprintType)
+enum class EJsonKeyPolicy : uint8
+{
+    /** 与 FJsonObject 一致：不区分大小写，同一对象中仅大小写不同的键被静默合并（后者覆盖前者） */
+    Default         UMETA(DisplayName = "Default"),
+    /** 不区分大小写，与已有路径冲突的路径不覆盖已有值，记录在 FParsedData::KeyCollisions 中 */
+    IgnoreCase      UMETA(DisplayName = "Ignore Case"),
+    /** 区分大小写（逐字符比较），条目总是保存在 FParsedData::FlatEntries 中，完全相同的路径同样记录冲突 */
+    CaseSensitive   UMETA(DisplayName = "Case Sensitive")
 };
 
 // ============================================================================
@@ -38,7 +95,7 @@ struct FJsonDataStruct
 {
     GENERATED_BODY()
 
-    /** 字符串值（当ValueType为String时有效，也用于存储序列化的Object/Array） */
+    /** 字符串值（当ValueType为String时有效，也用于存储序列化的Object/Array，见 ContainerKind） */
     UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
     FString StringValue {};
 
@@ -50,14 +107,26 @@ struct FJsonDataStruct
     UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
     int32 IntValue { 0 };
 
-    /** 浮点值（当ValueType为Float时有效） */
+    /** 浮点值（当ValueType为Float时有效；ValueType为Double时保存单精度副本，兼容只读取Float的调用方） */
     UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
     float FloatValue { 0.f };
 
+    /** 64位整数值（当ValueType为Int64时有效，超出int32范围的整数） */
+    UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
+    int64 Int64Value { 0 };
+
+    /** 双精度值（当ValueType为Double时有效，带小数点或指数且不能无损保存为float的数值；解析得到的Float同样保存该值） */
+    UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
+    double DoubleValue { 0.0 };
+
     /** 值类型标识 */
     UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
     EValueType ValueType { EValueType::String };
 
+    /** 字符串条目保存的容器类型或 null（扁平化时记录，ValueType 不为 String 时总是 None） */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    EJsonContainerKind ContainerKind { EJsonContainerKind::None };
+
     /** 默认构造函数 */
     FJsonDataStruct() = default;
 
@@ -70,6 +139,30 @@ struct FJsonDataStruct
         return Result;
     }
 
+    /** 构造函数 - 序列化的对象 */
+    static FJsonDataStruct MakeObject(const FString& InText)
+    {
+        FJsonDataStruct Result = MakeString(InText);
+        Result.ContainerKind = EJsonContainerKind::Object;
+        return Result;
+    }
+
+    /** 构造函数 - 序列化的数组 */
+    static FJsonDataStruct MakeArray(const FString& InText)
+    {
+        FJsonDataStruct Result = MakeString(InText);
+        Result.ContainerKind = EJsonContainerKind::Array;
+        return Result;
+    }
+
+    /** 构造函数 - null（读取为空字符串） */
+    static FJsonDataStruct MakeNull()
+    {
+        FJsonDataStruct Result;
+        Result.ContainerKind = EJsonContainerKind::Null;
+        return Result;
+    }
+
     /** 构造函数 - 布尔类型 */
     static FJsonDataStruct MakeBool(const bool InValue)
     {
@@ -96,6 +189,48 @@ struct FJsonDataStruct
         Result.ValueType = EValueType::Float;
         return Result;
     }
+
+    /** 构造函数 - 64位整数类型 */
+    static FJsonDataStruct MakeInt64(const int64 InValue)
+    {
+        FJsonDataStruct Result;
+        Result.Int64Value = InValue;
+        Result.ValueType = EValueType::Int64;
+        return Result;
+    }
+
+    /** 构造函数 - 双精度类型 */
+    static FJsonDataStruct MakeDouble(const double InValue)
+    {
+        FJsonDataStruct Result;
+        Result.DoubleValue = InValue;
+        Result.FloatValue = static_cast<float>(InValue);
+        Result.ValueType = EValueType::Double;
+        return Result;
+    }
+
+    /** 比较两个值是否相同（仅比较 ValueType 对应的有效字段，字符串区分大小写且容器类型相同） */
+    bool operator==(const FJsonDataStruct& Other) const
+    {
+        if (ValueType != Other.ValueType)
+        {
+            return false;
+        }
+        switch (ValueType)
+        {
+        case EValueType::Bool:  return BoolValue == Other.BoolValue;
+        case EValueType::Int:   return IntValue == Other.IntValue;
+        case EValueType::Float: return FloatValue == Other.FloatValue;
+        case EValueType::Int64: return Int64Value == Other.Int64Value;
+        case EValueType::Double: return DoubleValue == Other.DoubleValue;
+        default:                return ContainerKind == Other.ContainerKind && StringValue.Equals(Other.StringValue, ESearchCase::CaseSensitive);
+        }
+    }
+
+    bool operator!=(const FJsonDataStruct& Other) const
+    {
+        return !(*this == Other);
+    }
 };
 
 /**
@@ -123,9 +258,232 @@ struct FParsedData
 {
     GENERATED_BODY()
 
-    /** 路径到值的映射表 */
+    /**
+     * 路径到值的映射表
+     * 以数据表存储的文档（FReadJsonOptions::bFlatTableStorage 或键比较策略为 CaseSensitive）中为空，延迟记录的字符串也不在其中；
+     * 读取全部节点请使用 GetAllNodes，读取单个节点请使用 GetNodeData / GetNodeValue 系列
+     */
     UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
     TMap<FString, FJsonDataStruct> ParsedDataMap {};
+
+    /**
+     * 路径索引（首次查询时构建，见 JsonPathIndex.h）
+     * 直接增删 ParsedDataMap 的条目后需调用 JsonPathIndexHelper::InvalidateIndex
+     */
+    mutable TSharedPtr<FJsonPathIndex> PathIndex;
+
+    /**
+     * 修改计数，SetEntry / RemoveEntry 与重新扁平化时递增
+     * 路径索引记录构建时的计数，不一致时重建（增删数量相同、路径数量不变时同样能发现）
+     */
+    uint32 Generation { 0 };
+
+    /**
+     * 延迟记录的字符串节点（见 JsonLazyString.h），仅在 FReadJsonOptions 启用延迟字符串时有效
+     * 这些节点不在 ParsedDataMap 中，通过 GetNodeData / GetNodeValue_ToString / GetNodeValue_ToBytes 读取，
+     * C++ 中可用 FParsedData::GetValue 读取，或用 FJsonLazyStrings::GetStringView 零拷贝读取
+     */
+    TSharedPtr<FJsonLazyStrings> LazyStrings;
+
+    /**
+     * 因与已有路径冲突而未写入的路径（按出现顺序），仅在键比较策略不为 Default 时记录
+     */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    TArray<FString> KeyCollisions {};
+
+    /** 路径中的键名是否经过转义（见 JsonPath.h），由 FReadJsonOptions::bEscapePathKeys 决定 */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    bool bEscapedPaths { false };
+
+    /**
+     * 保存在开放寻址数据表中的条目（见 JsonFlatTable.h），键比较策略为 CaseSensitive 或启用 FReadJsonOptions::bFlatTableStorage 时有效，此时 ParsedDataMap 为空
+     * 通过 FindEntry / FindValue / ForEachPath 读取；路径索引、查询、结构体绑定、补丁、写出、分层与覆盖文档均经由这些接口，
+     * 蓝图节点（GetNodeData、GetAllNodes 等）同样可用
+     */
+    TSharedPtr<FJsonFlatTable> FlatEntries;
+
+    /** 路径是否区分大小写（FlatEntries 的键比较策略为 CaseSensitive） */
+    UNREALREADJSON_API bool IsCaseSensitive() const;
+
+    /** 查找条目（按文档的键比较策略），不含延迟记录的字符串 */
+    UNREALREADJSON_API const FJsonDataStruct* FindEntry(const FString& NodePath) const;
+
+    /** 条目数量，不含延迟记录的字符串 */
+    UNREALREADJSON_API int32 NumEntries() const;
+
+    /**
+     * 查找路径的值（条目或延迟记录的字符串），路径索引、查询、结构体绑定与补丁共用
+     * @param NodePath 节点路径
+     * @param Storage 延迟记录的字符串反转义后写入此处
+     * @return 条目（或 &Storage），路径不存在时返回 nullptr
+     */
+    UNREALREADJSON_API const FJsonDataStruct* FindValue(const FString& NodePath, FJsonDataStruct& Storage) const;
+
+    /** 按预先计算的哈希（GetTypeHash(NodePath)，与 ParsedDataMap 一致）查找路径的值，区分大小写的文档忽略 Hash */
+    UNREALREADJSON_API const FJsonDataStruct* FindValueByHash(uint32 Hash, const FString& NodePath, FJsonDataStruct& Storage) const;
+
+    /** 读取路径的值（条目或延迟记录的字符串），路径不存在时返回 false */
+    UNREALREADJSON_API bool GetValue(const FString& NodePath, FJsonDataStruct& OutValue) const;
+
+    /** 路径是否存在（条目或延迟记录的字符串） */
+    UNREALREADJSON_API bool ContainsPath(const FString& NodePath) const;
+
+    /** 路径数量（条目与延迟记录的字符串） */
+    UNREALREADJSON_API int32 NumPaths() const;
+
+    /**
+     * 遍历全部路径：先按顺序遍历条目（Entry 为条目），再遍历延迟记录的字符串（Entry 为 nullptr，值通过 GetValue 读取）
+     */
+    UNREALREADJSON_API void ForEachPath(TFunctionRef<void(const FString& NodePath, const FJsonDataStruct* Entry)> Function) const;
+
+    /**
+     * 写入条目（按文档的键比较策略），路径原为延迟记录的字符串时改为普通条目
+     * 被其他 FParsedData 共享的数据表与延迟记录会先复制；路径索引需由调用方更新（JsonPathIndexHelper::UpdateIndex）
+     */
+    UNREALREADJSON_API FJsonDataStruct& SetEntry(const FString& NodePath, FJsonDataStruct Value);
+
+    /** 删除路径（条目或延迟记录的字符串），返回路径是否存在；共享与索引的处理同 SetEntry */
+    UNREALREADJSON_API bool RemoveEntry(const FString& NodePath);
+};
+
+/**
+ * ReadJson 解析选项
+ */
+USTRUCT(BlueprintType)
+struct FReadJsonOptions
+{
+    GENERATED_BODY()
+
+    /**
+     * 字符串值在源文本中的长度达到该值时延迟记录：只保存源文本区间，不复制到 ParsedDataMap
+     * 适用于内嵌大段 Base64 等很少读取或需要按二进制读取的字符串；0 表示不启用
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReadJson", meta = (ClampMin = "0"))
+    int32 LazyStringThreshold { 0 };
+
+    /**
+     * 所有字符串值都延迟记录（忽略 LazyStringThreshold）
+     * 解析时不反转义、不复制任何字符串，适用于字符串很多但只读取少量节点的文档
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReadJson")
+    bool bLazyStrings { false };
+
+    /** 解析策略；启用延迟字符串、路径转义、数据表存储或键比较策略不为 Default 时总是使用 Streaming */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReadJson")
+    EJsonParseStrategy Strategy { EJsonParseStrategy::Auto };
+
+    /**
+     * 键比较策略
+     * FJsonObject 在反序列化时已合并大小写不同的键，因此 Default 以外的策略总是直接扫描源文本；
+     * CaseSensitive 时不启用延迟字符串（所有值保存在区分大小写的数据表中）
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReadJson")
+    EJsonKeyPolicy KeyPolicy { EJsonKeyPolicy::Default };
+
+    /**
+     * 转义路径中键名的 '\' 与 '.'（见 JsonPath.h），消除 {"data":{"key":..},"data.key":..} 这类路径歧义
+     * 启用时总是直接扫描源文本；不含 '.' 与 '\' 的键名路径不变
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReadJson")
+    bool bEscapePathKeys { false };
+
+    /**
+     * 解析前预扫描源文本，按条目数量一次性预留容量（额外遍历一次源文本）
+     * 不启用时不为预留额外扫描：池化上下文按上一次解析的条目数量预留；Auto 策略选择递归 / 迭代 / 并行时本身需要预扫描，此时总是按其结果预留
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReadJson")
+    bool bPreScanCapacity { false };
+
+    /**
+     * 条目写入开放寻址数据表 FParsedData::FlatEntries 而不是 ParsedDataMap（见 JsonFlatTable.h），适合构建后大量按路径查找的文档
+     * 启用时总是直接扫描源文本；键比较策略为 CaseSensitive 时总是使用数据表
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReadJson")
+    bool bFlatTableStorage { false };
+
+    /** 是否使用直接扫描源文本的扁平化器 */
+    bool UsesSourceFlattener() const
+    {
+        return bLazyStrings || LazyStringThreshold > 0 || KeyPolicy != EJsonKeyPolicy::Default || bEscapePathKeys || bFlatTableStorage;
+    }
+
+    /** 条目是否写入 FParsedData::FlatEntries */
+    bool UsesFlatTableStorage() const
+    {
+        return bFlatTableStorage || KeyPolicy == EJsonKeyPolicy::CaseSensitive;
+    }
+
+    /** 是否有字符串延迟记录 */
+    bool UsesLazyStrings() const
+    {
+        return KeyPolicy != EJsonKeyPolicy::CaseSensitive && (bLazyStrings || LazyStringThreshold > 0);
+    }
+
+    /** 源文本中长度为 Length 的字符串是否延迟记录 */
+    bool IsLazyString(const int32 Length) const
+    {
+        if (KeyPolicy == EJsonKeyPolicy::CaseSensitive)
+        {
+            return false;
+        }
+        return bLazyStrings || (LazyStringThreshold > 0 && Length >= LazyStringThreshold);
+    }
+};
+
+/**
+ * ReadJson 解析统计
+ */
+USTRUCT(BlueprintType)
+struct FReadJsonStats
+{
+    GENERATED_BODY()
+
+    /** 实际使用的解析策略 */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    EJsonParseStrategy Strategy { EJsonParseStrategy::Auto };
+
+    /** 策略是否由 Auto 预扫描选择 */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    bool bAutoSelected { false };
+
+    /** 预扫描得到的最大嵌套深度 */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    int32 MaxDepth { 0 };
+
+    /** 预扫描得到的根节点成员数量 */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    int32 RootFanOut { 0 };
+
+    /** 预扫描得到的单个对象或数组的最大成员数量 */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    int32 MaxFanOut { 0 };
+
+    /** 预扫描耗时（毫秒） */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    float PreScanMilliseconds { 0.0f };
+
+    /** 解析与扁平化耗时（毫秒，不含预扫描） */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    float ParseMilliseconds { 0.0f };
+
+    /** 扁平化后的条目数量 */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    int32 NumEntries { 0 };
+
+    /** 解析前预留的条目容量（预扫描结果、已反序列化对象的成员数量或池化上下文上一次的条目数量，未预留时为0） */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    int32 ReservedEntries { 0 };
+
+    /**
+     * 推算值，不是实测的重建哈希次数：按 TSet 的哈希桶规则，由 ReservedEntries 与 NumEntries 推算 Map 增长期间哈希桶数量变化的次数
+     * 实际是否扩容见 bStorageGrew
+     */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    int32 EstimatedRehashes { 0 };
+
+    /** 实测：条目存储（ParsedDataMap 或 FlatEntries）解析后占用的内存超过按 ReservedEntries 预留时的大小，即解析期间扩容过 */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "ReadJson")
+    bool bStorageGrew { false };
 };
 
 /**
@@ -149,10 +507,18 @@ struct FJsonArray
     UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
     TArray<int32> IntArray {};
 
-    /** 浮点数组 */
+    /** 浮点数组（带小数点或指数的数值） */
     UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
     TArray<float> FloatArray {};
 
+    /** 64位整数数组（超出int32范围的整数） */
+    UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
+    TArray<int64> Int64Array {};
+
+    /** 双精度数组（与 FloatArray 一一对应，保存同一元素的完整精度） */
+    UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "ReadJson")
+    TArray<double> DoubleArray {};
+
     // ========================================================================
     // 辅助方法
     // ========================================================================
@@ -161,13 +527,13 @@ struct FJsonArray
     bool HasAnyElements() const
     {
         return !StringArray.IsEmpty() || !BoolArray.IsEmpty() || 
-               !IntArray.IsEmpty() || !FloatArray.IsEmpty();
+               !IntArray.IsEmpty() || !FloatArray.IsEmpty() || !Int64Array.IsEmpty();
     }
 
-    /** 获取所有数组的元素总数 */
+    /** 获取所有数组的元素总数（DoubleArray 与 FloatArray 对应同一批元素，不重复计数） */
     int32 GetTotalCount() const
     {
-        return StringArray.Num() + BoolArray.Num() + IntArray.Num() + FloatArray.Num();
+        return StringArray.Num() + BoolArray.Num() + IntArray.Num() + FloatArray.Num() + Int64Array.Num();
     }
 
     /** 清空所有数组 */
@@ -177,6 +543,8 @@ struct FJsonArray
         BoolArray.Empty();
         IntArray.Empty();
         FloatArray.Empty();
+        Int64Array.Empty();
+        DoubleArray.Empty();
     }
 };
 
@@ -219,35 +587,206 @@ namespace JsonDataHelper
         case EValueType::Float:  return TEXT("Float");
         case EValueType::Int:    return TEXT("Int");
         case EValueType::Bool:   return TEXT("Bool");
+        case EValueType::Int64:  return TEXT("Int64");
+        case EValueType::Double: return TEXT("Double");
         default:                 return TEXT("Unknown");
         }
     }
 
+    /** 条目是否为扁平化时记录的对象（序列化文本） */
+    FORCEINLINE bool IsObjectEntry(const FJsonDataStruct* Entry)
+    {
+        return Entry && Entry->ValueType == EValueType::String && Entry->ContainerKind == EJsonContainerKind::Object;
+    }
+
+    /** 条目是否为扁平化时记录的数组（序列化文本） */
+    FORCEINLINE bool IsArrayEntry(const FJsonDataStruct* Entry)
+    {
+        return Entry && Entry->ValueType == EValueType::String && Entry->ContainerKind == EJsonContainerKind::Array;
+    }
+
+    /** 条目是否为对象或数组 */
+    FORCEINLINE bool IsContainerEntry(const FJsonDataStruct* Entry)
+    {
+        return Entry && Entry->ValueType == EValueType::String
+            && (Entry->ContainerKind == EJsonContainerKind::Object || Entry->ContainerKind == EJsonContainerKind::Array);
+    }
+
+    /** 条目是否为扁平化时记录的 null */
+    FORCEINLINE bool IsNullEntry(const FJsonDataStruct* Entry)
+    {
+        return Entry && Entry->ValueType == EValueType::String && Entry->ContainerKind == EJsonContainerKind::Null;
+    }
+
+    /** 数值字面量分类 */
+    enum class ENumberLiteralKind : uint8
+    {
+        Int,
+        Int64,
+        Double
+    };
+
     /**
-     * 判断数值是否为整数
+     * 按字面量文本对数值分类（不经过 double 往返，不会丢失精度）
+     * - 只含可选负号和数字的整数字面量：在 int32 范围内为 Int，在 int64 范围内为 Int64
+     * - 其余（含小数点或指数，或超出 int64 范围的整数）为 Double
      * 
-     * 判断逻辑说明:
-     * 1. 首先检查数值是否在int32的有效范围内 [MIN_int32, MAX_int32]
-     * 2. 然后使用 FMath::IsNearlyEqual 比较原值与四舍五入后的值
-     * 3. 容差使用 KINDA_SMALL_NUMBER (约 0.0001)
+     * @param Literal 字面量文本
+     * @param Length 字面量长度
+     * @param OutInteger 整数字面量的值
+     * @return 分类结果
+     */
+    inline ENumberLiteralKind ClassifyNumberLiteral(const TCHAR* Literal, const int32 Length, int64& OutInteger)
+    {
+        const bool bNegative = Length > 0 && Literal[0] == TEXT('-');
+        int32 Index = bNegative ? 1 : 0;
+        if (Index >= Length)
+        {
+            return ENumberLiteralKind::Double;
+        }
+
+        // uint64 可无溢出地容纳19位十进制数，只有第20位需要检查溢出
+        const int32 NumDigits = Length - Index;
+        if (NumDigits > 20)
+        {
+            return ENumberLiteralKind::Double;
+        }
+        uint64 Magnitude = 0;
+        const int32 UncheckedEnd = Index + FMath::Min(NumDigits, 19);
+        for (; Index < UncheckedEnd; ++Index)
+        {
+            const uint32 Digit = static_cast<uint32>(Literal[Index] - TEXT('0'));
+            if (Digit > 9)
+            {
+                return ENumberLiteralKind::Double;
+            }
+            Magnitude = Magnitude * 10 + Digit;
+        }
+        if (Index < Length)
+        {
+            const uint32 Digit = static_cast<uint32>(Literal[Index] - TEXT('0'));
+            if (Digit > 9 || Magnitude > (MAX_uint64 - Digit) / 10)
+            {
+                return ENumberLiteralKind::Double;
+            }
+            Magnitude = Magnitude * 10 + Digit;
+        }
+
+        constexpr uint64 MaxPositive = static_cast<uint64>(MAX_int64);
+        if (Magnitude > (bNegative ? MaxPositive + 1 : MaxPositive))
+        {
+            return ENumberLiteralKind::Double;
+        }
+        OutInteger = bNegative ? static_cast<int64>(0 - Magnitude) : static_cast<int64>(Magnitude);
+        return OutInteger >= MIN_int32 && OutInteger <= MAX_int32 ? ENumberLiteralKind::Int : ENumberLiteralKind::Int64;
+    }
+
+    /**
+     * 读取数值节点的 double 值
+     * 以字面量保存的数值使用 JsonNumberParser 快速解析（正确舍入），不经过 FCString::Atod
      * 
-     * 注意事项:
-     * - 对于极大或极小的整数，可能因浮点精度问题被误判
-     * - 如 1.0000001 可能被判定为整数
-     * - 如需严格整数判断，建议在业务层额外验证
+     * @param Value 数值节点
+     * @param OutNumber 输出数值
+     * @return 是否为有限数值
+     */
+    inline bool TryGetNumberValue(const FJsonValue& Value, double& OutNumber)
+    {
+        FString Literal;
+        if (!Value.TryGetString(Literal) || !JsonNumberParser::ParseDouble(*Literal, Literal.Len(), OutNumber))
+        {
+            OutNumber = Value.AsNumber();
+        }
+        return FMath::IsFinite(OutNumber);
+    }
+
+    /**
+     * 由带小数点或指数的数值构造条目
+     * 可无损保存为 float 的数值（如 0.5、2.0）为 Float，与引入 Double 之前的类型一致；
+     * 其余数值（如 0.1、1e300）为 Double，同时保存单精度副本
+     */
+    inline FJsonDataStruct MakeFloatingPointData(const double Number)
+    {
+        const float SingleNumber = static_cast<float>(Number);
+        if (static_cast<double>(SingleNumber) != Number)
+        {
+            return FJsonDataStruct::MakeDouble(Number);
+        }
+        FJsonDataStruct Data = FJsonDataStruct::MakeFloat(SingleNumber);
+        Data.DoubleValue = Number;
+        return Data;
+    }
+
+    /**
+     * 将数值节点转换为 Int / Int64 / Float / Double 条目
+     * 以 FJsonSerializer::EFlags::StoreNumbersAsStrings 解析时按原始字面量分类；
+     * 代码构造的 FJsonValueNumber 按其格式化文本分类
      * 
-     * @param Value 待检查的双精度浮点数
-     * @return 如果数值可安全转换为int32且无小数部分，返回true
+     * @param Value 数值节点
+     * @param OutData 输出条目
+     * @return 数值是否有限
      */
-    inline bool IsIntegerValue(const double Value)
+    inline bool MakeNumberData(const FJsonValue& Value, FJsonDataStruct& OutData)
     {
-        // 检查是否在int32范围内
-        if (Value < static_cast<double>(MIN_int32) || Value > static_cast<double>(MAX_int32))
+        FString Literal;
+        int64 Integer = 0;
+        if (Value.TryGetString(Literal))
+        {
+            switch (ClassifyNumberLiteral(*Literal, Literal.Len(), Integer))
+            {
+            case ENumberLiteralKind::Int:
+                OutData = FJsonDataStruct::MakeInt(static_cast<int32>(Integer));
+                return true;
+            case ENumberLiteralKind::Int64:
+                OutData = FJsonDataStruct::MakeInt64(Integer);
+                return true;
+            default:
+                break;
+            }
+        }
+
+        double Number = 0.0;
+        if (!JsonNumberParser::ParseDouble(*Literal, Literal.Len(), Number))
+        {
+            Number = Value.AsNumber();
+        }
+        if (!FMath::IsFinite(Number))
         {
             return false;
         }
-        // 检查是否没有小数部分
-        return FMath::IsNearlyEqual(Value, FMath::RoundToDouble(Value), KINDA_SMALL_NUMBER);
+        OutData = MakeFloatingPointData(Number);
+        return true;
+    }
+
+    /**
+     * 由 Int64 / Float / Double 条目构造数值节点
+     * 以字面量文本保存（FJsonValueNumberString），重新扁平化时分类与精度保持不变
+     */
+    inline TSharedPtr<FJsonValue> MakeWideNumberValue(const FJsonDataStruct& Data)
+    {
+        if (Data.ValueType == EValueType::Int64)
+        {
+            return MakeShared<FJsonValueNumberString>(LexToString(Data.Int64Value));
+        }
+
+        // Float 使用能还原 float 的最短精度，%.17g 可无损还原 double；整数值补 ".0" 以保持浮点分类
+        FString Literal;
+        if (Data.ValueType == EValueType::Float)
+        {
+            Literal = FString::Printf(TEXT("%.7g"), Data.FloatValue);
+            if (static_cast<float>(FCString::Atod(*Literal)) != Data.FloatValue)
+            {
+                Literal = FString::Printf(TEXT("%.9g"), Data.FloatValue);
+            }
+        }
+        else
+        {
+            Literal = FString::Printf(TEXT("%.17g"), Data.DoubleValue);
+        }
+        if (!Literal.Contains(TEXT(".")) && !Literal.Contains(TEXT("e")))
+        {
+            Literal += TEXT(".0");
+        }
+        return MakeShared<FJsonValueNumberString>(Literal);
     }
 
     /**
@@ -361,6 +900,27 @@ namespace JsonDataHelper
     // 模板辅助函数 - 获取节点值
     // ========================================================================
 
+    /** Float / Double 条目的数值（其他类型返回 false） */
+    inline bool TryGetFloatingPointValue(const FJsonDataStruct& Data, double& OutNumber)
+    {
+        switch (Data.ValueType)
+        {
+        case EValueType::Float:  OutNumber = Data.FloatValue; return true;
+        case EValueType::Double: OutNumber = Data.DoubleValue; return true;
+        default:                 return false;
+        }
+    }
+
+    /** Float / Double 条目是否为整数类型 T 范围内、没有小数部分的数值（如 2.0），不使用容差 */
+    template<typename T>
+    inline bool IsIntegralFloatingPoint(const FJsonDataStruct& Data)
+    {
+        // -Min 恰好是 2 的幂，可精确表示为 double；上界不含 -Min
+        constexpr double MinValue = static_cast<double>(TNumericLimits<T>::Min());
+        double Number = 0.0;
+        return TryGetFloatingPointValue(Data, Number) && Number >= MinValue && Number < -MinValue && FMath::RoundToDouble(Number) == Number;
+    }
+
     /**
      * 用于类型安全地从FJsonDataStruct提取值的特征模板
      */
@@ -370,31 +930,66 @@ namespace JsonDataHelper
     template<>
     struct TJsonValueTraits<FString>
     {
-        static constexpr EValueType ExpectedType = EValueType::String;
+        static bool IsCompatible(const FJsonDataStruct& Data) { return Data.ValueType == EValueType::String; }
         static const FString& GetValue(const FJsonDataStruct& Data) { return Data.StringValue; }
         static const TCHAR* GetTypeName() { return TEXT("string"); }
     };
 
+    /** Int 同时接受没有小数部分且在 int32 范围内的 Float / Double 条目（与引入 Double 之前 2.0 被读取为 Int 一致） */
     template<>
     struct TJsonValueTraits<int32>
     {
-        static constexpr EValueType ExpectedType = EValueType::Int;
-        static int32 GetValue(const FJsonDataStruct& Data) { return Data.IntValue; }
+        static bool IsCompatible(const FJsonDataStruct& Data) { return Data.ValueType == EValueType::Int || IsIntegralFloatingPoint<int32>(Data); }
+        static int32 GetValue(const FJsonDataStruct& Data)
+        {
+            double Number = 0.0;
+            return TryGetFloatingPointValue(Data, Number) ? static_cast<int32>(Number) : Data.IntValue;
+        }
         static const TCHAR* GetTypeName() { return TEXT("integer"); }
     };
 
+    /** Int64 同时接受 Int 条目，以及没有小数部分且在 int64 范围内的 Float / Double 条目 */
+    template<>
+    struct TJsonValueTraits<int64>
+    {
+        static bool IsCompatible(const FJsonDataStruct& Data)
+        {
+            return Data.ValueType == EValueType::Int64 || Data.ValueType == EValueType::Int || IsIntegralFloatingPoint<int64>(Data);
+        }
+        static int64 GetValue(const FJsonDataStruct& Data)
+        {
+            double Number = 0.0;
+            if (TryGetFloatingPointValue(Data, Number))
+            {
+                return static_cast<int64>(Number);
+            }
+            return Data.ValueType == EValueType::Int ? Data.IntValue : Data.Int64Value;
+        }
+        static const TCHAR* GetTypeName() { return TEXT("integer64"); }
+    };
+
+    /** Float 同时接受 Double 条目（读取其单精度副本） */
     template<>
     struct TJsonValueTraits<float>
     {
-        static constexpr EValueType ExpectedType = EValueType::Float;
+        static bool IsCompatible(const FJsonDataStruct& Data) { return Data.ValueType == EValueType::Float || Data.ValueType == EValueType::Double; }
         static float GetValue(const FJsonDataStruct& Data) { return Data.FloatValue; }
         static const TCHAR* GetTypeName() { return TEXT("float"); }
     };
 
+    /** Double 同时接受 Float 条目 */
+    template<>
+    struct TJsonValueTraits<double>
+    {
+        static bool IsCompatible(const FJsonDataStruct& Data) { return Data.ValueType == EValueType::Double || Data.ValueType == EValueType::Float; }
+        static double GetValue(const FJsonDataStruct& Data) { return Data.ValueType == EValueType::Double ? Data.DoubleValue : Data.FloatValue; }
+        static const TCHAR* GetTypeName() { return TEXT("double"); }
+    };
+
     template<>
     struct TJsonValueTraits<bool>
     {
-        static constexpr EValueType ExpectedType = EValueType::Bool;
+        static bool IsCompatible(const FJsonDataStruct& Data) { return Data.ValueType == EValueType::Bool; }
         static bool GetValue(const FJsonDataStruct& Data) { return Data.BoolValue; }
         static const TCHAR* GetTypeName() { return TEXT("boolean"); }
     };
@@ -402,9 +997,9 @@ namespace JsonDataHelper
     /**
      * 统一的节点值获取模板函数
      * 
-     * @tparam T 目标值类型 (FString, int32, float, bool)
+     * @tparam T 目标值类型 (FString, int32, int64, float, double, bool)
      * @param NodePath 节点路径
-     * @param ParsedDataMap 已解析的数据
+     * @param ParsedData 已解析的数据
      * @param OutValue 输出值
      * @param bOutValid 是否成功
      * @param FunctionName 调用函数名（用于日志）
@@ -412,7 +1007,7 @@ namespace JsonDataHelper
     template<typename T>
     inline void GetNodeValueImpl(
         const FString& NodePath,
-        const TMap<FString, FJsonDataStruct>& ParsedDataMap,
+        const FParsedData& ParsedData,
         T& OutValue,
         bool& bOutValid,
         const TCHAR* FunctionName)
@@ -423,10 +1018,10 @@ namespace JsonDataHelper
             return;
         }
 
-        if (const FJsonDataStruct* FoundData = ParsedDataMap.Find(NodePath))
+        if (const FJsonDataStruct* FoundData = ParsedData.FindEntry(NodePath))
         {
             using Traits = TJsonValueTraits<T>;
-            if (FoundData->ValueType == Traits::ExpectedType)
+            if (Traits::IsCompatible(*FoundData))
             {
                 OutValue = Traits::GetValue(*FoundData);
                 bOutValid = true;
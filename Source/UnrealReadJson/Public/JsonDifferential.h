@@ -0,0 +1,146 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+
+/**
+ * 参与差分测试的解析引擎
+ */
+enum class EJsonDiffEngines : uint8
+{
+    None        = 0,
+    /** FJsonObject + 显式栈展开（ParseJsonIterative_Block） */
+    Iterative   = 1 << 0,
+    /** FJsonObject + 按根节点成员并行展开（ParseJsonParallel_Block） */
+    Parallel    = 1 << 1,
+    /** 直接扫描源文本（FJsonSourceFlattener） */
+    Streaming   = 1 << 2,
+    /** 直接扫描源文本，全部字符串延迟记录（读取时反转义） */
+    LazyStrings = 1 << 3,
+    /** 直接扫描源文本，KeyPolicy 为 IgnoreCase（冲突的路径不覆盖） */
+    IgnoreCaseKeys = 1 << 4,
+    /** 直接扫描源文本，KeyPolicy 为 CaseSensitive（条目保存在区分大小写的数据表中） */
+    CaseSensitiveKeys = 1 << 5,
+    /** 直接扫描源文本，bEscapePathKeys 转义路径中的键名 */
+    EscapePathKeys = 1 << 6,
+    /** 不是解析引擎：参考实现中每个数组节点的文本交给批量解析（JsonNumberParser::Parse*Array / Parse*Matrix），与逐元素转换的结果比较 */
+    BulkArrays  = 1 << 7,
+
+    /** 生成 FParsedData 的解析引擎（可用于 ParseWithEngine 与吞吐量测量） */
+    ParseEngines = Iterative | Parallel | Streaming | LazyStrings | IgnoreCaseKeys | CaseSensitiveKeys | EscapePathKeys,
+    All = ParseEngines | BulkArrays
+};
+ENUM_CLASS_FLAGS(EJsonDiffEngines);
+
+/**
+ * 差分测试结果
+ */
+struct FJsonDiffResult
+{
+    /** 参考实现是否接受输入 */
+    bool bReferenceAccepted = false;
+
+    /** 参考实现的条目数量 */
+    int32 NumReferenceEntries = 0;
+
+    /** 与参考实现对输入是否合法的判断不同的引擎 */
+    EJsonDiffEngines AcceptanceMismatches = EJsonDiffEngines::None;
+
+    /** 条目不同的引擎 */
+    EJsonDiffEngines EntryMismatches = EJsonDiffEngines::None;
+
+    /** 差异描述（每个引擎最多 MaxReportedMismatches 条） */
+    TArray<FString> Messages;
+
+    bool HasMismatch() const { return AcceptanceMismatches != EJsonDiffEngines::None || EntryMismatches != EJsonDiffEngines::None; }
+};
+
+/**
+ * 解析引擎的差分测试
+ * 以 FJsonSerializer 反序列化 + ParseJsonValue 递归展开（ReadJson_Block 的路径）为参考实现，
+ * 对同一输入比较其他解析引擎的结果，用于在优化解析速度时发现行为变化：
+ * - 是否接受输入必须一致
+ * - 条目的路径集合一致，值的 ValueType 与有效字段一致（FJsonDataStruct::operator==），
+ *   包括 EJson::None 不生成条目、null 保存为 ContainerKind 为 Null 的空字符串、数值按字面量分类为 Int / Int64 / Double
+ * - 对象与数组节点保存的文本允许格式不同（源文本片段与重新序列化的文本），种类相同且反序列化后按 FJsonValue::CompareEqual 相等
+ * - 延迟记录的字符串反转义后参与比较
+ *
+ * 参考实现的数值不经过 JsonNumberParser：字面量按语法分类，值由 FCString::Atoi64 / FCString::Atod 转换，
+ * 各引擎的快速解析因此与独立的转换比较
+ *
+ * 键比较策略与路径转义会改变结果，按输入是否存在歧义分别比较：
+ * - IgnoreCaseKeys / CaseSensitiveKeys：输入没有不区分大小写时冲突的路径（IgnoreCase 扁平化没有 KeyCollisions）时与参考实现完全一致，
+ *   否则 FJsonObject 已合并冲突的键，只比较是否接受输入
+ * - EscapePathKeys：没有需要转义的键名时与参考实现完全一致；否则每条路径还原转义后须为参考实现的路径，
+ *   参考实现的每条路径都须由某条路径还原得到，还原后唯一的路径值须相同
+ *
+ * 数值字面量另外与 FCString::Atod 逐位比较（CheckNumberLiteral）
+ */
+namespace JsonDifferential
+{
+    /** 每个引擎最多记录的差异条数 */
+    inline constexpr int32 MaxReportedMismatches = 8;
+
+    /** 引擎名称（单个引擎） */
+    UNREALREADJSON_API const TCHAR* GetEngineName(EJsonDiffEngines Engine);
+
+    /**
+     * 用参考实现解析
+     * @return 是否接受输入
+     */
+    UNREALREADJSON_API bool ParseReference(const FString& JsonStr, FParsedData& OutParsedData);
+
+    /**
+     * 用单个解析引擎解析（Iterative / Parallel 各自反序列化一次；BulkArrays 不是解析引擎，按参考实现解析）
+     * @return 是否接受输入
+     */
+    UNREALREADJSON_API bool ParseWithEngine(EJsonDiffEngines Engine, const FString& JsonStr, FParsedData& OutParsedData);
+
+    /**
+     * 比较两份解析结果
+     * @param Expected 参考实现的结果
+     * @param Actual 被测引擎的结果
+     * @param EngineName 写入差异描述的引擎名称
+     * @param OutMessages 追加差异描述
+     * @return 是否一致
+     */
+    UNREALREADJSON_API bool CompareParsedData(const FParsedData& Expected, const FParsedData& Actual, const TCHAR* EngineName, TArray<FString>& OutMessages);
+
+    /**
+     * 参考实现中每个数组节点的文本交给批量解析，接受的数组须与逐元素按 FJsonValue 转换（FCString::Atod / Atoi64）的结果逐位相同
+     * @param Reference 参考实现的结果
+     * @param OutMessages 追加差异描述
+     * @return 是否一致
+     */
+    UNREALREADJSON_API bool CompareBulkArrays(const FParsedData& Reference, TArray<FString>& OutMessages);
+
+    /**
+     * 对同一输入运行参考实现与指定的引擎并比较（基于 FJsonObject 的引擎共用参考实现反序列化的结果）
+     * @param JsonStr JSON文本
+     * @param Engines 参与比较的引擎
+     * @param OutResult 比较结果
+     * @return 是否全部一致
+     */
+    UNREALREADJSON_API bool Run(const FString& JsonStr, EJsonDiffEngines Engines, FJsonDiffResult& OutResult);
+
+    /**
+     * 收集文本中字符串以外的数值片段（以 - 或数字开头，由数字、小数点、指数与符号组成），
+     * 不检查片段是否合法，变异输入中的非法片段同样交给 CheckNumberLiteral
+     * @param JsonStr JSON文本
+     * @param OutLiterals 追加收集到的片段
+     */
+    UNREALREADJSON_API void CollectNumberLiterals(const FString& JsonStr, TArray<FString>& OutLiterals);
+
+    /**
+     * 检查 JsonNumberParser 对单个字面量的解析：
+     * - ParseDouble 与 ParseNumber 只接受 JSON 数值语法
+     * - ParseDouble 的结果与 FCString::Atod 逐位相同（包括 -0、次正规数与溢出为 ±Inf）
+     * - 有限值按 %.17g 格式化后再次解析得到同一个值
+     * - ParseNumber 只把不含小数点和指数且在 int64 范围内的字面量分类为整数，整数值与 FCString::Atoi64 相同，
+     *   其余字面量的 double 与 FCString::Atod 逐位相同
+     * @param Literal 字面量文本
+     * @param OutMessages 追加差异描述
+     * @return 是否全部一致
+     */
+    UNREALREADJSON_API bool CheckNumberLiteral(const FString& Literal, TArray<FString>& OutMessages);
+}
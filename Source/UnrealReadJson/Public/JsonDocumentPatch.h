@@ -0,0 +1,102 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "JsonDocumentPatch.generated.h"
+
+// ============================================================================
+// 枚举定义
+// ============================================================================
+
+/**
+ * JSON补丁格式
+ */
+UENUM(BlueprintType)
+enum class EJsonPatchFormat : uint8
+{
+    /** 根据补丁根节点自动判断：数组为 JSON Patch，对象为 Merge Patch */
+    Auto        UMETA(DisplayName = "Auto"),
+    /** RFC 6902 JSON Patch（操作数组） */
+    JsonPatch   UMETA(DisplayName = "JSON Patch (RFC 6902)"),
+    /** RFC 7386 JSON Merge Patch（合并对象） */
+    MergePatch  UMETA(DisplayName = "Merge Patch (RFC 7386)")
+};
+
+// ============================================================================
+// C++ 接口
+// ============================================================================
+
+/**
+ * 增量更新已解析的JSON数据
+ *
+ * 只修改发生变化的路径条目，不重建整个Map，并返回变化路径列表
+ * 注意事项:
+ * - 对象节点在Map中保存的是其序列化字符串，因此子节点变化时，其所有祖先对象节点会被重新序列化并计入变化路径
+ * - 补丁应用失败时（如 test 操作不通过、路径不存在），所有修改会回滚，数据保持不变
+ */
+namespace JsonPatchHelper
+{
+    /**
+     * 使用新的完整JSON文档更新已解析数据，仅写入与旧数据不同的条目
+     * @param InOutMap 已解析的数据
+     * @param NewJsonStr 新的完整JSON字符串（根节点必须为对象）
+     * @param OutChangedPaths 发生变化的路径（新增、修改、删除）
+     * @return 是否成功
+     */
+    UNREALREADJSON_API bool ApplyDocument(TMap<FString, FJsonDataStruct>& InOutMap, const FString& NewJsonStr, TArray<FString>& OutChangedPaths);
+
+    /**
+     * 同上，作用于完整的解析结果（包括区分大小写的数据表与延迟记录的字符串）
+     * 路径索引需由调用方更新（JsonPathIndexHelper::UpdateIndex）
+     */
+    UNREALREADJSON_API bool ApplyDocument(FParsedData& InOutParsedData, const FString& NewJsonStr, TArray<FString>& OutChangedPaths);
+
+    /**
+     * 将 RFC 6902 / RFC 7386 补丁应用到已解析数据
+     * @param InOutMap 已解析的数据
+     * @param PatchStr 补丁字符串
+     * @param Format 补丁格式
+     * @param OutChangedPaths 发生变化的路径（新增、修改、删除）
+     * @return 是否成功
+     */
+    UNREALREADJSON_API bool ApplyPatch(TMap<FString, FJsonDataStruct>& InOutMap, const FString& PatchStr, EJsonPatchFormat Format, TArray<FString>& OutChangedPaths);
+
+    /** 同上，作用于完整的解析结果；路径索引需由调用方更新 */
+    UNREALREADJSON_API bool ApplyPatch(FParsedData& InOutParsedData, const FString& PatchStr, EJsonPatchFormat Format, TArray<FString>& OutChangedPaths);
+}
+
+// ============================================================================
+// 蓝图接口
+// ============================================================================
+
+/**
+ * JSON增量更新蓝图函数库
+ */
+UCLASS()
+class UNREALREADJSON_API UJsonPatchLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 使用新的完整JSON文档更新已解析数据（只更新变化的条目）
+     * @param ParsedData 已解析的数据（原地修改）
+     * @param NewJsonStr 新的完整JSON字符串
+     * @param ChangedPaths 发生变化的路径
+     * @param bIsValid 是否成功
+     */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Patch", DisplayName = "ApplyJsonDocument")
+    static void ApplyJsonDocument(UPARAM(ref) FParsedData& ParsedData, const FString& NewJsonStr, TArray<FString>& ChangedPaths, bool& bIsValid);
+
+    /**
+     * 将JSON补丁应用到已解析数据
+     * @param ParsedData 已解析的数据（原地修改，失败时保持不变）
+     * @param PatchStr 补丁字符串
+     * @param Format 补丁格式
+     * @param ChangedPaths 发生变化的路径
+     * @param bIsValid 是否成功
+     */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Patch", DisplayName = "ApplyJsonPatch")
+    static void ApplyJsonPatch(UPARAM(ref) FParsedData& ParsedData, const FString& PatchStr, EJsonPatchFormat Format, TArray<FString>& ChangedPaths, bool& bIsValid);
+};
@@ -0,0 +1,146 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "JsonData.h"
+
+/**
+ * 开放寻址的扁平化数据表
+ * 与 TMap<FString, FJsonDataStruct> 存储相同的数据，面向构建后频繁查找的文档：
+ * - 条目按插入顺序连续存放，哈希表只保存条目下标和每个槽位 1 字节的控制字节（哈希值的高 7 位）
+ * - 查找时一次比较一组控制字节（x86 上 16 字节 SSE2，其他平台 8 字节 SWAR），只有控制字节与完整哈希都相同时才比较键
+ * - 每个条目保存完整哈希，扩容时不重新计算字符串哈希
+ * - 键比较默认与 TMap<FString> 一致（不区分大小写）；区分大小写时逐字符比较，哈希直接按字节计算，不做大小写转换
+ * - 可按 FStringView 查找而不构造 FString
+ *
+ * 删除保持插入顺序并重建哈希表（O(N)），适合构建后少量修改；与 FParsedData 之间可以互相转换
+ */
+class UNREALREADJSON_API FJsonFlatTable
+{
+public:
+    /** 条目 */
+    struct FEntry
+    {
+        FString Key;
+        FJsonDataStruct Value;
+        uint32 Hash = 0;
+    };
+
+    /** @param InKeyPolicy 键比较策略，只有 CaseSensitive 区分大小写 */
+    explicit FJsonFlatTable(EJsonKeyPolicy InKeyPolicy = EJsonKeyPolicy::Default)
+        : KeyPolicy(InKeyPolicy)
+    {
+    }
+
+    /** 从扁平化 Map 构建（复制） */
+    explicit FJsonFlatTable(const TMap<FString, FJsonDataStruct>& Map);
+
+    /** 从扁平化 Map 构建（移出 Map 中的键和值，Map 随后被清空） */
+    explicit FJsonFlatTable(TMap<FString, FJsonDataStruct>&& Map);
+
+    /** 从解析结果构建，延迟记录的字符串会被反转义后一并加入；以数据表存储的文档沿用其键比较策略 */
+    static FJsonFlatTable FromParsedData(const FParsedData& ParsedData);
+
+    /** 转换为解析结果（按插入顺序写入 ParsedDataMap；区分大小写时复制到 FlatEntries） */
+    void ToParsedData(FParsedData& OutParsedData) const;
+
+    /** 清空，并为 ExpectedNum 个条目预留 */
+    void Reset(int32 ExpectedNum = 0);
+
+    /** 预留容量，添加 Number 个条目之前不再扩容 */
+    void Reserve(int32 Number);
+
+    /** 添加条目，键已存在时覆盖值 */
+    FJsonDataStruct& Add(FString Key, FJsonDataStruct Value)
+    {
+        const uint32 Hash = HashKey(Key);
+        return AddByHash(Hash, MoveTemp(Key), MoveTemp(Value));
+    }
+
+    /** 按预先计算的哈希（HashKey）添加条目，键已存在时覆盖值 */
+    FJsonDataStruct& AddByHash(uint32 Hash, FString Key, FJsonDataStruct Value);
+
+    /**
+     * 删除条目，之后的条目下标减一
+     * @return 键是否存在
+     */
+    bool Remove(FStringView Key);
+
+    /**
+     * 删除键满足条件的全部条目，保持其余条目的插入顺序，只重建一次哈希表
+     * @return 删除的条目数量
+     */
+    template <typename TPredicate>
+    int32 RemoveAll(TPredicate&& Predicate)
+    {
+        const int32 NumRemoved = Entries.RemoveAll([&Predicate](const FEntry& Entry) { return Predicate(Entry.Key); });
+        if (NumRemoved > 0)
+        {
+            Rehash(SlotEntries.Num());
+        }
+        return NumRemoved;
+    }
+
+    /** 查找条目 */
+    const FJsonDataStruct* Find(FStringView Key) const { return FindByHash(HashKey(Key), Key); }
+
+    FJsonDataStruct* Find(const FStringView Key) { return const_cast<FJsonDataStruct*>(FindByHash(HashKey(Key), Key)); }
+
+    /** 条目在 GetEntries 中的下标（下标在 Remove / Reset 之前不变） */
+    int32 IndexOf(const FStringView Key) const { return FindEntryIndex(HashKey(Key), Key); }
+
+    /** 按预先计算的哈希（HashKey）查找条目 */
+    const FJsonDataStruct* FindByHash(uint32 Hash, FStringView Key) const;
+
+    /** 条目数量 */
+    int32 Num() const { return Entries.Num(); }
+
+    /** 按插入顺序排列的条目 */
+    const TArray<FEntry>& GetEntries() const { return Entries; }
+
+    /** 哈希槽位数量 */
+    int32 GetCapacity() const { return SlotEntries.Num(); }
+
+    /** 表自身分配的内存（不含字符串内容，与 TMap::GetAllocatedSize 口径相同） */
+    SIZE_T GetAllocatedSize() const
+    {
+        return Entries.GetAllocatedSize() + Controls.GetAllocatedSize() + SlotEntries.GetAllocatedSize();
+    }
+
+    /** 键比较策略 */
+    EJsonKeyPolicy GetKeyPolicy() const { return KeyPolicy; }
+
+    bool IsCaseSensitive() const { return KeyPolicy == EJsonKeyPolicy::CaseSensitive; }
+
+    /** 键的哈希（按键比较策略，与 Find 一致） */
+    uint32 HashKey(const FStringView Key) const { return HashKey(Key, KeyPolicy); }
+
+    static uint32 HashKey(FStringView Key, EJsonKeyPolicy KeyPolicy);
+
+private:
+    /** 查找键所在的条目下标 */
+    int32 FindEntryIndex(uint32 Hash, FStringView Key) const;
+
+    /** 将条目插入哈希表（调用方保证键不存在且容量足够） */
+    void InsertSlot(uint32 Hash, int32 EntryIndex);
+
+    /** 按新的槽位数量重建哈希表 */
+    void Rehash(int32 NewCapacity);
+
+    void SetControl(int32 Slot, uint8 Control);
+
+    bool KeysEqual(const FStringView A, const FStringView B) const
+    {
+        return A.Equals(B, IsCaseSensitive() ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase);
+    }
+
+    EJsonKeyPolicy KeyPolicy = EJsonKeyPolicy::Default;
+
+    TArray<FEntry> Entries;
+
+    /** 控制字节，长度为槽位数量加一组，末尾一组镜像开头，成组读取时不需要回绕 */
+    TArray<uint8> Controls;
+
+    /** 每个槽位对应的条目下标 */
+    TArray<int32> SlotEntries;
+};
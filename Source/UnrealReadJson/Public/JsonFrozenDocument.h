@@ -0,0 +1,93 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "JsonData.h"
+
+class FJsonFlatTable;
+
+/**
+ * 冻结的只读文档
+ * 面向解析一次、之后大量读取的文档（如服务器配置）：冻结时对全部路径构建最小完美哈希（CHD，先哈希分桶再按桶位移），
+ * 每个路径对应 [0, Num) 中唯一的槽位，键与值按槽位连续存放：
+ * - 查找固定为一次哈希、一次位移表读取、一次键比较，不存在探测链
+ * - 键集中保存在一块字符缓冲中，不为每个键单独分配 FString；位移表平均每个键约 1 字节
+ * - 键比较策略与来源一致（区分大小写的文档或数据表冻结后仍区分大小写，哈希直接按字节计算），不存在的路径同样只比较一次即返回
+ *
+ * 冻结后不可修改，需要修改时转换回 FParsedData；可在多个线程间共享只读访问
+ */
+class UNREALREADJSON_API FJsonFrozenDocument
+{
+public:
+    FJsonFrozenDocument() = default;
+
+    /**
+     * 冻结解析结果，延迟记录的字符串会被反转义后一并加入
+     * @param ParsedData 已解析的数据
+     * @return 是否冻结成功（仅在两个路径的 64 位哈希相同时失败）
+     */
+    bool Freeze(const FParsedData& ParsedData);
+
+    /** 冻结扁平化数据表（沿用数据表的键比较策略） */
+    bool Freeze(const FJsonFlatTable& Table);
+
+    /** 冻结扁平化 Map（不区分大小写） */
+    bool Freeze(const TMap<FString, FJsonDataStruct>& Map);
+
+    /** 转换为解析结果（按槽位顺序写入 ParsedDataMap；区分大小写时写入 FlatEntries） */
+    void ToParsedData(FParsedData& OutParsedData) const;
+
+    /** 清空 */
+    void Reset();
+
+    /** 查找条目 */
+    const FJsonDataStruct* Find(FStringView Key) const;
+
+    /** 条目数量 */
+    int32 Num() const { return Values.Num(); }
+
+    /** 是否区分大小写 */
+    bool IsCaseSensitive() const { return bCaseSensitive; }
+
+    /** 槽位 Index 的键 */
+    FStringView GetKey(const int32 Index) const
+    {
+        return FStringView(KeyChars.GetData() + KeyOffsets[Index], KeyOffsets[Index + 1] - KeyOffsets[Index]);
+    }
+
+    /** 槽位 Index 的值 */
+    const FJsonDataStruct& GetValue(const int32 Index) const { return Values[Index]; }
+
+    /** 文档占用的内存（包含键的内容，不含值中字符串的堆内存） */
+    SIZE_T GetAllocatedSize() const
+    {
+        return KeyChars.GetAllocatedSize() + KeyOffsets.GetAllocatedSize() + Values.GetAllocatedSize() + Displacements.GetAllocatedSize();
+    }
+
+private:
+    /** 待冻结的条目 */
+    struct FPendingEntry
+    {
+        FStringView Key;
+        const FJsonDataStruct* Value = nullptr;
+        uint64 Hash = 0;
+    };
+
+    bool Build(TArray<FPendingEntry>& Pending, bool bInCaseSensitive);
+
+    uint64 HashPath(FStringView Key) const;
+
+    /** 键连续存放，槽位 i 的键为 [KeyOffsets[i], KeyOffsets[i + 1]) */
+    TArray<TCHAR> KeyChars;
+    TArray<int32> KeyOffsets;
+
+    /** 按槽位存放的值 */
+    TArray<FJsonDataStruct> Values;
+
+    /**
+     * 每个桶的位移：0 表示空桶，正数为该桶使用的哈希种子，负数 -(Slot + 1) 表示只有一个键的桶直接指定的槽位
+     */
+    TArray<int32> Displacements;
+
+    bool bCaseSensitive = false;
+};
@@ -0,0 +1,164 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "JsonFlatTable.h"
+#include "UObject/Object.h"
+#include "JsonLayeredDocument.generated.h"
+
+/**
+ * 按优先级叠加的多层文档
+ * 持有若干共享的只读解析结果（如 基础配置 -> 平台覆盖 -> 运营覆盖），后加入的层优先；查找时按层解析，不复制任何层的条目
+ * - 路径的哈希只计算一次，逐层按同一哈希探测；没有隐藏子树时每个路径的代价约为一次哈希加各层一次探测
+ * - 对象按路径深度合并：上层对象中没有的子路径继续读取下层
+ * - 上层把下层的对象替换为非对象值（包括 null 与数组）时，下层该对象下的全部路径被隐藏
+ * - 对象节点保存的文本只来自提供该路径的那一层，需要合并后的文本时用 ToParsedData 生成独立文档
+ * - 各层须使用相同的键比较方式（是否区分大小写）与路径编码
+ *
+ * 加入一层的代价与该层条目数乘以层数成正比（检查隐藏的子树）；层在加入后不可修改，读取接口可以在多个线程同时调用
+ */
+class UNREALREADJSON_API FJsonLayeredDocument
+{
+public:
+    // ========================================================================
+    // 层
+    // ========================================================================
+
+    /**
+     * 在最上方加入一层（优先级最高）
+     * @return 与已有的层的键比较方式、路径编码是否一致
+     */
+    bool PushLayer(const TSharedRef<const FParsedData>& Layer);
+
+    /**
+     * 移除一层
+     * @param LayerIndex 层下标，0 为最底层
+     * @return 下标是否有效
+     */
+    bool RemoveLayer(int32 LayerIndex);
+
+    /** 移除全部层 */
+    void Reset();
+
+    int32 NumLayers() const { return Layers.Num(); }
+
+    const TSharedRef<const FParsedData>& GetLayer(const int32 LayerIndex) const { return Layers[LayerIndex]; }
+
+    // ========================================================================
+    // 读取
+    // ========================================================================
+
+    /** 查找条目（与 FParsedData::FindEntry 相同，不含延迟记录的字符串） */
+    const FJsonDataStruct* Find(const FString& NodePath) const;
+
+    /**
+     * 读取节点数据，延迟记录的字符串会被反转义
+     * @return 路径是否存在
+     */
+    bool GetNodeData(const FString& NodePath, FJsonDataStruct& OutValue) const;
+
+    /** 路径是否存在（包括延迟记录的字符串） */
+    bool Contains(const FString& NodePath) const { return FindLayerIndex(NodePath) != INDEX_NONE; }
+
+    /** 提供路径的值的层下标，不存在时为 INDEX_NONE */
+    int32 FindLayerIndex(const FString& NodePath) const;
+
+    // ========================================================================
+    // 合并
+    // ========================================================================
+
+    /**
+     * 合并为独立的文档
+     * 条目按层从下到上、层内按原顺序排列；被上层修改过的对象按子条目重新生成文本
+     * 只有一层时直接复制该层（共享延迟字符串的源文本）
+     */
+    void ToParsedData(FParsedData& OutParsedData) const;
+
+private:
+    /** 路径在一层中的查找结果 */
+    struct FLayerHit
+    {
+        const FJsonDataStruct* Entry = nullptr;
+        bool bLazy = false;
+
+        bool IsFound() const { return Entry || bLazy; }
+    };
+
+    /** 按预先计算的哈希在一层中查找 */
+    FLayerHit FindInLayer(int32 LayerIndex, uint32 Hash, const FString& NodePath) const;
+
+    /** 路径的哈希（与各层的键比较方式一致） */
+    uint32 HashPath(const FString& NodePath) const;
+
+    /** 从上到下查找提供路径的层，低于被隐藏的层不再查找 */
+    int32 ResolveLayer(uint32 Hash, const FString& NodePath, FLayerHit& OutHit) const;
+
+    /** 路径所在的子树被隐藏的最高层（层下标低于返回值的条目不可见），没有时为0 */
+    int32 GetVisibleFloor(FStringView NodePath) const;
+
+    /** 记录该层用非对象值替换下层对象的路径 */
+    void AddHiddenSubtrees(int32 LayerIndex);
+
+    /** 按层从下到上排列（最后一个优先级最高） */
+    TArray<TSharedRef<const FParsedData>> Layers;
+
+    bool bCaseSensitive = false;
+    bool bEscapedPaths = false;
+
+    /** 被替换为非对象值的对象路径 -> 替换它的最高层下标（IntValue）；为空时读取不检查祖先路径 */
+    FJsonFlatTable HiddenSubtrees;
+};
+
+/**
+ * 多层文档（蓝图）
+ * 每次 PushLayer 复制一次传入的解析结果，之后的查找不再复制条目
+ */
+UCLASS(BlueprintType)
+class UNREALREADJSON_API UJsonLayeredDocument : public UObject
+{
+    GENERATED_BODY()
+
+    /* Property */
+private:
+    FJsonLayeredDocument Document;
+
+
+    /* Function */
+public:
+    /** 创建空的多层文档 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Layered")
+    static UJsonLayeredDocument* CreateLayeredDocument();
+
+    /**
+     * 在最上方加入一层（优先级最高）
+     * @param Layer 解析结果
+     * @param bIsValid 与已有的层的键比较方式、路径编码是否一致
+     */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Layered")
+    void PushLayer(const FParsedData& Layer, bool& bIsValid);
+
+    /** 移除一层（0 为最底层） */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Layered")
+    void RemoveLayer(int32 LayerIndex, bool& bIsValid);
+
+    /** 层数 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Layered")
+    int32 NumLayers() const { return Document.NumLayers(); }
+
+    /** 获取节点完整数据（按优先级从上到下查找） */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Layered")
+    void GetNodeData(const FString& NodePath, FJsonNode& NodeData, bool& bIsValid) const;
+
+    /** 提供节点值的层下标，不存在时为 -1 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Layered")
+    int32 GetNodeLayer(const FString& NodePath) const { return Document.FindLayerIndex(NodePath); }
+
+    /** 合并为独立的解析结果 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Layered")
+    void ToParsedData(FParsedData& ParsedData) const;
+
+    /** C++ 访问 */
+    const FJsonLayeredDocument& GetDocument() const { return Document; }
+
+    FJsonLayeredDocument& GetMutableDocument() { return Document; }
+};
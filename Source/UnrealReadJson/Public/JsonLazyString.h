@@ -0,0 +1,118 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "JsonData.h"
+
+/**
+ * 字符串值在源文本中的区间（不含引号）
+ */
+struct FJsonSourceSpan
+{
+    int32 Offset = 0;
+    int32 Length = 0;
+
+    /** 区间内含有转义序列，使用前需要反转义 */
+    bool bHasEscapes = false;
+};
+
+/**
+ * 延迟记录的字符串节点
+ * 持有源文本，每个节点只记录路径和区间；读取时才构造 FString，
+ * Base64 内容可以直接从源文本解码为二进制，不经过中间字符串
+ *
+ * 不含转义的字符串可通过 GetStringView 零拷贝读取；含转义的字符串在第一次读取时反转义并缓存，
+ * 之后的读取（包括 GetStringView）直接使用缓存。读取接口可以在多个线程同时调用
+ *
+ * 由 FParsedData::LazyStrings 共享持有，拷贝 FParsedData 不会复制源文本
+ * 这些节点不在 ParsedDataMap 中，通过 FParsedData::FindValue / GetValue / ForEachPath 与条目一起读取（路径索引、查询、结构体绑定与补丁均使用这些接口），
+ * 需要完整 Map 时调用 MaterializeTo
+ */
+class UNREALREADJSON_API FJsonLazyStrings
+{
+public:
+    explicit FJsonLazyStrings(const TSharedRef<const FString>& InSource);
+
+    /** 记录字符串节点 */
+    void Add(FString&& Path, const FJsonSourceSpan& Span);
+
+    /** 预留节点容量 */
+    void Reserve(int32 Number);
+
+    /**
+     * 删除节点记录（节点被写入条目或删除时使用），源文本不变
+     * @return 节点是否存在
+     */
+    bool Remove(const FString& Path);
+
+    /** 复制节点记录（共享源文本，不复制反转义缓存），修改被多份 FParsedData 共享的记录前使用 */
+    TSharedRef<FJsonLazyStrings> Clone() const;
+
+    /** 节点数量 */
+    int32 Num() const { return SpanIndices.Num(); }
+
+    /** 查找节点区间 */
+    const FJsonSourceSpan* Find(const FString& Path) const;
+
+    /** 按预先计算的哈希（GetTypeHash(Path)，与 ParsedDataMap 一致）查找节点区间 */
+    const FJsonSourceSpan* FindByHash(uint32 Hash, const FString& Path) const;
+
+    /**
+     * 读取字符串值
+     * @param Path 节点路径
+     * @param OutValue 字符串值
+     * @return 节点是否存在
+     */
+    bool GetString(const FString& Path, FString& OutValue) const;
+
+    /** 按预先计算的哈希读取字符串值 */
+    bool GetStringByHash(uint32 Hash, const FString& Path, FString& OutValue) const;
+
+    /**
+     * 读取字符串值的视图，不复制字符串
+     * 视图指向源文本或反转义缓存，在本对象销毁前有效
+     * @param Path 节点路径
+     * @param OutView 字符串视图
+     * @return 节点是否存在
+     */
+    bool GetStringView(const FString& Path, FStringView& OutView) const;
+
+    /**
+     * 将字符串值按 Base64 解码
+     * 不含转义时直接从源文本解码，不构造中间 FString
+     * @param Path 节点路径
+     * @param OutBytes 解码结果
+     * @return 节点是否存在且为合法的 Base64
+     */
+    bool DecodeBase64(const FString& Path, TArray<uint8>& OutBytes) const;
+
+    /** 将全部节点反转义后写入扁平化 Map */
+    void MaterializeTo(TMap<FString, FJsonDataStruct>& OutMap) const;
+
+    /** 按记录顺序遍历节点路径与区间（区间内容未反转义） */
+    template <typename TFunction>
+    void ForEachSpan(TFunction&& Function) const
+    {
+        for (const TPair<FString, int32>& Pair : SpanIndices)
+        {
+            Function(Pair.Key, Spans[Pair.Value]);
+        }
+    }
+
+    /** 源文本 */
+    const FString& GetSource() const { return *Source; }
+
+private:
+    /** 按下标取得视图，含转义时反转义并写入缓存 */
+    FStringView GetViewByIndex(int32 SpanIndex) const;
+
+    TSharedRef<const FString> Source;
+
+    /** 路径 -> Spans 下标 */
+    TMap<FString, int32> SpanIndices;
+    TArray<FJsonSourceSpan> Spans;
+
+    /** 含转义节点的反转义缓存，与 Spans 一一对应，未读取的为空；元素地址在创建后不变 */
+    mutable TArray<TUniquePtr<FString>> Unescaped;
+    mutable FRWLock UnescapedLock;
+};
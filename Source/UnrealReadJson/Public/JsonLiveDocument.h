@@ -0,0 +1,192 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "JsonDocumentPatch.h"
+#include "JsonPath.h"
+#include "Containers/Ticker.h"
+#include "JsonLiveDocument.generated.h"
+
+/** 订阅路径发生变化时的委托（蓝图） */
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnJsonPathChanged, const FString&, SubscribedPath, const TArray<FString>&, ChangedPaths);
+
+/** 订阅路径发生变化时的委托（C++） */
+DECLARE_DELEGATE_TwoParams(FOnJsonPathChangedNative, const FString& /*SubscribedPath*/, const TArray<FString>& /*ChangedPaths*/);
+
+/**
+ * 可持续更新的JSON文档
+ * 通过 ApplyJsonDocument / ApplyJsonPatch 增量更新，订阅者只在关心的路径发生变化时收到通知
+ * - 通知按帧合并，每个订阅者每帧最多回调一次
+ * - 订阅按路径段组织为前缀树，分发成本与变化路径的深度相关，与订阅者数量无关
+ */
+UCLASS(BlueprintType)
+class UNREALREADJSON_API UJsonLiveDocument : public UObject
+{
+    GENERATED_BODY()
+
+    /* Property */
+private:
+    /** 订阅记录 */
+    struct FSubscription
+    {
+        FString Path;
+        int32 TrieNodeIndex = INDEX_NONE;
+        bool bIncludeDescendants = false;
+        FOnJsonPathChanged Delegate;
+        FOnJsonPathChangedNative NativeDelegate;
+    };
+
+    /** 订阅前缀树节点（路径按文档的编码拆分为路径段，见 JsonPath::SplitPath；按文档的键比较策略匹配） */
+    struct FSubscriptionTrieNode
+    {
+        TJsonSegmentMap<int32> Children;
+        TArray<int32> ExactSubscribers;
+        TArray<int32> PrefixSubscribers;
+
+        /** 所在路径段与父节点（用于取消订阅后回收节点） */
+        FString Segment;
+        int32 Parent = INDEX_NONE;
+
+        bool IsEmpty() const
+        {
+            return Children.IsEmpty() && ExactSubscribers.IsEmpty() && PrefixSubscribers.IsEmpty();
+        }
+    };
+
+    /** 当前文档数据 */
+    FParsedData ParsedData;
+
+    /** 订阅句柄 -> 订阅记录 */
+    TMap<int32, FSubscription> Subscriptions;
+
+    /** 订阅前缀树，下标0为根节点 */
+    TArray<FSubscriptionTrieNode> TrieNodes;
+
+    /** 已回收可复用的前缀树节点下标 */
+    TArray<int32> FreeTrieNodes;
+
+    /** 下一个订阅句柄 */
+    int32 NextSubscriptionHandle = 1;
+
+    /** 本帧内累计的变化路径 */
+    TSet<FString> PendingChangedPaths;
+
+    /** 分发通知的 Ticker 句柄（只在有待分发变化时注册） */
+    FTSTicker::FDelegateHandle DispatchTickerHandle;
+
+
+    /* Function */
+public:
+    UJsonLiveDocument();
+
+    virtual void BeginDestroy() override;
+
+    // ========================================================================
+    // 创建与更新
+    // ========================================================================
+
+    /**
+     * 创建可持续更新的JSON文档
+     * @param InitialData 初始数据
+     * @return 文档对象
+     */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|LiveDocument")
+    static UJsonLiveDocument* CreateLiveDocument(const FParsedData& InitialData);
+
+    /** 使用新的完整JSON文档更新（只更新变化的条目） */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|LiveDocument")
+    void ApplyJsonDocument(const FString& NewJsonStr, TArray<FString>& ChangedPaths, bool& bIsValid);
+
+    /** 应用JSON补丁 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|LiveDocument")
+    void ApplyJsonPatch(const FString& PatchStr, EJsonPatchFormat Format, TArray<FString>& ChangedPaths, bool& bIsValid);
+
+    /** 手动登记变化路径（用于直接修改 GetMutableParsedData 之后） */
+    void NotifyPathsChanged(const TArray<FString>& ChangedPaths);
+
+    /** 立即分发本帧累计的变化通知 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|LiveDocument")
+    void FlushNotifications();
+
+    // ========================================================================
+    // 订阅
+    // ========================================================================
+
+    /**
+     * 订阅路径变化
+     * @param NodePath 订阅的路径
+     * @param bIncludeDescendants 为true时，NodePath 及其所有子路径的变化都会通知
+     * @param OnChanged 变化回调
+     * @return 订阅句柄（用于取消订阅）
+     */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|LiveDocument")
+    int32 Subscribe(const FString& NodePath, bool bIncludeDescendants, FOnJsonPathChanged OnChanged);
+
+    /** 订阅路径变化（C++） */
+    int32 SubscribeNative(const FString& NodePath, bool bIncludeDescendants, FOnJsonPathChangedNative OnChanged);
+
+    /** 取消订阅 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|LiveDocument")
+    void Unsubscribe(int32 SubscriptionHandle);
+
+    // ========================================================================
+    // 读取
+    // ========================================================================
+
+    /** 获取文档数据（只读引用，无拷贝） */
+    const FParsedData& GetParsedDataRef() const { return ParsedData; }
+
+    /** 获取可修改的文档数据，修改后需调用 NotifyPathsChanged */
+    FParsedData& GetMutableParsedData() { return ParsedData; }
+
+    /**
+     * 获取完整解析结果
+     * @note 蓝图中会拷贝整个Map，读取单个字段请直接使用下方的 GetNodeValue 节点
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|LiveDocument")
+    FParsedData GetParsedData() const { return ParsedData; }
+
+    /** 获取节点完整数据 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|LiveDocument")
+    void GetNodeData(const FString& NodePath, FJsonNode& NodeData, bool& bIsValid) const;
+
+    /** 获取字符串值 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|LiveDocument", DisplayName = "GetNodeValue_ToString")
+    void GetNodeValueToString(const FString& NodePath, FString& NodeValue, bool& bIsValid) const;
+
+    /** 获取整数值 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|LiveDocument", DisplayName = "GetNodeValue_ToInt")
+    void GetNodeValueToInt(const FString& NodePath, int32& NodeValue, bool& bIsValid) const;
+
+    /** 获取64位整数值（同时接受 Int 节点） */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|LiveDocument", DisplayName = "GetNodeValue_ToInt64")
+    void GetNodeValueToInt64(const FString& NodePath, int64& NodeValue, bool& bIsValid) const;
+
+    /** 获取浮点值 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|LiveDocument", DisplayName = "GetNodeValue_ToFloat")
+    void GetNodeValueToFloat(const FString& NodePath, float& NodeValue, bool& bIsValid) const;
+
+    /** 获取双精度值（同时接受 Float 节点） */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|LiveDocument", DisplayName = "GetNodeValue_ToDouble")
+    void GetNodeValueToDouble(const FString& NodePath, double& NodeValue, bool& bIsValid) const;
+
+    /** 获取布尔值 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|LiveDocument", DisplayName = "GetNodeValue_ToBool")
+    void GetNodeValueToBool(const FString& NodePath, bool& NodeValue, bool& bIsValid) const;
+
+private:
+    /** 添加订阅记录并插入前缀树 */
+    int32 AddSubscription(FSubscription&& Subscription);
+
+    /** 查找或创建路径对应的前缀树节点 */
+    int32 FindOrAddTrieNode(const FString& NodePath);
+
+    /** 从指定节点向上回收没有订阅者和子节点的前缀树节点 */
+    void PruneTrieNodes(int32 NodeIndex);
+
+    /** 登记变化路径并在下一帧分发 */
+    void QueueChangedPaths(const TArray<FString>& ChangedPaths);
+
+    /** Ticker 回调 */
+    bool HandleDispatchTick(float DeltaTime);
+};
@@ -0,0 +1,81 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 数值字面量快速解析
+ * 浮点数使用 Eisel-Lemire 算法：有效数字不超过19位时，用 64 位尾数与预先计算的 128 位 5 的幂相乘，
+ * 直接得到正确舍入的 double，不经过 FCString::Atod 的逐位高精度转换；
+ * 有效数字超过19位的少见情况回退到 FCString::Atod
+ *
+ * 只接受 JSON 数值语法：-?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+ *
+ * 连续的数字字符每 4 个一组（UTF-16 的 4 个字符恰好是一个 uint64）用 SWAR 方式检查并合并，
+ * 长尾数和数值数组的解析不再逐字符累加
+ */
+namespace JsonNumberParser
+{
+    /**
+     * 解析数值字面量为 double（正确舍入，与 strtod 结果一致）
+     * 
+     * @param Literal 字面量文本
+     * @param Length 字面量长度
+     * @param OutValue 解析结果，超出范围时为 ±Inf
+     * @return 是否为合法的 JSON 数值字面量
+     */
+    UNREALREADJSON_API bool ParseDouble(const TCHAR* Literal, int32 Length, double& OutValue);
+
+    /**
+     * 解析数值字面量，只遍历一次
+     * 不含小数点和指数且在 int64 范围内的字面量输出为整数，其余输出为 double
+     * 
+     * @param Literal 字面量文本
+     * @param Length 字面量长度
+     * @param bOutIsInteger 是否为整数（决定 OutInteger / OutDouble 哪个有效）
+     * @param OutInteger 整数值
+     * @param OutDouble 浮点值
+     * @return 是否为合法的 JSON 数值字面量
+     */
+    UNREALREADJSON_API bool ParseNumber(const TCHAR* Literal, int32 Length, bool& bOutIsInteger, int64& OutInteger, double& OutDouble);
+
+    /**
+     * 将只包含数值的 JSON 数组文本直接解析到连续数组
+     * 按逗号数量一次性预留容量，不构建 FJsonValue，不为元素分配内存
+     * 
+     * 遇到非数值元素、语法错误或数值不符合目标类型（如整数数组中的 1.5、超出范围的整数、非有限浮点数）时返回 false，
+     * OutValues 被清空，调用方可回退到逐元素的 DOM 解析
+     * 
+     * @param Text JSON 数组文本
+     * @param Length 文本长度
+     * @param OutValues 输出数组
+     * @return 是否全部解析成功
+     */
+    UNREALREADJSON_API bool ParseFloatArray(const TCHAR* Text, int32 Length, TArray<float>& OutValues);
+
+    /** 解析数值数组到 double，规则同 ParseFloatArray */
+    UNREALREADJSON_API bool ParseDoubleArray(const TCHAR* Text, int32 Length, TArray<double>& OutValues);
+
+    /** 解析整数数组到 int32，规则同 ParseFloatArray，元素须为 int32 范围内的整数字面量 */
+    UNREALREADJSON_API bool ParseIntArray(const TCHAR* Text, int32 Length, TArray<int32>& OutValues);
+
+    /** 解析整数数组到 int64，规则同 ParseFloatArray，元素须为 int64 范围内的整数字面量 */
+    UNREALREADJSON_API bool ParseInt64Array(const TCHAR* Text, int32 Length, TArray<int64>& OutValues);
+
+    /**
+     * 将二维数值数组 [[...],[...]] 一次遍历解析为行优先的连续数组
+     * 元素 (Row, Column) 位于 OutValues[Row * OutNumColumns + Column]
+     * 
+     * 各行长度必须一致，元素规则同 ParseFloatArray；失败时输出清空、行列数为 0
+     * 
+     * @param Text JSON 二维数组文本
+     * @param Length 文本长度
+     * @param OutValues 行优先的输出数组
+     * @param OutNumRows 行数
+     * @param OutNumColumns 列数
+     * @return 是否全部解析成功
+     */
+    UNREALREADJSON_API bool ParseFloatMatrix(const TCHAR* Text, int32 Length, TArray<float>& OutValues, int32& OutNumRows, int32& OutNumColumns);
+
+    /** 解析二维整数数组到 int32，规则同 ParseFloatMatrix，元素须为 int32 范围内的整数字面量 */
+    UNREALREADJSON_API bool ParseIntMatrix(const TCHAR* Text, int32 Length, TArray<int32>& OutValues, int32& OutNumRows, int32& OutNumColumns);
+}
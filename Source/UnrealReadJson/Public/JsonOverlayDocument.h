@@ -0,0 +1,201 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "JsonFlatTable.h"
+#include "UObject/Object.h"
+#include "JsonOverlayDocument.generated.h"
+
+/**
+ * 写时复制的覆盖文档
+ * 共享一份只读的基础文档，只记录被修改或删除的路径；读取时先查覆盖表，未覆盖的路径直接读取基础文档
+ * - 适用于在共享配置上为每局游戏、每种模式打少量补丁，不复制整个 FParsedData
+ * - 删除对象或用其他值替换对象时，其下的全部路径一并隐藏
+ * - 只能在根节点或已有对象下新增路径（与 JsonDocumentPatch 的规则一致）；设置的对象文本不会展开为子路径
+ * - 按基础文档的键比较策略与路径编码处理路径
+ * - 读取结果中对象节点保存的文本不反映覆盖的修改，需要时用 ToParsedData 生成独立文档（会刷新对象文本）
+ *
+ * 基础文档在共享期间不可修改；多个覆盖文档可在不同线程中各自读写，单个覆盖文档非线程安全
+ */
+class UNREALREADJSON_API FJsonOverlayDocument
+{
+public:
+    FJsonOverlayDocument();
+
+    /** @param InBase 共享的基础文档 */
+    explicit FJsonOverlayDocument(const TSharedRef<const FParsedData>& InBase);
+
+    // ========================================================================
+    // 修改
+    // ========================================================================
+
+    /**
+     * 设置路径的值
+     * @param NodePath 已有路径，或父节点为根/对象的新路径
+     * @param Value 新值
+     * @return 路径是否可以设置
+     */
+    bool SetValue(const FString& NodePath, const FJsonDataStruct& Value);
+
+    /**
+     * 删除路径及其下的全部路径
+     * @return 路径是否存在
+     */
+    bool Remove(const FString& NodePath);
+
+    /** 撤销全部修改 */
+    void ResetOverrides();
+
+    // ========================================================================
+    // 读取
+    // ========================================================================
+
+    /**
+     * 查找条目（覆盖表优先，其余读取基础文档；与 FParsedData::FindEntry 相同，不含延迟记录的字符串）
+     * 返回的指针在下一次修改前有效
+     */
+    const FJsonDataStruct* Find(const FString& NodePath) const;
+
+    /**
+     * 读取节点数据，基础文档中延迟记录的字符串会被反转义
+     * @return 路径是否存在
+     */
+    bool GetNodeData(const FString& NodePath, FJsonDataStruct& OutValue) const;
+
+    /** 路径是否存在（包括基础文档中延迟记录的字符串） */
+    bool Contains(const FString& NodePath) const;
+
+    /** 是否有修改 */
+    bool IsModified() const { return Overrides.Num() > 0; }
+
+    /** 被修改或删除的路径（按修改顺序，同一路径只出现一次） */
+    void GetModifiedPaths(TArray<FString>& OutPaths) const;
+
+    const FParsedData& GetBase() const { return *Base; }
+
+    const TSharedRef<const FParsedData>& GetSharedBase() const { return Base; }
+
+    // ========================================================================
+    // 合并
+    // ========================================================================
+
+    /**
+     * 合并为独立的文档（不再共享基础文档的存储）
+     * 被修改路径的祖先对象按子条目重新生成文本；未涉及修改的延迟字符串继续与基础文档共享源文本
+     */
+    void ToParsedData(FParsedData& OutParsedData) const;
+
+private:
+    /** 覆盖条目的状态，与 Overrides 的条目一一对应 */
+    struct FOverrideState
+    {
+        /** 路径已被删除 */
+        bool bRemoved = false;
+        /** 路径下的全部子路径被隐藏（删除或替换了对象） */
+        bool bHidesDescendants = false;
+    };
+
+    /**
+     * 按覆盖表与基础文档解析路径（不含延迟记录的字符串）
+     * @param bOutShadowed 路径被覆盖表删除或被祖先隐藏，此时不应再读取基础文档
+     */
+    const FJsonDataStruct* Resolve(const FString& NodePath, bool& bOutShadowed) const;
+
+    /** 删除路径下的全部覆盖条目 */
+    void RemoveDescendantOverrides(FStringView NodePath);
+
+    /** 是否被已删除或已替换的祖先路径隐藏 */
+    bool IsHiddenByAncestor(FStringView NodePath) const;
+
+    /** Descendant 是否为 Ancestor 的子路径 */
+    bool IsDescendantPath(FStringView Descendant, FStringView Ancestor) const;
+
+    /** 基础文档中是否存在路径（包括延迟记录的字符串） */
+    bool BaseContains(const FString& NodePath) const;
+
+    /** 写入覆盖条目并返回其状态 */
+    FOverrideState& AddOverride(const FString& NodePath, const FJsonDataStruct& Value);
+
+    TSharedRef<const FParsedData> Base;
+
+    /** 覆盖的条目（与基础文档的键比较策略一致） */
+    FJsonFlatTable Overrides;
+    TArray<FOverrideState> OverrideStates;
+
+    /** 隐藏子路径的覆盖条目数量（为0时读取不检查祖先路径） */
+    int32 NumHidingOverrides = 0;
+};
+
+/**
+ * 覆盖文档（蓝图）
+ * 由 CreateOverlayBase 复制一次基础数据，之后 CreateOverlay 创建的覆盖文档共享这份数据，只记录各自的修改
+ */
+UCLASS(BlueprintType)
+class UNREALREADJSON_API UJsonOverlayDocument : public UObject
+{
+    GENERATED_BODY()
+
+    /* Property */
+private:
+    FJsonOverlayDocument Document;
+
+
+    /* Function */
+public:
+    /**
+     * 创建覆盖文档，基础数据只在此处复制一次
+     * @param BaseData 基础数据
+     * @return 没有修改的覆盖文档，可继续用 CreateOverlay 创建共享同一基础数据的覆盖文档
+     */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Overlay")
+    static UJsonOverlayDocument* CreateOverlayBase(const FParsedData& BaseData);
+
+    /** 创建共享同一基础数据的新覆盖文档（不包含本文档的修改） */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Overlay")
+    UJsonOverlayDocument* CreateOverlay() const;
+
+    /** 设置节点值 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Overlay")
+    void SetNodeData(const FString& NodePath, const FJsonDataStruct& Value, bool& bIsValid);
+
+    /** 设置字符串值 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Overlay", DisplayName = "SetNodeValue_String")
+    void SetNodeValueString(const FString& NodePath, const FString& Value, bool& bIsValid);
+
+    /** 设置整数值 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Overlay", DisplayName = "SetNodeValue_Int")
+    void SetNodeValueInt(const FString& NodePath, int32 Value, bool& bIsValid);
+
+    /** 设置浮点值 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Overlay", DisplayName = "SetNodeValue_Float")
+    void SetNodeValueFloat(const FString& NodePath, float Value, bool& bIsValid);
+
+    /** 设置布尔值 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Overlay", DisplayName = "SetNodeValue_Bool")
+    void SetNodeValueBool(const FString& NodePath, bool Value, bool& bIsValid);
+
+    /** 删除节点及其子节点 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Overlay")
+    void RemoveNode(const FString& NodePath, bool& bIsValid);
+
+    /** 撤销全部修改 */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Overlay")
+    void ResetOverrides();
+
+    /** 获取节点完整数据（未修改的路径读取基础数据） */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Overlay")
+    void GetNodeData(const FString& NodePath, FJsonNode& NodeData, bool& bIsValid) const;
+
+    /** 被修改或删除的路径 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Overlay")
+    void GetModifiedPaths(TArray<FString>& ModifiedPaths) const;
+
+    /** 合并为独立的解析结果 */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Overlay")
+    void ToParsedData(FParsedData& ParsedData) const;
+
+    /** C++ 访问 */
+    const FJsonOverlayDocument& GetDocument() const { return Document; }
+
+    FJsonOverlayDocument& GetMutableDocument() { return Document; }
+};
@@ -0,0 +1,86 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+
+/**
+ * 预扫描结果
+ * 只统计括号、逗号、冒号与键的长度，不校验语法，也不解析任何值；
+ * 用于选择解析策略，并在解析前一次性预留 Map、路径缓冲与扫描栈
+ */
+struct FJsonPreScan
+{
+    /** 最大嵌套深度（根对象为1） */
+    int32 MaxDepth = 0;
+
+    /** 根节点成员数量 */
+    int32 RootFanOut = 0;
+
+    /** 单个对象或数组的最大成员数量 */
+    int32 MaxFanOut = 0;
+
+    /** 不在数组内的对象成员总数，即扁平化后的条目数量（用于预留 Map 容量） */
+    int32 NumMembers = 0;
+
+    /** 扁平化路径的最大长度（按源文本中键的长度计算，含转义时为上界） */
+    int32 MaxPathLength = 0;
+
+    /** 不在数组内、值为字符串且源文本长度不小于 LazyStringThreshold 的对象成员数量（用于预留延迟字符串） */
+    int32 NumLazyStrings = 0;
+};
+
+/**
+ * 解析策略选择
+ */
+namespace JsonParseStrategy
+{
+    /** 嵌套深度超过该值时不使用递归展开 */
+    inline constexpr int32 MaxRecursiveDepth = 128;
+
+    /** 源文本长度达到该值时使用迭代或并行展开（100KB） */
+    inline constexpr int32 LargeJsonLength = 100000;
+
+    /** 使用并行展开所需的最少根节点成员数量 */
+    inline constexpr int32 MinParallelRootFanOut = 4;
+
+    /** 使用并行展开所需的最少条目数量 */
+    inline constexpr int32 MinParallelMembers = 10000;
+
+    /**
+     * 一次遍历源文本，统计深度与扇出
+     * @param JsonStr JSON文本
+     * @param OutPreScan 统计结果
+     * @param LazyStringThreshold 统计 NumLazyStrings 的字符串长度下限（0 统计全部字符串成员）
+     */
+    UNREALREADJSON_API void PreScan(const FString& JsonStr, FJsonPreScan& OutPreScan, int32 LazyStringThreshold = 0);
+
+    /**
+     * 根据选项与预扫描结果确定解析策略
+     * 启用延迟字符串时为 Streaming；指定了非 Auto 策略时直接使用；否则：
+     * - 深度超过 MaxRecursiveDepth，或长度达到 LargeJsonLength：Iterative
+     * - 长度达到 LargeJsonLength 且根节点扇出与条目数量足够大：Parallel
+     * - 其余：Recursive
+     */
+    UNREALREADJSON_API EJsonParseStrategy Resolve(const FReadJsonOptions& Options, const FJsonPreScan& PreScan, int32 JsonLength);
+
+    /** 是否需要预扫描：Auto 策略按预扫描结果选择递归 / 迭代 / 并行，或选项要求按预扫描结果预留容量 */
+    UNREALREADJSON_API bool NeedsPreScan(const FReadJsonOptions& Options);
+
+    /**
+     * 推算 Map 在预留 ReservedCapacity 后增长到 NumEntries 个条目期间重建哈希的次数
+     * 按 TSet 的哈希桶规则计算：元素数量每使哈希桶数量变化一次，即重建一次（不观察实际的 Map）
+     * @param ReservedCapacity 预留的容量（0 表示未预留）
+     * @param NumEntries 最终的条目数量
+     * @return 重建哈希的次数
+     */
+    UNREALREADJSON_API int32 EstimateRehashes(int32 ReservedCapacity, int32 NumEntries);
+
+    /**
+     * 解析结果的条目存储（ParsedDataMap 或 FlatEntries）是否在解析期间扩容过
+     * 与按 ReservedEntries 新建的同类存储比较已分配的内存，观察的是实际的存储
+     * @param ParsedData 解析结果（解析前为空，只预留过 ReservedEntries）
+     * @param ReservedEntries 解析前预留的条目数量
+     * @return 已分配的内存超过预留时的大小
+     */
+    UNREALREADJSON_API bool ExceedsReservation(const FParsedData& ParsedData, int32 ReservedEntries);
+}
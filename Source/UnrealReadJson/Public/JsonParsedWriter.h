@@ -0,0 +1,200 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "JsonData.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "JsonParsedWriter.generated.h"
+
+struct FJsonSourceSpan;
+
+/**
+ * 将扁平化数据直接序列化为紧凑的 UTF-8 JSON
+ * 不构建 FJsonObject，按路径还原对象层级后逐个写出：
+ * - 对象与数组节点保存的文本（源文本片段或补丁后重新序列化的文本）在未修改时直接复用，
+ *   复制时去掉多余空白并校验语法，不合法时对象按子条目重建、其余按字符串写出
+ * - 延迟记录的字符串直接复制源文本中的转义内容，不反转义
+ * - 空字符串写为 ""，null（ContainerKind 为 Null 的条目）写为 null
+ * - 启用 bEscapedPaths 的文档按转义规则还原键名；未转义的文档中含 '.' 的键名按 JsonPath.h 所述的歧义处理
+ *
+ * 通过 JsonDocumentPatch / UJsonLiveDocument 修改的数据会同步更新祖先节点的文本，可以直接写出；
+ * 直接修改 ParsedDataMap 时需用 MarkModified 标记修改的路径（或关闭 SetReuseSpans），
+ * 标记路径所在的对象及其祖先按子条目重建，其余子树仍复用保存的文本
+ *
+ * 节点表、栈等缓冲为成员变量，同一个实例重复使用时不再分配；非线程安全
+ */
+class UNREALREADJSON_API FJsonParsedWriter
+{
+public:
+    /**
+     * 序列化到字节缓冲
+     * @param ParsedData 扁平化数据
+     * @param OutBytes 输出缓冲，写入前清空（保留已分配的容量）
+     */
+    void Write(const FParsedData& ParsedData, TArray<uint8>& OutBytes);
+
+    /**
+     * 序列化到 FArchive，内部缓冲每累计一定大小写入一次
+     * @return Archive 是否没有出错
+     */
+    bool Write(const FParsedData& ParsedData, FArchive& Ar);
+
+    /** 标记被修改的路径（已删除的路径同样有效），在 ResetModified 之前对之后的每次写入生效 */
+    void MarkModified(FStringView NodePath);
+
+    /** 清除标记的路径 */
+    void ResetModified();
+
+    /**
+     * 按子条目重新生成对象节点保存的文本（直接修改 ParsedDataMap 之后使用）
+     * 刷新每个路径所在的对象及其全部祖先对象（默认路径本身保存的文本视为已更新），只建立一次节点表
+     * @param ParsedData 扁平化数据（原地更新）
+     * @param ChangedPaths 被修改的路径（已删除的路径同样有效）
+     * @param bIncludeSelf 路径本身是对象时也按子条目重新生成（保存的文本可能缺少子条目时使用）
+     */
+    void RefreshObjectText(FParsedData& ParsedData, TConstArrayView<FString> ChangedPaths, bool bIncludeSelf = false);
+
+    /** 是否复用对象节点保存的文本（默认开启），关闭后所有对象均按子条目重建 */
+    void SetReuseSpans(const bool bInReuseSpans) { bReuseSpans = bInReuseSpans; }
+
+private:
+    /** 扁平化条目 */
+    struct FNode
+    {
+        FStringView Path;
+        /** 键名在路径中的起始位置 */
+        int32 KeyStart = 0;
+        /** 二者之一有效 */
+        const FJsonDataStruct* Data = nullptr;
+        const FJsonSourceSpan* LazySpan = nullptr;
+        int32 Parent = INDEX_NONE;
+        int32 FirstChild = INDEX_NONE;
+        int32 LastChild = INDEX_NONE;
+        int32 NextSibling = INDEX_NONE;
+        /** 子树中有被修改的路径，需要重建 */
+        bool bDirty = false;
+    };
+
+    /** 正在重建的对象 */
+    struct FFrame
+    {
+        int32 NextChild = INDEX_NONE;
+        bool bFirst = true;
+    };
+
+    void WriteDocument(const FParsedData& ParsedData);
+
+    /** 收集条目并按路径前缀连接父子关系 */
+    void BuildNodes(const FParsedData& ParsedData);
+
+    /** 路径的最近一个对象祖先（不含自身） */
+    int32 FindParentObject(FStringView Path, int32& OutKeyStart);
+
+    /** 路径对应的对象节点 */
+    int32 FindObjectNode(FStringView Path);
+
+    /** 标记路径所在的对象及其祖先需要重建 */
+    void MarkDirtyPath(FStringView Path, bool bIncludeSelf);
+
+    /** 按子条目写出对象（FirstChild 为 INDEX_NONE 时写出空对象） */
+    void WriteObject(int32 FirstChild);
+
+    /** 写出一个值；需要按子条目重建的对象不写出并返回 true，由调用方压栈 */
+    bool WriteValue(const FNode& Node);
+
+    void WriteKey(const FNode& Node);
+
+    /** 按 JSON 规则转义并写出字符串（含引号） */
+    void WriteString(FStringView Text);
+
+    /** 按 JSON 规则转义并写出字符串内容（不含引号） */
+    void WriteStringBody(FStringView Text);
+
+    /** 复制延迟记录的字符串（转义内容按原样复制） */
+    void WriteLazyString(const FNode& Node);
+
+    void WriteInt64(int64 Value);
+
+    void WriteDouble(double Value, bool bSinglePrecision);
+
+    /** 复制对象或数组文本，去掉空白并校验语法；不合法时撤销已写入的内容并返回 false */
+    bool CopyContainer(FStringView Text);
+
+    /** 复制字符串内容，校验转义序列；停在结束引号或 End 上，转义不合法时返回 false */
+    bool CopyStringBody(const TCHAR*& Cursor, const TCHAR* End);
+
+    /** 以 UTF-8 写出一个字符（UTF-16 时合并代理对），返回消耗的字符数；孤立的代理项写为 \uXXXX */
+    int32 WriteChar(const TCHAR* Cursor, const TCHAR* End);
+
+    void WriteUnicodeEscape(uint32 CodeUnit);
+
+    FORCEINLINE void WriteByte(const uint8 Byte) { Bytes->Add(Byte); }
+
+    void WriteAscii(const ANSICHAR* Text, int32 Length);
+
+    /** 写出只含 ASCII 的字符 */
+    void WriteNarrow(const TCHAR* Text, int32 Length);
+
+    /** 撤销到指定长度 */
+    void Rollback(int32 NumBytes);
+
+    void FlushIfNeeded();
+
+    /** 当前写入的缓冲 */
+    TArray<uint8>* Bytes = nullptr;
+
+    /** 写入 FArchive 时使用的缓冲 */
+    TArray<uint8> ArchiveBuffer;
+    FArchive* Archive = nullptr;
+
+    const FParsedData* Document = nullptr;
+
+    TArray<FNode> Nodes;
+    int32 RootFirstChild = INDEX_NONE;
+    TArray<FFrame> Stack;
+    TArray<TCHAR> ContainerStack;
+    TArray<int32, TInlineAllocator<16>> Separators;
+
+    /** 对象节点的条目 -> Nodes 下标 */
+    TMap<const FJsonDataStruct*, int32> ObjectNodes;
+
+    /** 查找不区分大小写的 Map 时使用的路径缓冲 */
+    FString PathScratch;
+
+    TSet<FString> ModifiedPaths;
+
+    bool bReuseSpans = true;
+};
+
+// ============================================================================
+// 蓝图接口
+// ============================================================================
+
+/**
+ * 扁平化数据序列化蓝图函数库
+ */
+UCLASS()
+class UNREALREADJSON_API UJsonWriterLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 将已解析数据序列化为紧凑的JSON字符串
+     * @param ParsedData 已解析的数据
+     * @param ModifiedPaths 直接修改过的路径（通过补丁修改的数据不需要填写）
+     * @param JsonStr JSON字符串
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Write")
+    static void WriteJsonString(const FParsedData& ParsedData, const TArray<FString>& ModifiedPaths, FString& JsonStr);
+
+    /**
+     * 将已解析数据序列化为 UTF-8 JSON 文件
+     * @param ParsedData 已解析的数据
+     * @param ModifiedPaths 直接修改过的路径（通过补丁修改的数据不需要填写）
+     * @param FilePath 文件路径
+     * @param bIsValid 是否写入成功
+     */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Write")
+    static void WriteJsonFile(const FParsedData& ParsedData, const TArray<FString>& ModifiedPaths, const FString& FilePath, bool& bIsValid);
+};
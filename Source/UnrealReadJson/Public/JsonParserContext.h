@@ -0,0 +1,127 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "JsonParseStrategy.h"
+#include "JsonSourceFlattener.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "JsonParserContext.generated.h"
+
+/** 池化解析完成时的委托（在游戏线程调用） */
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnJsonParsed, const FParsedData&, ParsedData, bool, bIsValid);
+
+/**
+ * 可复用的解析上下文（非 UObject）
+ * 持有扫描栈、路径缓冲等解析状态（FJsonSourceFlattener），多次解析之间不再重复分配；
+ * 解析前按预扫描结果预留 Map、路径缓冲与扫描栈，没有预扫描结果时按上一次解析的条目数量预留 Map（在扁平化的同一次遍历中统计）；
+ * 扁平化规则与 ReadJson_WithOptions 相同
+ *
+ * 非线程安全，同一时间只能被一个线程使用，通常通过 FJsonParserContextPool 获取
+ */
+class UNREALREADJSON_API FJsonParserContext
+{
+public:
+    /**
+     * 解析JSON文本
+     * @param JsonStr JSON文本，根节点须为对象
+     * @param Options 解析选项
+     * @param OutParsedData 输出数据；重复传入同一个对象时复用其 Map 内存
+     * @param PreScan 已有的预扫描结果；为空且 Options.bPreScanCapacity 为 true 时在此预扫描，否则按上一次解析的条目数量预留
+     * @return 是否解析成功，失败原因见 GetError
+     */
+    bool Parse(const FString& JsonStr, const FReadJsonOptions& Options, FParsedData& OutParsedData, const FJsonPreScan* PreScan = nullptr);
+
+    /**
+     * 按访问者的节点扫描JSON文本（见 FJsonSourceFlattener::Scan），复用上下文的扫描缓冲
+     * @param JsonStr JSON文本，根节点须为对象
+     * @param Visitor 访问者
+     * @return 是否解析成功，失败原因见 GetError
+     */
+    bool Scan(const FString& JsonStr, IJsonSourceVisitor& Visitor) { return Flattener.Scan(JsonStr, Visitor); }
+
+    /** 最近一次失败的原因 */
+    const FString& GetError() const { return Flattener.GetError(); }
+
+    /** 最近一次解析前预留的条目数量 */
+    int32 GetReservedEntries() const { return ReservedEntries; }
+
+private:
+    FJsonSourceFlattener Flattener;
+
+    /** 上一次解析得到的条目数量 */
+    int32 LastNumEntries = 0;
+
+    /** 上一次解析延迟记录的字符串数量 */
+    int32 LastNumLazyStrings = 0;
+
+    /** 最近一次解析前预留的条目数量 */
+    int32 ReservedEntries = 0;
+};
+
+/**
+ * 解析上下文池
+ * 全局共享，线程安全；归还的上下文保留其缓冲，最多保留 MaxPooledContexts 个
+ */
+class UNREALREADJSON_API FJsonParserContextPool
+{
+public:
+    /** 池中最多保留的上下文数量 */
+    static constexpr int32 MaxPooledContexts = 16;
+
+    /** 作用域内持有一个上下文，析构时归还 */
+    class FScopedContext
+    {
+    public:
+        FScopedContext();
+        ~FScopedContext();
+
+        FScopedContext(const FScopedContext&) = delete;
+        FScopedContext& operator=(const FScopedContext&) = delete;
+
+        FJsonParserContext& operator*() const { return *Context; }
+        FJsonParserContext* operator->() const { return Context.Get(); }
+
+    private:
+        TUniquePtr<FJsonParserContext> Context;
+    };
+
+    /** 取出一个上下文，池为空时创建新的 */
+    static TUniquePtr<FJsonParserContext> Acquire();
+
+    /** 归还上下文 */
+    static void Release(TUniquePtr<FJsonParserContext>&& Context);
+
+    /** 释放池中全部上下文 */
+    static void Trim();
+};
+
+/**
+ * 池化解析蓝图接口
+ * 不为每次解析创建 UObject，适合高频的小消息（如网络消息）
+ */
+UCLASS()
+class UNREALREADJSON_API UJsonParserContextLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 在工作线程上使用池化上下文解析JSON，完成后在游戏线程调用 OnParsed
+     * 不创建异步任务对象；OnParsed 绑定的对象被销毁后不再回调
+     * @param InJsonStr 待解析的JSON字符串
+     * @param Options 解析选项
+     * @param OnParsed 完成回调
+     */
+    UFUNCTION(BlueprintCallable, Category = "FH|ReadJson|Read|Pooled", DisplayName = "ReadJson_Pooled", meta = (AdvancedDisplay = "Options"))
+    static void ReadJson_Pooled(const FString& InJsonStr, const FReadJsonOptions& Options, FOnJsonParsed OnParsed);
+
+    /**
+     * 使用池化上下文同步解析JSON
+     * @param InJsonStr 待解析的JSON字符串
+     * @param Options 解析选项
+     * @param OutParsedData 解析结果
+     * @param bIsValid 是否解析成功
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Read|Pooled", DisplayName = "ReadJson_PooledBlock", meta = (AdvancedDisplay = "Options"))
+    static void ReadJson_PooledBlock(const FString& InJsonStr, const FReadJsonOptions& Options, FParsedData& OutParsedData, bool& bIsValid);
+};
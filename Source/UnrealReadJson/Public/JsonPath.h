@@ -0,0 +1,161 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "JsonData.h"
+
+/**
+ * 扁平化路径的路径段编码
+ * 默认的路径直接以 '.' 连接键名，键名本身含 '.' 时有歧义（如 {"data":{"key":1},"data.key":2}）；
+ * 启用 FReadJsonOptions::bEscapePathKeys 后，键名中的 '\' 与 '.' 分别写为 "\\" 与 "\."，路径与路径段一一对应：
+ * - data.key 表示 data 对象中的 key，data\.key 表示根节点的 "data.key"
+ * - 不含 '.' 与 '\' 的键名不受影响，路径与默认规则相同
+ * - 分隔符按路径段数量添加，空键名同样占一个路径段：{"":{"a":1}} 中的 a 为 ".a"，与 {"a":1} 的 "a" 不同；
+ *   根节点下的空键名本身的路径为 ""，在按路径访问子节点的接口（GetChildren 等）中与根节点相同
+ *   （默认规则按路径是否为空添加分隔符，两者都是 "a"）
+ *
+ * 文档使用的编码记录在 FParsedData::bEscapedPaths 中，以下函数按 bEscape / bEscaped 参数处理
+ */
+namespace JsonPath
+{
+    /** 键名是否含有需要转义的字符 */
+    UNREALREADJSON_API bool NeedsEscape(FStringView Segment);
+
+    /**
+     * 追加一个路径段
+     * @param InOutPath 路径
+     * @param Segment 键名
+     * @param bEscape 是否转义键名中的 '\' 与 '.'
+     * @param bFirstSegment 是否为第一个路径段（根节点的直接子节点）；转义编码按此决定是否添加分隔符，默认规则只在 InOutPath 为空时不添加
+     */
+    UNREALREADJSON_API void AppendSegment(FString& InOutPath, FStringView Segment, bool bEscape, bool bFirstSegment);
+
+    /** 由路径段构建路径 */
+    UNREALREADJSON_API FString JoinSegments(TConstArrayView<FString> Segments, bool bEscape);
+
+    /**
+     * 拆分路径（保留空路径段）
+     * @param NodePath 路径
+     * @param OutSegments 路径段（已还原为键名）
+     * @param bEscaped 路径是否使用转义编码；否则按 '.' 直接拆分
+     */
+    UNREALREADJSON_API void SplitPath(FStringView NodePath, TArray<FString>& OutSegments, bool bEscaped);
+
+    /**
+     * 查找路径分隔符的位置（不拆分、不分配路径段），Left(位置) 即为对应的祖先路径
+     * @param NodePath 路径
+     * @param bEscaped 路径是否使用转义编码（跳过 "\." 中的 '.'）
+     * @param OutSeparators 分隔符位置，从前到后
+     */
+    UNREALREADJSON_API void FindSeparators(FStringView NodePath, bool bEscaped, TArray<int32, TInlineAllocator<16>>& OutSeparators);
+
+    /**
+     * 按路径段查找条目（按文档的路径编码与键比较策略，不含延迟记录的字符串）
+     * 路径在线程内复用的缓冲中构建，不分配内存
+     */
+    UNREALREADJSON_API const FJsonDataStruct* FindEntry(const FParsedData& ParsedData, TConstArrayView<FString> Segments);
+
+    UNREALREADJSON_API const FJsonDataStruct* FindEntry(const FParsedData& ParsedData, TConstArrayView<FStringView> Segments);
+
+    /** 不区分大小写的查找键（见 TJsonSegmentKeyFuncs） */
+    struct FIgnoreCaseKey
+    {
+        const FString& Key;
+    };
+}
+
+/**
+ * 以路径段为键的 TMap KeyFuncs
+ * 键逐字符比较（区分大小写）；哈希与 GetTypeHash(FString) 相同、不区分大小写，仅大小写不同的键位于同一哈希链，
+ * 因此同一张表既可以区分大小写查找，也可以用 JsonPath::FIgnoreCaseKey 按 ParsedDataMap 的规则查找（见 JsonPath::FindSegment）
+ */
+template <typename ValueType>
+struct TJsonSegmentKeyFuncs : TDefaultMapKeyFuncs<FString, ValueType, false>
+{
+    static FORCEINLINE bool Matches(const FString& A, const FString& B)
+    {
+        return A.Equals(B, ESearchCase::CaseSensitive);
+    }
+
+    static FORCEINLINE bool Matches(const FString& A, const JsonPath::FIgnoreCaseKey& B)
+    {
+        return A.Equals(B.Key, ESearchCase::IgnoreCase);
+    }
+
+    static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+    {
+        return GetTypeHash(Key);
+    }
+
+    static FORCEINLINE uint32 GetKeyHash(const JsonPath::FIgnoreCaseKey& Key)
+    {
+        return GetTypeHash(Key.Key);
+    }
+};
+
+template <typename ValueType>
+using TJsonSegmentMap = TMap<FString, ValueType, FDefaultSetAllocator, TJsonSegmentKeyFuncs<ValueType>>;
+
+namespace JsonPath
+{
+    /**
+     * 按文档的键比较策略查找路径段
+     * @param bCaseSensitive 是否区分大小写（FParsedData::IsCaseSensitive）；否则与 ParsedDataMap 一样不区分大小写
+     */
+    template <typename ValueType>
+    const ValueType* FindSegment(const TJsonSegmentMap<ValueType>& Map, const FString& Segment, const bool bCaseSensitive)
+    {
+        return bCaseSensitive ? Map.Find(Segment) : Map.FindByHash(GetTypeHash(Segment), FIgnoreCaseKey{ Segment });
+    }
+}
+
+/**
+ * 增量路径构建器
+ * 遍历子节点时逐层压入、弹出路径段，只追加键名而不重新拼接整条路径；缓冲在多次使用之间保留
+ *
+ * FJsonPathBuilder Builder(ParsedData);
+ * Builder.Push(TEXT("players"));
+ * for (const FString& Name : PlayerNames)
+ * {
+ *     Builder.Push(Name);
+ *     Builder.Push(TEXT("score"));
+ *     const FJsonDataStruct* Score = Builder.Find(ParsedData);
+ *     Builder.Pop();
+ *     Builder.Pop();
+ * }
+ */
+class UNREALREADJSON_API FJsonPathBuilder
+{
+public:
+    /** @param bInEscape 是否转义键名（与文档的 bEscapedPaths 一致） */
+    explicit FJsonPathBuilder(bool bInEscape = false);
+
+    /** 使用文档的路径编码 */
+    explicit FJsonPathBuilder(const FParsedData& ParsedData);
+
+    /** 压入一个路径段 */
+    void Push(FStringView Segment);
+
+    /** 弹出最后一个路径段 */
+    void Pop();
+
+    /** 清空路径（保留缓冲） */
+    void Reset();
+
+    /** 当前路径段数量 */
+    int32 Num() const { return SegmentStarts.Num(); }
+
+    /** 当前路径 */
+    const FString& GetPath() const { return Path; }
+
+    /** 查找当前路径对应的条目 */
+    const FJsonDataStruct* Find(const FParsedData& ParsedData) const { return ParsedData.FindEntry(Path); }
+
+private:
+    FString Path;
+
+    /** 每个路径段压入前的路径长度 */
+    TArray<int32, TInlineAllocator<16>> SegmentStarts;
+
+    bool bEscape = false;
+};
@@ -0,0 +1,267 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "JsonPath.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "JsonPathIndex.generated.h"
+
+/**
+ * 扁平化路径的前缀树索引
+ * 按 '.' 将路径拆分为路径段（转义编码的文档按 JsonPath::SplitPath 的规则拆分），支持子树枚举、直接子节点列举和通配符匹配，
+ * 查询成本只与结果规模（及路径深度）相关，不需要遍历整个文档
+ * 路径段按文档的键比较策略匹配：区分大小写的文档（CaseSensitive）逐字符匹配，其余与 ParsedDataMap 一样不区分大小写
+ *
+ * 通配符规则（按路径段匹配）:
+ * - "*"  匹配任意一个路径段，如 players.*.score
+ * - "**" 匹配任意多个（含0个）路径段，如 **.price
+ * - 含有 '*' 或 '?' 的路径段按 FString::MatchesWildcard 匹配，如 item_*
+ */
+class UNREALREADJSON_API FJsonPathIndex
+{
+public:
+    FJsonPathIndex();
+
+    /**
+     * 由解析结果构建索引（条目与延迟记录的字符串，见 FParsedData::ForEachPath）
+     * @param ParsedData 扁平化数据，路径编码取自 FParsedData::bEscapedPaths，键比较策略取自 FParsedData::IsCaseSensitive
+     */
+    void Build(const FParsedData& ParsedData);
+
+    /** 添加路径 */
+    void AddPath(const FString& NodePath);
+
+    /** 移除路径（其余子节点保持原有顺序） */
+    void RemovePath(const FString& NodePath);
+
+    /** 已索引的路径数量 */
+    int32 Num() const { return NumEntries; }
+
+    /** 索引对应的 FParsedData::Generation */
+    uint32 GetGeneration() const { return Generation; }
+
+    /** 按变化路径更新后记录对应的修改计数 */
+    void SetGeneration(const uint32 InGeneration) { Generation = InGeneration; }
+
+    /** 路径是否已索引 */
+    bool Contains(const FString& NodePath) const;
+
+    /**
+     * 枚举子树中的所有路径（深度优先，子节点按插入顺序）
+     * @param NodePath 子树根路径，为空表示整个文档
+     * @param bIncludeSelf 是否包含 NodePath 本身
+     * @param OutPaths 输出路径
+     * @return NodePath 是否存在
+     */
+    bool GetSubtreePaths(const FString& NodePath, bool bIncludeSelf, TArray<FString>& OutPaths) const;
+
+    /**
+     * 列举直接子节点
+     * @param NodePath 父节点路径，为空表示根节点
+     * @param OutChildKeys 子节点键名
+     * @param OutChildPaths 子节点完整路径
+     * @return NodePath 是否存在
+     */
+    bool GetChildren(const FString& NodePath, TArray<FString>& OutChildKeys, TArray<FString>& OutChildPaths) const;
+
+    /**
+     * 按通配符模式匹配路径
+     * @param Pattern 模式，如 players.*.score
+     * @param OutPaths 匹配到的路径（不重复）
+     */
+    void MatchPattern(const FString& Pattern, TArray<FString>& OutPaths) const;
+
+    /** 查找路径对应的节点下标，未找到返回 INDEX_NONE */
+    int32 FindNode(const FString& NodePath) const;
+
+    /** 按已拆分的路径段查找节点下标（键名不需要转义），未找到返回 INDEX_NONE */
+    int32 FindNodeBySegments(TConstArrayView<FString> Segments) const;
+
+    // ========================================================================
+    // 节点级访问（供查询引擎逐层遍历）
+    // ========================================================================
+
+    /** 根节点下标 */
+    static constexpr int32 RootNode = 0;
+
+    /** 查找直接子节点，未找到返回 INDEX_NONE */
+    int32 FindChildNode(int32 NodeIndex, const FString& Segment) const;
+
+    /** 获取直接子节点下标（按插入顺序） */
+    void GetChildNodes(int32 NodeIndex, TArray<int32>& OutChildIndices) const;
+
+    /** 获取节点对应的完整路径，节点没有条目时返回nullptr */
+    const FString* GetNodePath(int32 NodeIndex) const;
+
+    /**
+     * 获取数组节点解析后的值（首次访问时解析并缓存，路径变化或条目文本与缓存时不同时重新解析）
+     * 数组不会被扁平化，查询需要进入数组内部时通过此函数避免重复解析
+     * @param NodeIndex 节点下标
+     * @param Entry 节点对应的条目
+     * @return 数组值，条目不是数组时返回nullptr
+     */
+    TSharedPtr<FJsonValue> GetArrayValue(int32 NodeIndex, const FJsonDataStruct& Entry) const;
+
+private:
+    struct FNode
+    {
+        /** 路径段 -> 子节点下标（按 FindChild 查找） */
+        TJsonSegmentMap<int32> Children;
+
+        /** 完整路径（仅当 bHasEntry 时有效） */
+        FString Path;
+
+        /** 所在路径段（用于从父节点中移除） */
+        FString Segment;
+
+        int32 Parent = INDEX_NONE;
+
+        bool bHasEntry = false;
+    };
+
+    int32 AllocateNode(int32 Parent, const FString& Segment);
+
+    /** 按键比较策略查找直接子节点 */
+    const int32* FindChild(const FNode& Node, const FString& Segment) const
+    {
+        return JsonPath::FindSegment(Node.Children, Segment, bCaseSensitive);
+    }
+
+    void CollectSubtree(int32 NodeIndex, TArray<FString>& OutPaths) const;
+
+    void MatchRecursive(int32 NodeIndex, const TArray<FString>& PatternSegments, int32 PatternIndex, TSet<int32>& Emitted, TArray<FString>& OutPaths) const;
+
+    /** 节点池，下标0为根节点 */
+    TArray<FNode> Nodes;
+
+    /** 已释放可复用的节点下标 */
+    TArray<int32> FreeNodes;
+
+    /** 解析后的数组值及解析时的条目文本 */
+    struct FCachedArray
+    {
+        FString Text;
+        TSharedPtr<FJsonValue> Value;
+    };
+
+    /** 节点下标 -> 解析后的数组值 */
+    mutable TMap<int32, FCachedArray> ArrayValueCache;
+
+    int32 NumEntries = 0;
+
+    uint32 Generation = 0;
+
+    bool bEscapedPaths = false;
+
+    /** 路径段是否区分大小写 */
+    bool bCaseSensitive = false;
+};
+
+// ============================================================================
+// C++ 辅助函数
+// ============================================================================
+
+namespace JsonPathIndexHelper
+{
+    /**
+     * 获取解析结果的路径索引，不存在或已失效（修改计数或路径数量不一致）时构建
+     * 直接修改 ParsedDataMap 而不经过写入接口时，只有路径数量变化才能被发现：
+     * 改写已有路径的值不需要处理（数组值的缓存按条目文本校验），但增删路径后数量恰好不变时需调用 InvalidateIndex
+     * @note 非线程安全，应在持有 ParsedData 的线程上调用
+     */
+    UNREALREADJSON_API const FJsonPathIndex& GetOrBuildIndex(const FParsedData& ParsedData);
+
+    /** 使路径索引失效（下次查询时重建） */
+    UNREALREADJSON_API void InvalidateIndex(FParsedData& ParsedData);
+
+    /**
+     * 根据变化路径增量更新索引，并记录当前的修改计数
+     * ChangedPaths 需包含上次构建或更新索引之后的全部修改；含有被删除的路径时使索引失效（下次查询时按数据的遍历顺序重建），
+     * 索引被其他 FParsedData 拷贝共享时同样使其失效，避免影响其他拷贝
+     */
+    UNREALREADJSON_API void UpdateIndex(FParsedData& ParsedData, const TArray<FString>& ChangedPaths);
+}
+
+// ============================================================================
+// 蓝图接口
+// ============================================================================
+
+/**
+ * 路径查询蓝图函数库
+ */
+UCLASS()
+class UNREALREADJSON_API UJsonPathIndexLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 获取子树中的所有路径
+     * @param NodePath 子树根路径，为空表示整个文档
+     * @param ParsedData 已解析的数据
+     * @param bIncludeSelf 是否包含 NodePath 本身
+     * @param Paths 输出路径
+     * @param bIsValid NodePath 是否存在
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Query")
+    static void GetSubtreePaths(const FString& NodePath, const FParsedData& ParsedData, bool bIncludeSelf, TArray<FString>& Paths, bool& bIsValid);
+
+    /**
+     * 获取直接子节点
+     * @param NodePath 父节点路径，为空表示根节点
+     * @param ParsedData 已解析的数据
+     * @param ChildKeys 子节点键名
+     * @param ChildPaths 子节点完整路径
+     * @param bIsValid NodePath 是否存在
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Query")
+    static void GetChildPaths(const FString& NodePath, const FParsedData& ParsedData, TArray<FString>& ChildKeys, TArray<FString>& ChildPaths, bool& bIsValid);
+
+    /**
+     * 获取直接子节点数据
+     * @param NodePath 父节点路径，为空表示根节点
+     * @param ParsedData 已解析的数据
+     * @param ChildNodes 子节点（Key 为完整路径）
+     * @param bIsValid NodePath 是否存在
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Query")
+    static void GetChildNodes(const FString& NodePath, const FParsedData& ParsedData, TArray<FJsonNode>& ChildNodes, bool& bIsValid);
+
+    /**
+     * 按通配符模式查找路径（如 players.*.score）
+     * @param Pattern 模式
+     * @param ParsedData 已解析的数据
+     * @param Paths 匹配到的路径
+     * @param bIsValid 是否匹配到任何路径
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Query")
+    static void FindPathsByPattern(const FString& Pattern, const FParsedData& ParsedData, TArray<FString>& Paths, bool& bIsValid);
+
+    /**
+     * 由路径段构建节点路径（按文档的路径编码转义键名）
+     * @param Segments 路径段（原始键名）
+     * @param ParsedData 已解析的数据
+     * @return 节点路径
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Query")
+    static FString MakeNodePath(const TArray<FString>& Segments, const FParsedData& ParsedData);
+
+    /**
+     * 将节点路径拆分为路径段（按文档的路径编码还原键名）
+     * @param NodePath 节点路径
+     * @param ParsedData 已解析的数据
+     * @param Segments 路径段
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Query")
+    static void SplitNodePath(const FString& NodePath, const FParsedData& ParsedData, TArray<FString>& Segments);
+
+    /**
+     * 按路径段获取节点数据，键名中的 '.' 不需要转义
+     * @param Segments 路径段（原始键名）
+     * @param ParsedData 已解析的数据
+     * @param NodeData 节点数据（Key 为节点路径）
+     * @param bIsValid 是否找到节点
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Query")
+    static void GetNodeDataBySegments(const TArray<FString>& Segments, const FParsedData& ParsedData, FJsonNode& NodeData, bool& bIsValid);
+};
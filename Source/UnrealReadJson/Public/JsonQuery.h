@@ -0,0 +1,183 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "JsonQuery.generated.h"
+
+/**
+ * 编译后的 JSONPath 查询
+ * 查询字符串只编译一次，之后可对任意解析结果重复求值；求值沿路径索引逐层定位，
+ * 只有进入数组内部时才解析数组（每个数组每份文档只解析一次）
+ *
+ * 支持的语法:
+ * - $ 根节点（可省略）
+ * - .name / ['name'] 子节点，['a','b'] / [0,1] 多选
+ * - .* / [*] 所有子节点
+ * - ..name / ..* / ..[...] 递归下降
+ * - [n] / [-n] 数组下标，[start:end:step] 切片
+ * - [?(expr)] 过滤，expr 支持 @.path、字面量（'str' / 数字 / true / false / null）、
+ *   == != < <= > >=、仅 @.path 的存在性判断，以及 ! && || 和括号
+ * - null：扁平化的 null 条目（ContainerKind 为 Null）与数组内部的 null 元素一致，只与 null 字面量相等，不等于 ''
+ *
+ * 结果路径: 扁平化节点使用 ParsedDataMap 中的路径，数组元素使用 path[n] 表示
+ */
+class UNREALREADJSON_API FJsonQuery
+{
+public:
+    /**
+     * 编译查询
+     * @param QueryString 查询字符串
+     * @param OutError 编译失败时的错误信息
+     * @return 编译结果，失败返回nullptr
+     */
+    static TSharedPtr<const FJsonQuery> Compile(const FString& QueryString, FString& OutError);
+
+    /**
+     * 对解析结果求值
+     * @param ParsedData 已解析的数据
+     * @param OutResults 匹配到的节点（Key 为结果路径）
+     */
+    void Evaluate(const FParsedData& ParsedData, TArray<FJsonNode>& OutResults) const;
+
+    /** 原始查询字符串 */
+    const FString& GetQueryString() const { return QueryString; }
+
+private:
+    friend class FJsonQueryParser;
+    friend class FJsonQueryEvaluator;
+
+    /** 相对路径段：对象键名或数组下标 */
+    struct FPathSegment
+    {
+        FString Name;
+        int32 Index = 0;
+        bool bIsIndex = false;
+    };
+
+    enum class EScalarType : uint8
+    {
+        Missing,
+        Null,
+        Bool,
+        Number,
+        String,
+        Container
+    };
+
+    /** 过滤表达式求值时的标量 */
+    struct FScalar
+    {
+        EScalarType Type = EScalarType::Missing;
+        bool BoolValue = false;
+        double NumberValue = 0.0;
+        /** 数值来自 Float 条目时按单精度比较，与文档存储精度一致 */
+        bool bSinglePrecision = false;
+        /** 整数值（Int / Int64 条目及整数字面量），两侧均为整数时按 int64 精确比较 */
+        bool bIsInteger = false;
+        int64 IntegerValue = 0;
+        FString StringValue;
+    };
+
+    /** 过滤表达式操作数：@ 相对路径或字面量 */
+    struct FOperand
+    {
+        bool bIsRelativePath = false;
+        TArray<FPathSegment> RelativePath;
+        FScalar Literal;
+    };
+
+    enum class EFilterOp : uint8
+    {
+        Or,
+        And,
+        Not,
+        Exists,
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual
+    };
+
+    struct FFilterNode
+    {
+        EFilterOp Op = EFilterOp::Exists;
+        TArray<int32> Children;
+        FOperand Left;
+        FOperand Right;
+    };
+
+    enum class EStepType : uint8
+    {
+        Child,
+        Wildcard,
+        Slice,
+        Filter
+    };
+
+    struct FStep
+    {
+        EStepType Type = EStepType::Child;
+        /** 递归下降（..） */
+        bool bRecursive = false;
+        /** Child: 键名（多选） */
+        TArray<FString> Names;
+        /** Child: 数组下标（多选） */
+        TArray<int32> Indices;
+        /** Slice */
+        int32 SliceStart = 0;
+        int32 SliceEnd = 0;
+        int32 SliceStep = 1;
+        bool bHasSliceStart = false;
+        bool bHasSliceEnd = false;
+        /** Filter: 表达式根节点 */
+        int32 FilterRoot = INDEX_NONE;
+    };
+
+    FString QueryString;
+    TArray<FStep> Steps;
+    TArray<FFilterNode> FilterNodes;
+};
+
+// ============================================================================
+// C++ 辅助函数
+// ============================================================================
+
+namespace JsonQueryHelper
+{
+    /**
+     * 获取编译后的查询（按查询字符串缓存，线程安全）
+     * @param QueryString 查询字符串
+     * @param OutError 编译失败时的错误信息
+     * @return 编译结果，失败返回nullptr
+     */
+    UNREALREADJSON_API TSharedPtr<const FJsonQuery> GetOrCompile(const FString& QueryString, FString& OutError);
+}
+
+// ============================================================================
+// 蓝图接口
+// ============================================================================
+
+/**
+ * JSONPath 查询蓝图函数库
+ */
+UCLASS()
+class UNREALREADJSON_API UJsonQueryLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 执行 JSONPath 查询（编译结果按查询字符串缓存，重复调用不会重新编译）
+     * @param Query 查询字符串，如 $.items[?(@.rarity=='epic')].id、$..price
+     * @param ParsedData 已解析的数据
+     * @param Results 匹配到的节点（Key 为结果路径）
+     * @param TypedValues 按值类型分组的结果，规则与 ParseJsonArray 相同：Float / Double 同时加入 FloatArray 与 DoubleArray，
+     *                    对象与数组为 JSON 文本，null 为空字符串，均加入 StringArray
+     * @param bIsValid 是否匹配到任何节点
+     */
+    UFUNCTION(BlueprintPure, Category = "FH|ReadJson|Query", DisplayName = "QueryJson")
+    static void QueryJson(const FString& Query, const FParsedData& ParsedData, TArray<FJsonNode>& Results, FJsonArray& TypedValues, bool& bIsValid);
+};
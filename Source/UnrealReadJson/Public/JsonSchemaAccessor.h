@@ -0,0 +1,147 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+
+/**
+ * 模式字段：节点路径与值类型
+ * 由 JsonSchemaCodegen 命令行工具生成的访问器以静态数组的形式提供
+ */
+struct FJsonSchemaField
+{
+    const TCHAR* Path;
+    EValueType Type;
+};
+
+/**
+ * 按模式填充的槽位
+ * 每种值类型一个连续数组，字段在数组中的下标在生成代码时确定，读取是固定下标的数组访问
+ */
+struct UNREALREADJSON_API FJsonSchemaSlots
+{
+    TArray<bool> Bools;
+    TArray<int32> Ints;
+    TArray<float> Floats;
+    TArray<FString> Strings;
+    TArray<int64> Int64s;
+    TArray<double> Doubles;
+
+    /** 槽位是否已被填充（按字段顺序） */
+    TBitArray<> Present;
+
+    bool IsPresent(const int32 SlotIndex) const
+    {
+        return Present.IsValidIndex(SlotIndex) && Present[SlotIndex];
+    }
+};
+
+/**
+ * 模式布局
+ * 将字段路径编译为路径段树（扫描JSON文本时逐个键解析槽位，见 FJsonSourceFlattener::Scan）和预先计算哈希的完整路径（用于读取已扁平化的数据），
+ * 填充时只访问模式中出现的路径，不构建 FJsonObject，也不构建扁平化Map
+ *
+ * 字段在类型数组中的下标按字段顺序分别计数：第 n 个 Int 字段位于 Ints[n]，与生成代码保持一致
+ */
+class UNREALREADJSON_API FJsonSchemaLayout
+{
+public:
+    /**
+     * @param Fields 字段
+     * @param NumFields 字段数量
+     * @param bInEscapedPaths 字段路径是否使用转义编码（见 JsonPath.h），须与 ReadFromParsedData 的数据一致
+     */
+    FJsonSchemaLayout(const FJsonSchemaField* Fields, int32 NumFields, bool bInEscapedPaths = false);
+
+    /** 字段数量 */
+    int32 Num() const { return Slots.Num(); }
+
+    /** 按布局重置槽位（全部置为默认值且未填充） */
+    void InitSlots(FJsonSchemaSlots& OutSlots) const;
+
+    /**
+     * 解析JSON文本并填充槽位
+     * 模式之外的成员只校验不展开；键不区分大小写，重复的键按出现顺序逐个填充，null 不填充
+     * @param JsonStr JSON文本，根节点须为对象
+     * @param OutSlots 输出槽位
+     * @return 是否解析成功（失败时槽位全部重置）
+     */
+    bool ReadFromJson(const FString& JsonStr, FJsonSchemaSlots& OutSlots) const;
+
+    /**
+     * 从已扁平化的数据填充槽位
+     * @param ParsedData 已解析的数据
+     * @param OutSlots 输出槽位
+     * @return 填充的槽位数量（路径编码与布局不一致时为 0）
+     */
+    int32 ReadFromParsedData(const FParsedData& ParsedData, FJsonSchemaSlots& OutSlots) const;
+
+private:
+    struct FSlot
+    {
+        FString Path;
+        uint32 PathHash = 0;
+        EValueType Type = EValueType::String;
+        /** 在对应类型数组中的下标 */
+        int32 TypedIndex = 0;
+    };
+
+    struct FTreeNode
+    {
+        FString Key;
+        TArray<int32> Children;
+        int32 SlotIndex = INDEX_NONE;
+    };
+
+    struct FSlotVisitor;
+
+    bool AssignEntry(int32 SlotIndex, const FJsonDataStruct& Entry, FJsonSchemaSlots& OutSlots) const;
+
+    TArray<FSlot> Slots;
+
+    /** 路径段树，下标0为根节点 */
+    TArray<FTreeNode> Tree;
+
+    int32 NumBools = 0;
+    int32 NumInts = 0;
+    int32 NumFloats = 0;
+    int32 NumStrings = 0;
+    int32 NumInt64s = 0;
+    int32 NumDoubles = 0;
+
+    /** 字段路径是否使用转义编码 */
+    bool bEscapedPaths = false;
+};
+
+/**
+ * 生成访问器的基类
+ * 派生类由 JsonSchemaCodegen 生成，需要提供 static const FJsonSchemaLayout& StaticLayout()
+ */
+template <typename TDerived>
+struct TJsonSchemaAccessor
+{
+    TJsonSchemaAccessor()
+    {
+        TDerived::StaticLayout().InitSlots(Slots);
+    }
+
+    /** 解析JSON文本并填充 */
+    bool Read(const FString& JsonStr)
+    {
+        return TDerived::StaticLayout().ReadFromJson(JsonStr, Slots);
+    }
+
+    /** 从已扁平化的数据填充 */
+    bool Read(const FParsedData& ParsedData)
+    {
+        return TDerived::StaticLayout().ReadFromParsedData(ParsedData, Slots) > 0;
+    }
+
+    /** 槽位是否已被填充 */
+    bool IsPresent(const int32 SlotIndex) const
+    {
+        return Slots.IsPresent(SlotIndex);
+    }
+
+protected:
+    FJsonSchemaSlots Slots;
+};
@@ -0,0 +1,169 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "JsonData.h"
+
+struct FJsonSourceSpan;
+
+/**
+ * 按节点扫描源文本的访问者（见 FJsonSourceFlattener::Scan）
+ * 节点编号由访问者定义，根对象为 0；只展开访问者需要的对象，其余成员的值只校验并跳过，不生成路径与条目
+ */
+class IJsonSourceVisitor
+{
+public:
+    virtual ~IJsonSourceVisitor() = default;
+
+    /** 查找对象成员对应的节点，不需要该成员时返回 INDEX_NONE */
+    virtual int32 FindChild(int32 ParentNode, FStringView Key) const = 0;
+
+    /** 节点的值为对象时是否展开其成员 */
+    virtual bool HasChildren(int32 Node) const = 0;
+
+    /** 节点是否需要值 */
+    virtual bool WantsValue(int32 Node) const = 0;
+
+    /** 节点的值，与扁平化条目相同（对象与数组为源文本中的原始片段，null 为 FJsonDataStruct::MakeNull） */
+    virtual void Visit(int32 Node, const FJsonDataStruct& Value) = 0;
+};
+
+/**
+ * 直接扫描源文本的扁平化器
+ * 不构建 FJsonObject，一次遍历生成与 ReadJson 相同路径规则的扁平化数据：
+ * - 对象逐层展开，键以 '.' 连接（可选转义键名，见 JsonPath.h）；对象与数组节点本身保存源文本中的原始片段
+ * - 数值按字面量分类为 Int / Int64 / Double（JsonNumberParser），null 保存为 ContainerKind 为 Null 的空字符串
+ * - 不含转义的字符串直接从源文本截取，不逐字符处理
+ * - 达到 FReadJsonOptions::LazyStringThreshold 的字符串只记录区间（见 JsonLazyString.h）
+ * - 按 FReadJsonOptions::KeyPolicy 比较路径；区分大小写或启用 bFlatTableStorage 时写入 FParsedData::FlatEntries，
+ *   Default 以外的策略遇到已有路径时不覆盖，记录到 FParsedData::KeyCollisions；
+ *   Default 与 FJsonObject 一样以重复键最后一次出现的值为准，先前对象的子节点与延迟记录的字符串一并删除
+ *
+ * 扫描使用显式栈，深层嵌套不会导致栈溢出；栈与路径缓冲为成员变量，同一个实例重复使用时不再分配
+ * （可通过 FJsonParserContextPool 在多次解析之间复用）
+ * 非线程安全，每个线程使用各自的实例
+ */
+class UNREALREADJSON_API FJsonSourceFlattener
+{
+public:
+    /**
+     * 扁平化源文本
+     * @param Source 源文本，根节点须为对象；启用延迟字符串时由 OutParsedData 共享持有
+     * @param Options 解析选项
+     * @param OutParsedData 输出数据
+     * @return 是否解析成功，失败原因见 GetError
+     */
+    bool Flatten(const TSharedRef<const FString>& Source, const FReadJsonOptions& Options, FParsedData& OutParsedData);
+
+    /** 扁平化源文本；产生延迟字符串时复制一份源文本由 OutParsedData 持有 */
+    bool Flatten(const FString& Source, const FReadJsonOptions& Options, FParsedData& OutParsedData);
+
+    /**
+     * 按访问者的节点扫描源文本，不生成路径，不写入任何条目存储
+     * 节点在扫描过程中逐个键解析，未命中的子树整体跳过；重复的键按出现顺序逐个交给访问者
+     * @param Source 源文本，根节点须为对象
+     * @param Visitor 访问者
+     * @return 是否解析成功（整个源文本均经过校验），失败原因见 GetError
+     */
+    bool Scan(const FString& Source, IJsonSourceVisitor& Visitor);
+
+    /**
+     * 预留扫描栈与路径缓冲（只增不减）
+     * @param MaxDepth 最大嵌套深度
+     * @param MaxPathLength 扁平化路径的最大长度
+     * @param NumEntries 下一次扁平化的条目数量，用于预留数据表（FParsedData::FlatEntries；ParsedDataMap 由调用方预留）
+     * @param NumLazyStrings 下一次扁平化延迟记录的字符串数量，用于预留 FParsedData::LazyStrings
+     */
+    void Reserve(int32 MaxDepth, int32 MaxPathLength, int32 NumEntries = 0, int32 NumLazyStrings = 0);
+
+    /** 最近一次失败的原因（含源文本位置） */
+    const FString& GetError() const { return Error; }
+
+    /**
+     * 反转义 JSON 字符串内容（不含引号）
+     * @param Text 字符串内容
+     * @param Length 内容长度
+     * @param OutValue 反转义结果
+     * @return 转义序列是否合法
+     */
+    static bool Unescape(const TCHAR* Text, int32 Length, FString& OutValue);
+
+private:
+    /** 正在展开的对象 */
+    struct FFrame
+    {
+        /** '{' 在源文本中的位置 */
+        int32 StartOffset = 0;
+        /** 进入对象前的路径长度 */
+        int32 ParentPathLength = 0;
+        /** 对象节点的路径与哈希（根对象不生成节点） */
+        FString EntryPath;
+        uint32 EntryHash = 0;
+        /** 对象节点是否已写入（路径冲突时不写入） */
+        bool bHasEntry = false;
+    };
+
+    /** 按访问者扫描时正在展开的对象 */
+    struct FScanFrame
+    {
+        /** '{' 在源文本中的位置 */
+        int32 StartOffset = 0;
+        /** 访问者的节点编号 */
+        int32 Node = 0;
+    };
+
+    bool FlattenText(const FString& Source, const TSharedPtr<const FString>& SharedSource, const FReadJsonOptions& Options, FParsedData& OutParsedData);
+
+    /** 扫描源文本并写入 Store（ParsedDataMap 或 FParsedData::FlatEntries） */
+    template <typename TStore>
+    bool FlattenEntries(TStore& Store, const FString& Source, const TSharedPtr<const FString>& SharedSource, const FReadJsonOptions& Options, FParsedData& OutParsedData);
+
+    bool Fail(const TCHAR* Message);
+
+    void SkipWhitespace();
+
+    /** 读取字符串，Cursor 位于起始引号，结束后位于结束引号之后 */
+    bool ScanString(FJsonSourceSpan& OutSpan);
+
+    /** 读取数值字面量并转换为条目；非有限数值返回 true 但 bOutFinite 为 false */
+    bool ScanNumber(FJsonDataStruct& OutData, bool& bOutFinite);
+
+    bool ConsumeLiteral(const TCHAR* Literal, int32 Length);
+
+    /** 校验并跳过一个完整的值（用于不展开的数组） */
+    bool SkipValue();
+
+    /** 将键追加到路径缓冲（按 bEscapeKeys 转义） */
+    bool AppendKey(const FJsonSourceSpan& KeySpan);
+
+    FStringView GetPathView() const { return FStringView(PathBuffer.GetData(), PathLength); }
+
+    const TCHAR* Begin = nullptr;
+    const TCHAR* Cursor = nullptr;
+    const TCHAR* End = nullptr;
+
+    TArray<FFrame> Stack;
+    TArray<FScanFrame> ScanStack;
+    TArray<TCHAR> SkipStack;
+
+    /** 当前路径（只增长，实际长度为 PathLength） */
+    TArray<TCHAR> PathBuffer;
+    int32 PathLength = 0;
+
+    /** 含转义的键的反转义缓冲 */
+    FString KeyScratch;
+
+    FString Error;
+
+    /** 数据表预留的条目数量 */
+    int32 ExpectedEntries = 0;
+
+    /** 延迟字符串预留的节点数量 */
+    int32 ExpectedLazyStrings = 0;
+
+    /** 是否转义路径中的键名（见 JsonPath.h） */
+    bool bEscapeKeys = false;
+
+    /** 不转义时是否已出现含 '.' 的键名（此后相同的路径不一定来自同一个键） */
+    bool bHasDottedKeys = false;
+};
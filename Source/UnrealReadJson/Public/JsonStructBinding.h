@@ -0,0 +1,170 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "JsonPath.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "JsonStructBinding.generated.h"
+
+/**
+ * USTRUCT 绑定计划
+ * 每种结构体只编译一次：遍历反射属性，把属性偏移与相对路径对应起来（嵌套结构体展开为子路径），
+ * 之后每次绑定只按预先计算好哈希的路径查表并直接写入内存，不再查找反射信息，也不再拼接字符串
+ *
+ * 路径映射规则:
+ * - 默认使用属性名作为键名（ParsedDataMap 的键不区分大小写，Health 可匹配 health；区分大小写的文档需完全一致）
+ * - 属性元数据 meta = (JsonPath = "stats.hp") 可覆盖相对路径（元数据仅编辑器可用）
+ * - 运行时可通过 JsonStructBindingHelper::RegisterPathOverride 覆盖相对路径（打包后同样有效）
+ *
+ * 类型转换:
+ * - bool / 整数 / 浮点 / 枚举（名称或数值）/ FString / FName / FText 直接写入
+ * - 数组、Map、Set 等容器以及其他类型交给 FJsonObjectConverter 处理
+ * - 节点不存在或类型无法转换时保持属性原值
+ */
+class UNREALREADJSON_API FJsonStructBindingPlan
+{
+public:
+    /**
+     * 获取结构体的绑定计划（按结构体类型缓存，线程安全）
+     * @param Struct 结构体类型
+     * @return 绑定计划，Struct 为空时返回nullptr
+     */
+    static TSharedPtr<const FJsonStructBindingPlan> GetOrCompile(const UScriptStruct* Struct);
+
+    /**
+     * 将解析结果写入结构体实例
+     * @param ParsedData 已解析的数据
+     * @param PathPrefix 结构体对应的节点路径，为空表示根节点
+     * @param StructMemory 结构体实例内存
+     * @return 成功写入的属性数量
+     */
+    int32 Bind(const FParsedData& ParsedData, const FString& PathPrefix, void* StructMemory) const;
+
+    /** 计划中的绑定数量 */
+    int32 NumBindings() const { return Bindings.Num(); }
+
+    /** 计划对应的结构体类型 */
+    const UScriptStruct* GetStruct() const { return Struct.Get(); }
+
+private:
+    friend class FJsonStructBindingCompiler;
+
+    enum class EBindingKind : uint8
+    {
+        Bool,
+        Integer,
+        Float,
+        Enum,
+        String,
+        Name,
+        Text,
+        /** 交给 FJsonObjectConverter 处理 */
+        Converter
+    };
+
+    struct FBinding
+    {
+        EBindingKind Kind = EBindingKind::Converter;
+        const FProperty* Property = nullptr;
+        /** 相对于根结构体的偏移（嵌套结构体已累加） */
+        int32 Offset = 0;
+        /** 枚举类型（Kind == Enum） */
+        const UEnum* Enum = nullptr;
+        /** 结构体属性的回退绑定：节点为对象时跳过，由展开后的子属性负责 */
+        bool bSkipObjectEntry = false;
+    };
+
+    /** 预先计算哈希的完整路径 */
+    struct FPathHandle
+    {
+        FString Path;
+        uint32 Hash = 0;
+
+        explicit FPathHandle(FString&& InPath);
+    };
+
+    using FPathHandleArray = TArray<FPathHandle>;
+
+    /** 按前缀获取完整路径（非空前缀的结果会被缓存） */
+    TSharedRef<const FPathHandleArray> ResolvePaths(const FString& PathPrefix) const;
+
+    bool ApplyBinding(const FBinding& Binding, const FJsonDataStruct& Entry, void* StructMemory) const;
+
+    TWeakObjectPtr<const UScriptStruct> Struct;
+
+    /** 编译时的结构体大小，用于检测结构体被重新编译 */
+    int32 StructureSize = 0;
+
+    TArray<FBinding> Bindings;
+
+    /** 相对路径（与 Bindings 一一对应） */
+    TArray<FString> RelativePaths;
+
+    /** 无前缀时的完整路径 */
+    TSharedRef<const FPathHandleArray> RootPaths = MakeShared<FPathHandleArray>();
+
+    /** 前缀 -> 完整路径（前缀区分大小写，同一计划可用于区分大小写的文档） */
+    mutable FRWLock PrefixPathsLock;
+    mutable TJsonSegmentMap<TSharedRef<const FPathHandleArray>> PrefixPaths;
+};
+
+// ============================================================================
+// C++ 辅助函数
+// ============================================================================
+
+namespace JsonStructBindingHelper
+{
+    /**
+     * 将解析结果写入结构体实例
+     * @param ParsedData 已解析的数据
+     * @param PathPrefix 结构体对应的节点路径，为空表示根节点
+     * @param Struct 结构体类型
+     * @param StructMemory 结构体实例内存
+     * @return 是否至少写入了一个属性
+     */
+    UNREALREADJSON_API bool ReadStruct(const FParsedData& ParsedData, const FString& PathPrefix, const UScriptStruct* Struct, void* StructMemory);
+
+    /** 将解析结果写入 USTRUCT 实例 */
+    template <typename TStruct>
+    bool ReadStruct(const FParsedData& ParsedData, const FString& PathPrefix, TStruct& OutStruct)
+    {
+        return ReadStruct(ParsedData, PathPrefix, TStruct::StaticStruct(), &OutStruct);
+    }
+
+    /**
+     * 覆盖属性的相对路径（使该结构体已缓存的绑定计划失效）
+     * @param Struct 结构体类型
+     * @param PropertyName 属性名
+     * @param RelativePath 相对于结构体节点的路径，如 stats.hp
+     */
+    UNREALREADJSON_API void RegisterPathOverride(const UScriptStruct* Struct, FName PropertyName, const FString& RelativePath);
+
+    /** 清空所有已缓存的绑定计划（对象重新实例化与蓝图结构体修改时由模块自动调用） */
+    UNREALREADJSON_API void ClearPlanCache();
+}
+
+// ============================================================================
+// 蓝图接口
+// ============================================================================
+
+/**
+ * 结构体绑定蓝图函数库
+ */
+UCLASS()
+class UNREALREADJSON_API UJsonStructBindingLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 将解析结果写入任意结构体
+     * @param ParsedData 已解析的数据
+     * @param PathPrefix 结构体对应的节点路径，为空表示根节点
+     * @param OutStruct 输出结构体（连接任意结构体变量）
+     * @param bIsValid 是否至少写入了一个属性
+     */
+    UFUNCTION(BlueprintCallable, CustomThunk, Category = "FH|ReadJson|Struct", DisplayName = "ReadJsonToStruct", meta = (CustomStructureParam = "OutStruct"))
+    static void ReadJsonToStruct(const FParsedData& ParsedData, const FString& PathPrefix, int32& OutStruct, bool& bIsValid);
+
+    DECLARE_FUNCTION(execReadJsonToStruct);
+};
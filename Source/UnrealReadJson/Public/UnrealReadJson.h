@@ -12,4 +12,8 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	/** 对象重新实例化（热重载等）时清空结构体绑定计划 */
+	FDelegateHandle ObjectsReplacedHandle;
 };
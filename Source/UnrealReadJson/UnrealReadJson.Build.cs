@@ -25,7 +25,7 @@ public class UnrealReadJson : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core", "Json", "JsonUtilities"
+				"Core", "CoreUObject", "Engine", "Json", "JsonUtilities"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -34,8 +34,6 @@ public class UnrealReadJson : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"CoreUObject",
-				"Engine",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
@@ -0,0 +1,158 @@
+﻿#include "FlattenedJsonAssetFactory.h"
+#include "Async_ReadJson.h"
+#include "FlattenedJsonAsset.h"
+#include "Editor.h"
+#include "EditorFramework/AssetImportData.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Subsystems/ImportSubsystem.h"
+
+UFlattenedJsonAssetFactory::UFlattenedJsonAssetFactory()
+{
+    SupportedClass = UFlattenedJsonAsset::StaticClass();
+    bCreateNew = false;
+    bEditorImport = true;
+    bText = true;
+    Formats.Add(TEXT("json;Flattened JSON"));
+    ImportPriority = DefaultImportPriority;
+}
+
+void UFlattenedJsonAssetFactory::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    // 显式开启后优先于引擎自带的 JSON 导入，通过 FactoryCanImport 只接管根节点为对象的文件
+    ImportPriority = bPreferForJsonObjects ? DefaultImportPriority + 1 : DefaultImportPriority;
+}
+
+// ============================================================================
+// UFactory 接口
+// ============================================================================
+bool UFlattenedJsonAssetFactory::FactoryCanImport(const FString& Filename)
+{
+    if (!FPaths::GetExtension(Filename).Equals(TEXT("json"), ESearchCase::IgnoreCase))
+    {
+        return false;
+    }
+
+    // 只读取文件开头（按 BOM 识别编码），不加载整个文件
+    const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+    if (!Reader)
+    {
+        return false;
+    }
+    TArray<uint8> Prefix;
+    Prefix.SetNumUninitialized(static_cast<int32>(FMath::Min<int64>(Reader->TotalSize(), MaxSniffBytes)));
+    Reader->Serialize(Prefix.GetData(), Prefix.Num());
+    if (Reader->IsError())
+    {
+        return false;
+    }
+
+    FString PrefixText;
+    FFileHelper::BufferToString(PrefixText, Prefix.GetData(), Prefix.Num());
+
+    // 扁平化要求根节点为对象，根节点为数组的文件交给引擎的 DataTable 导入
+    for (const TCHAR Char : PrefixText)
+    {
+        if (!FChar::IsWhitespace(Char))
+        {
+            return Char == TEXT('{');
+        }
+    }
+    return false;
+}
+
+UObject* UFlattenedJsonAssetFactory::FactoryCreateText(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, UObject* Context,
+    const TCHAR* Type, const TCHAR*& Buffer, const TCHAR* BufferEnd, FFeedbackContext* Warn)
+{
+    GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPreImport(this, InClass, InParent, InName, Type);
+
+    const FString JsonText(static_cast<int32>(BufferEnd - Buffer), Buffer);
+    FParsedData ParsedData;
+    if (!FlattenJsonText(JsonText, ParsedData))
+    {
+        Warn->Logf(ELogVerbosity::Error, TEXT("Failed to flatten JSON file [ %s ]"), *GetCurrentFilename());
+        GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, nullptr);
+        return nullptr;
+    }
+
+    UFlattenedJsonAsset* Asset = NewObject<UFlattenedJsonAsset>(InParent, InClass, InName, Flags);
+    Asset->SetParsedData(MoveTemp(ParsedData));
+    Asset->AssetImportData->Update(GetCurrentFilename());
+
+    UE_LOG(LogReadJson, Log, TEXT("[ %hs ] Imported [ %s ], %d nodes"), __FUNCTION__, *GetCurrentFilename(), Asset->GetNodeCount());
+
+    GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, Asset);
+    return Asset;
+}
+
+// ============================================================================
+// FReimportHandler 接口
+// ============================================================================
+bool UFlattenedJsonAssetFactory::CanReimport(UObject* Obj, TArray<FString>& OutFilenames)
+{
+    const UFlattenedJsonAsset* Asset = Cast<UFlattenedJsonAsset>(Obj);
+    if (Asset && Asset->AssetImportData)
+    {
+        Asset->AssetImportData->ExtractFilenames(OutFilenames);
+        return true;
+    }
+    return false;
+}
+
+void UFlattenedJsonAssetFactory::SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths)
+{
+    UFlattenedJsonAsset* Asset = Cast<UFlattenedJsonAsset>(Obj);
+    if (Asset && Asset->AssetImportData && ensure(NewReimportPaths.Num() == 1))
+    {
+        Asset->AssetImportData->UpdateFilenameOnly(NewReimportPaths[0]);
+    }
+}
+
+EReimportResult::Type UFlattenedJsonAssetFactory::Reimport(UObject* Obj)
+{
+    UFlattenedJsonAsset* Asset = Cast<UFlattenedJsonAsset>(Obj);
+    if (!Asset || !Asset->AssetImportData)
+    {
+        return EReimportResult::Failed;
+    }
+
+    const FString Filename = Asset->AssetImportData->GetFirstFilename();
+    FString JsonText;
+    if (Filename.IsEmpty() || !FFileHelper::LoadFileToString(JsonText, *Filename))
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to load source file [ %s ]"), __FUNCTION__, *Filename);
+        return EReimportResult::Failed;
+    }
+
+    FParsedData ParsedData;
+    if (!FlattenJsonText(JsonText, ParsedData))
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to flatten source file [ %s ]"), __FUNCTION__, *Filename);
+        return EReimportResult::Failed;
+    }
+
+    Asset->Modify();
+    Asset->SetParsedData(MoveTemp(ParsedData));
+    Asset->AssetImportData->Update(Filename);
+    Asset->MarkPackageDirty();
+
+    UE_LOG(LogReadJson, Log, TEXT("[ %hs ] Reimported [ %s ], %d nodes"), __FUNCTION__, *Filename, Asset->GetNodeCount());
+    return EReimportResult::Succeeded;
+}
+
+int32 UFlattenedJsonAssetFactory::GetPriority() const
+{
+    return ImportPriority;
+}
+
+// ============================================================================
+// 内部实现
+// ============================================================================
+bool UFlattenedJsonAssetFactory::FlattenJsonText(const FString& JsonText, FParsedData& OutParsedData)
+{
+    bool bIsValid = false;
+    UAsync_ReadJson::ReadJson_Block(nullptr, JsonText, OutParsedData, bIsValid);
+    return bIsValid;
+}
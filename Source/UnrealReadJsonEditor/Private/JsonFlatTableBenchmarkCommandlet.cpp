@@ -0,0 +1,187 @@
+﻿#include "JsonFlatTableBenchmarkCommandlet.h"
+#include "Async_ReadJson.h"
+#include "JsonFlatTable.h"
+#include "JsonFrozenDocument.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+    /** 重复执行取最快的一次（秒） */
+    template <typename TFunction>
+    double MeasureBest(const int32 Iterations, TFunction&& Function)
+    {
+        double Best = TNumericLimits<double>::Max();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            Function();
+            Best = FMath::Min(Best, FPlatformTime::Seconds() - StartTime);
+        }
+        return Best;
+    }
+
+    /** 生成测试数据：约每 8 个字段一个 item，每 64 个 item 一个 group */
+    void MakeSyntheticEntries(const int32 NumEntries, TMap<FString, FJsonDataStruct>& OutMap)
+    {
+        static const TCHAR* FieldNames[] = { TEXT("id"), TEXT("name"), TEXT("position"), TEXT("rotation"), TEXT("health"), TEXT("level"), TEXT("tags"), TEXT("owner") };
+
+        OutMap.Reserve(NumEntries);
+        for (int32 Index = 0; Index < NumEntries; ++Index)
+        {
+            const int32 Item = Index / UE_ARRAY_COUNT(FieldNames);
+            const FString Path = FString::Printf(TEXT("group%d.item%d.%s"), Item / 64, Item % 64, FieldNames[Index % UE_ARRAY_COUNT(FieldNames)]);
+            OutMap.Add(Path, FJsonDataStruct::MakeInt(Index));
+        }
+    }
+}
+
+UJsonFlatTableBenchmarkCommandlet::UJsonFlatTableBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UJsonFlatTableBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 NumEntries = 100000;
+    int32 Iterations = 5;
+    FString InputFile;
+    FParse::Value(*Params, TEXT("Entries="), NumEntries);
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    Iterations = FMath::Max(Iterations, 1);
+
+    // 准备数据
+    TMap<FString, FJsonDataStruct> SourceMap;
+    if (FParse::Value(*Params, TEXT("Input="), InputFile))
+    {
+        FString JsonText;
+        if (!FFileHelper::LoadFileToString(JsonText, *InputFile))
+        {
+            UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to load [ %s ]"), __FUNCTION__, *InputFile);
+            return 1;
+        }
+        FParsedData ParsedData;
+        bool bIsValid = false;
+        UAsync_ReadJson::ReadJson_Block(nullptr, JsonText, ParsedData, bIsValid);
+        if (!bIsValid)
+        {
+            UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to parse [ %s ]"), __FUNCTION__, *InputFile);
+            return 1;
+        }
+        SourceMap = MoveTemp(ParsedData.ParsedDataMap);
+    }
+    else
+    {
+        MakeSyntheticEntries(FMath::Max(NumEntries, 1), SourceMap);
+    }
+
+    TArray<FString> HitKeys;
+    SourceMap.GenerateKeyArray(HitKeys);
+    const FRandomStream Random(12345);
+    for (int32 Index = HitKeys.Num() - 1; Index > 0; --Index)
+    {
+        HitKeys.Swap(Index, Random.RandRange(0, Index));
+    }
+    TArray<FString> MissKeys;
+    MissKeys.Reserve(HitKeys.Num());
+    for (const FString& Key : HitKeys)
+    {
+        MissKeys.Add(Key + TEXT("#"));
+    }
+    const int32 NumKeys = HitKeys.Num();
+
+    // 构建
+    TMap<FString, FJsonDataStruct> Map;
+    const double MapBuildSeconds = MeasureBest(Iterations, [&SourceMap, &Map]()
+    {
+        Map.Empty(SourceMap.Num());
+        for (const TPair<FString, FJsonDataStruct>& Pair : SourceMap)
+        {
+            Map.Add(Pair.Key, Pair.Value);
+        }
+    });
+
+    FJsonFlatTable Table;
+    const double TableBuildSeconds = MeasureBest(Iterations, [&SourceMap, &Table]()
+    {
+        Table.Reset(SourceMap.Num());
+        for (const TPair<FString, FJsonDataStruct>& Pair : SourceMap)
+        {
+            Table.Add(Pair.Key, Pair.Value);
+        }
+    });
+
+    FJsonFrozenDocument Frozen;
+    bool bFrozen = true;
+    const double FreezeSeconds = MeasureBest(Iterations, [&SourceMap, &Frozen, &bFrozen]()
+    {
+        bFrozen &= Frozen.Freeze(SourceMap);
+    });
+    if (!bFrozen)
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to freeze"), __FUNCTION__);
+        return 1;
+    }
+
+    // 查找（累加结果，避免被优化掉）
+    int64 Checksum = 0;
+    const auto MeasureLookup = [Iterations, &Checksum](const TArray<FString>& Keys, auto&& FindFunction)
+    {
+        return MeasureBest(Iterations, [&Keys, &Checksum, &FindFunction]()
+        {
+            for (const FString& Key : Keys)
+            {
+                if (const FJsonDataStruct* Found = FindFunction(Key))
+                {
+                    Checksum += Found->IntValue + 1;
+                }
+            }
+        });
+    };
+    const auto MapFind = [&Map](const FString& Key) { return Map.Find(Key); };
+    const auto TableFind = [&Table](const FString& Key) { return Table.Find(Key); };
+    const auto FrozenFind = [&Frozen](const FString& Key) { return Frozen.Find(Key); };
+
+    const double MapHitSeconds = MeasureLookup(HitKeys, MapFind);
+    const double TableHitSeconds = MeasureLookup(HitKeys, TableFind);
+    const double FrozenHitSeconds = MeasureLookup(HitKeys, FrozenFind);
+    const double MapMissSeconds = MeasureLookup(MissKeys, MapFind);
+    const double TableMissSeconds = MeasureLookup(MissKeys, TableFind);
+    const double FrozenMissSeconds = MeasureLookup(MissKeys, FrozenFind);
+
+    // 经由 FParsedData::FindEntry 命中查找：ParsedDataMap 存储与数据表存储（FReadJsonOptions::bFlatTableStorage）
+    FParsedData MapDocument;
+    MapDocument.ParsedDataMap = Map;
+    FParsedData TableDocument;
+    TableDocument.FlatEntries = MakeShared<FJsonFlatTable>(Table);
+    const double MapDocumentHitSeconds = MeasureLookup(HitKeys, [&MapDocument](const FString& Key) { return MapDocument.FindEntry(Key); });
+    const double TableDocumentHitSeconds = MeasureLookup(HitKeys, [&TableDocument](const FString& Key) { return TableDocument.FindEntry(Key); });
+
+    // 内存包含键的内容（冻结文档的键集中存放，TMap 与数据表的键各自分配）
+    SIZE_T MapBytes = Map.GetAllocatedSize();
+    for (const TPair<FString, FJsonDataStruct>& Pair : Map)
+    {
+        MapBytes += Pair.Key.GetAllocatedSize();
+    }
+    SIZE_T TableBytes = Table.GetAllocatedSize();
+    for (const FJsonFlatTable::FEntry& Entry : Table.GetEntries())
+    {
+        TableBytes += Entry.Key.GetAllocatedSize();
+    }
+
+    const auto NanosecondsPerKey = [NumKeys](const double Seconds)
+    {
+        return Seconds * 1.0e9 / NumKeys;
+    };
+
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] %d entries, best of %d iterations (checksum %lld)"), __FUNCTION__, NumKeys, Iterations, Checksum);
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ]                 TMap        FJsonFlatTable  FJsonFrozenDocument"), __FUNCTION__);
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] Build (ns/key)  %-10.1f  %-14.1f  %-10.1f"), __FUNCTION__, NanosecondsPerKey(MapBuildSeconds), NanosecondsPerKey(TableBuildSeconds), NanosecondsPerKey(FreezeSeconds));
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] Hit   (ns/key)  %-10.1f  %-14.1f  %-10.1f"), __FUNCTION__, NanosecondsPerKey(MapHitSeconds), NanosecondsPerKey(TableHitSeconds), NanosecondsPerKey(FrozenHitSeconds));
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] Miss  (ns/key)  %-10.1f  %-14.1f  %-10.1f"), __FUNCTION__, NanosecondsPerKey(MapMissSeconds), NanosecondsPerKey(TableMissSeconds), NanosecondsPerKey(FrozenMissSeconds));
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] FindEntry (ns)  %-10.1f  %-14.1f  -"), __FUNCTION__, NanosecondsPerKey(MapDocumentHitSeconds), NanosecondsPerKey(TableDocumentHitSeconds));
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] Memory (KB)     %-10.1f  %-14.1f  %-10.1f"), __FUNCTION__, MapBytes / 1024.0, TableBytes / 1024.0, Frozen.GetAllocatedSize() / 1024.0);
+    return 0;
+}
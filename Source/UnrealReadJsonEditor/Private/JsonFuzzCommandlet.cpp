@@ -0,0 +1,350 @@
+﻿#include "JsonFuzzCommandlet.h"
+#include "JsonDifferential.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    /** 参与测试的引擎（按 JsonDifferential 的顺序） */
+    const EJsonDiffEngines TestedEngines[] =
+    {
+        EJsonDiffEngines::Iterative, EJsonDiffEngines::Parallel, EJsonDiffEngines::Streaming, EJsonDiffEngines::LazyStrings,
+        EJsonDiffEngines::IgnoreCaseKeys, EJsonDiffEngines::CaseSensitiveKeys, EJsonDiffEngines::EscapePathKeys, EJsonDiffEngines::BulkArrays
+    };
+    constexpr int32 NumTestedEngines = UE_ARRAY_COUNT(TestedEngines);
+
+    /** 变异时插入的片段：结构字符、边界数值、转义与路径相关的键 */
+    const TCHAR* const MutationTokens[] =
+    {
+        TEXT("{"), TEXT("}"), TEXT("["), TEXT("]"), TEXT(":"), TEXT(","), TEXT("\""), TEXT("\\"),
+        TEXT("null"), TEXT("true"), TEXT("false"), TEXT("{}"), TEXT("[]"), TEXT("\"\""),
+        TEXT("0"), TEXT("-0"), TEXT("1.0"), TEXT("1e400"), TEXT("-1e-400"), TEXT("2147483648"), TEXT("-2147483649"),
+        TEXT("9223372036854775808"), TEXT("0.1e1"), TEXT("1E+2"), TEXT("00"), TEXT(".5"),
+        TEXT("\"\\ud800\""), TEXT("\"\\udc00\\ud800\""), TEXT("\"\\u00e9\""), TEXT("\"\\n\\t\\/\""),
+        TEXT("\"a.b\""), TEXT("\"A\""), TEXT("\"a\""), TEXT(" "), TEXT("\n")
+    };
+    constexpr int32 NumMutationTokens = UE_ARRAY_COUNT(MutationTokens);
+
+    /** 重复执行取最快的一次（秒） */
+    template <typename TFunction>
+    double MeasureBest(const int32 Iterations, TFunction&& Function)
+    {
+        double Best = TNumericLimits<double>::Max();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            Function();
+            Best = FMath::Min(Best, FPlatformTime::Seconds() - StartTime);
+        }
+        return Best;
+    }
+
+    /** 生成测试文档：items 下每个对象含数值、字符串、嵌套对象与数组，按两空格缩进 */
+    FString MakeSyntheticJson(const int32 NumItems)
+    {
+        FString JsonText;
+        JsonText.Reserve(NumItems * 256);
+        JsonText += TEXT("{\n  \"items\": {\n");
+        for (int32 Index = 0; Index < NumItems; ++Index)
+        {
+            JsonText += FString::Printf(
+                TEXT("    \"item%d\": {\n      \"id\": %d,\n      \"name\": \"Item \\\"%d\\\"\",\n      \"health\": %d.25,\n      \"enabled\": %s,\n")
+                TEXT("      \"position\": { \"x\": %d.5, \"y\": -%d.5, \"z\": 0.125 },\n      \"tags\": [ \"common\", \"level%d\" ]\n    }%s\n"),
+                Index, Index, Index, Index % 100, Index % 2 ? TEXT("true") : TEXT("false"), Index, Index, Index % 10, Index + 1 < NumItems ? TEXT(",") : TEXT(""));
+        }
+        JsonText += TEXT("  }\n}\n");
+        return JsonText;
+    }
+
+    /** 对输入做 1~4 次随机变异：替换字符、删除区间、复制区间、截断或插入片段 */
+    FString Mutate(const FString& Input, FRandomStream& Random)
+    {
+        FString Output = Input;
+        const int32 NumEdits = Random.RandRange(1, 4);
+        for (int32 Edit = 0; Edit < NumEdits; ++Edit)
+        {
+            const int32 Length = Output.Len();
+            const int32 Position = Length > 0 ? Random.RandRange(0, Length - 1) : 0;
+            const int32 SpanLength = Length > 0 ? Random.RandRange(1, FMath::Min(16, Length - Position)) : 0;
+            switch (Random.RandRange(0, 4))
+            {
+            case 0:
+                if (Length > 0)
+                {
+                    Output[Position] = MutationTokens[Random.RandRange(0, NumMutationTokens - 1)][0];
+                }
+                break;
+            case 1:
+                Output.RemoveAt(Position, SpanLength);
+                break;
+            case 2:
+                Output.InsertAt(Random.RandRange(0, Length), Output.Mid(Position, SpanLength));
+                break;
+            case 3:
+                Output.LeftInline(Position);
+                break;
+            default:
+                Output.InsertAt(Random.RandRange(0, Length), MutationTokens[Random.RandRange(0, NumMutationTokens - 1)]);
+                break;
+            }
+        }
+        return Output;
+    }
+
+    /** 最多输出的数值字面量差异条数 */
+    constexpr int32 MaxLoggedNumberFailures = 32;
+
+    /**
+     * 随机数值字面量：
+     * 随机位模式的有限 double 按 %.17g（可还原）或 %.15g（需要舍入）格式化，
+     * 或 1~25 位随机尾数加随机小数点与指数（超过 19 位有效数字时走回退路径）
+     */
+    FString MakeRandomNumberLiteral(FRandomStream& Random)
+    {
+        const int32 Kind = Random.RandRange(0, 2);
+        if (Kind < 2)
+        {
+            double Value = 0.0;
+            do
+            {
+                const uint64 High = Random.GetUnsignedInt();
+                const uint64 Bits = High << 32 | Random.GetUnsignedInt();
+                FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+            }
+            while (!FMath::IsFinite(Value));
+            return Kind == 0 ? FString::Printf(TEXT("%.17g"), Value) : FString::Printf(TEXT("%.15g"), Value);
+        }
+
+        FString Literal = Random.RandRange(0, 1) ? TEXT("-") : TEXT("");
+        const int32 NumDigits = Random.RandRange(1, 25);
+        // 0 表示没有小数点
+        const int32 PointPosition = Random.RandRange(0, NumDigits - 1);
+        for (int32 Index = 0; Index < NumDigits; ++Index)
+        {
+            Literal.AppendChar(static_cast<TCHAR>(TEXT('0') + Random.RandRange(Index == 0 && NumDigits > 1 ? 1 : 0, 9)));
+            if (Index + 1 == PointPosition)
+            {
+                Literal.AppendChar(TEXT('.'));
+            }
+        }
+        if (Random.RandRange(0, 1))
+        {
+            Literal += FString::Printf(TEXT("e%d"), Random.RandRange(-350, 350));
+        }
+        return Literal;
+    }
+
+    /** 读取基线文件（每行 Name=MB/s） */
+    TMap<FString, double> LoadBaseline(const FString& FilePath)
+    {
+        TMap<FString, double> Baseline;
+        TArray<FString> Lines;
+        FFileHelper::LoadFileToStringArray(Lines, *FilePath);
+        for (const FString& Line : Lines)
+        {
+            FString Name;
+            FString Value;
+            if (Line.Split(TEXT("="), &Name, &Value))
+            {
+                Baseline.Add(Name.TrimStartAndEnd(), FCString::Atod(*Value));
+            }
+        }
+        return Baseline;
+    }
+}
+
+UJsonFuzzCommandlet::UJsonFuzzCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UJsonFuzzCommandlet::Main(const FString& Params)
+{
+    FString CorpusDir;
+    if (!FParse::Value(*Params, TEXT("Corpus="), CorpusDir))
+    {
+        if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UnrealReadJson")))
+        {
+            CorpusDir = Plugin->GetBaseDir() / TEXT("Resources/Fuzz/Corpus");
+        }
+    }
+    FString FailDir = FPaths::ProjectSavedDir() / TEXT("JsonFuzz");
+    FParse::Value(*Params, TEXT("FailDir="), FailDir);
+    int32 NumMutations = 200;
+    int32 NumRandomNumbers = 100000;
+    int32 Seed = 1;
+    int32 NumItems = 20000;
+    int32 Iterations = 5;
+    float MaxSlowdown = 0.2f;
+    FParse::Value(*Params, TEXT("Mutations="), NumMutations);
+    FParse::Value(*Params, TEXT("Numbers="), NumRandomNumbers);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Items="), NumItems);
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("MaxSlowdown="), MaxSlowdown);
+    Iterations = FMath::Max(Iterations, 1);
+
+    // ========================================================================
+    // 差分测试
+    // ========================================================================
+    TArray<FString> CorpusFiles;
+    IFileManager::Get().FindFiles(CorpusFiles, *(CorpusDir / TEXT("*.json")), true, false);
+    CorpusFiles.Sort();
+    if (CorpusFiles.Num() == 0)
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] No *.json seeds in [ %s ]"), __FUNCTION__, *CorpusDir);
+        return 1;
+    }
+
+    FRandomStream Random(Seed);
+    int32 NumInputs = 0;
+    int32 NumAccepted = 0;
+    int32 NumFailures = 0;
+    int32 FailuresByEngine[NumTestedEngines] = {};
+    const auto RunInput = [&](const FString& Input, const FString& Origin)
+    {
+        FJsonDiffResult Result;
+        const bool bMatched = JsonDifferential::Run(Input, EJsonDiffEngines::All, Result);
+        ++NumInputs;
+        NumAccepted += Result.bReferenceAccepted ? 1 : 0;
+        if (bMatched)
+        {
+            return;
+        }
+
+        for (int32 EngineIndex = 0; EngineIndex < NumTestedEngines; ++EngineIndex)
+        {
+            if (EnumHasAnyFlags(Result.AcceptanceMismatches | Result.EntryMismatches, TestedEngines[EngineIndex]))
+            {
+                ++FailuresByEngine[EngineIndex];
+            }
+        }
+        const FString FailPath = FailDir / FString::Printf(TEXT("mismatch_%04d.json"), NumFailures++);
+        FFileHelper::SaveStringToFile(Input, *FailPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] %s -> %s\n%s"), __FUNCTION__, *Origin, *FailPath, *FString::Join(Result.Messages, TEXT("\n")));
+    };
+
+    TArray<FString> NumberLiterals;
+    for (const FString& FileName : CorpusFiles)
+    {
+        FString SeedText;
+        if (!FFileHelper::LoadFileToString(SeedText, *(CorpusDir / FileName)))
+        {
+            UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Failed to load [ %s ]"), __FUNCTION__, *FileName);
+            continue;
+        }
+        RunInput(SeedText, FileName);
+        JsonDifferential::CollectNumberLiterals(SeedText, NumberLiterals);
+        for (int32 Mutation = 0; Mutation < NumMutations; ++Mutation)
+        {
+            RunInput(Mutate(SeedText, Random), FString::Printf(TEXT("%s (mutation %d)"), *FileName, Mutation));
+        }
+    }
+
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] %d inputs from %d seeds (seed %d), %d accepted by the reference, %d mismatching"),
+        __FUNCTION__, NumInputs, CorpusFiles.Num(), Seed, NumAccepted, NumFailures);
+    for (int32 EngineIndex = 0; EngineIndex < NumTestedEngines; ++EngineIndex)
+    {
+        UE_LOG(LogReadJson, Display, TEXT("[ %hs ]   %-14s %d"), __FUNCTION__, JsonDifferential::GetEngineName(TestedEngines[EngineIndex]), FailuresByEngine[EngineIndex]);
+    }
+
+    // ========================================================================
+    // 数值字面量
+    // ========================================================================
+    // 参考实现与各引擎共用 JsonNumberParser，舍入错误在差分测试中不会表现为差异，单独与 FCString::Atod 比较
+    const int32 NumSeedLiterals = NumberLiterals.Num();
+    for (int32 Index = 0; Index < NumRandomNumbers; ++Index)
+    {
+        NumberLiterals.Add(MakeRandomNumberLiteral(Random));
+    }
+
+    int32 NumNumberFailures = 0;
+    for (const FString& Literal : NumberLiterals)
+    {
+        TArray<FString> Messages;
+        if (!JsonDifferential::CheckNumberLiteral(Literal, Messages) && NumNumberFailures++ < MaxLoggedNumberFailures)
+        {
+            UE_LOG(LogReadJson, Error, TEXT("[ %hs ] %s"), __FUNCTION__, *FString::Join(Messages, TEXT("\n")));
+        }
+    }
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] %d number literals (%d from seeds, %d random), %d mismatching Atod"),
+        __FUNCTION__, NumberLiterals.Num(), NumSeedLiterals, NumberLiterals.Num() - NumSeedLiterals, NumNumberFailures);
+
+    // ========================================================================
+    // 吞吐量
+    // ========================================================================
+    FString JsonText;
+    FString InputFile;
+    if (FParse::Value(*Params, TEXT("Input="), InputFile))
+    {
+        if (!FFileHelper::LoadFileToString(JsonText, *InputFile))
+        {
+            UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to load [ %s ]"), __FUNCTION__, *InputFile);
+            return 1;
+        }
+    }
+    else
+    {
+        JsonText = MakeSyntheticJson(FMath::Max(NumItems, 1));
+    }
+
+    const double SourceMegabytes = JsonText.Len() * sizeof(TCHAR) / (1024.0 * 1024.0);
+    TArray<TPair<FString, double>> Throughputs;
+    FParsedData ParsedData;
+    bool bParsed = true;
+    const double ReferenceSeconds = MeasureBest(Iterations, [&JsonText, &ParsedData, &bParsed]()
+    {
+        bParsed &= JsonDifferential::ParseReference(JsonText, ParsedData);
+    });
+    Throughputs.Emplace(JsonDifferential::GetEngineName(EJsonDiffEngines::None), SourceMegabytes / FMath::Max(ReferenceSeconds, 1.0e-9));
+    for (const EJsonDiffEngines Engine : TestedEngines)
+    {
+        // BulkArrays 不是解析引擎
+        if (!EnumHasAnyFlags(EJsonDiffEngines::ParseEngines, Engine))
+        {
+            continue;
+        }
+        const double Seconds = MeasureBest(Iterations, [&JsonText, &ParsedData, &bParsed, Engine]()
+        {
+            bParsed &= JsonDifferential::ParseWithEngine(Engine, JsonText, ParsedData);
+        });
+        Throughputs.Emplace(JsonDifferential::GetEngineName(Engine), SourceMegabytes / FMath::Max(Seconds, 1.0e-9));
+    }
+    if (!bParsed)
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to parse throughput input"), __FUNCTION__);
+        return 1;
+    }
+
+    FString SaveBaseline;
+    FString BaselineFile;
+    const bool bSaveBaseline = FParse::Value(*Params, TEXT("SaveBaseline="), SaveBaseline);
+    const TMap<FString, double> Baseline = FParse::Value(*Params, TEXT("Baseline="), BaselineFile) ? LoadBaseline(BaselineFile) : TMap<FString, double>();
+
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] %d source characters, best of %d iterations"), __FUNCTION__, JsonText.Len(), Iterations);
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ]                MB/s        Baseline"), __FUNCTION__);
+    int32 NumRegressions = 0;
+    FString BaselineText;
+    for (const TPair<FString, double>& Throughput : Throughputs)
+    {
+        BaselineText += FString::Printf(TEXT("%s=%.3f\n"), *Throughput.Key, Throughput.Value);
+        const double* Expected = Baseline.Find(Throughput.Key);
+        const bool bRegressed = Expected && Throughput.Value < *Expected * (1.0 - MaxSlowdown);
+        NumRegressions += bRegressed ? 1 : 0;
+        UE_LOG(LogReadJson, Display, TEXT("[ %hs ] %-14s %-10.1f  %s%s"), __FUNCTION__, *Throughput.Key, Throughput.Value,
+            Expected ? *FString::Printf(TEXT("%.1f"), *Expected) : TEXT("-"), bRegressed ? TEXT("  REGRESSED") : TEXT(""));
+    }
+    if (bSaveBaseline && !FFileHelper::SaveStringToFile(BaselineText, *SaveBaseline))
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to save baseline [ %s ]"), __FUNCTION__, *SaveBaseline);
+        return 1;
+    }
+
+    return NumFailures > 0 || NumNumberFailures > 0 || NumRegressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,309 @@
+﻿#include "JsonSchemaCodegenCommandlet.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    /** 生成代码中的返回类型与槽位数组 */
+    void GetAccessorInfo(const EValueType Type, const TCHAR*& OutReturnType, const TCHAR*& OutSlotArray)
+    {
+        switch (Type)
+        {
+        case EValueType::Bool:  OutReturnType = TEXT("bool");           OutSlotArray = TEXT("Bools"); break;
+        case EValueType::Int:   OutReturnType = TEXT("int32");          OutSlotArray = TEXT("Ints"); break;
+        case EValueType::Float: OutReturnType = TEXT("float");          OutSlotArray = TEXT("Floats"); break;
+        case EValueType::Int64: OutReturnType = TEXT("int64");          OutSlotArray = TEXT("Int64s"); break;
+        case EValueType::Double: OutReturnType = TEXT("double");        OutSlotArray = TEXT("Doubles"); break;
+        default:                OutReturnType = TEXT("const FString&"); OutSlotArray = TEXT("Strings"); break;
+        }
+    }
+
+    /** 读取 JSON Schema 的 type（数组形式时取第一个非 null 类型） */
+    FString GetSchemaType(const TSharedPtr<FJsonObject>& Schema)
+    {
+        const TSharedPtr<FJsonValue> TypeValue = Schema->TryGetField(TEXT("type"));
+        if (!TypeValue.IsValid())
+        {
+            return Schema->HasTypedField<EJson::Object>(TEXT("properties")) ? TEXT("object") : FString();
+        }
+        if (TypeValue->Type == EJson::Array)
+        {
+            for (const TSharedPtr<FJsonValue>& Element : TypeValue->AsArray())
+            {
+                if (Element.IsValid() && Element->Type == EJson::String && Element->AsString() != TEXT("null"))
+                {
+                    return Element->AsString();
+                }
+            }
+            return FString();
+        }
+        return TypeValue->Type == EJson::String ? TypeValue->AsString() : FString();
+    }
+
+    FString EscapeCppString(const FString& Value)
+    {
+        return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+    }
+}
+
+UJsonSchemaCodegenCommandlet::UJsonSchemaCodegenCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UJsonSchemaCodegenCommandlet::Main(const FString& Params)
+{
+    FString InputFile;
+    FString OutputFile;
+    FString StructName;
+    FString Mode;
+    if (!FParse::Value(*Params, TEXT("Input="), InputFile) || !FParse::Value(*Params, TEXT("Output="), OutputFile))
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Usage: -run=JsonSchemaCodegen -Input=<schema or sample .json> -Output=<header .h> [-Name=<StructName>] [-Mode=Schema|Sample]"), __FUNCTION__);
+        return 1;
+    }
+    if (!FParse::Value(*Params, TEXT("Name="), StructName))
+    {
+        StructName = FPaths::GetBaseFilename(OutputFile);
+    }
+    FParse::Value(*Params, TEXT("Mode="), Mode);
+
+    FString JsonText;
+    if (!FFileHelper::LoadFileToString(JsonText, *InputFile))
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to load [ %s ]"), __FUNCTION__, *InputFile);
+        return 1;
+    }
+
+    TSharedPtr<FJsonObject> RootObject;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+    if (!FJsonSerializer::Deserialize(Reader, RootObject, FJsonSerializer::EFlags::StoreNumbersAsStrings) || !RootObject.IsValid())
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to parse [ %s ]: %s"), __FUNCTION__, *InputFile, *Reader->GetErrorMessage());
+        return 1;
+    }
+
+    bool bIsSchema = Mode.Equals(TEXT("Schema"), ESearchCase::IgnoreCase);
+    if (Mode.IsEmpty())
+    {
+        bIsSchema = RootObject->HasField(TEXT("$schema"))
+            || (GetSchemaType(RootObject) == TEXT("object") && RootObject->HasTypedField<EJson::Object>(TEXT("properties")));
+    }
+
+    TArray<FGeneratedField> Fields;
+    if (bIsSchema)
+    {
+        CollectSchemaFields(RootObject, FString(), Fields);
+    }
+    else
+    {
+        CollectSampleFields(RootObject, FString(), Fields);
+    }
+
+    if (Fields.IsEmpty())
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] No fields found in [ %s ]"), __FUNCTION__, *InputFile);
+        return 1;
+    }
+
+    if (!StructName.StartsWith(TEXT("F"), ESearchCase::CaseSensitive))
+    {
+        StructName = TEXT("F") + StructName;
+    }
+    const FString Header = GenerateHeader(MakeIdentifier(StructName), FPaths::GetCleanFilename(InputFile), Fields);
+    if (!FFileHelper::SaveStringToFile(Header, *OutputFile, FFileHelper::EEncodingOptions::ForceUTF8))
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to write [ %s ]"), __FUNCTION__, *OutputFile);
+        return 1;
+    }
+
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] Generated [ %s ] with %d fields from %s [ %s ]"),
+        __FUNCTION__, *OutputFile, Fields.Num(), bIsSchema ? TEXT("schema") : TEXT("sample"), *InputFile);
+    return 0;
+}
+
+void UJsonSchemaCodegenCommandlet::CollectSchemaFields(const TSharedPtr<FJsonObject>& Schema, const FString& BasePath, TArray<FGeneratedField>& OutFields)
+{
+    const TSharedPtr<FJsonObject>* Properties = nullptr;
+    if (!Schema->TryGetObjectField(TEXT("properties"), Properties))
+    {
+        return;
+    }
+
+    for (const auto& Elem : (*Properties)->Values)
+    {
+        const FString Path = JsonDataHelper::BuildNodePath(BasePath, Elem.Key);
+        if (!Elem.Value.IsValid() || Elem.Value->Type != EJson::Object)
+        {
+            continue;
+        }
+
+        const TSharedPtr<FJsonObject> PropertySchema = Elem.Value->AsObject();
+        if (PropertySchema->HasField(TEXT("$ref")))
+        {
+            UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] $ref is not supported, [ %s ] is skipped"), __FUNCTION__, *Path);
+            continue;
+        }
+
+        const FString Type = GetSchemaType(PropertySchema);
+        if (Type == TEXT("object") && PropertySchema->HasTypedField<EJson::Object>(TEXT("properties")))
+        {
+            CollectSchemaFields(PropertySchema, Path, OutFields);
+        }
+        else if (Type == TEXT("boolean"))
+        {
+            OutFields.Add({ Path, EValueType::Bool });
+        }
+        else if (Type == TEXT("integer"))
+        {
+            // format: int64 用于超出 int32 范围的ID、时间戳等
+            FString Format;
+            PropertySchema->TryGetStringField(TEXT("format"), Format);
+            OutFields.Add({ Path, Format == TEXT("int64") ? EValueType::Int64 : EValueType::Int });
+        }
+        else if (Type == TEXT("number"))
+        {
+            FString Format;
+            PropertySchema->TryGetStringField(TEXT("format"), Format);
+            OutFields.Add({ Path, Format == TEXT("double") ? EValueType::Double : EValueType::Float });
+        }
+        else if (Type == TEXT("string") || Type == TEXT("array") || Type == TEXT("object"))
+        {
+            OutFields.Add({ Path, EValueType::String });
+        }
+        else
+        {
+            UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Unsupported type [ %s ] at [ %s ], skipped"), __FUNCTION__, *Type, *Path);
+        }
+    }
+}
+
+void UJsonSchemaCodegenCommandlet::CollectSampleFields(const TSharedPtr<FJsonObject>& Sample, const FString& BasePath, TArray<FGeneratedField>& OutFields)
+{
+    for (const auto& Elem : Sample->Values)
+    {
+        const FString Path = JsonDataHelper::BuildNodePath(BasePath, Elem.Key);
+        if (!Elem.Value.IsValid())
+        {
+            continue;
+        }
+
+        switch (Elem.Value->Type)
+        {
+        case EJson::Object:
+            CollectSampleFields(Elem.Value->AsObject(), Path, OutFields);
+            break;
+        case EJson::Boolean:
+            OutFields.Add({ Path, EValueType::Bool });
+            break;
+        case EJson::Number:
+            {
+                // 与扁平化规则一致：按字面量分类为 Int / Int64 / Double（能无损保存为 float 的样本值同样生成 double 字段）
+                FJsonDataStruct NumberData;
+                if (JsonDataHelper::MakeNumberData(*Elem.Value, NumberData))
+                {
+                    OutFields.Add({ Path, NumberData.ValueType == EValueType::Float ? EValueType::Double : NumberData.ValueType });
+                }
+                break;
+            }
+        case EJson::String:
+        case EJson::Array:
+            OutFields.Add({ Path, EValueType::String });
+            break;
+        default:
+            UE_LOG(LogReadJson, Warning, TEXT("[ %hs ] Cannot infer type of [ %s ] from null, skipped"), __FUNCTION__, *Path);
+            break;
+        }
+    }
+}
+
+FString UJsonSchemaCodegenCommandlet::GenerateHeader(const FString& StructName, const FString& SourceFile, const TArray<FGeneratedField>& Fields)
+{
+    // 访问器名称去重
+    TArray<FString> Names;
+    TSet<FString> UsedNames;
+    for (const FGeneratedField& Field : Fields)
+    {
+        FString Name = MakeIdentifier(Field.Path);
+        for (int32 Suffix = 2; UsedNames.Contains(Name); ++Suffix)
+        {
+            Name = FString::Printf(TEXT("%s%d"), *MakeIdentifier(Field.Path), Suffix);
+        }
+        UsedNames.Add(Name);
+        Names.Add(MoveTemp(Name));
+    }
+
+    FString Out;
+    Out += FString::Printf(TEXT("// 由 JsonSchemaCodegen 根据 %s 生成，请勿手动修改\n\n"), *SourceFile);
+    Out += TEXT("#pragma once\n\n");
+    Out += TEXT("#include \"CoreMinimal.h\"\n");
+    Out += TEXT("#include \"JsonSchemaAccessor.h\"\n\n");
+    Out += FString::Printf(TEXT("struct %s : public TJsonSchemaAccessor<%s>\n{\n"), *StructName, *StructName);
+
+    // 槽位下标
+    Out += TEXT("    enum ESlot : int32\n    {\n");
+    for (int32 FieldIndex = 0; FieldIndex < Fields.Num(); ++FieldIndex)
+    {
+        Out += FString::Printf(TEXT("        Slot_%s = %d,\n"), *Names[FieldIndex], FieldIndex);
+    }
+    Out += TEXT("        NumSlots\n    };\n\n");
+
+    // 布局
+    Out += TEXT("    static const FJsonSchemaLayout& StaticLayout()\n    {\n");
+    Out += TEXT("        static const FJsonSchemaField Fields[] =\n        {\n");
+    for (const FGeneratedField& Field : Fields)
+    {
+        Out += FString::Printf(TEXT("            { TEXT(\"%s\"), EValueType::%s },\n"), *EscapeCppString(Field.Path), *JsonDataHelper::GetValueTypeName(Field.Type));
+    }
+    Out += TEXT("        };\n");
+    Out += TEXT("        static const FJsonSchemaLayout Layout(Fields, UE_ARRAY_COUNT(Fields));\n");
+    Out += TEXT("        return Layout;\n    }\n");
+
+    // 访问器：类型数组下标按字段顺序分别计数，与 FJsonSchemaLayout 一致
+    TMap<EValueType, int32> TypedCounts;
+    for (int32 FieldIndex = 0; FieldIndex < Fields.Num(); ++FieldIndex)
+    {
+        const FGeneratedField& Field = Fields[FieldIndex];
+        const TCHAR* ReturnType = nullptr;
+        const TCHAR* SlotArray = nullptr;
+        GetAccessorInfo(Field.Type, ReturnType, SlotArray);
+        int32& TypedIndex = TypedCounts.FindOrAdd(Field.Type);
+
+        Out += FString::Printf(TEXT("\n    /** %s */\n"), *Field.Path);
+        Out += FString::Printf(TEXT("    %s Get%s() const { return Slots.%s[%d]; }\n"), ReturnType, *Names[FieldIndex], SlotArray, TypedIndex++);
+        Out += FString::Printf(TEXT("    bool Has%s() const { return IsPresent(Slot_%s); }\n"), *Names[FieldIndex], *Names[FieldIndex]);
+    }
+
+    Out += TEXT("};\n");
+    return Out;
+}
+
+FString UJsonSchemaCodegenCommandlet::MakeIdentifier(const FString& Path)
+{
+    FString Identifier;
+    Identifier.Reserve(Path.Len());
+
+    bool bCapitalizeNext = true;
+    for (const TCHAR Char : Path)
+    {
+        if (!FChar::IsAlnum(Char))
+        {
+            bCapitalizeNext = true;
+            continue;
+        }
+        Identifier.AppendChar(bCapitalizeNext ? FChar::ToUpper(Char) : Char);
+        bCapitalizeNext = false;
+    }
+
+    if (Identifier.IsEmpty() || FChar::IsDigit(Identifier[0]))
+    {
+        Identifier.InsertAt(0, TEXT('_'));
+    }
+    return Identifier;
+}
@@ -0,0 +1,123 @@
+﻿#include "JsonWriterBenchmarkCommandlet.h"
+#include "Async_ReadJson.h"
+#include "JsonParsedWriter.h"
+#include "Misc/FileHelper.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    /** 重复执行取最快的一次（秒） */
+    template <typename TFunction>
+    double MeasureBest(const int32 Iterations, TFunction&& Function)
+    {
+        double Best = TNumericLimits<double>::Max();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            Function();
+            Best = FMath::Min(Best, FPlatformTime::Seconds() - StartTime);
+        }
+        return Best;
+    }
+
+    /** 生成测试文档：items 下每个对象含数值、字符串、嵌套对象与数组，按两空格缩进 */
+    FString MakeSyntheticJson(const int32 NumItems)
+    {
+        FString JsonText;
+        JsonText.Reserve(NumItems * 256);
+        JsonText += TEXT("{\n  \"items\": {\n");
+        for (int32 Index = 0; Index < NumItems; ++Index)
+        {
+            JsonText += FString::Printf(
+                TEXT("    \"item%d\": {\n      \"id\": %d,\n      \"name\": \"Item \\\"%d\\\"\",\n      \"health\": %d.25,\n      \"enabled\": %s,\n")
+                TEXT("      \"position\": { \"x\": %d.5, \"y\": -%d.5, \"z\": 0.125 },\n      \"tags\": [ \"common\", \"level%d\" ]\n    }%s\n"),
+                Index, Index, Index, Index % 100, Index % 2 ? TEXT("true") : TEXT("false"), Index, Index, Index % 10, Index + 1 < NumItems ? TEXT(",") : TEXT(""));
+        }
+        JsonText += TEXT("  }\n}\n");
+        return JsonText;
+    }
+}
+
+UJsonWriterBenchmarkCommandlet::UJsonWriterBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UJsonWriterBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 NumItems = 20000;
+    int32 Iterations = 5;
+    FString InputFile;
+    FParse::Value(*Params, TEXT("Items="), NumItems);
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    Iterations = FMath::Max(Iterations, 1);
+
+    // 准备数据
+    FString JsonText;
+    if (FParse::Value(*Params, TEXT("Input="), InputFile))
+    {
+        if (!FFileHelper::LoadFileToString(JsonText, *InputFile))
+        {
+            UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to load [ %s ]"), __FUNCTION__, *InputFile);
+            return 1;
+        }
+    }
+    else
+    {
+        JsonText = MakeSyntheticJson(FMath::Max(NumItems, 1));
+    }
+
+    FParsedData ParsedData;
+    bool bIsValid = false;
+    UAsync_ReadJson::ReadJson_Block(nullptr, JsonText, ParsedData, bIsValid);
+    TSharedPtr<FJsonObject> JsonObject;
+    if (!bIsValid || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonText), JsonObject) || !JsonObject.IsValid())
+    {
+        UE_LOG(LogReadJson, Error, TEXT("[ %hs ] Failed to parse input"), __FUNCTION__);
+        return 1;
+    }
+
+    // FJsonSerializer：紧凑格式写入 FString 后转换为 UTF-8
+    TArray<uint8> SerializerBytes;
+    const double SerializerSeconds = MeasureBest(Iterations, [&JsonObject, &SerializerBytes]()
+    {
+        FString Output;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+        FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+        const FTCHARToUTF8 Converter(*Output, Output.Len());
+        SerializerBytes.Reset();
+        SerializerBytes.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+    });
+
+    // FJsonParsedWriter：写入器与输出缓冲复用
+    FJsonParsedWriter ParsedWriter;
+    TArray<uint8> ReuseBytes;
+    const double ReuseSeconds = MeasureBest(Iterations, [&ParsedWriter, &ParsedData, &ReuseBytes]()
+    {
+        ParsedWriter.Write(ParsedData, ReuseBytes);
+    });
+
+    ParsedWriter.SetReuseSpans(false);
+    TArray<uint8> RebuildBytes;
+    const double RebuildSeconds = MeasureBest(Iterations, [&ParsedWriter, &ParsedData, &RebuildBytes]()
+    {
+        ParsedWriter.Write(ParsedData, RebuildBytes);
+    });
+
+    const auto Throughput = [](const TArray<uint8>& Bytes, const double Seconds)
+    {
+        return Bytes.Num() / (1024.0 * 1024.0) / FMath::Max(Seconds, 1.0e-9);
+    };
+
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] %d entries, %d source characters, best of %d iterations"), __FUNCTION__, ParsedData.NumEntries(), JsonText.Len(), Iterations);
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ]                        Time (ms)   Output (KB)  MB/s"), __FUNCTION__);
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] FJsonSerializer        %-10.2f  %-11.1f  %-10.1f"), __FUNCTION__, SerializerSeconds * 1000.0, SerializerBytes.Num() / 1024.0, Throughput(SerializerBytes, SerializerSeconds));
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] ParsedWriter (reuse)   %-10.2f  %-11.1f  %-10.1f"), __FUNCTION__, ReuseSeconds * 1000.0, ReuseBytes.Num() / 1024.0, Throughput(ReuseBytes, ReuseSeconds));
+    UE_LOG(LogReadJson, Display, TEXT("[ %hs ] ParsedWriter (rebuild) %-10.2f  %-11.1f  %-10.1f"), __FUNCTION__, RebuildSeconds * 1000.0, RebuildBytes.Num() / 1024.0, Throughput(RebuildBytes, RebuildSeconds));
+    return 0;
+}
@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealReadJsonEditor.h"
+#include "JsonStructBinding.h"
+#include "Kismet2/StructureEditorUtils.h"
+
+#define LOCTEXT_NAMESPACE "FUnrealReadJsonEditorModule"
+
+/**
+ * 蓝图结构体（UUserDefinedStruct）在原对象上重新编译，结构体指针不变而属性被重建，
+ * 修改前后都清空结构体绑定计划（外层结构体的计划中可能展开了该结构体）
+ */
+class FJsonStructChangeListener : public FStructureEditorUtils::INotifyOnStructChanged
+{
+public:
+	virtual void PreChange(const UUserDefinedStruct* Changed, FStructureEditorUtils::EStructureEditorChangeInfo ChangedType) override
+	{
+		JsonStructBindingHelper::ClearPlanCache();
+	}
+
+	virtual void PostChange(const UUserDefinedStruct* Changed, FStructureEditorUtils::EStructureEditorChangeInfo ChangedType) override
+	{
+		JsonStructBindingHelper::ClearPlanCache();
+	}
+};
+
+void FUnrealReadJsonEditorModule::StartupModule()
+{
+	// UFlattenedJsonAssetFactory 通过 UClass 反射自动注册，这里无需额外操作
+	StructChangeListener = MakeUnique<FJsonStructChangeListener>();
+}
+
+void FUnrealReadJsonEditorModule::ShutdownModule()
+{
+	StructChangeListener.Reset();
+}
+
+#undef LOCTEXT_NAMESPACE
+	
+IMPLEMENT_MODULE(FUnrealReadJsonEditorModule, UnrealReadJsonEditor)
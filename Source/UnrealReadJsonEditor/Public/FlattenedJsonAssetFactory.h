@@ -0,0 +1,62 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Factories/Factory.h"
+#include "EditorReimportHandler.h"
+#include "FlattenedJsonAssetFactory.generated.h"
+
+struct FParsedData;
+
+/**
+ * 扁平化JSON资产导入工厂
+ * 导入根节点为对象的 .json 文件，在导入/重新导入时运行插件的扁平化流程，
+ * 运行时与打包后的游戏不再需要解析JSON
+ * 根节点为数组的 .json 文件（如 DataTable）不会被本工厂接管
+ *
+ * 默认与引擎自带的 JSON 导入优先级相同；需要优先导入为扁平化资产时在 DefaultEditor.ini 中开启：
+ * [/Script/UnrealReadJsonEditor.FlattenedJsonAssetFactory]
+ * bPreferForJsonObjects=True
+ */
+UCLASS(hidecategories = Object, config = Editor)
+class UNREALREADJSONEDITOR_API UFlattenedJsonAssetFactory : public UFactory, public FReimportHandler
+{
+    GENERATED_BODY()
+
+public:
+    UFlattenedJsonAssetFactory();
+
+    /** 根节点为对象的 .json 文件优先于引擎自带的 JSON 导入（DataTable/CurveTable），修改后重启编辑器生效 */
+    UPROPERTY(Config)
+    bool bPreferForJsonObjects = false;
+
+    virtual void PostInitProperties() override;
+
+    // ========================================================================
+    // UFactory 接口
+    // ========================================================================
+
+    virtual bool FactoryCanImport(const FString& Filename) override;
+    virtual UObject* FactoryCreateText(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, UObject* Context,
+        const TCHAR* Type, const TCHAR*& Buffer, const TCHAR* BufferEnd, FFeedbackContext* Warn) override;
+
+    // ========================================================================
+    // FReimportHandler 接口
+    // ========================================================================
+
+    virtual bool CanReimport(UObject* Obj, TArray<FString>& OutFilenames) override;
+    virtual void SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths) override;
+    virtual EReimportResult::Type Reimport(UObject* Obj) override;
+    virtual int32 GetPriority() const override;
+
+private:
+    /** FactoryCanImport 读取的文件开头的字节数 */
+    static constexpr int32 MaxSniffBytes = 4096;
+
+    /**
+     * 扁平化JSON文本
+     * @param JsonText JSON文本
+     * @param OutParsedData 扁平化结果
+     * @return 是否成功
+     */
+    static bool FlattenJsonText(const FString& JsonText, FParsedData& OutParsedData);
+};
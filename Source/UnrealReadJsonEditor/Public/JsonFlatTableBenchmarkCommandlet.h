@@ -0,0 +1,27 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "JsonFlatTableBenchmarkCommandlet.generated.h"
+
+/**
+ * FJsonFlatTable、FJsonFrozenDocument 与 TMap<FString, FJsonDataStruct> 的构建与查找基准测试
+ *
+ * 用法:
+ * UnrealEditor-Cmd.exe Project.uproject -run=JsonFlatTableBenchmark [-Input=Data.json] [-Entries=100000] [-Iterations=5]
+ *
+ * - 指定 Input 时使用该文档扁平化后的条目，否则生成 Entries 个形如 groupN.itemN.field 的路径
+ * - 每项测量重复 Iterations 次取最快的一次，查找按打乱后的顺序进行，分别测量命中与未命中
+ * - FindEntry 一行经由 FParsedData::FindEntry 命中查找，对比 ParsedDataMap 存储与数据表存储（bFlatTableStorage）
+ * - 内存包含键的内容，不含值中字符串的堆内存
+ */
+UCLASS()
+class UNREALREADJSONEDITOR_API UJsonFlatTableBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UJsonFlatTableBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
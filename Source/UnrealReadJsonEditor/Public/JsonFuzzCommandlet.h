@@ -0,0 +1,31 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "JsonFuzzCommandlet.generated.h"
+
+/**
+ * 解析引擎的差分模糊测试与吞吐量回归检查（可在 Linux 上无界面运行）
+ *
+ * 用法:
+ * UnrealEditor-Cmd Project.uproject -run=JsonFuzz [-Corpus=Dir] [-Mutations=200] [-Seed=1] [-FailDir=Dir] [-Numbers=100000]
+ *                  [-Input=Data.json] [-Items=20000] [-Iterations=5] [-SaveBaseline=File] [-Baseline=File] [-MaxSlowdown=0.2]
+ *
+ * - 语料目录下的每个 *.json（默认为插件的 Resources/Fuzz/Corpus）及其 Mutations 个随机变异输入都交给 JsonDifferential::Run，
+ *   与参考实现（FJsonSerializer + ParseJsonValue，数值由 FCString::Atod / Atoi64 转换）结果不同的输入写入 FailDir（默认 Saved/JsonFuzz），
+ *   参与比较的包括键比较策略、路径转义与数组批量解析
+ * - 种子中的数值字面量与 Numbers 个随机字面量交给 JsonDifferential::CheckNumberLiteral，与 FCString::Atod 逐位比较
+ * - 之后在 Input 文档（未指定时生成 Items 个对象）上测量参考实现与各解析引擎的吞吐量，重复 Iterations 次取最快的一次
+ * - SaveBaseline 保存吞吐量；指定 Baseline 时，任一引擎低于基线的 (1 - MaxSlowdown) 倍即视为回归
+ * - 出现差异、数值解析不一致或回归时返回 1
+ */
+UCLASS()
+class UNREALREADJSONEDITOR_API UJsonFuzzCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UJsonFuzzCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
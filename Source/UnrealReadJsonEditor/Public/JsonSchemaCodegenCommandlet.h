@@ -0,0 +1,49 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonData.h"
+#include "Commandlets/Commandlet.h"
+#include "JsonSchemaCodegenCommandlet.generated.h"
+
+class FJsonObject;
+
+/**
+ * 类型化访问器代码生成命令行工具
+ * 读取 JSON Schema 或示例文档，生成继承 TJsonSchemaAccessor 的 C++ 访问器结构体，
+ * 每个已知路径对应固定的槽位下标，读取时为常量下标访问并在编译期检查类型
+ *
+ * 用法:
+ * UnrealEditor-Cmd.exe Project.uproject -run=JsonSchemaCodegen -Input=Player.schema.json -Output=Source/Game/PlayerJson.h -Name=PlayerJson [-Mode=Schema|Sample]
+ *
+ * - Mode 省略时自动判断：根对象包含 $schema，或 type 为 object 且包含 properties 时按 Schema 处理
+ * - 数组与没有声明属性的对象不会被扁平化，生成为字符串字段（保存序列化后的JSON）
+ */
+UCLASS()
+class UNREALREADJSONEDITOR_API UJsonSchemaCodegenCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UJsonSchemaCodegenCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    struct FGeneratedField
+    {
+        FString Path;
+        EValueType Type = EValueType::String;
+    };
+
+    /** 从 JSON Schema 收集字段 */
+    static void CollectSchemaFields(const TSharedPtr<FJsonObject>& Schema, const FString& BasePath, TArray<FGeneratedField>& OutFields);
+
+    /** 从示例文档收集字段 */
+    static void CollectSampleFields(const TSharedPtr<FJsonObject>& Sample, const FString& BasePath, TArray<FGeneratedField>& OutFields);
+
+    /** 生成访问器头文件内容 */
+    static FString GenerateHeader(const FString& StructName, const FString& SourceFile, const TArray<FGeneratedField>& Fields);
+
+    /** 将路径转换为合法的 C++ 标识符（PascalCase） */
+    static FString MakeIdentifier(const FString& Path);
+};
@@ -0,0 +1,27 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "JsonWriterBenchmarkCommandlet.generated.h"
+
+/**
+ * FJsonParsedWriter 与 FJsonSerializer::Serialize 的序列化吞吐量基准测试
+ *
+ * 用法:
+ * UnrealEditor-Cmd.exe Project.uproject -run=JsonWriterBenchmark [-Input=Data.json] [-Items=20000] [-Iterations=5]
+ *
+ * - 指定 Input 时使用该文档，否则生成 Items 个带缩进的对象
+ * - FJsonSerializer 从已构建好的 FJsonObject 写出紧凑格式后转换为 UTF-8（不含由扁平化数据重建 DOM 的时间）
+ * - FJsonParsedWriter 分别测量复用保存的文本与按子条目全部重建两种情况，输出缓冲在多次写入之间复用
+ * - 每项测量重复 Iterations 次取最快的一次
+ */
+UCLASS()
+class UNREALREADJSONEDITOR_API UJsonWriterBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UJsonWriterBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};